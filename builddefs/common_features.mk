@@ -23,8 +23,10 @@ QUANTUM_SRC += \
     $(QUANTUM_DIR)/action_util.c \
     $(QUANTUM_DIR)/eeconfig.c \
     $(QUANTUM_DIR)/keyboard.c \
+    $(QUANTUM_DIR)/keyevent_queue.c \
     $(QUANTUM_DIR)/keymap_common.c \
     $(QUANTUM_DIR)/keycode_config.c \
+    $(QUANTUM_DIR)/keycode_dispatch.c \
     $(QUANTUM_DIR)/sync_timer.c \
     $(QUANTUM_DIR)/logging/debug.c \
     $(QUANTUM_DIR)/logging/sendchar.c \
@@ -47,6 +49,12 @@ else ifeq ($(strip $(DEBUG_MATRIX_SCAN_RATE_ENABLE)), api)
     OPT_DEFS += -DDEBUG_MATRIX_SCAN_RATE
 endif
 
+ifeq ($(strip $(DEFERRED_LOG_ENABLE)), yes)
+    OPT_DEFS += -DDEFERRED_LOG_ENABLE
+    CONSOLE_ENABLE = yes
+    QUANTUM_SRC += $(QUANTUM_DIR)/logging/deferred_log.c
+endif
+
 AUDIO_ENABLE ?= no
 ifeq ($(strip $(AUDIO_ENABLE)), yes)
     ifeq ($(PLATFORM),CHIBIOS)
@@ -75,6 +83,7 @@ ifeq ($(strip $(AUDIO_ENABLE)), yes)
     SRC += $(PLATFORM_PATH)/$(PLATFORM_KEY)/$(DRIVER_DIR)/audio_$(strip $(AUDIO_DRIVER)).c
     SRC += $(QUANTUM_DIR)/audio/voices.c
     SRC += $(QUANTUM_DIR)/audio/luts.c
+    SRC += $(QUANTUM_DIR)/audio/audio_dds.c
 endif
 
 ifeq ($(strip $(SEQUENCER_ENABLE)), yes)
@@ -133,6 +142,8 @@ ifeq ($(strip $(POINTING_DEVICE_ENABLE)), yes)
         VPATH += $(QUANTUM_DIR)/pointing_device
         SRC += $(QUANTUM_DIR)/pointing_device/pointing_device.c
         SRC += $(QUANTUM_DIR)/pointing_device/pointing_device_auto_mouse.c
+        SRC += $(QUANTUM_DIR)/pointing_device/pointing_device_accumulator.c
+        SRC += $(QUANTUM_DIR)/pointing_device/pointing_device_sampling.c
         ifneq ($(strip $(POINTING_DEVICE_DRIVER)), custom)
             SRC += drivers/sensors/$(strip $(POINTING_DEVICE_DRIVER)).c
             OPT_DEFS += -DPOINTING_DEVICE_DRIVER_$(strip $(shell echo $(POINTING_DEVICE_DRIVER) | tr '[:lower:]' '[:upper:]'))
@@ -242,6 +253,10 @@ ifneq ($(strip $(EEPROM_DRIVER)),none)
           OPT_DEFS += -DEEPROM_DRIVER -DEEPROM_TRANSIENT
           SRC += eeprom_driver.c eeprom_transient.c
         endif
+      else ifeq ($(PLATFORM),LINUX)
+        # Host "EEPROM", optionally backed by a file
+        OPT_DEFS += -DEEPROM_DRIVER -DEEPROM_LINUX
+        SRC += eeprom_driver.c eeprom_linux.c
       else ifeq ($(PLATFORM),TEST)
         # Test harness "EEPROM"
         OPT_DEFS += -DEEPROM_TEST_HARNESS
@@ -354,6 +369,7 @@ ifeq ($(strip $(LED_MATRIX_ENABLE)), yes)
     SRC += $(QUANTUM_DIR)/led_matrix/led_matrix_drivers.c
     LIB8TION_ENABLE := yes
     CIE1931_CURVE := yes
+    RENDER_BUDGET := yes
 
     ifeq ($(strip $(LED_MATRIX_DRIVER)), is31fl3218)
         I2C_DRIVER_REQUIRED = yes
@@ -474,6 +490,7 @@ ifeq ($(strip $(RGB_MATRIX_ENABLE)), yes)
     SRC += $(QUANTUM_DIR)/rgb_matrix/rgb_matrix_drivers.c
     LIB8TION_ENABLE := yes
     CIE1931_CURVE := yes
+    RENDER_BUDGET := yes
 
     ifeq ($(strip $(RGB_MATRIX_DRIVER)), aw20216s)
         SPI_DRIVER_REQUIRED = yes
@@ -628,6 +645,11 @@ ifeq ($(strip $(LED_TABLES)), yes)
     SRC += $(QUANTUM_DIR)/led_tables.c
 endif
 
+ifeq ($(strip $(RENDER_BUDGET)), yes)
+    COMMON_VPATH += $(QUANTUM_DIR)/render_budget
+    SRC += $(QUANTUM_DIR)/render_budget/render_budget.c
+endif
+
 ifeq ($(strip $(VIA_ENABLE)), yes)
     DYNAMIC_KEYMAP_ENABLE := yes
     RAW_ENABLE := yes
@@ -644,6 +666,27 @@ ifeq ($(strip $(DYNAMIC_KEYMAP_ENABLE)), yes)
     SEND_STRING_ENABLE := yes
 endif
 
+VALID_ANALOG_MATRIX_DRIVER_TYPES := mux custom
+ANALOG_MATRIX_DRIVER ?= mux
+ifeq ($(strip $(ANALOG_MATRIX_ENABLE)), yes)
+    ifeq ($(filter $(ANALOG_MATRIX_DRIVER),$(VALID_ANALOG_MATRIX_DRIVER_TYPES)),)
+        $(call CATASTROPHIC_ERROR,Invalid ANALOG_MATRIX_DRIVER,ANALOG_MATRIX_DRIVER="$(ANALOG_MATRIX_DRIVER)" is not a valid analog matrix driver)
+    else
+        OPT_DEFS += -DANALOG_MATRIX_ENABLE
+        COMMON_VPATH += $(QUANTUM_DIR)/analog_matrix
+        QUANTUM_SRC += $(QUANTUM_DIR)/analog_matrix/analog_matrix.c
+
+        # The analog matrix provides the scanning, and its hysteresis replaces debouncing
+        CUSTOM_MATRIX = lite
+        DEBOUNCE_TYPE ?= none
+
+        ifeq ($(strip $(ANALOG_MATRIX_DRIVER)), mux)
+            ANALOG_DRIVER_REQUIRED = yes
+            QUANTUM_SRC += $(QUANTUM_DIR)/analog_matrix/analog_matrix_mux.c
+        endif
+    endif
+endif
+
 VALID_CUSTOM_MATRIX_TYPES:= yes lite no
 
 CUSTOM_MATRIX ?= no
@@ -687,7 +730,8 @@ ifeq ($(strip $(SPLIT_KEYBOARD)), yes)
     # Determine which (if any) transport files are required
     ifneq ($(strip $(SPLIT_TRANSPORT)), custom)
         QUANTUM_SRC += $(QUANTUM_DIR)/split_common/transport.c \
-                       $(QUANTUM_DIR)/split_common/transactions.c
+                       $(QUANTUM_DIR)/split_common/transactions.c \
+                       $(QUANTUM_DIR)/split_common/split_switch_events.c
 
         OPT_DEFS += -DSPLIT_COMMON_TRANSACTIONS
 
@@ -704,7 +748,8 @@ ifeq ($(strip $(SPLIT_KEYBOARD)), yes)
         ifeq ($(strip $(SERIAL_DRIVER)), bitbang)
             QUANTUM_LIB_SRC += serial.c
         else
-            QUANTUM_LIB_SRC += serial_protocol.c
+            QUANTUM_LIB_SRC += serial_protocol.c \
+                               split_frame.c
             QUANTUM_LIB_SRC += serial_$(strip $(SERIAL_DRIVER)).c
         endif
     endif
@@ -998,6 +1043,18 @@ ifeq ($(strip $(ANALOG_DRIVER_REQUIRED)), yes)
     QUANTUM_LIB_SRC += analog.c
 endif
 
+ifeq ($(strip $(BUS_QUEUE_ENABLE)), yes)
+    OPT_DEFS += -DBUS_QUEUE_ENABLE
+    COMMON_VPATH += $(QUANTUM_DIR)/bus_queue
+    SRC += $(QUANTUM_DIR)/bus_queue/bus_queue.c
+    ifeq ($(strip $(I2C_DRIVER_REQUIRED)), yes)
+        OPT_DEFS += -DBUS_QUEUE_I2C
+    endif
+    ifeq ($(strip $(SPI_DRIVER_REQUIRED)), yes)
+        OPT_DEFS += -DBUS_QUEUE_SPI
+    endif
+endif
+
 ifeq ($(strip $(I2C_DRIVER_REQUIRED)), yes)
     OPT_DEFS += -DHAL_USE_I2C=TRUE
     QUANTUM_LIB_SRC += i2c_master.c
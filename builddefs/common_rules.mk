@@ -43,6 +43,15 @@ ifneq ($(USE_CCACHE),no)
     CC_PREFIX ?= ccache
 endif
 
+# Share object files between builds (eg. mass compiles) through the built-in compilation cache
+USE_COMPILE_CACHE ?= no
+COMPILE_CACHE_DIR ?= $(BUILD_DIR)/compile_cache
+# Least recently used objects are removed once the cache grows past this many MiB
+COMPILE_CACHE_MAX_SIZE ?= 2048
+ifneq ($(USE_COMPILE_CACHE),no)
+    CC_PREFIX ?= $(TOP_DIR)/util/compile_cache.py --cache-dir $(COMPILE_CACHE_DIR) --max-size $(COMPILE_CACHE_MAX_SIZE)
+endif
+
 #---------------- Debug Options ----------------
 
 DEBUG_ENABLE ?= no
@@ -29,7 +29,8 @@ HARDWARE_OPTION_NAMES = \
   ENCODER_ENABLE \
   LED_TABLES \
   POINTING_DEVICE_ENABLE \
-  DIP_SWITCH_ENABLE
+  DIP_SWITCH_ENABLE \
+  BUS_QUEUE_ENABLE
 
 OTHER_OPTION_NAMES = \
   UNICODE_ENABLE \
@@ -18,7 +18,12 @@
 #include "i2c_master.h"
 #include "gpio.h"
 
+#ifdef BUS_QUEUE_ENABLE
+#    include "bus_queue.h"
+#endif
+
 #define IS31FL3218_PWM_REGISTER_COUNT 18
+#define IS31FL3218_PWM_TRANSACTION_COUNT 2
 #define IS31FL3218_LED_CONTROL_REGISTER_COUNT 3
 
 #ifndef IS31FL3218_I2C_TIMEOUT
@@ -44,6 +49,19 @@ is31fl3218_driver_t driver_buffers = {
     .led_control_buffer_dirty = false,
 };
 
+#ifdef BUS_QUEUE_ENABLE
+// The PWM transfer and the update register write, queued by is31fl3218_update_pwm_buffers().
+static const uint8_t     update_value = 0x01;
+static bus_transaction_t pwm_transactions[IS31FL3218_PWM_TRANSACTION_COUNT];
+
+static void is31fl3218_pwm_transaction_done(bus_transaction_t *transaction) {
+    // Out of IS31FL3218_I2C_PERSISTENCE attempts, send the whole buffer again with the next flush
+    if (transaction->status != I2C_STATUS_SUCCESS) {
+        ((is31fl3218_driver_t *)transaction->context)->pwm_buffer_dirty = true;
+    }
+}
+#endif
+
 void is31fl3218_write_register(uint8_t reg, uint8_t data) {
 #if IS31FL3218_I2C_PERSISTENCE > 0
     for (uint8_t i = 0; i < IS31FL3218_I2C_PERSISTENCE; i++) {
@@ -137,9 +155,28 @@ void is31fl3218_set_led_control_register(uint8_t index, bool value) {
 
 void is31fl3218_update_pwm_buffers(void) {
     if (driver_buffers.pwm_buffer_dirty) {
+#ifdef BUS_QUEUE_ENABLE
+        bus_transaction_t *transactions = pwm_transactions;
+
+        // The last flush is still on the bus, leave the changes for the next one
+        if (bus_transaction_pending(&transactions[IS31FL3218_PWM_TRANSACTION_COUNT - 1])) {
+            return;
+        }
+
+        for (uint8_t i = 0; i < IS31FL3218_PWM_TRANSACTION_COUNT; i++) {
+            transactions[i].callback    = is31fl3218_pwm_transaction_done;
+            transactions[i].context     = &driver_buffers;
+            transactions[i].persistence = IS31FL3218_I2C_PERSISTENCE;
+        }
+
+        bus_queue_i2c_write_register(&transactions[0], IS31FL3218_I2C_ADDRESS << 1, IS31FL3218_REG_PWM, driver_buffers.pwm_buffer, IS31FL3218_PWM_REGISTER_COUNT, IS31FL3218_I2C_TIMEOUT);
+        // Load PWM registers and LED Control register data
+        bus_queue_i2c_write_register(&transactions[1], IS31FL3218_I2C_ADDRESS << 1, IS31FL3218_REG_UPDATE, &update_value, 1, IS31FL3218_I2C_TIMEOUT);
+#else
         is31fl3218_write_pwm_buffer();
         // Load PWM registers and LED Control register data
         is31fl3218_write_register(IS31FL3218_REG_UPDATE, 0x01);
+#endif
 
         driver_buffers.pwm_buffer_dirty = false;
     }
@@ -21,7 +21,12 @@
 #include "gpio.h"
 #include "wait.h"
 
+#ifdef BUS_QUEUE_ENABLE
+#    include "bus_queue.h"
+#endif
+
 #define IS31FL3729_PWM_REGISTER_COUNT 143
+#define IS31FL3729_PWM_TRANSACTION_COUNT (IS31FL3729_PWM_REGISTER_COUNT / 13)
 #define IS31FL3729_SCALING_REGISTER_COUNT 16
 
 #ifndef IS31FL3729_I2C_TIMEOUT
@@ -93,6 +98,18 @@ is31fl3729_driver_t driver_buffers[IS31FL3729_DRIVER_COUNT] = {{
     .scaling_buffer_dirty = false,
 }};
 
+#ifdef BUS_QUEUE_ENABLE
+// The 11 PWM transfers of each driver, queued by is31fl3729_update_pwm_buffers().
+static bus_transaction_t pwm_transactions[IS31FL3729_DRIVER_COUNT][IS31FL3729_PWM_TRANSACTION_COUNT];
+
+static void is31fl3729_pwm_transaction_done(bus_transaction_t *transaction) {
+    // Out of IS31FL3729_I2C_PERSISTENCE attempts, send the whole buffer again with the next flush
+    if (transaction->status != I2C_STATUS_SUCCESS) {
+        ((is31fl3729_driver_t *)transaction->context)->pwm_buffer_dirty = true;
+    }
+}
+#endif
+
 void is31fl3729_write_register(uint8_t index, uint8_t reg, uint8_t data) {
 #if IS31FL3729_I2C_PERSISTENCE > 0
     for (uint8_t i = 0; i < IS31FL3729_I2C_PERSISTENCE; i++) {
@@ -196,7 +213,26 @@ void is31fl3729_set_scaling_register(uint8_t index, uint8_t red, uint8_t green,
 
 void is31fl3729_update_pwm_buffers(uint8_t index) {
     if (driver_buffers[index].pwm_buffer_dirty) {
+#ifdef BUS_QUEUE_ENABLE
+        bus_transaction_t *transactions = pwm_transactions[index];
+
+        // The last flush is still on the bus, leave the changes for the next one
+        if (bus_transaction_pending(&transactions[IS31FL3729_PWM_TRANSACTION_COUNT - 1])) {
+            return;
+        }
+
+        for (uint8_t i = 0; i < IS31FL3729_PWM_TRANSACTION_COUNT; i++) {
+            transactions[i].callback    = is31fl3729_pwm_transaction_done;
+            transactions[i].context     = &driver_buffers[index];
+            transactions[i].persistence = IS31FL3729_I2C_PERSISTENCE;
+        }
+
+        for (uint8_t i = 0; i < IS31FL3729_PWM_REGISTER_COUNT; i += 13) {
+            bus_queue_i2c_write_register(&transactions[i / 13], i2c_addresses[index] << 1, IS31FL3729_REG_PWM + i, driver_buffers[index].pwm_buffer + i, 13, IS31FL3729_I2C_TIMEOUT);
+        }
+#else
         is31fl3729_write_pwm_buffer(index);
+#endif
 
         driver_buffers[index].pwm_buffer_dirty = false;
     }
@@ -22,7 +22,12 @@
 #include "gpio.h"
 #include "wait.h"
 
+#ifdef BUS_QUEUE_ENABLE
+#    include "bus_queue.h"
+#endif
+
 #define IS31FL3731_PWM_REGISTER_COUNT 144
+#define IS31FL3731_PWM_TRANSACTION_COUNT (IS31FL3731_PWM_REGISTER_COUNT / 16)
 #define IS31FL3731_LED_CONTROL_REGISTER_COUNT 18
 
 #ifndef IS31FL3731_I2C_TIMEOUT
@@ -65,6 +70,18 @@ is31fl3731_driver_t driver_buffers[IS31FL3731_DRIVER_COUNT] = {{
     .led_control_buffer_dirty = false,
 }};
 
+#ifdef BUS_QUEUE_ENABLE
+// The 9 PWM transfers of each driver, queued by is31fl3731_update_pwm_buffers().
+static bus_transaction_t pwm_transactions[IS31FL3731_DRIVER_COUNT][IS31FL3731_PWM_TRANSACTION_COUNT];
+
+static void is31fl3731_pwm_transaction_done(bus_transaction_t *transaction) {
+    // Out of IS31FL3731_I2C_PERSISTENCE attempts, send the whole buffer again with the next flush
+    if (transaction->status != I2C_STATUS_SUCCESS) {
+        ((is31fl3731_driver_t *)transaction->context)->pwm_buffer_dirty = true;
+    }
+}
+#endif
+
 void is31fl3731_write_register(uint8_t index, uint8_t reg, uint8_t data) {
 #if IS31FL3731_I2C_PERSISTENCE > 0
     for (uint8_t i = 0; i < IS31FL3731_I2C_PERSISTENCE; i++) {
@@ -76,6 +93,10 @@ void is31fl3731_write_register(uint8_t index, uint8_t reg, uint8_t data) {
 }
 
 void is31fl3731_select_page(uint8_t index, uint8_t page) {
+#ifdef BUS_QUEUE_ENABLE
+    // Queued PWM writes go to the frame selected when they were queued
+    bus_queue_flush();
+#endif
     is31fl3731_write_register(index, IS31FL3731_REG_COMMAND, page);
 }
 
@@ -207,7 +228,26 @@ void is31fl3731_set_led_control_register(uint8_t index, bool value) {
 
 void is31fl3731_update_pwm_buffers(uint8_t index) {
     if (driver_buffers[index].pwm_buffer_dirty) {
+#ifdef BUS_QUEUE_ENABLE
+        bus_transaction_t *transactions = pwm_transactions[index];
+
+        // The last flush is still on the bus, leave the changes for the next one
+        if (bus_transaction_pending(&transactions[IS31FL3731_PWM_TRANSACTION_COUNT - 1])) {
+            return;
+        }
+
+        for (uint8_t i = 0; i < IS31FL3731_PWM_TRANSACTION_COUNT; i++) {
+            transactions[i].callback    = is31fl3731_pwm_transaction_done;
+            transactions[i].context     = &driver_buffers[index];
+            transactions[i].persistence = IS31FL3731_I2C_PERSISTENCE;
+        }
+
+        for (uint8_t i = 0; i < IS31FL3731_PWM_REGISTER_COUNT; i += 16) {
+            bus_queue_i2c_write_register(&transactions[i / 16], i2c_addresses[index] << 1, IS31FL3731_FRAME_REG_PWM + i, driver_buffers[index].pwm_buffer + i, 16, IS31FL3731_I2C_TIMEOUT);
+        }
+#else
         is31fl3731_write_pwm_buffer(index);
+#endif
 
         driver_buffers[index].pwm_buffer_dirty = false;
     }
@@ -20,7 +20,12 @@
 #include "gpio.h"
 #include "wait.h"
 
+#ifdef BUS_QUEUE_ENABLE
+#    include "bus_queue.h"
+#endif
+
 #define IS31FL3736_PWM_REGISTER_COUNT 192 // actually 96
+#define IS31FL3736_PWM_TRANSACTION_COUNT (2 + IS31FL3736_PWM_REGISTER_COUNT / 16)
 #define IS31FL3736_LED_CONTROL_REGISTER_COUNT 24
 
 #ifndef IS31FL3736_I2C_TIMEOUT
@@ -80,6 +85,20 @@ is31fl3736_driver_t driver_buffers[IS31FL3736_DRIVER_COUNT] = {{
     .led_control_buffer_dirty = false,
 }};
 
+#ifdef BUS_QUEUE_ENABLE
+// The page select and the 12 PWM transfers of each driver, queued by is31fl3736_update_pwm_buffers().
+static const uint8_t     command_write_lock_magic = IS31FL3736_COMMAND_WRITE_LOCK_MAGIC;
+static const uint8_t     command_pwm              = IS31FL3736_COMMAND_PWM;
+static bus_transaction_t pwm_transactions[IS31FL3736_DRIVER_COUNT][IS31FL3736_PWM_TRANSACTION_COUNT];
+
+static void is31fl3736_pwm_transaction_done(bus_transaction_t *transaction) {
+    // Out of IS31FL3736_I2C_PERSISTENCE attempts, send the whole buffer again with the next flush
+    if (transaction->status != I2C_STATUS_SUCCESS) {
+        ((is31fl3736_driver_t *)transaction->context)->pwm_buffer_dirty = true;
+    }
+}
+#endif
+
 void is31fl3736_write_register(uint8_t index, uint8_t reg, uint8_t data) {
 #if IS31FL3736_I2C_PERSISTENCE > 0
     for (uint8_t i = 0; i < IS31FL3736_I2C_PERSISTENCE; i++) {
@@ -91,6 +110,10 @@ void is31fl3736_write_register(uint8_t index, uint8_t reg, uint8_t data) {
 }
 
 void is31fl3736_select_page(uint8_t index, uint8_t page) {
+#ifdef BUS_QUEUE_ENABLE
+    // Queued PWM writes rely on the page they selected themselves
+    bus_queue_flush();
+#endif
     is31fl3736_write_register(index, IS31FL3736_REG_COMMAND_WRITE_LOCK, IS31FL3736_COMMAND_WRITE_LOCK_MAGIC);
     is31fl3736_write_register(index, IS31FL3736_REG_COMMAND, page);
 }
@@ -230,9 +253,30 @@ void is31fl3736_set_led_control_register(uint8_t index, bool red, bool green, bo
 
 void is31fl3736_update_pwm_buffers(uint8_t index) {
     if (driver_buffers[index].pwm_buffer_dirty) {
+#ifdef BUS_QUEUE_ENABLE
+        bus_transaction_t *transactions = pwm_transactions[index];
+
+        // The last flush is still on the bus, leave the changes for the next one
+        if (bus_transaction_pending(&transactions[IS31FL3736_PWM_TRANSACTION_COUNT - 1])) {
+            return;
+        }
+
+        for (uint8_t i = 0; i < IS31FL3736_PWM_TRANSACTION_COUNT; i++) {
+            transactions[i].callback    = is31fl3736_pwm_transaction_done;
+            transactions[i].context     = &driver_buffers[index];
+            transactions[i].persistence = IS31FL3736_I2C_PERSISTENCE;
+        }
+
+        bus_queue_i2c_write_register(&transactions[0], i2c_addresses[index] << 1, IS31FL3736_REG_COMMAND_WRITE_LOCK, &command_write_lock_magic, 1, IS31FL3736_I2C_TIMEOUT);
+        bus_queue_i2c_write_register(&transactions[1], i2c_addresses[index] << 1, IS31FL3736_REG_COMMAND, &command_pwm, 1, IS31FL3736_I2C_TIMEOUT);
+        for (uint8_t i = 0; i < IS31FL3736_PWM_REGISTER_COUNT; i += 16) {
+            bus_queue_i2c_write_register(&transactions[2 + i / 16], i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer + i, 16, IS31FL3736_I2C_TIMEOUT);
+        }
+#else
         is31fl3736_select_page(index, IS31FL3736_COMMAND_PWM);
 
         is31fl3736_write_pwm_buffer(index);
+#endif
 
         driver_buffers[index].pwm_buffer_dirty = false;
     }
@@ -33,6 +33,12 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "progmem.h"
 #include "wait.h"
 
+#if defined(OLED_TRANSPORT_I2C) && defined(BUS_QUEUE_I2C)
+#    include "bus_queue.h"
+// Blocks are queued on the bus while the main loop carries on, see oled_render_dirty()
+#    define OLED_BUS_QUEUE
+#endif
+
 // Used commands from spec sheet: https://cdn-shop.adafruit.com/datasheets/SSD1306.pdf
 // for SH1106: https://www.velleman.eu/downloads/29/infosheets/sh1106_datasheet.pdf
 // for SH1107: https://www.displayfuture.com/Display/datasheet/controller/SH1107.pdf
@@ -203,6 +209,9 @@ __attribute__((weak)) bool oled_send_cmd(const uint8_t *data, uint16_t size) {
     spi_stop();
     return true;
 #elif defined(OLED_TRANSPORT_I2C)
+#    ifdef OLED_BUS_QUEUE
+    bus_queue_flush();
+#    endif
     i2c_status_t status = i2c_transmit((OLED_DISPLAY_ADDRESS << 1), data, size, OLED_I2C_TIMEOUT);
 
     return (status == I2C_STATUS_SUCCESS);
@@ -226,6 +235,9 @@ __attribute__((weak)) bool oled_send_cmd_P(const uint8_t *data, uint16_t size) {
     return (status >= 0);
 #    elif defined(OLED_TRANSPORT_I2C)
 
+#        ifdef OLED_BUS_QUEUE
+    bus_queue_flush();
+#        endif
     i2c_status_t status = i2c_transmit_P((OLED_DISPLAY_ADDRESS << 1), data, size, OLED_I2C_TIMEOUT);
 
     return (status == I2C_STATUS_SUCCESS);
@@ -250,11 +262,81 @@ __attribute__((weak)) bool oled_send_data(const uint8_t *data, uint16_t size) {
     spi_stop();
     return true;
 #elif defined(OLED_TRANSPORT_I2C)
+#    ifdef OLED_BUS_QUEUE
+    bus_queue_flush();
+#    endif
     i2c_status_t status = i2c_write_register((OLED_DISPLAY_ADDRESS << 1), I2C_DATA, data, size, OLED_I2C_TIMEOUT);
     return (status == I2C_STATUS_SUCCESS);
 #endif
 }
 
+#ifdef OLED_BUS_QUEUE
+#    if OLED_IC_HAS_HORIZONTAL_MODE
+#        define OLED_BLOCK_COMMAND_SIZE 7
+#        define OLED_BLOCK_PAGES 1
+#    else
+#        define OLED_BLOCK_COMMAND_SIZE 4
+// Rotated blocks are sent a page at a time
+#        define OLED_BLOCK_PAGES (OLED_BLOCK_SIZE / ((OLED_BLOCK_SIZE + OLED_DISPLAY_HEIGHT - 1) / OLED_DISPLAY_HEIGHT * 8))
+#    endif
+
+// The position commands and the rotated data of a block, which stay put until the bus is done with them
+typedef struct {
+    uint8_t           block;
+    uint8_t           count;
+    uint8_t           commands[OLED_BLOCK_PAGES][OLED_BLOCK_COMMAND_SIZE];
+    uint8_t           data[OLED_BLOCK_SIZE];
+    bus_transaction_t transactions[2 * OLED_BLOCK_PAGES];
+} oled_block_transfer_t;
+
+// One for each block rendered at a time
+static oled_block_transfer_t  block_transfers[OLED_UPDATE_PROCESS_LIMIT];
+static uint8_t                next_block_transfer = 0;
+static oled_block_transfer_t *block_transfer;
+
+static void oled_block_transfer_done(bus_transaction_t *transaction) {
+    // Render the block again
+    if (transaction->status != I2C_STATUS_SUCCESS) {
+        oled_dirty |= (OLED_BLOCK_TYPE)1 << ((oled_block_transfer_t *)transaction->context)->block;
+    }
+}
+
+static bool oled_block_transfer_pending(const oled_block_transfer_t *transfer) {
+    for (uint8_t i = 0; i < transfer->count; i++) {
+        if (bus_transaction_pending(&transfer->transactions[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bus_transaction_t *oled_block_transaction(void) {
+    bus_transaction_t *transaction = &block_transfer->transactions[block_transfer->count++];
+    transaction->callback          = oled_block_transfer_done;
+    transaction->context           = block_transfer;
+    return transaction;
+}
+
+// Commands and data alternate, so every page of a block has a command buffer of its own
+static bool oled_send_block_cmd(const uint8_t *data, uint16_t size) {
+    uint8_t *command = block_transfer->commands[block_transfer->count / 2];
+    memcpy(command, data, size);
+    return bus_queue_i2c_transmit(oled_block_transaction(), (OLED_DISPLAY_ADDRESS << 1), command, size, OLED_I2C_TIMEOUT);
+}
+
+static bool oled_send_block_data(const uint8_t *data, uint16_t size) {
+    return bus_queue_i2c_write_register(oled_block_transaction(), (OLED_DISPLAY_ADDRESS << 1), I2C_DATA, data, size, OLED_I2C_TIMEOUT);
+}
+#else
+static inline bool oled_send_block_cmd(const uint8_t *data, uint16_t size) {
+    return oled_send_cmd(data, size);
+}
+
+static inline bool oled_send_block_data(const uint8_t *data, uint16_t size) {
+    return oled_send_data(data, size);
+}
+#endif
+
 __attribute__((weak)) void oled_driver_init(void) {
 #if defined(OLED_TRANSPORT_SPI)
     spi_init();
@@ -466,6 +548,20 @@ void oled_render_dirty(bool all) {
             ++update_start;
         }
 
+#ifdef OLED_BUS_QUEUE
+        block_transfer = &block_transfers[next_block_transfer];
+        if (oled_block_transfer_pending(block_transfer)) {
+            // The bus is still busy with earlier blocks, leave the rest for the next render
+            if (!all) {
+                return;
+            }
+            bus_queue_flush();
+        }
+        block_transfer->block = update_start;
+        block_transfer->count = 0;
+        next_block_transfer   = (next_block_transfer + 1) % OLED_UPDATE_PROCESS_LIMIT;
+#endif
+
         // Set column & page position
 #if OLED_IC_HAS_HORIZONTAL_MODE
         static uint8_t display_start[] = {I2C_CMD, COLUMN_ADDR, 0, OLED_DISPLAY_WIDTH - 1, PAGE_ADDR, 0, OLED_DISPLAY_HEIGHT / 8 - 1};
@@ -479,14 +575,14 @@ void oled_render_dirty(bool all) {
         }
 
         // Send column & page position
-        if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
+        if (!oled_send_block_cmd(display_start, ARRAY_SIZE(display_start))) {
             print("oled_render offset command failed\n");
             return;
         }
 
         if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
             // Send render data chunk as is
-            if (!oled_send_data(&oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE)) {
+            if (!oled_send_block_data(&oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE)) {
                 print("oled_render data failed\n");
                 return;
             }
@@ -495,15 +591,19 @@ void oled_render_dirty(bool all) {
             const static uint8_t source_map[] = OLED_SOURCE_MAP;
             const static uint8_t target_map[] = OLED_TARGET_MAP;
 
+#ifdef OLED_BUS_QUEUE
+            uint8_t *temp_buffer = block_transfer->data;
+#else
             static uint8_t temp_buffer[OLED_BLOCK_SIZE];
-            memset(temp_buffer, 0, sizeof(temp_buffer));
+#endif
+            memset(temp_buffer, 0, OLED_BLOCK_SIZE);
             for (uint8_t i = 0; i < sizeof(source_map); ++i) {
                 rotate_90(&oled_buffer[OLED_BLOCK_SIZE * update_start + source_map[i]], &temp_buffer[target_map[i]]);
             }
 
 #if OLED_IC_HAS_HORIZONTAL_MODE
             // Send render data chunk after rotating
-            if (!oled_send_data(&temp_buffer[0], OLED_BLOCK_SIZE)) {
+            if (!oled_send_block_data(&temp_buffer[0], OLED_BLOCK_SIZE)) {
                 print("oled_render90 data failed\n");
                 return;
             }
@@ -515,13 +615,13 @@ void oled_render_dirty(bool all) {
                 // Send column & page position for all pages except the first one
                 if (i > 0) {
                     display_start[1]++;
-                    if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
+                    if (!oled_send_block_cmd(display_start, ARRAY_SIZE(display_start))) {
                         print("oled_render offset command failed\n");
                         return;
                     }
                 }
                 // Send data for the page
-                if (!oled_send_data(&temp_buffer[columns_in_block * i], columns_in_block)) {
+                if (!oled_send_block_data(&temp_buffer[columns_in_block * i], columns_in_block)) {
                     print("oled_render90 data failed\n");
                     return;
                 }
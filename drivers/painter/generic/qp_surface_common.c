@@ -49,6 +49,16 @@ void qp_surface_update_dirty(surface_dirty_data_t *dirty, uint16_t x, uint16_t y
     }
 }
 
+void qp_surface_set_dirty(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom) {
+    surface_painter_device_t *surface = (surface_painter_device_t *)device;
+
+    surface->dirty.l        = left;
+    surface->dirty.t        = top;
+    surface->dirty.r        = right;
+    surface->dirty.b        = bottom;
+    surface->dirty.is_dirty = true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Driver vtable
 
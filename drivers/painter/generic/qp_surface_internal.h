@@ -90,6 +90,9 @@ bool qp_surface_viewport(painter_device_t device, uint16_t left, uint16_t top, u
 void qp_surface_increment_pixdata_location(surface_viewport_data_t *viewport);
 void qp_surface_update_dirty(surface_dirty_data_t *dirty, uint16_t x, uint16_t y);
 
+// Replaces the dirty region, so that the next qp_surface_draw() transfers exactly the supplied area
+void qp_surface_set_dirty(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom);
+
 #endif // QUANTUM_PAINTER_SURFACE_ENABLE
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -84,6 +84,36 @@ static bool qp_surface_append_pixels_mono1bpp(painter_device_t device, uint8_t *
     return true;
 }
 
+static bool qp_surface_append_pixel_span_mono1bpp(painter_device_t device, uint8_t *target_buffer, qp_pixel_t *palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t palette_index) {
+    bool     mono_pixel = palette[palette_index].mono;
+    uint32_t pixel_num  = pixel_offset;
+    uint32_t pixel_end  = pixel_offset + pixel_count;
+
+    // Set individual bits up to the first byte boundary, whole bytes in the middle, then the trailing bits
+    while (pixel_num < pixel_end && (pixel_num % 8) != 0) {
+        if (mono_pixel) {
+            target_buffer[pixel_num / 8] |= (1 << (pixel_num % 8));
+        } else {
+            target_buffer[pixel_num / 8] &= ~(1 << (pixel_num % 8));
+        }
+        ++pixel_num;
+    }
+    if (pixel_end - pixel_num >= 8) {
+        uint32_t whole_bytes = (pixel_end - pixel_num) / 8;
+        memset(&target_buffer[pixel_num / 8], mono_pixel ? 0xFF : 0x00, whole_bytes);
+        pixel_num += whole_bytes * 8;
+    }
+    while (pixel_num < pixel_end) {
+        if (mono_pixel) {
+            target_buffer[pixel_num / 8] |= (1 << (pixel_num % 8));
+        } else {
+            target_buffer[pixel_num / 8] &= ~(1 << (pixel_num % 8));
+        }
+        ++pixel_num;
+    }
+    return true;
+}
+
 static bool mono1bpp_target_pixdata_transfer(painter_driver_t *surface_driver, painter_driver_t *target_driver, uint16_t x, uint16_t y, bool entire_surface) {
     return false; // Not yet supported.
 }
@@ -95,15 +125,16 @@ static bool qp_surface_append_pixdata_mono1bpp(painter_device_t device, uint8_t
 const surface_painter_driver_vtable_t mono1bpp_surface_driver_vtable = {
     .base =
         {
-            .init            = qp_surface_init,
-            .power           = qp_surface_power,
-            .clear           = qp_surface_clear,
-            .flush           = qp_surface_flush,
-            .pixdata         = qp_surface_pixdata_mono1bpp,
-            .viewport        = qp_surface_viewport,
-            .palette_convert = qp_surface_palette_convert_mono1bpp,
-            .append_pixels   = qp_surface_append_pixels_mono1bpp,
-            .append_pixdata  = qp_surface_append_pixdata_mono1bpp,
+            .init              = qp_surface_init,
+            .power             = qp_surface_power,
+            .clear             = qp_surface_clear,
+            .flush             = qp_surface_flush,
+            .pixdata           = qp_surface_pixdata_mono1bpp,
+            .viewport          = qp_surface_viewport,
+            .palette_convert   = qp_surface_palette_convert_mono1bpp,
+            .append_pixels     = qp_surface_append_pixels_mono1bpp,
+            .append_pixdata    = qp_surface_append_pixdata_mono1bpp,
+            .append_pixel_span = qp_surface_append_pixel_span_mono1bpp,
         },
     .target_pixdata_transfer = mono1bpp_target_pixdata_transfer,
 };
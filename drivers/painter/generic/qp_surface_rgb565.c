@@ -11,33 +11,55 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Surface driver impl: rgb565
 
-static inline void setpixel_rgb565(surface_painter_device_t *surface, uint16_t x, uint16_t y, uint16_t rgb565) {
+static inline void setpixels_rgb565(surface_painter_device_t *surface, uint16_t x, uint16_t y, const uint16_t *data, uint32_t count) {
     uint16_t w = surface->base.panel_width;
     uint16_t h = surface->base.panel_height;
 
-    // Drop out if it's off-screen
+    // Drop out if it's off-screen, otherwise clip to the right-hand edge
     if (x >= w || y >= h) {
         return;
     }
+    if (count > w - x) {
+        count = w - x;
+    }
 
-    // Skip messing with the dirty info if the original value already matches
-    if (surface->u16buffer[y * w + x] != rgb565) {
-        // Update the dirty region
-        qp_surface_update_dirty(&surface->dirty, x, y);
-
-        // Update the pixel data in the buffer
-        surface->u16buffer[y * w + x] = rgb565;
+    // Skip messing with the dirty info for any leading or trailing pixels which already match
+    uint16_t *dest  = &surface->u16buffer[y * w + x];
+    uint32_t  first = 0;
+    while (first < count && dest[first] == data[first]) {
+        ++first;
     }
-}
+    if (first == count) {
+        return;
+    }
+    uint32_t last = count - 1;
+    while (dest[last] == data[last]) {
+        --last;
+    }
+
+    // Update the dirty region
+    qp_surface_update_dirty(&surface->dirty, x + first, y);
+    qp_surface_update_dirty(&surface->dirty, x + last, y);
 
-static inline void append_pixel_rgb565(surface_painter_device_t *surface, uint16_t rgb565) {
-    setpixel_rgb565(surface, surface->viewport.pixdata_x, surface->viewport.pixdata_y, rgb565);
-    qp_surface_increment_pixdata_location(&surface->viewport);
+    // Update the pixel data in the buffer
+    memcpy(&dest[first], &data[first], (last - first + 1) * sizeof(uint16_t));
 }
 
 static inline void stream_pixdata_rgb565(surface_painter_device_t *surface, const uint16_t *data, uint32_t native_pixel_count) {
-    for (uint32_t pixel_counter = 0; pixel_counter < native_pixel_count; ++pixel_counter) {
-        append_pixel_rgb565(surface, data[pixel_counter]);
+    surface_viewport_data_t *viewport = &surface->viewport;
+    while (native_pixel_count > 0) {
+        // Write as much of the current viewport row as we can in one go
+        uint32_t count = viewport->viewport_r - viewport->pixdata_x + 1;
+        if (count > native_pixel_count) {
+            count = native_pixel_count;
+        }
+        setpixels_rgb565(surface, viewport->pixdata_x, viewport->pixdata_y, data, count);
+        data += count;
+        native_pixel_count -= count;
+
+        // Move the write location, wrapping around the viewport as required
+        viewport->pixdata_x += count - 1;
+        qp_surface_increment_pixdata_location(viewport);
     }
 }
 
@@ -68,6 +90,15 @@ static bool qp_surface_append_pixels_rgb565(painter_device_t device, uint8_t *ta
     return true;
 }
 
+static bool qp_surface_append_pixel_span_rgb565(painter_device_t device, uint8_t *target_buffer, qp_pixel_t *palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t palette_index) {
+    uint16_t *buf    = (uint16_t *)target_buffer + pixel_offset;
+    uint16_t  rgb565 = palette[palette_index].rgb565;
+    for (uint32_t i = 0; i < pixel_count; ++i) {
+        buf[i] = rgb565;
+    }
+    return true;
+}
+
 static bool rgb565_target_pixdata_transfer(painter_driver_t *surface_driver, painter_driver_t *target_driver, uint16_t x, uint16_t y, bool entire_surface) {
     surface_painter_device_t *surface_handle = (surface_painter_device_t *)surface_driver;
 
@@ -127,15 +158,16 @@ static bool qp_surface_append_pixdata_rgb565(painter_device_t device, uint8_t *t
 const surface_painter_driver_vtable_t rgb565_surface_driver_vtable = {
     .base =
         {
-            .init            = qp_surface_init,
-            .power           = qp_surface_power,
-            .clear           = qp_surface_clear,
-            .flush           = qp_surface_flush,
-            .pixdata         = qp_surface_pixdata_rgb565,
-            .viewport        = qp_surface_viewport,
-            .palette_convert = qp_surface_palette_convert_rgb565_swapped,
-            .append_pixels   = qp_surface_append_pixels_rgb565,
-            .append_pixdata  = qp_surface_append_pixdata_rgb565,
+            .init              = qp_surface_init,
+            .power             = qp_surface_power,
+            .clear             = qp_surface_clear,
+            .flush             = qp_surface_flush,
+            .pixdata           = qp_surface_pixdata_rgb565,
+            .viewport          = qp_surface_viewport,
+            .palette_convert   = qp_surface_palette_convert_rgb565_swapped,
+            .append_pixels     = qp_surface_append_pixels_rgb565,
+            .append_pixdata    = qp_surface_append_pixdata_rgb565,
+            .append_pixel_span = qp_surface_append_pixel_span_rgb565,
         },
     .target_pixdata_transfer = rgb565_target_pixdata_transfer,
 };
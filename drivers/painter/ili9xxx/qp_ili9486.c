@@ -184,15 +184,16 @@ static bool qp_ili9486_viewport(painter_device_t device, uint16_t left, uint16_t
 const tft_panel_dc_reset_painter_driver_vtable_t ili9486_driver_vtable = {
     .base =
         {
-            .init            = qp_ili9486_init,
-            .power           = qp_tft_panel_power,
-            .clear           = qp_tft_panel_clear,
-            .flush           = qp_tft_panel_flush,
-            .pixdata         = qp_tft_panel_pixdata,
-            .viewport        = qp_tft_panel_viewport,
-            .palette_convert = qp_tft_panel_palette_convert_rgb565_swapped,
-            .append_pixels   = qp_tft_panel_append_pixels_rgb565,
-            .append_pixdata  = qp_tft_panel_append_pixdata,
+            .init              = qp_ili9486_init,
+            .power             = qp_tft_panel_power,
+            .clear             = qp_tft_panel_clear,
+            .flush             = qp_tft_panel_flush,
+            .pixdata           = qp_tft_panel_pixdata,
+            .viewport          = qp_tft_panel_viewport,
+            .palette_convert   = qp_tft_panel_palette_convert_rgb565_swapped,
+            .append_pixels     = qp_tft_panel_append_pixels_rgb565,
+            .append_pixdata    = qp_tft_panel_append_pixdata,
+            .append_pixel_span = qp_tft_panel_append_pixel_span_rgb565,
         },
     .num_window_bytes   = 2,
     .swap_window_coords = false,
@@ -210,15 +211,16 @@ const tft_panel_dc_reset_painter_driver_vtable_t ili9486_driver_vtable = {
 const tft_panel_dc_reset_painter_driver_vtable_t ili9486_waveshare_driver_vtable = {
     .base =
         {
-            .init            = qp_ili9486_init,
-            .power           = qp_tft_panel_power,
-            .clear           = qp_tft_panel_clear,
-            .flush           = qp_tft_panel_flush,
-            .pixdata         = qp_tft_panel_pixdata,
-            .viewport        = qp_ili9486_viewport,
-            .palette_convert = qp_tft_panel_palette_convert_rgb565_swapped,
-            .append_pixels   = qp_tft_panel_append_pixels_rgb565,
-            .append_pixdata  = qp_tft_panel_append_pixdata,
+            .init              = qp_ili9486_init,
+            .power             = qp_tft_panel_power,
+            .clear             = qp_tft_panel_clear,
+            .flush             = qp_tft_panel_flush,
+            .pixdata           = qp_tft_panel_pixdata,
+            .viewport          = qp_ili9486_viewport,
+            .palette_convert   = qp_tft_panel_palette_convert_rgb565_swapped,
+            .append_pixels     = qp_tft_panel_append_pixels_rgb565,
+            .append_pixdata    = qp_tft_panel_append_pixdata,
+            .append_pixel_span = qp_tft_panel_append_pixel_span_rgb565,
         },
     .num_window_bytes   = 2,
     .swap_window_coords = false,
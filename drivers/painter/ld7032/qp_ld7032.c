@@ -287,15 +287,16 @@ bool qp_ld7032_flush(painter_device_t device) {
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 const painter_driver_vtable_t ld7032_driver_vtable = {
-    .init            = qp_ld7032_init,
-    .power           = qp_ld7032_power,
-    .clear           = qp_ld7032_clear,
-    .flush           = qp_ld7032_flush,
-    .pixdata         = qp_oled_panel_passthru_pixdata,
-    .viewport        = qp_oled_panel_passthru_viewport,
-    .palette_convert = qp_oled_panel_passthru_palette_convert,
-    .append_pixels   = qp_oled_panel_passthru_append_pixels,
-    .append_pixdata  = qp_oled_panel_passthru_append_pixdata,
+    .init              = qp_ld7032_init,
+    .power             = qp_ld7032_power,
+    .clear             = qp_ld7032_clear,
+    .flush             = qp_ld7032_flush,
+    .pixdata           = qp_oled_panel_passthru_pixdata,
+    .viewport          = qp_oled_panel_passthru_viewport,
+    .palette_convert   = qp_oled_panel_passthru_palette_convert,
+    .append_pixels     = qp_oled_panel_passthru_append_pixels,
+    .append_pixdata    = qp_oled_panel_passthru_append_pixdata,
+    .append_pixel_span = qp_oled_panel_passthru_append_pixel_span,
 };
 
 #ifdef QUANTUM_PAINTER_LD7032_SPI_ENABLE
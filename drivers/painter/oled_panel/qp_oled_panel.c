@@ -49,6 +49,11 @@ bool qp_oled_panel_passthru_append_pixels(painter_device_t device, uint8_t *targ
     return driver->surface.base.validate_ok && driver->surface.base.driver_vtable->append_pixels(&driver->surface.base, target_buffer, palette, pixel_offset, pixel_count, palette_indices);
 }
 
+bool qp_oled_panel_passthru_append_pixel_span(painter_device_t device, uint8_t *target_buffer, qp_pixel_t *palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t palette_index) {
+    oled_panel_painter_device_t *driver = (oled_panel_painter_device_t *)device;
+    return driver->surface.base.validate_ok && driver->surface.base.driver_vtable->append_pixel_span(&driver->surface.base, target_buffer, palette, pixel_offset, pixel_count, palette_index);
+}
+
 bool qp_oled_panel_passthru_append_pixdata(painter_device_t device, uint8_t *target_buffer, uint32_t pixdata_offset, uint8_t pixdata_byte) {
     oled_panel_painter_device_t *driver = (oled_panel_painter_device_t *)device;
     return driver->surface.base.validate_ok && driver->surface.base.driver_vtable->append_pixdata(&driver->surface.base, target_buffer, pixdata_offset, pixdata_byte);
@@ -127,6 +127,36 @@ bool qp_tft_panel_append_pixels_rgb888(painter_device_t device, uint8_t *target_
     return true;
 }
 
+bool qp_tft_panel_append_pixel_span_rgb565(painter_device_t device, uint8_t *target_buffer, qp_pixel_t *palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t palette_index) {
+    uint16_t *buf    = (uint16_t *)target_buffer + pixel_offset;
+    uint16_t  rgb565 = palette[palette_index].rgb565;
+    if ((rgb565 >> 8) == (rgb565 & 0xFF)) {
+        memset(buf, rgb565 & 0xFF, pixel_count * sizeof(uint16_t));
+    } else {
+        for (uint32_t i = 0; i < pixel_count; ++i) {
+            buf[i] = rgb565;
+        }
+    }
+    return true;
+}
+
+bool qp_tft_panel_append_pixel_span_rgb888(painter_device_t device, uint8_t *target_buffer, qp_pixel_t *palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t palette_index) {
+    uint8_t *buf = target_buffer + pixel_offset * 3;
+    uint8_t  r   = palette[palette_index].rgb888.r;
+    uint8_t  g   = palette[palette_index].rgb888.g;
+    uint8_t  b   = palette[palette_index].rgb888.b;
+    if (r == g && g == b) {
+        memset(buf, r, pixel_count * 3);
+    } else {
+        for (uint32_t i = 0; i < pixel_count; ++i) {
+            buf[i * 3 + 0] = r;
+            buf[i * 3 + 1] = g;
+            buf[i * 3 + 2] = b;
+        }
+    }
+    return true;
+}
+
 bool qp_tft_panel_append_pixdata(painter_device_t device, uint8_t *target_buffer, uint32_t pixdata_offset, uint8_t pixdata_byte) {
     target_buffer[pixdata_offset] = pixdata_byte;
     return true;
@@ -0,0 +1,69 @@
+"""Decode the deferred log output of a keyboard.
+"""
+import sys
+
+from milc import cli
+
+from qmk.deferred_log import Decoder, ElfStrings
+from qmk.path import normpath
+
+CONSOLE_USAGE_PAGE = 0xFF31
+CONSOLE_USAGE = 0x0074
+
+
+def _find_console(device):
+    import hid
+
+    for info in hid.enumerate():
+        if info['usage_page'] != CONSOLE_USAGE_PAGE or info['usage'] != CONSOLE_USAGE:
+            continue
+        if device and (info['vendor_id'], info['product_id']) != device:
+            continue
+        return info
+    return None
+
+
+def _parse_device(device):
+    vid, _, pid = device.partition(':')
+    return int(vid, 16), int(pid, 16)
+
+
+@cli.argument('-e', '--elf', arg_only=True, type=normpath, required=True, help='The ELF file of the firmware running on the keyboard.')
+@cli.argument('-i', '--input', arg_only=True, type=normpath, help='Decode a raw capture of the console instead of reading from the keyboard.')
+@cli.argument('-d', '--device', arg_only=True, help='The keyboard to read from as VID:PID in hex. Defaults to the first console found.')
+@cli.subcommand('Decodes the console output of a keyboard built with DEFERRED_LOG_ENABLE.', hidden=False if cli.config.user.developer else True)
+def console_decode(cli):
+    """Formats the log records of a keyboard built with `DEFERRED_LOG_ENABLE`, using the format strings from its ELF file.
+    """
+    if not cli.args.elf.exists():
+        cli.log.error('ELF file %s does not exist!', cli.args.elf)
+        return False
+
+    strings = ElfStrings(cli.args.elf)
+    decoder = Decoder(strings.get, strings.int_size, strings.long_size)
+
+    if cli.args.input:
+        with open(cli.args.input, 'rb') as fd:
+            for message in decoder.feed(fd.read()):
+                sys.stdout.write(message)
+        return True
+
+    import hid
+
+    info = _find_console(_parse_device(cli.args.device) if cli.args.device else None)
+    if info is None:
+        cli.log.error('No keyboard console found!')
+        return False
+
+    cli.log.info('Listening to %s %s (%04x:%04x)', info['manufacturer_string'], info['product_string'], info['vendor_id'], info['product_id'])
+    device = hid.Device(path=info['path'])
+    try:
+        while True:
+            for message in decoder.feed(device.read(32)):
+                sys.stdout.write(message)
+                sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        device.close()
+    return True
@@ -56,6 +56,26 @@ def _render_keycodes(module_jsons):
     return lines
 
 
+def _render_process_record_handlers(module_jsons):
+    """Registers each module's process_record hook with process_record_quantum()'s dispatch table.
+    """
+    entries = []
+    for module_json in module_jsons:
+        module_name = Path(module_json['module']).name
+        if module_json.get('process_record', {}).get('all_keycodes', True):
+            entries.append(f'PROCESS_RECORD_ALL_KEYCODES(process_record_{module_name}),')
+        else:
+            entries.append(f'PROCESS_RECORD_HANDLER(process_record_{module_name}, COMMUNITY_MODULE),')
+
+    lines = []
+    lines.append('')
+    lines.append('#define COMMUNITY_MODULES_PROCESS_RECORD_HANDLERS \\')
+    for index, entry in enumerate(entries):
+        suffix = ' \\' if index + 1 < len(entries) else ''
+        lines.append(f'    {entry}{suffix}')
+    return lines
+
+
 def _render_api_declarations(api, module, user_kb=True):
     lines = []
     lines.append('')
@@ -244,6 +264,8 @@ def generate_community_modules_h(cli):
         for api in api_list:
             lines.extend(_render_api_declarations(api, 'modules', user_kb=False))
 
+        lines.extend(_render_process_record_handlers(module_jsons))
+
     dump_lines(cli.args.output, lines, cli.args.quiet, remove_repeated_newlines=True)
 
 
@@ -49,6 +49,28 @@ def _generate_ranges(lines, keycodes):
     lines.append('};')
 
 
+def _generate_segments(lines, keycodes):
+    """Partition the keycode space into non-overlapping segments along range boundaries.
+
+    Gaps between ranges become segments of their own, so every keycode falls into exactly one segment.
+    """
+    boundaries = {0}
+    for key in keycodes["ranges"].keys():
+        lo, mask = map(lambda x: int(x, 16), key.split("/"))
+        boundaries.add(lo)
+        boundaries.add(lo + mask + 1)
+    boundaries = sorted(b for b in boundaries if b <= 0xFFFF)
+
+    lines.append('')
+    lines.append('// Range Segments')
+    lines.append(f'#define QK_KEYCODE_SEGMENT_COUNT {len(boundaries)}')
+    lines.append('#define QK_KEYCODE_SEGMENTS(X) \\')
+    for index, lo in enumerate(boundaries):
+        hi = boundaries[index + 1] - 1 if index + 1 < len(boundaries) else 0xFFFF
+        suffix = ' \\' if index + 1 < len(boundaries) else ''
+        lines.append(f'    X(0x{lo:04X}, 0x{hi:04X}){suffix}')
+
+
 def _generate_defines(lines, keycodes):
     lines.append('')
     lines.append('enum qk_keycode_defines {')
@@ -154,6 +176,7 @@ def generate_keycodes(cli):
 
     _generate_version(keycodes_h_lines, keycodes)
     _generate_ranges(keycodes_h_lines, keycodes)
+    _generate_segments(keycodes_h_lines, keycodes)
     _generate_defines(keycodes_h_lines, keycodes)
     _generate_helpers(keycodes_h_lines, keycodes)
 
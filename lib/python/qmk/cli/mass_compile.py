@@ -13,15 +13,26 @@ from qmk.constants import QMK_FIRMWARE
 from qmk.commands import find_make, get_make_parallel_args, build_environment
 from qmk.search import search_keymap_targets, search_make_targets
 from qmk.build_targets import BuildTarget, JsonKeymapBuildTarget
-from qmk.util import maybe_exit_config
+from qmk.util import maybe_exit_config, parallel_map
 
 
-def mass_compile_targets(targets: List[BuildTarget], clean: bool, dry_run: bool, no_temp: bool, parallel: int, **env):
+def _target_processor(target: BuildTarget) -> str:
+    return target.json.get('processor', '')
+
+
+def mass_compile_targets(targets: List[BuildTarget], clean: bool, dry_run: bool, no_temp: bool, parallel: int, compile_cache: bool = False, **env):
     if len(targets) == 0:
         return
 
     os.environ.setdefault('SKIP_SCHEMA_VALIDATION', '1')
 
+    processors = {}
+    if compile_cache and not dry_run:
+        # Builds for the same MCU share most of their objects, so schedule them next to each other to get cache hits
+        # as early as possible
+        env['USE_COMPILE_CACHE'] = 'yes'
+        processors = dict(zip(targets, parallel_map(_target_processor, targets)))
+
     make_cmd = find_make()
     builddir = Path(QMK_FIRMWARE) / '.build'
     makefile = builddir / 'parallel_kb_builds.mk'
@@ -37,7 +48,7 @@ def mass_compile_targets(targets: List[BuildTarget], clean: bool, dry_run: bool,
 
         builddir.mkdir(parents=True, exist_ok=True)
         with open(makefile, "w") as f:
-            for target in sorted(targets, key=lambda t: (t.keyboard, t.keymap)):
+            for target in sorted(targets, key=lambda t: (processors.get(t, ''), t.keyboard, t.keymap)):
                 keyboard_name = target.keyboard
                 keymap_name = target.keymap
                 keyboard_safe = keyboard_name.replace('/', '_')
@@ -97,6 +108,7 @@ all: {target_filename}{target_suffix}_binary
 @cli.argument('-t', '--no-temp', arg_only=True, action='store_true', help="Remove temporary files during build.")
 @cli.argument('-j', '--parallel', type=int, default=1, help="Set the number of parallel make jobs; 0 means unlimited.")
 @cli.argument('-c', '--clean', arg_only=True, action='store_true', help="Remove object files before compiling.")
+@cli.argument('--compile-cache', arg_only=True, action='store_true', help="Share identical object files between builds, grouping builds by MCU.")
 @cli.argument('-n', '--dry-run', arg_only=True, action='store_true', help="Don't actually build, just show the commands to be run.")
 @cli.argument(
     '-f',
@@ -123,4 +135,4 @@ def mass_compile(cli):
     else:
         targets = search_keymap_targets([('all', cli.config.mass_compile.keymap)], cli.args.filter)
 
-    return mass_compile_targets(targets, cli.args.clean, cli.args.dry_run, cli.args.no_temp, cli.config.mass_compile.parallel, **build_environment(cli.args.env))
+    return mass_compile_targets(targets, cli.args.clean, cli.args.dry_run, cli.args.no_temp, cli.config.mass_compile.parallel, cli.args.compile_cache, **build_environment(cli.args.env))
@@ -1,17 +1,190 @@
+"""QMK C Unit Tests.
+
+Every test binary is built and run in parallel, with each binary optionally split into googletest shards.
+"""
 import fnmatch
+import os
 import re
+import shlex
+from pathlib import Path
 from subprocess import DEVNULL
+from xml.etree import ElementTree
 
 from milc import cli
 
+from qmk.constants import QMK_FIRMWARE
 from qmk.commands import find_make, get_make_parallel_args, build_environment
 
 
+def _full_tests():
+    """Returns the names of the tests with their own directory under tests/, as FULL_TESTS in builddefs/testlist.mk.
+    """
+    return sorted({p.parent.name for p in (Path(QMK_FIRMWARE) / 'tests').rglob('test.mk')})
+
+
+def _test_make_vars(test, full_tests):
+    """Returns the variables the top level Makefile passes to build_test.mk for a given test.
+    """
+    if (Path(QMK_FIRMWARE) / 'tests' / test / 'test.mk').exists():
+        test_path = f'./tests/{test}'
+    else:
+        test_path = test
+
+    return {
+        'TEST': Path(test_path).name,
+        'TEST_OUTPUT': test.replace('/', '_'),
+        'TEST_PATH': test_path,
+        'FULL_TESTS': ' '.join(full_tests),
+    }
+
+
+def _merge_junit(tests, shards, results_dir, build_logs, output):
+    """Combines the googletest XML output of every shard of every test into a single JUnit report.
+    """
+    root = ElementTree.Element('testsuites', name='qmk')
+    totals = {'tests': 0, 'failures': 0, 'errors': 0, 'disabled': 0}
+    time = 0.0
+
+    for test in tests:
+        safe_name = test.replace('/', '_')
+        if build_logs.get(test):
+            suite = ElementTree.SubElement(root, 'testsuite', name=test, tests='1', failures='0', errors='1', disabled='0', time='0')
+            case = ElementTree.SubElement(suite, 'testcase', name='build', classname=test)
+            ElementTree.SubElement(case, 'error', message='Build failed').text = build_logs[test]
+            totals['tests'] += 1
+            totals['errors'] += 1
+            continue
+
+        for shard in range(shards):
+            result = results_dir / f'{safe_name}.{shard}.xml'
+            if not result.exists():
+                continue
+            for suite in ElementTree.parse(result).getroot().iter('testsuite'):
+                suite.set('name', f'{test}.{suite.get("name")}')
+                for case in suite.iter('testcase'):
+                    case.set('classname', f'{test}.{case.get("classname")}')
+                for key in totals:
+                    totals[key] += int(suite.get(key, 0))
+                time += float(suite.get('time', 0))
+                root.append(suite)
+
+    for key, value in totals.items():
+        root.set(key, str(value))
+    root.set('time', f'{time:.3f}')
+
+    output.parent.mkdir(parents=True, exist_ok=True)
+    ElementTree.ElementTree(root).write(output, encoding='utf-8', xml_declaration=True)
+
+
+def run_tests(tests, shards, parallel, junit_xml=None, **env):
+    """Builds and runs the supplied tests through a generated makefile, so that the make jobserver schedules both.
+
+    The googletest objects are built once up front and shared between all tests. Each test binary is then linked as
+    soon as it has been compiled, and its shards are started as soon as it has been linked.
+    """
+    make_cmd = find_make()
+    builddir = Path(QMK_FIRMWARE) / '.build'
+    results_dir = builddir / 'test' / 'results'
+    makefile = builddir / 'parallel_tests.mk'
+    log_prefix = f'test.log.{os.getpid()}'
+    failed_prefix = f'failed.test.log.{os.getpid()}'
+
+    results_dir.mkdir(parents=True, exist_ok=True)
+    for stale in results_dir.glob('*.xml'):
+        stale.unlink()
+
+    full_tests = _full_tests()
+    safe_names = {test.replace('/', '_'): test for test in tests}
+    build_cmd = f'+@$(MAKE) -r -R -C "{QMK_FIRMWARE}" -f builddefs/build_test.mk SILENT=true'
+    extra_vars = ' '.join(shlex.quote(f'{k}={v}') for k, v in env.items())
+
+    with open(makefile, 'w') as f:
+        # yapf: disable
+        f.write(
+            f"""\
+.PHONY: all gtest
+all:
+gtest:
+	{build_cmd} {extra_vars} gtest
+
+"""# noqa
+        )
+        # yapf: enable
+
+        for test in tests:
+            make_vars = _test_make_vars(test, full_tests)
+            safe_name = make_vars['TEST_OUTPUT']
+            elf = f'{builddir}/test/{safe_name}.elf'
+            build_log = f'{builddir}/{log_prefix}.{safe_name}.build'
+            failed_build_log = f'{builddir}/{failed_prefix}.{safe_name}.build'
+            make_args = ' '.join(shlex.quote(f'{k}={v}') for k, v in make_vars.items())
+
+            # yapf: disable
+            f.write(
+                f"""\
+.PHONY: {safe_name}_build
+{safe_name}_build: gtest
+	@rm -f "{build_log}" || true
+	{build_cmd} {make_args} {extra_vars} elf >>"{build_log}" 2>&1 \\
+		|| {{ cp "{build_log}" "{failed_build_log}"; rm -f "{elf}"; }}
+	@{{ test -f "{failed_build_log}" && printf "Build %-64s \\e[1;31m[ERRORS]\\e[0m\\n" "{test}" ; }} \\
+		|| printf "Build %-64s \\e[1;32m[OK]\\e[0m\\n" "{test}"
+	@rm -f "{build_log}" || true
+
+"""# noqa
+            )
+            # yapf: enable
+
+            for shard in range(shards):
+                shard_name = f'{test} [{shard + 1}/{shards}]' if shards > 1 else test
+                run_log = f'{builddir}/{log_prefix}.{safe_name}.{shard}'
+                failed_run_log = f'{builddir}/{failed_prefix}.{safe_name}.{shard}'
+
+                # yapf: disable
+                f.write(
+                    f"""\
+.PHONY: {safe_name}_{shard}
+all: {safe_name}_{shard}
+{safe_name}_{shard}: {safe_name}_build
+	@test -f "{elf}" || exit 0; \\
+	GTEST_TOTAL_SHARDS={shards} GTEST_SHARD_INDEX={shard} "{elf}" --gtest_output=xml:"{results_dir}/{safe_name}.{shard}.xml" >"{run_log}" 2>&1 \\
+		|| cp "{run_log}" "{failed_run_log}"; \\
+	{{ test -f "{failed_run_log}" && printf "Test  %-64s \\e[1;31m[FAILED]\\e[0m\\n" "{shard_name}" ; }} \\
+		|| printf "Test  %-64s \\e[1;32m[OK]\\e[0m\\n" "{shard_name}"
+	@rm -f "{run_log}" || true
+
+"""# noqa
+                )
+                # yapf: enable
+
+    result = cli.run([make_cmd, *get_make_parallel_args(parallel), '-f', makefile.as_posix(), 'all'], capture_output=False, stdin=DEVNULL)
+
+    build_logs = {}
+    failures = sorted(builddir.glob(f'{failed_prefix}.*'))
+    for failure in failures:
+        safe_name, kind = failure.name[len(failed_prefix) + 1:].rsplit('.', 1)
+        test = safe_names[safe_name]
+        log = failure.read_text(errors='replace')
+        cli.log.error(f'{{fg_red}}{test}{{fg_reset}} failed to {"build" if kind == "build" else "pass"}:')
+        print(log)
+        if kind == 'build':
+            build_logs[test] = log
+        failure.unlink()
+
+    if junit_xml:
+        _merge_junit(tests, shards, results_dir, build_logs, junit_xml)
+        cli.log.info(f'Wrote test results to {{fg_cyan}}{junit_xml}')
+
+    return result.returncode == 0 and len(failures) == 0
+
+
 @cli.argument('-j', '--parallel', type=int, default=1, help="Set the number of parallel make jobs; 0 means unlimited.")
 @cli.argument('-e', '--env', arg_only=True, action='append', default=[], help="Set a variable to be passed to make. May be passed multiple times.")
 @cli.argument('-c', '--clean', arg_only=True, action='store_true', help="Remove object files before compiling.")
 @cli.argument('-l', '--list', arg_only=True, action='store_true', help='List available tests.')
 @cli.argument('-t', '--test', arg_only=True, action='append', default=[], help="Test to run from the available list. Supports wildcard globs. May be passed multiple times.")
+@cli.argument('-s', '--shards', type=int, default=1, help="Split each test binary into this many googletest shards, run concurrently.")
+@cli.argument('-x', '--junit-xml', arg_only=True, type=Path, help="Write the combined results of all tests to this JUnit XML file.")
 @cli.subcommand("QMK C Unit Tests.", hidden=False if cli.config.user.developer else True)
 def test_c(cli):
     """Run native unit tests.
@@ -31,17 +204,11 @@ def test_c(cli):
     for invalid in filtered_tests - set(available_tests):
         cli.log.warning(f'Invalid test provided: {invalid}')
 
-    # convert test names to build targets
-    targets = list(map(lambda x: f'test:{x}', filtered_tests or ['all']))
-
     if cli.args.clean:
-        targets.insert(0, 'clean')
-
-    # Add in the environment vars
-    for key, value in build_environment(cli.args.env).items():
-        targets.append(f'{key}={value}')
+        cli.run([find_make(), 'clean'], capture_output=False, stdin=DEVNULL)
 
-    command = [find_make(), *get_make_parallel_args(cli.config.test_c.parallel), *targets]
+    tests = sorted(filtered_tests) or available_tests
+    shards = max(1, cli.config.test_c.shards)
 
-    cli.log.info('Compiling tests with {fg_cyan}%s', ' '.join(command))
-    return cli.run(command, capture_output=False, stdin=DEVNULL).returncode
+    cli.log.info(f'Running {{fg_cyan}}{len(tests)}{{fg_reset}} tests with {{fg_cyan}}{shards}{{fg_reset}} shards each')
+    return run_tests(tests, shards, cli.config.test_c.parallel, cli.args.junit_xml, **build_environment(cli.args.env))
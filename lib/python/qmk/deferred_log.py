@@ -0,0 +1,230 @@
+"""Decoding of deferred log output.
+
+With `DEFERRED_LOG_ENABLE` the keyboard sends COBS encoded records of a format string address and the raw arguments,
+see quantum/logging/deferred_log.h. The format strings are looked up in the firmware ELF and formatted here.
+"""
+import re
+import struct
+
+ELF_MACHINE_AVR = 83
+SHF_ALLOC = 0x2
+SHT_NOBITS = 8
+
+# %[flags][width][.precision][length]conversion
+FORMAT_SPEC = re.compile(r'%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?(hh|h|ll|l|z|j|t)?([diuxXobcspfFeEgG%])')
+
+
+class ElfStrings:
+    """Reads NUL terminated strings out of the loaded sections of an ELF file by their address.
+    """
+    def __init__(self, path):
+        with open(path, 'rb') as fd:
+            self.data = fd.read()
+
+        if self.data[:4] != b'\x7fELF':
+            raise ValueError(f'{path} is not an ELF file')
+
+        elf_class = self.data[4]
+        endian = '<' if self.data[5] == 1 else '>'
+        machine, = struct.unpack_from(endian + 'H', self.data, 18)
+
+        if elf_class == 2:
+            shoff, = struct.unpack_from(endian + 'Q', self.data, 40)
+            shentsize, shnum = struct.unpack_from(endian + 'HH', self.data, 58)
+            section = endian + 'IIQQQQ'
+        else:
+            shoff, = struct.unpack_from(endian + 'I', self.data, 32)
+            shentsize, shnum = struct.unpack_from(endian + 'HH', self.data, 46)
+            section = endian + 'IIIIII'
+
+        self.sections = []
+        for i in range(shnum):
+            _, sh_type, flags, addr, offset, size = struct.unpack_from(section, self.data, shoff + i * shentsize)
+            if flags & SHF_ALLOC and sh_type != SHT_NOBITS and size:
+                self.sections.append((addr, offset, size))
+
+        # Sizes of int and long on the keyboard, for how the arguments are masked and sign extended
+        if machine == ELF_MACHINE_AVR:
+            self.int_size, self.long_size = 2, 4
+        else:
+            self.int_size, self.long_size = 4, 8 if elf_class == 2 else 4
+
+    def get(self, address):
+        for addr, offset, size in self.sections:
+            if addr <= address < addr + size:
+                start = offset + address - addr
+                end = self.data.find(b'\0', start, offset + size)
+                if end < 0:
+                    return None
+                return self.data[start:end].decode('utf-8', errors='replace')
+        return None
+
+
+def cobs_decode(data):
+    """Decodes a COBS encoded record, without its delimiter. Returns None if it is malformed.
+    """
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            return None
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+class _Reader:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def varint(self):
+        value = 0
+        shift = 0
+        while True:
+            if self.pos >= len(self.data):
+                raise IndexError
+            byte = self.data[self.pos]
+            self.pos += 1
+            value |= (byte & 0x7F) << shift
+            shift += 7
+            if not byte & 0x80:
+                return value
+
+    def signed(self):
+        value = self.varint()
+        return (value >> 1) ^ -(value & 1)
+
+    def float(self):
+        if self.pos + 4 > len(self.data):
+            raise IndexError
+        value, = struct.unpack_from('<f', self.data, self.pos)
+        self.pos += 4
+        return value
+
+    def string(self):
+        if self.pos >= len(self.data):
+            raise IndexError
+        length = self.data[self.pos] & 0x7F
+        truncated = self.data[self.pos] & 0x80
+        value = self.data[self.pos + 1:self.pos + 1 + length]
+        if len(value) != length:
+            raise IndexError
+        self.pos += 1 + length
+        return value.decode('utf-8', errors='replace') + ('...' if truncated else '')
+
+
+def format_record(fmt, args, int_size=4, long_size=4):
+    """Formats a record the way printf() on the keyboard would have.
+
+    Args:
+        fmt
+            The format string
+
+        args
+            A `_Reader` positioned on the first argument of the record
+
+        int_size, long_size
+            Sizes of int and long on the keyboard
+    """
+    def convert(match):
+        flags, width, precision, length, conversion = match.groups()
+        if conversion == '%':
+            return '%'
+
+        try:
+            # Widths and precisions given as arguments are passed along with the others
+            if width == '*':
+                width = str(args.signed())
+            if precision == '*':
+                precision = str(args.signed())
+            spec = '%' + flags + (width or '') + ('.' + precision if precision is not None else '')
+
+            if conversion == 's':
+                return (spec + 's') % args.string()
+            if conversion in 'fFeEgG':
+                return (spec + conversion) % args.float()
+
+            value = args.signed()
+            size = {'hh': 1, 'h': 2, 'l': long_size, 'll': 8, 'z': int_size, 'j': 8, 't': int_size}.get(length, int_size)
+            mask = (1 << (size * 8)) - 1
+            value &= mask
+
+            if conversion in 'di':
+                if value & (1 << (size * 8 - 1)):
+                    value -= 1 << (size * 8)
+                return (spec + 'd') % value
+            if conversion == 'u':
+                return (spec + 'd') % value
+            if conversion == 'c':
+                return (spec + 'c') % chr(value & 0xFF)
+            if conversion == 'p':
+                return (spec + 'x') % value
+            if conversion == 'b':
+                return format_binary(value, flags, width)
+            return (spec + conversion) % value
+
+        except IndexError:
+            return '<?>'
+
+    return FORMAT_SPEC.sub(convert, fmt)
+
+
+def format_binary(value, flags, width):
+    fill = '0' if '0' in flags and '-' not in flags else ' '
+    digits = format(value, 'b')
+    width = int(width or 0)
+    if '-' in flags:
+        return digits.ljust(width)
+    return digits.rjust(width, fill)
+
+
+class Decoder:
+    """Turns the byte stream of the console back into log messages.
+
+    Args:
+        strings
+            Looks up a format string by its address, returning None for unknown addresses
+    """
+    def __init__(self, strings, int_size=4, long_size=4):
+        self.strings = strings
+        self.int_size = int_size
+        self.long_size = long_size
+        self.pending = bytearray()
+
+    def feed(self, data):
+        """Decodes what has been received so far, returning the complete messages.
+        """
+        messages = []
+        self.pending += data
+        while True:
+            end = self.pending.find(0)
+            if end < 0:
+                break
+            frame = bytes(self.pending[:end])
+            del self.pending[:end + 1]
+            if frame:
+                messages.append(self.decode(frame))
+        return messages
+
+    def decode(self, frame):
+        record = cobs_decode(frame)
+        if record is None:
+            return frame.decode('utf-8', errors='replace')
+
+        reader = _Reader(record)
+        try:
+            address = reader.varint()
+            if address == 0:
+                return f'<{reader.varint()} log messages dropped>\n'
+        except IndexError:
+            return frame.decode('utf-8', errors='replace')
+
+        fmt = self.strings(address)
+        if fmt is None:
+            # Not a record after all, most likely plain text from a direct sendchar()
+            return frame.decode('utf-8', errors='replace')
+        return format_record(fmt, reader, self.int_size, self.long_size)
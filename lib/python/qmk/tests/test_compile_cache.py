@@ -0,0 +1,94 @@
+import importlib.util
+import os
+import sys
+import tempfile
+from pathlib import Path
+
+# The cache is a standalone script run by make, rather than part of the qmk package
+_spec = importlib.util.spec_from_file_location('compile_cache', Path(__file__).resolve().parents[4] / 'util' / 'compile_cache.py')
+compile_cache = importlib.util.module_from_spec(_spec)
+_spec.loader.exec_module(compile_cache)
+
+# Preprocesses by echoing the source, and compiles by writing the flags and source to the object, logging each
+# compilation so that hits can be told apart from misses
+FAKE_COMPILER = '''#!{python}
+import sys
+args = sys.argv[1:]
+source = open(next(arg for arg in args if arg.endswith('.c'))).read()
+if '-E' in args:
+    sys.stdout.write(source)
+else:
+    with open(args[args.index('-o') + 1], 'w') as f:
+        f.write(' '.join(args) + source)
+    with open(__file__ + '.log', 'a') as f:
+        f.write('compiled\\n')
+'''
+
+
+class _Build:
+    def __init__(self, root):
+        self.root = Path(root)
+        self.cache_dir = self.root / 'cache'
+        self.source = self.root / 'source.c'
+        self.source.write_text('int main(void) { return 0; }\n')
+
+    def compiler(self, name):
+        path = self.root / name
+        if not path.exists():
+            path.write_text(FAKE_COMPILER.format(python=sys.executable))
+            path.chmod(0o755)
+        return path
+
+    def compile(self, compiler, *flags):
+        output = self.root / 'source.o'
+        argv = ['--cache-dir', str(self.cache_dir), str(self.compiler(compiler)), *flags, '-c', str(self.source), '-o', str(output)]
+        assert compile_cache.main(argv) == 0
+        return output.read_text()
+
+    def compilations(self, compiler):
+        log = Path(str(self.compiler(compiler)) + '.log')
+        return len(log.read_text().splitlines()) if log.exists() else 0
+
+
+def test_compile_cache_hit():
+    with tempfile.TemporaryDirectory() as root:
+        build = _Build(root)
+        first = build.compile('gcc', '-Os', '-Iinclude')
+        # Include paths only matter through the preprocessed source
+        second = build.compile('gcc', '-Os', '-Iother')
+        assert second == first
+        assert build.compilations('gcc') == 1
+
+
+def test_compile_cache_miss_on_flag_change():
+    with tempfile.TemporaryDirectory() as root:
+        build = _Build(root)
+        build.compile('gcc', '-Os')
+        assert '-O2' in build.compile('gcc', '-O2')
+        assert build.compilations('gcc') == 2
+
+
+def test_compile_cache_miss_on_compiler_change():
+    with tempfile.TemporaryDirectory() as root:
+        build = _Build(root)
+        build.compile('gcc', '-Os')
+        build.compile('other-gcc', '-Os')
+        assert build.compilations('gcc') == 1
+        assert build.compilations('other-gcc') == 1
+
+
+def test_compile_cache_prune_removes_least_recently_used():
+    with tempfile.TemporaryDirectory() as root:
+        cache_dir = Path(root)
+        for age, name in enumerate(['newest', 'middle', 'oldest']):
+            entry = cache_dir / name[:2] / name
+            entry.parent.mkdir(exist_ok=True)
+            entry.with_suffix('.o').write_bytes(b'x' * 100)
+            entry.with_suffix('.stderr').write_bytes(b'')
+            mtime = 1000000 - age * 100
+            os.utime(entry.with_suffix('.o'), (mtime, mtime))
+
+        compile_cache.prune(cache_dir, 250)
+
+        assert sorted(path.stem for path in cache_dir.glob('*/*.o')) == ['middle', 'newest']
+        assert not (cache_dir / 'ol' / 'oldest.stderr').exists()
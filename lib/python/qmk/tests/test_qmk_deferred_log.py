@@ -0,0 +1,80 @@
+from qmk.deferred_log import Decoder, cobs_decode
+
+STRINGS = {
+    0x1000: 'hello\n',
+    0x2000: '%d %u %02X %s\n',
+    0x3000: '%08b %ld\n',
+}
+
+
+def _varint(value):
+    out = bytearray()
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+        if value:
+            out.append(byte | 0x80)
+        else:
+            out.append(byte)
+            return bytes(out)
+
+
+def _zigzag(value):
+    return _varint((value << 1) ^ (value >> 63))
+
+
+def _cobs_encode(data):
+    out = bytearray([0])
+    code_index = 0
+    for byte in data:
+        if byte == 0:
+            out[code_index] = len(out) - code_index
+            code_index = len(out)
+            out.append(0)
+        else:
+            out.append(byte)
+    out[code_index] = len(out) - code_index
+    return bytes(out) + b'\0'
+
+
+def _decoder(int_size=4):
+    return Decoder(STRINGS.get, int_size, 4)
+
+
+def test_cobs_round_trip():
+    data = b'\x00\x01\x00\x00\x02'
+    assert cobs_decode(_cobs_encode(data)[:-1]) == data
+
+
+def test_decode_no_args():
+    assert _decoder().feed(_cobs_encode(_varint(0x1000))) == ['hello\n']
+
+
+def test_decode_integers_and_string():
+    record = _varint(0x2000) + _zigzag(-5) + _zigzag(-1) + _zigzag(0x0A) + b'\x03abc'
+    assert _decoder().feed(_cobs_encode(record)) == ['-5 4294967295 0A abc\n']
+
+
+def test_decode_int_size():
+    record = _varint(0x2000) + _zigzag(-1) + _zigzag(-1) + _zigzag(0) + b'\x00'
+    assert _decoder(int_size=2).feed(_cobs_encode(record)) == ['-1 65535 00 \n']
+
+
+def test_decode_binary_and_missing_args():
+    record = _varint(0x3000) + _zigzag(5)
+    assert _decoder().feed(_cobs_encode(record)) == ['00000101 <?>\n']
+
+
+def test_decode_split_across_reads_with_padding():
+    stream = _cobs_encode(_varint(0x1000)) + b'\0' * 8 + _cobs_encode(_varint(0x1000))
+    decoder = _decoder()
+    assert decoder.feed(stream[:2]) == []
+    assert decoder.feed(stream[2:]) == ['hello\n', 'hello\n']
+
+
+def test_decode_dropped():
+    assert _decoder().feed(_cobs_encode(b'\x00' + _varint(7))) == ['<7 log messages dropped>\n']
+
+
+def test_decode_plain_text():
+    assert _decoder().feed(b'plain\n\0') == ['plain\n']
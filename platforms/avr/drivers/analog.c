@@ -26,6 +26,13 @@ int16_t analogReadPin(pin_t pin) {
     return adc_read(pinToMux(pin));
 }
 
+bool analogReadPins(const pin_t pins[], uint8_t count, int16_t samples[]) {
+    for (uint8_t i = 0; i < count; i++) {
+        samples[i] = analogReadPin(pins[i]);
+    }
+    return true;
+}
+
 uint8_t pinToMux(pin_t pin) {
     switch (pin) {
         // clang-format off
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "gpio.h"
 
 #ifdef __cplusplus
@@ -25,6 +26,7 @@ extern "C" {
 void analogReference(uint8_t mode);
 
 int16_t analogReadPin(pin_t pin);
+bool    analogReadPins(const pin_t pins[], uint8_t count, int16_t samples[]);
 uint8_t pinToMux(pin_t pin);
 
 int16_t adc_read(uint8_t mux);
@@ -15,6 +15,7 @@
  */
 
 #include "analog.h"
+#include <string.h>
 #include <ch.h>
 #include <hal.h>
 
@@ -108,6 +109,24 @@
 #    define ADC_BUFFER_DEPTH 1
 #endif
 
+// Most pins read together by analogReadPins()
+#ifndef ADC_SWEEP_MAX_CHANNELS
+#    define ADC_SWEEP_MAX_CHANNELS 8
+#endif
+
+// How a sweep selects its channels, others fall back to converting one pin at a time
+#if defined(USE_ADCV1) || defined(RP2040)
+#    define ADC_SWEEP_CHANNEL_MASK // converted in ascending channel order
+#elif defined(STM32F1XX) || defined(STM32F2XX) || defined(STM32F4XX)
+#    define ADC_SWEEP_SQR_FIELDS // sqr1...sqr3, five bits per conversion
+#elif !defined(USE_ADCV2)
+#    define ADC_SWEEP_SQR_ARRAY // sqr[0]...sqr[3], six bits per conversion
+#endif
+
+#if (defined(ADC_SWEEP_SQR_FIELDS) || defined(ADC_SWEEP_SQR_ARRAY)) && (ADC_DUMMY_CONVERSIONS_AT_START + ADC_SWEEP_MAX_CHANNELS) > 16
+#    error "ADC_SWEEP_MAX_CHANNELS exceeds the length of the ADC regular sequence."
+#endif
+
 // For more sampling rate options, look at hal_adc_lld.h in ChibiOS
 #if !defined(ADC_SAMPLING_RATE) && !defined(RP2040)
 #    if defined(ADC_SMPR_SMP_1P5)
@@ -448,3 +467,104 @@ int16_t adc_read(adc_mux mux) {
     return sampleBuffer[ADC_DUMMY_CONVERSIONS_AT_START];
 #endif
 }
+
+#if defined(ADC_SWEEP_CHANNEL_MASK) || defined(ADC_SWEEP_SQR_FIELDS) || defined(ADC_SWEEP_SQR_ARRAY)
+static ADCConversionGroup adcSweepGroup;
+static adcsample_t        sweepBuffer[ADC_DUMMY_CONVERSIONS_AT_START + ADC_SWEEP_MAX_CHANNELS];
+
+#    if !defined(ADC_SWEEP_CHANNEL_MASK)
+static void sweepSetConversion(uint8_t index, uint16_t input) {
+#        if defined(ADC_SWEEP_SQR_FIELDS)
+    if (index < 6) {
+        adcSweepGroup.sqr3 |= (uint32_t)input << (5 * index);
+    } else if (index < 12) {
+        adcSweepGroup.sqr2 |= (uint32_t)input << (5 * (index - 6));
+    } else {
+        adcSweepGroup.sqr1 |= (uint32_t)input << (5 * (index - 12));
+    }
+#        else
+    // The first field of sqr[0] holds the sequence length
+    adcSweepGroup.sqr[(index + 1) / 5] |= (uint32_t)input << (6 * ((index + 1) % 5));
+#        endif
+}
+#    endif
+
+/* Converts all pins in one DMA transfer, rather than one conversion for each. The pins must be on the same ADC. */
+bool analogReadPins(const pin_t pins[], uint8_t count, int16_t samples[]) {
+    adc_mux muxes[ADC_SWEEP_MAX_CHANNELS];
+
+    if (count == 0 || count > ADC_SWEEP_MAX_CHANNELS) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        palSetLineMode(pins[i], PAL_MODE_INPUT_ANALOG);
+        muxes[i] = pinToMux(pins[i]);
+        if (muxes[i].adc != muxes[0].adc) {
+            return false;
+        }
+    }
+
+    ADCDriver* targetDriver = intToADCDriver(muxes[0].adc);
+    if (!targetDriver) {
+        return false;
+    }
+
+    adcSweepGroup = adcConversionGroup;
+#    if defined(ADC_SWEEP_CHANNEL_MASK)
+    uint32_t mask = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        mask |= 1UL << muxes[i].input;
+    }
+#        if defined(RP2040)
+    adcSweepGroup.channel_mask = mask;
+#        else
+    adcSweepGroup.chselr = mask;
+#        endif
+    adcSweepGroup.num_channels = __builtin_popcountl(mask);
+#    else
+#        if defined(ADC_SWEEP_SQR_FIELDS)
+    adcSweepGroup.sqr1 = 0;
+    adcSweepGroup.sqr2 = 0;
+    adcSweepGroup.sqr3 = 0;
+#        else
+    memset(adcSweepGroup.sqr, 0, sizeof(adcSweepGroup.sqr));
+#        endif
+    // Dummy conversions repeat the first pin
+    for (uint8_t i = 0; i < ADC_DUMMY_CONVERSIONS_AT_START; i++) {
+        sweepSetConversion(i, muxes[0].input);
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        sweepSetConversion(ADC_DUMMY_CONVERSIONS_AT_START + i, muxes[i].input);
+    }
+    adcSweepGroup.num_channels = ADC_DUMMY_CONVERSIONS_AT_START + count;
+#    endif
+
+    manageAdcInitializationDriver(muxes[0].adc, targetDriver);
+    if (adcConvert(targetDriver, &adcSweepGroup, &sweepBuffer[0], 1) != MSG_OK) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+#    if defined(ADC_SWEEP_CHANNEL_MASK)
+        // Position of the channel among the ones that were converted
+        uint8_t index = __builtin_popcountl(mask & ((1UL << muxes[i].input) - 1));
+#    else
+        uint8_t index = ADC_DUMMY_CONVERSIONS_AT_START + i;
+#    endif
+#    if defined(USE_ADCV2) || defined(RP2040)
+        samples[i] = sweepBuffer[index] >> (12 - ADC_RESOLUTION);
+#    else
+        samples[i] = sweepBuffer[index];
+#    endif
+    }
+    return true;
+}
+#else
+bool analogReadPins(const pin_t pins[], uint8_t count, int16_t samples[]) {
+    for (uint8_t i = 0; i < count; i++) {
+        samples[i] = analogReadPin(pins[i]);
+    }
+    return true;
+}
+#endif
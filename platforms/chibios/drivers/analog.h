@@ -17,6 +17,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "gpio.h"
 
 #ifdef __cplusplus
@@ -34,6 +35,7 @@ typedef struct {
 
 int16_t analogReadPin(pin_t pin);
 int16_t analogReadPinAdc(pin_t pin, uint8_t adc);
+bool    analogReadPins(const pin_t pins[], uint8_t count, int16_t samples[]);
 adc_mux pinToMux(pin_t pin);
 
 int16_t adc_read(adc_mux mux);
@@ -16,8 +16,8 @@
  */
 
 #include "audio.h"
+#include "audio_dds.h"
 #include "gpio.h"
-#include <math.h>
 #include "util.h"
 
 // Need to disable GCC's "tautological-compare" warning for this file, as it causes issues when running `KEEP_INTERMEDIATES=yes`. Corresponding pop at the end of the file.
@@ -88,10 +88,33 @@ static const dacsample_t dac_buffer_trapezoid[] = {
 };
 #endif // AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID
 
+#if defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE)
+#    define DAC_WAVETABLE dac_buffer_sine
+#    define DAC_WAVETABLE_BITS 8
+#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE)
+#    define DAC_WAVETABLE dac_buffer_triangle
+#    define DAC_WAVETABLE_BITS 8
+#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
+#    define DAC_WAVETABLE dac_buffer_trapezoid
+#    define DAC_WAVETABLE_BITS 8
+#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE)
+#    define DAC_WAVETABLE dac_buffer_square
+#    define DAC_WAVETABLE_BITS 1
+#endif
+_Static_assert(ARRAY_SIZE(DAC_WAVETABLE) == (1 << DAC_WAVETABLE_BITS), "DAC wavetable length must match DAC_WAVETABLE_BITS");
+
+/* Note: the oscillators run at 3/2 of AUDIO_DAC_SAMPLE_RATE to get the correct
+ *       frequencies on the DAC output (as measured with an oscilloscope), since
+ *       the gpt timer runs with 3*AUDIO_DAC_SAMPLE_RATE; and the DAC callback
+ *       is called twice per conversion.
+ */
+#define DAC_OSCILLATOR_RATE (AUDIO_DAC_SAMPLE_RATE * 3U / 2U)
+
 static dacsample_t dac_buffer[AUDIO_DAC_BUFFER_SIZE];
 
-/* keep track of the sample position for for each frequency */
-static float dac_if[AUDIO_MAX_SIMULTANEOUS_TONES] = {0.0};
+/* one fixed-point oscillator per frequency, keeping track of its position in the wavetable */
+static audio_dds_oscillator_t dac_oscillators[AUDIO_MAX_SIMULTANEOUS_TONES];
+static audio_dds_bank_t       dac_oscillator_bank;
 
 static float   active_tones_snapshot[AUDIO_MAX_SIMULTANEOUS_TONES] = {0};
 static uint8_t active_tones_snapshot_length                        = 0;
@@ -123,64 +146,12 @@ __attribute__((weak)) uint16_t dac_value_generate(void) {
     }
 
     /* doing additive wave synthesis over all currently playing tones = adding up
-     * sine-wave-samples for each frequency, scaled by the number of active tones
-     */
-    uint_fast16_t value     = 0;
-    float         frequency = 0.0f;
-
-#if defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE)
-    const size_t wavetable_length = ARRAY_SIZE(dac_buffer_sine);
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE)
-    const size_t wavetable_length = ARRAY_SIZE(dac_buffer_triangle);
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
-    const size_t wavetable_length = ARRAY_SIZE(dac_buffer_trapezoid);
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE)
-    const size_t wavetable_length = ARRAY_SIZE(dac_buffer_square);
-#endif
-
-    for (size_t i = 0; i < active_tones_snapshot_length; i++) {
-        /* Note: a user implementation does not have to rely on the active_tones_snapshot, but
-         * could directly query the active frequencies through audio_get_processed_frequency */
-        frequency = active_tones_snapshot[i];
-
-        float new_dac_if = dac_if[i];
-        new_dac_if += frequency * ((float)wavetable_length / AUDIO_DAC_SAMPLE_RATE * 2.0f / 3.0f);
-        /*Note: the 2/3 are necessary to get the correct frequencies on the
-         *      DAC output (as measured with an oscilloscope), since the gpt
-         *      timer runs with 3*AUDIO_DAC_SAMPLE_RATE; and the DAC callback
-         *      is called twice per conversion.*/
-
-        while (new_dac_if >= wavetable_length)
-            new_dac_if -= wavetable_length;
-        dac_if[i] = new_dac_if;
-
-        // Wavetable generation/lookup
-        size_t dac_i = (size_t)new_dac_if;
-
-#if defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE)
-        value += dac_buffer_sine[dac_i] / active_tones_snapshot_length;
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE)
-        value += dac_buffer_triangle[dac_i] / active_tones_snapshot_length;
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
-        value += dac_buffer_trapezoid[dac_i] / active_tones_snapshot_length;
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE)
-        value += dac_buffer_square[dac_i] / active_tones_snapshot_length;
-#endif
-        /*
-        // SINE
-        value += dac_buffer_sine[dac_i] / active_tones_snapshot_length / 3;
-        // TRIANGLE
-        value += dac_buffer_triangle[dac_i] / active_tones_snapshot_length / 3;
-        // SQUARE
-        value += dac_buffer_square[dac_i] / active_tones_snapshot_length / 3;
-        //NOTE: combination of these three wave-forms is more exemplary - and doesn't sound particularly good :-P
-        */
-
-        // STAIRS (mostly usefully as test-pattern)
-        // value_avg = dac_buffer_staircase[dac_i] / active_tones_snapshot_length;
-    }
-
-    return value;
+     * wavetable samples for each frequency, scaled by the number of active tones;
+     * the phase increments are only recalculated when the active tones change
+     *
+     * Note: a user implementation does not have to rely on the active_tones_snapshot, but
+     * could directly query the active frequencies through audio_get_processed_frequency */
+    return audio_dds_next_sample(&dac_oscillator_bank);
 }
 
 /**
@@ -247,6 +218,8 @@ static void dac_end(DACDriver *dacp) {
                 }
             }
 
+            audio_dds_set_tones(&dac_oscillator_bank, active_tones_snapshot, active_tones_snapshot_length, DAC_OSCILLATOR_RATE);
+
             if ((0 == active_tones_snapshot_length) && (OUTPUT_REACHED_ZERO_BEFORE_OFF == state)) {
                 state = OUTPUT_OFF;
             }
@@ -304,6 +277,8 @@ static const DACConfig dac_conf = {.init = AUDIO_DAC_OFF_VALUE, .datamode = DAC_
 static const DACConversionGroup dac_conv_cfg = {.num_channels = 1U, .end_cb = dac_end, .error_cb = dac_error, .trigger = DAC_TRG(0b000)};
 
 void audio_driver_initialize_impl(void) {
+    audio_dds_init(&dac_oscillator_bank, dac_oscillators, DAC_WAVETABLE, DAC_WAVETABLE_BITS);
+
     if ((AUDIO_PIN == A4) || (AUDIO_PIN_ALT == A4)) {
         palSetLineMode(A4, PAL_MODE_INPUT_ANALOG);
         dacStart(&DACD1, &dac_conf);
@@ -357,8 +332,8 @@ void audio_driver_stop_impl(void) {
 void audio_driver_start_impl(void) {
     gptStartContinuous(&GPTD6, 2U);
 
+    audio_dds_reset(&dac_oscillator_bank, AUDIO_MAX_SIMULTANEOUS_TONES);
     for (uint8_t i = 0; i < AUDIO_MAX_SIMULTANEOUS_TONES; i++) {
-        dac_if[i]                = 0.0f;
         active_tones_snapshot[i] = 0.0f;
     }
     active_tones_snapshot_length = 0;
@@ -7,8 +7,27 @@
 #include "serial_protocol.h"
 #include "synchronization_util.h"
 
+#if defined(SERIAL_USART_STREAMING)
+#    include <string.h>
+#    include "split_frame.h"
+
+static inline bool receive_frame(bool blocking);
+static inline void respond_to_frame(void);
+
+/* Outgoing frames are double buffered, the next one is built while the driver
+ * is still sending the previous one. */
+static split_frame_t        tx_frames[2];
+static uint8_t              tx_frame_index = 0;
+static split_frame_parser_t rx_parser;
+
+/* Bytes that were read from the driver past the end of the last frame. */
+static uint8_t rx_chunk[32];
+static size_t  rx_chunk_size   = 0;
+static size_t  rx_chunk_offset = 0;
+#else
 static inline bool initiate_transaction(uint8_t transaction_id);
 static inline bool react_to_transaction(void);
+#endif
 
 /**
  * @brief This thread runs on the slave and responds to transactions initiated
@@ -20,11 +39,17 @@ static THD_FUNCTION(SlaveThread, arg) {
     chRegSetThreadName("split_protocol_tx_rx");
 
     while (true) {
+#if defined(SERIAL_USART_STREAMING)
+        if (likely(receive_frame(true))) {
+            respond_to_frame();
+        }
+#else
         if (unlikely(!react_to_transaction())) {
             /* Clear the receive queue, to start with a clean slate.
              * Parts of failed transactions or spurious bytes could still be in it. */
             serial_transport_driver_clear();
         }
+#endif
     }
 }
 
@@ -43,7 +68,220 @@ void soft_serial_target_init(void) {
  */
 void soft_serial_initiator_init(void) {
     serial_transport_driver_master_init();
+#if defined(SERIAL_USART_STREAMING)
+    split_frame_begin(&tx_frames[tx_frame_index], 0);
+#endif
+}
+
+#if defined(SERIAL_USART_STREAMING)
+/**
+ * @brief Feed received bytes to the frame parser until a frame is complete.
+ */
+static inline bool receive_frame(bool blocking) {
+    while (true) {
+        while (rx_chunk_offset < rx_chunk_size) {
+            if (split_frame_parser_feed(&rx_parser, rx_chunk[rx_chunk_offset++])) {
+                return true;
+            }
+        }
+
+        rx_chunk_offset = 0;
+        rx_chunk_size   = serial_transport_stream_read(rx_chunk, sizeof(rx_chunk), blocking);
+        if (rx_chunk_size == 0) {
+            return false;
+        }
+    }
+}
+
+/**
+ * @brief Send the current frame and start the next one.
+ */
+static inline bool send_frame(void) {
+    split_frame_t* frame    = &tx_frames[tx_frame_index];
+    uint8_t        sequence = split_frame_sequence(frame);
+    bool           success  = serial_transport_stream_write(frame->data, split_frame_finish(frame));
+
+    tx_frame_index ^= 1;
+    split_frame_begin(&tx_frames[tx_frame_index], sequence + 1);
+    return success;
+}
+
+/**
+ * @brief Run all transactions of a frame received from the master, and send
+ * back the target2initiator buffers in a frame with the same sequence number.
+ */
+static inline void respond_to_frame(void) {
+    split_frame_t* response = &tx_frames[tx_frame_index];
+    split_frame_begin(response, split_frame_sequence(&rx_parser.frame));
+
+    {
+        split_shared_memory_lock_autounlock();
+
+        uint16_t       offset = 0;
+        uint8_t        transaction_id;
+        const uint8_t* data;
+        uint8_t        size;
+        while (split_frame_next_record(&rx_parser.frame, &offset, &transaction_id, &data, &size)) {
+            /* Sanity check that we are actually responding to a valid transaction. */
+            if (unlikely(transaction_id >= NUM_TOTAL_TRANSACTIONS)) {
+                continue;
+            }
+
+            split_transaction_desc_t* transaction = &split_transaction_table[transaction_id];
+            if (unlikely(size != transaction->initiator2target_buffer_size)) {
+                continue;
+            }
+            memcpy(split_trans_initiator2target_buffer(transaction), data, size);
+
+            /* Allow any slave processing to occur. */
+            if (transaction->slave_callback) {
+                transaction->slave_callback(transaction->initiator2target_buffer_size, split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size, split_trans_target2initiator_buffer(transaction));
+            }
+
+            /* A response that does not fit is left out, which fails the transaction on the master. */
+            if (transaction->target2initiator_buffer_size) {
+                split_frame_append(response, transaction_id, split_trans_target2initiator_buffer(transaction), transaction->target2initiator_buffer_size);
+            }
+        }
+    }
+
+    send_frame();
+}
+
+/**
+ * @brief Writes to the slave's shared memory can be batched up and sent again
+ * safely. Transactions that read back, or run a callback on the slave, are
+ * exchanged right away instead.
+ */
+static inline bool is_batched(const split_transaction_desc_t* transaction) {
+    return !transaction->target2initiator_buffer_size && !transaction->slave_callback;
+}
+
+/**
+ * @brief Check whether a frame already carries a record for a transaction.
+ */
+static inline bool frame_has_record(const split_frame_t* frame, uint8_t transaction_id) {
+    uint16_t       offset = 0;
+    uint8_t        id;
+    const uint8_t* data;
+    uint8_t        size;
+    while (split_frame_next_record(frame, &offset, &id, &data, &size)) {
+        if (id == transaction_id) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Carry the batched up records of a frame that failed over into the
+ * next one.
+ *
+ * Batched transactions were already reported as sent when they were queued,
+ * so they are sent again until a frame carrying them makes it across rather
+ * than being dropped.
+ */
+static inline void carry_batched_records(const split_frame_t* failed) {
+    uint16_t       offset = 0;
+    uint8_t        id;
+    const uint8_t* data;
+    uint8_t        size;
+    while (split_frame_next_record(failed, &offset, &id, &data, &size)) {
+        if (id < NUM_TOTAL_TRANSACTIONS && is_batched(&split_transaction_table[id])) {
+            split_frame_append(&tx_frames[tx_frame_index], id, data, size);
+        }
+    }
+}
+
+/**
+ * @brief Send the current frame to the slave and wait for its response.
+ *
+ * @param transaction_id Transaction that needs its target2initiator buffer from
+ * the response, or NUM_TOTAL_TRANSACTIONS for none.
+ */
+static inline bool exchange_frames(uint8_t transaction_id) {
+    uint8_t sequence = split_frame_sequence(&tx_frames[tx_frame_index]);
+
+    if (unlikely(!send_frame())) {
+        serial_dprintf("SPLIT: sending frame failed\n");
+        carry_batched_records(&tx_frames[tx_frame_index ^ 1]);
+        return false;
+    }
+
+    while (receive_frame(false)) {
+        /* Skip late responses to earlier frames that timed out. */
+        if (split_frame_sequence(&rx_parser.frame) != sequence) {
+            continue;
+        }
+
+        bool           found  = transaction_id == NUM_TOTAL_TRANSACTIONS;
+        uint16_t       offset = 0;
+        uint8_t        id;
+        const uint8_t* data;
+        uint8_t        size;
+        while (split_frame_next_record(&rx_parser.frame, &offset, &id, &data, &size)) {
+            if (id < NUM_TOTAL_TRANSACTIONS && size == split_transaction_table[id].target2initiator_buffer_size) {
+                memcpy(split_trans_target2initiator_buffer(&split_transaction_table[id]), data, size);
+                found |= id == transaction_id;
+            }
+        }
+        return found;
+    }
+
+    serial_dprintf("SPLIT: receiving frame failed\n");
+    carry_batched_records(&tx_frames[tx_frame_index ^ 1]);
+    return false;
+}
+
+/**
+ * @brief Queue a transaction from the master half to the slave half.
+ *
+ * Transactions which only write to the slave's shared memory are batched up
+ * into a single frame with the next one that is exchanged right away, which
+ * then also reports whether the batch made it across. If it did not, the
+ * batched up writes are sent again with the next frame.
+ *
+ * @param index Transaction Table index of the transaction to start.
+ * @return bool Indicates success of transaction.
+ */
+bool soft_serial_transaction(int index) {
+    uint8_t transaction_id = (uint8_t)index;
+
+    /* Sanity check that we are actually starting a valid transaction. */
+    if (unlikely(transaction_id >= NUM_TOTAL_TRANSACTIONS)) {
+        serial_dprintf("SPLIT: illegal transaction id\n");
+        return false;
+    }
+
+    split_shared_memory_lock_autounlock();
+
+    split_transaction_desc_t* transaction = &split_transaction_table[transaction_id];
+
+    /* A write carried over from a failed frame has to reach the slave before
+     * the one replacing it, or the slave would only ever see the latter. */
+    if (unlikely(frame_has_record(&tx_frames[tx_frame_index], transaction_id))) {
+        if (unlikely(!exchange_frames(NUM_TOTAL_TRANSACTIONS))) {
+            return false;
+        }
+    }
+
+    if (unlikely(!split_frame_append(&tx_frames[tx_frame_index], transaction_id, split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size))) {
+        /* Make room by sending off what has been batched up so far. */
+        if (unlikely(!exchange_frames(NUM_TOTAL_TRANSACTIONS))) {
+            return false;
+        }
+        if (unlikely(!split_frame_append(&tx_frames[tx_frame_index], transaction_id, split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size))) {
+            serial_dprintf("SPLIT: transaction too large for a frame\n");
+            return false;
+        }
+    }
+
+    if (is_batched(transaction)) {
+        return true;
+    }
+    return exchange_frames(transaction->target2initiator_buffer_size ? transaction_id : NUM_TOTAL_TRANSACTIONS);
 }
+#else
 
 /**
  * @brief React to transactions started by the master.
@@ -156,3 +394,4 @@ static inline bool initiate_transaction(uint8_t transaction_id) {
 
     return true;
 }
+#endif
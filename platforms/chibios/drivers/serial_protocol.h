@@ -47,3 +47,24 @@ bool __attribute__((nonnull, hot)) serial_transport_receive_blocking(uint8_t* de
  * @return false Send failed, e.g. by timeout or bit errors.
  */
 bool __attribute__((nonnull, hot)) serial_transport_send(const uint8_t* source, const size_t size);
+
+#if defined(SERIAL_USART_STREAMING)
+/**
+ * @brief Non-blocking read of the bytes received since the last read, the
+ * driver keeps receiving into a ring buffer in the background. Waits for at
+ * least one byte to arrive, with an implicitly defined timeout unless blocking
+ * is set.
+ *
+ * @return Number of bytes read, 0 after a timeout.
+ */
+size_t __attribute__((nonnull, hot)) serial_transport_stream_read(uint8_t* destination, const size_t size, bool blocking);
+
+/**
+ * @brief Starts sending a buffer in the background, once the previous one has
+ * been sent. The buffer must be left untouched until the next call.
+ *
+ * @return true Send started.
+ * @return false The previous send timed out.
+ */
+bool __attribute__((nonnull, hot)) serial_transport_stream_write(const uint8_t* source, const size_t size);
+#endif
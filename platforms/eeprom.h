@@ -57,6 +57,9 @@ void     eeprom_update_block(const void *__src, void *__dst, size_t __n);
 #elif defined(EEPROM_LEGACY_EMULATED_FLASH)
 #    include "eeprom_legacy_emulated_flash_defs.h"
 #    define TOTAL_EEPROM_BYTE_COUNT (FEE_DENSITY_BYTES)
+#elif defined(EEPROM_LINUX)
+#    include "eeprom_linux.h"
+#    define TOTAL_EEPROM_BYTE_COUNT (LINUX_EEPROM_SIZE)
 #elif defined(EEPROM_SAMD)
 #    include "eeprom_samd.h"
 #    define TOTAL_EEPROM_BYTE_COUNT (EEPROM_SIZE)
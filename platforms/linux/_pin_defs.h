@@ -0,0 +1,413 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+/* Emulated pins, named as on the MCUs keyboards are built for so that their pin configuration compiles unchanged:
+ * ports A-K as on AVR and STM32, plus the GPn pins of the RP2040. Every port has 32 pins. */
+
+#define LINUX_PIN_PORT_SIZE 32
+#define LINUX_PIN_PORT_COUNT 12
+#define LINUX_PIN_COUNT (LINUX_PIN_PORT_SIZE * LINUX_PIN_PORT_COUNT)
+
+#define LINUX_PIN(port, n) ((port) * LINUX_PIN_PORT_SIZE + (n))
+
+#define A0 LINUX_PIN(0, 0)
+#define A1 LINUX_PIN(0, 1)
+#define A2 LINUX_PIN(0, 2)
+#define A3 LINUX_PIN(0, 3)
+#define A4 LINUX_PIN(0, 4)
+#define A5 LINUX_PIN(0, 5)
+#define A6 LINUX_PIN(0, 6)
+#define A7 LINUX_PIN(0, 7)
+#define A8 LINUX_PIN(0, 8)
+#define A9 LINUX_PIN(0, 9)
+#define A10 LINUX_PIN(0, 10)
+#define A11 LINUX_PIN(0, 11)
+#define A12 LINUX_PIN(0, 12)
+#define A13 LINUX_PIN(0, 13)
+#define A14 LINUX_PIN(0, 14)
+#define A15 LINUX_PIN(0, 15)
+#define A16 LINUX_PIN(0, 16)
+#define A17 LINUX_PIN(0, 17)
+#define A18 LINUX_PIN(0, 18)
+#define A19 LINUX_PIN(0, 19)
+#define A20 LINUX_PIN(0, 20)
+#define A21 LINUX_PIN(0, 21)
+#define A22 LINUX_PIN(0, 22)
+#define A23 LINUX_PIN(0, 23)
+#define A24 LINUX_PIN(0, 24)
+#define A25 LINUX_PIN(0, 25)
+#define A26 LINUX_PIN(0, 26)
+#define A27 LINUX_PIN(0, 27)
+#define A28 LINUX_PIN(0, 28)
+#define A29 LINUX_PIN(0, 29)
+#define A30 LINUX_PIN(0, 30)
+#define A31 LINUX_PIN(0, 31)
+
+#define B0 LINUX_PIN(1, 0)
+#define B1 LINUX_PIN(1, 1)
+#define B2 LINUX_PIN(1, 2)
+#define B3 LINUX_PIN(1, 3)
+#define B4 LINUX_PIN(1, 4)
+#define B5 LINUX_PIN(1, 5)
+#define B6 LINUX_PIN(1, 6)
+#define B7 LINUX_PIN(1, 7)
+#define B8 LINUX_PIN(1, 8)
+#define B9 LINUX_PIN(1, 9)
+#define B10 LINUX_PIN(1, 10)
+#define B11 LINUX_PIN(1, 11)
+#define B12 LINUX_PIN(1, 12)
+#define B13 LINUX_PIN(1, 13)
+#define B14 LINUX_PIN(1, 14)
+#define B15 LINUX_PIN(1, 15)
+#define B16 LINUX_PIN(1, 16)
+#define B17 LINUX_PIN(1, 17)
+#define B18 LINUX_PIN(1, 18)
+#define B19 LINUX_PIN(1, 19)
+#define B20 LINUX_PIN(1, 20)
+#define B21 LINUX_PIN(1, 21)
+#define B22 LINUX_PIN(1, 22)
+#define B23 LINUX_PIN(1, 23)
+#define B24 LINUX_PIN(1, 24)
+#define B25 LINUX_PIN(1, 25)
+#define B26 LINUX_PIN(1, 26)
+#define B27 LINUX_PIN(1, 27)
+#define B28 LINUX_PIN(1, 28)
+#define B29 LINUX_PIN(1, 29)
+#define B30 LINUX_PIN(1, 30)
+#define B31 LINUX_PIN(1, 31)
+
+#define C0 LINUX_PIN(2, 0)
+#define C1 LINUX_PIN(2, 1)
+#define C2 LINUX_PIN(2, 2)
+#define C3 LINUX_PIN(2, 3)
+#define C4 LINUX_PIN(2, 4)
+#define C5 LINUX_PIN(2, 5)
+#define C6 LINUX_PIN(2, 6)
+#define C7 LINUX_PIN(2, 7)
+#define C8 LINUX_PIN(2, 8)
+#define C9 LINUX_PIN(2, 9)
+#define C10 LINUX_PIN(2, 10)
+#define C11 LINUX_PIN(2, 11)
+#define C12 LINUX_PIN(2, 12)
+#define C13 LINUX_PIN(2, 13)
+#define C14 LINUX_PIN(2, 14)
+#define C15 LINUX_PIN(2, 15)
+#define C16 LINUX_PIN(2, 16)
+#define C17 LINUX_PIN(2, 17)
+#define C18 LINUX_PIN(2, 18)
+#define C19 LINUX_PIN(2, 19)
+#define C20 LINUX_PIN(2, 20)
+#define C21 LINUX_PIN(2, 21)
+#define C22 LINUX_PIN(2, 22)
+#define C23 LINUX_PIN(2, 23)
+#define C24 LINUX_PIN(2, 24)
+#define C25 LINUX_PIN(2, 25)
+#define C26 LINUX_PIN(2, 26)
+#define C27 LINUX_PIN(2, 27)
+#define C28 LINUX_PIN(2, 28)
+#define C29 LINUX_PIN(2, 29)
+#define C30 LINUX_PIN(2, 30)
+#define C31 LINUX_PIN(2, 31)
+
+#define D0 LINUX_PIN(3, 0)
+#define D1 LINUX_PIN(3, 1)
+#define D2 LINUX_PIN(3, 2)
+#define D3 LINUX_PIN(3, 3)
+#define D4 LINUX_PIN(3, 4)
+#define D5 LINUX_PIN(3, 5)
+#define D6 LINUX_PIN(3, 6)
+#define D7 LINUX_PIN(3, 7)
+#define D8 LINUX_PIN(3, 8)
+#define D9 LINUX_PIN(3, 9)
+#define D10 LINUX_PIN(3, 10)
+#define D11 LINUX_PIN(3, 11)
+#define D12 LINUX_PIN(3, 12)
+#define D13 LINUX_PIN(3, 13)
+#define D14 LINUX_PIN(3, 14)
+#define D15 LINUX_PIN(3, 15)
+#define D16 LINUX_PIN(3, 16)
+#define D17 LINUX_PIN(3, 17)
+#define D18 LINUX_PIN(3, 18)
+#define D19 LINUX_PIN(3, 19)
+#define D20 LINUX_PIN(3, 20)
+#define D21 LINUX_PIN(3, 21)
+#define D22 LINUX_PIN(3, 22)
+#define D23 LINUX_PIN(3, 23)
+#define D24 LINUX_PIN(3, 24)
+#define D25 LINUX_PIN(3, 25)
+#define D26 LINUX_PIN(3, 26)
+#define D27 LINUX_PIN(3, 27)
+#define D28 LINUX_PIN(3, 28)
+#define D29 LINUX_PIN(3, 29)
+#define D30 LINUX_PIN(3, 30)
+#define D31 LINUX_PIN(3, 31)
+
+#define E0 LINUX_PIN(4, 0)
+#define E1 LINUX_PIN(4, 1)
+#define E2 LINUX_PIN(4, 2)
+#define E3 LINUX_PIN(4, 3)
+#define E4 LINUX_PIN(4, 4)
+#define E5 LINUX_PIN(4, 5)
+#define E6 LINUX_PIN(4, 6)
+#define E7 LINUX_PIN(4, 7)
+#define E8 LINUX_PIN(4, 8)
+#define E9 LINUX_PIN(4, 9)
+#define E10 LINUX_PIN(4, 10)
+#define E11 LINUX_PIN(4, 11)
+#define E12 LINUX_PIN(4, 12)
+#define E13 LINUX_PIN(4, 13)
+#define E14 LINUX_PIN(4, 14)
+#define E15 LINUX_PIN(4, 15)
+#define E16 LINUX_PIN(4, 16)
+#define E17 LINUX_PIN(4, 17)
+#define E18 LINUX_PIN(4, 18)
+#define E19 LINUX_PIN(4, 19)
+#define E20 LINUX_PIN(4, 20)
+#define E21 LINUX_PIN(4, 21)
+#define E22 LINUX_PIN(4, 22)
+#define E23 LINUX_PIN(4, 23)
+#define E24 LINUX_PIN(4, 24)
+#define E25 LINUX_PIN(4, 25)
+#define E26 LINUX_PIN(4, 26)
+#define E27 LINUX_PIN(4, 27)
+#define E28 LINUX_PIN(4, 28)
+#define E29 LINUX_PIN(4, 29)
+#define E30 LINUX_PIN(4, 30)
+#define E31 LINUX_PIN(4, 31)
+
+#define F0 LINUX_PIN(5, 0)
+#define F1 LINUX_PIN(5, 1)
+#define F2 LINUX_PIN(5, 2)
+#define F3 LINUX_PIN(5, 3)
+#define F4 LINUX_PIN(5, 4)
+#define F5 LINUX_PIN(5, 5)
+#define F6 LINUX_PIN(5, 6)
+#define F7 LINUX_PIN(5, 7)
+#define F8 LINUX_PIN(5, 8)
+#define F9 LINUX_PIN(5, 9)
+#define F10 LINUX_PIN(5, 10)
+#define F11 LINUX_PIN(5, 11)
+#define F12 LINUX_PIN(5, 12)
+#define F13 LINUX_PIN(5, 13)
+#define F14 LINUX_PIN(5, 14)
+#define F15 LINUX_PIN(5, 15)
+#define F16 LINUX_PIN(5, 16)
+#define F17 LINUX_PIN(5, 17)
+#define F18 LINUX_PIN(5, 18)
+#define F19 LINUX_PIN(5, 19)
+#define F20 LINUX_PIN(5, 20)
+#define F21 LINUX_PIN(5, 21)
+#define F22 LINUX_PIN(5, 22)
+#define F23 LINUX_PIN(5, 23)
+#define F24 LINUX_PIN(5, 24)
+#define F25 LINUX_PIN(5, 25)
+#define F26 LINUX_PIN(5, 26)
+#define F27 LINUX_PIN(5, 27)
+#define F28 LINUX_PIN(5, 28)
+#define F29 LINUX_PIN(5, 29)
+#define F30 LINUX_PIN(5, 30)
+#define F31 LINUX_PIN(5, 31)
+
+#define G0 LINUX_PIN(6, 0)
+#define G1 LINUX_PIN(6, 1)
+#define G2 LINUX_PIN(6, 2)
+#define G3 LINUX_PIN(6, 3)
+#define G4 LINUX_PIN(6, 4)
+#define G5 LINUX_PIN(6, 5)
+#define G6 LINUX_PIN(6, 6)
+#define G7 LINUX_PIN(6, 7)
+#define G8 LINUX_PIN(6, 8)
+#define G9 LINUX_PIN(6, 9)
+#define G10 LINUX_PIN(6, 10)
+#define G11 LINUX_PIN(6, 11)
+#define G12 LINUX_PIN(6, 12)
+#define G13 LINUX_PIN(6, 13)
+#define G14 LINUX_PIN(6, 14)
+#define G15 LINUX_PIN(6, 15)
+#define G16 LINUX_PIN(6, 16)
+#define G17 LINUX_PIN(6, 17)
+#define G18 LINUX_PIN(6, 18)
+#define G19 LINUX_PIN(6, 19)
+#define G20 LINUX_PIN(6, 20)
+#define G21 LINUX_PIN(6, 21)
+#define G22 LINUX_PIN(6, 22)
+#define G23 LINUX_PIN(6, 23)
+#define G24 LINUX_PIN(6, 24)
+#define G25 LINUX_PIN(6, 25)
+#define G26 LINUX_PIN(6, 26)
+#define G27 LINUX_PIN(6, 27)
+#define G28 LINUX_PIN(6, 28)
+#define G29 LINUX_PIN(6, 29)
+#define G30 LINUX_PIN(6, 30)
+#define G31 LINUX_PIN(6, 31)
+
+#define H0 LINUX_PIN(7, 0)
+#define H1 LINUX_PIN(7, 1)
+#define H2 LINUX_PIN(7, 2)
+#define H3 LINUX_PIN(7, 3)
+#define H4 LINUX_PIN(7, 4)
+#define H5 LINUX_PIN(7, 5)
+#define H6 LINUX_PIN(7, 6)
+#define H7 LINUX_PIN(7, 7)
+#define H8 LINUX_PIN(7, 8)
+#define H9 LINUX_PIN(7, 9)
+#define H10 LINUX_PIN(7, 10)
+#define H11 LINUX_PIN(7, 11)
+#define H12 LINUX_PIN(7, 12)
+#define H13 LINUX_PIN(7, 13)
+#define H14 LINUX_PIN(7, 14)
+#define H15 LINUX_PIN(7, 15)
+#define H16 LINUX_PIN(7, 16)
+#define H17 LINUX_PIN(7, 17)
+#define H18 LINUX_PIN(7, 18)
+#define H19 LINUX_PIN(7, 19)
+#define H20 LINUX_PIN(7, 20)
+#define H21 LINUX_PIN(7, 21)
+#define H22 LINUX_PIN(7, 22)
+#define H23 LINUX_PIN(7, 23)
+#define H24 LINUX_PIN(7, 24)
+#define H25 LINUX_PIN(7, 25)
+#define H26 LINUX_PIN(7, 26)
+#define H27 LINUX_PIN(7, 27)
+#define H28 LINUX_PIN(7, 28)
+#define H29 LINUX_PIN(7, 29)
+#define H30 LINUX_PIN(7, 30)
+#define H31 LINUX_PIN(7, 31)
+
+#define I0 LINUX_PIN(8, 0)
+#define I1 LINUX_PIN(8, 1)
+#define I2 LINUX_PIN(8, 2)
+#define I3 LINUX_PIN(8, 3)
+#define I4 LINUX_PIN(8, 4)
+#define I5 LINUX_PIN(8, 5)
+#define I6 LINUX_PIN(8, 6)
+#define I7 LINUX_PIN(8, 7)
+#define I8 LINUX_PIN(8, 8)
+#define I9 LINUX_PIN(8, 9)
+#define I10 LINUX_PIN(8, 10)
+#define I11 LINUX_PIN(8, 11)
+#define I12 LINUX_PIN(8, 12)
+#define I13 LINUX_PIN(8, 13)
+#define I14 LINUX_PIN(8, 14)
+#define I15 LINUX_PIN(8, 15)
+#define I16 LINUX_PIN(8, 16)
+#define I17 LINUX_PIN(8, 17)
+#define I18 LINUX_PIN(8, 18)
+#define I19 LINUX_PIN(8, 19)
+#define I20 LINUX_PIN(8, 20)
+#define I21 LINUX_PIN(8, 21)
+#define I22 LINUX_PIN(8, 22)
+#define I23 LINUX_PIN(8, 23)
+#define I24 LINUX_PIN(8, 24)
+#define I25 LINUX_PIN(8, 25)
+#define I26 LINUX_PIN(8, 26)
+#define I27 LINUX_PIN(8, 27)
+#define I28 LINUX_PIN(8, 28)
+#define I29 LINUX_PIN(8, 29)
+#define I30 LINUX_PIN(8, 30)
+#define I31 LINUX_PIN(8, 31)
+
+#define J0 LINUX_PIN(9, 0)
+#define J1 LINUX_PIN(9, 1)
+#define J2 LINUX_PIN(9, 2)
+#define J3 LINUX_PIN(9, 3)
+#define J4 LINUX_PIN(9, 4)
+#define J5 LINUX_PIN(9, 5)
+#define J6 LINUX_PIN(9, 6)
+#define J7 LINUX_PIN(9, 7)
+#define J8 LINUX_PIN(9, 8)
+#define J9 LINUX_PIN(9, 9)
+#define J10 LINUX_PIN(9, 10)
+#define J11 LINUX_PIN(9, 11)
+#define J12 LINUX_PIN(9, 12)
+#define J13 LINUX_PIN(9, 13)
+#define J14 LINUX_PIN(9, 14)
+#define J15 LINUX_PIN(9, 15)
+#define J16 LINUX_PIN(9, 16)
+#define J17 LINUX_PIN(9, 17)
+#define J18 LINUX_PIN(9, 18)
+#define J19 LINUX_PIN(9, 19)
+#define J20 LINUX_PIN(9, 20)
+#define J21 LINUX_PIN(9, 21)
+#define J22 LINUX_PIN(9, 22)
+#define J23 LINUX_PIN(9, 23)
+#define J24 LINUX_PIN(9, 24)
+#define J25 LINUX_PIN(9, 25)
+#define J26 LINUX_PIN(9, 26)
+#define J27 LINUX_PIN(9, 27)
+#define J28 LINUX_PIN(9, 28)
+#define J29 LINUX_PIN(9, 29)
+#define J30 LINUX_PIN(9, 30)
+#define J31 LINUX_PIN(9, 31)
+
+// Keyboards can `#define KEYBOARD_REQUIRES_GPIOK` if they need to access GPIO-K pins, as on ChibiOS these conflict
+// with a whole bunch of layout definitions.
+#ifdef KEYBOARD_REQUIRES_GPIOK
+#    define K0 LINUX_PIN(10, 0)
+#    define K1 LINUX_PIN(10, 1)
+#    define K2 LINUX_PIN(10, 2)
+#    define K3 LINUX_PIN(10, 3)
+#    define K4 LINUX_PIN(10, 4)
+#    define K5 LINUX_PIN(10, 5)
+#    define K6 LINUX_PIN(10, 6)
+#    define K7 LINUX_PIN(10, 7)
+#    define K8 LINUX_PIN(10, 8)
+#    define K9 LINUX_PIN(10, 9)
+#    define K10 LINUX_PIN(10, 10)
+#    define K11 LINUX_PIN(10, 11)
+#    define K12 LINUX_PIN(10, 12)
+#    define K13 LINUX_PIN(10, 13)
+#    define K14 LINUX_PIN(10, 14)
+#    define K15 LINUX_PIN(10, 15)
+#    define K16 LINUX_PIN(10, 16)
+#    define K17 LINUX_PIN(10, 17)
+#    define K18 LINUX_PIN(10, 18)
+#    define K19 LINUX_PIN(10, 19)
+#    define K20 LINUX_PIN(10, 20)
+#    define K21 LINUX_PIN(10, 21)
+#    define K22 LINUX_PIN(10, 22)
+#    define K23 LINUX_PIN(10, 23)
+#    define K24 LINUX_PIN(10, 24)
+#    define K25 LINUX_PIN(10, 25)
+#    define K26 LINUX_PIN(10, 26)
+#    define K27 LINUX_PIN(10, 27)
+#    define K28 LINUX_PIN(10, 28)
+#    define K29 LINUX_PIN(10, 29)
+#    define K30 LINUX_PIN(10, 30)
+#    define K31 LINUX_PIN(10, 31)
+#endif
+
+#define GP0 LINUX_PIN(11, 0)
+#define GP1 LINUX_PIN(11, 1)
+#define GP2 LINUX_PIN(11, 2)
+#define GP3 LINUX_PIN(11, 3)
+#define GP4 LINUX_PIN(11, 4)
+#define GP5 LINUX_PIN(11, 5)
+#define GP6 LINUX_PIN(11, 6)
+#define GP7 LINUX_PIN(11, 7)
+#define GP8 LINUX_PIN(11, 8)
+#define GP9 LINUX_PIN(11, 9)
+#define GP10 LINUX_PIN(11, 10)
+#define GP11 LINUX_PIN(11, 11)
+#define GP12 LINUX_PIN(11, 12)
+#define GP13 LINUX_PIN(11, 13)
+#define GP14 LINUX_PIN(11, 14)
+#define GP15 LINUX_PIN(11, 15)
+#define GP16 LINUX_PIN(11, 16)
+#define GP17 LINUX_PIN(11, 17)
+#define GP18 LINUX_PIN(11, 18)
+#define GP19 LINUX_PIN(11, 19)
+#define GP20 LINUX_PIN(11, 20)
+#define GP21 LINUX_PIN(11, 21)
+#define GP22 LINUX_PIN(11, 22)
+#define GP23 LINUX_PIN(11, 23)
+#define GP24 LINUX_PIN(11, 24)
+#define GP25 LINUX_PIN(11, 25)
+#define GP26 LINUX_PIN(11, 26)
+#define GP27 LINUX_PIN(11, 27)
+#define GP28 LINUX_PIN(11, 28)
+#define GP29 LINUX_PIN(11, 29)
+#define GP30 LINUX_PIN(11, 30)
+#define GP31 LINUX_PIN(11, 31)
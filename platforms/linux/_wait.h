@@ -0,0 +1,14 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+
+/* Both sleep the calling thread on the monotonic clock, so delays in the firmware cost wall time but no CPU time,
+ * as they would on the MCU. */
+void wait_ms(uint32_t ms);
+void wait_us(uint32_t us);
+
+/* Emulated pins settle instantly. */
+#define waitInputPinDelay()
@@ -0,0 +1,21 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+
+/* There are no interrupts on the host, the only other thread is the split transport's which takes
+ * split_shared_memory_lock() itself. Atomic blocks only have to keep the compiler from reordering around them. */
+
+static __inline__ void __atomic_block_barrier__(const uint8_t *__s) {
+    __asm__ volatile("" ::: "memory");
+    (void)__s;
+}
+
+#define ATOMIC_BLOCK(type) for (type, __ToDo = 1; __ToDo; __ToDo = 0)
+#define ATOMIC_FORCEON uint8_t status_save __attribute__((__cleanup__(__atomic_block_barrier__))) = 0
+#define ATOMIC_RESTORESTATE uint8_t status_save __attribute__((__cleanup__(__atomic_block_barrier__))) = 0
+
+#define ATOMIC_BLOCK_RESTORESTATE ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+#define ATOMIC_BLOCK_FORCEON ATOMIC_BLOCK(ATOMIC_FORCEON)
@@ -0,0 +1,3 @@
+# There is nothing to flash, the firmware is a host executable that is run directly
+BOOTLOADER_TYPE = none
+FIRMWARE_FORMAT = elf
@@ -0,0 +1,15 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stdlib.h>
+#include "bootloader.h"
+
+/* There is nothing to jump to on the host, so both end the process. */
+
+__attribute__((weak)) void bootloader_jump(void) {
+    exit(EXIT_SUCCESS);
+}
+
+__attribute__((weak)) void mcu_reset(void) {
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,78 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "eeprom_driver.h"
+#include "eeprom_linux.h"
+
+/* EEPROM contents are kept in memory and written through to the file named by QMK_EEPROM_FILE, if there is one, so
+ * that they persist between runs. Without a file they start out zeroed on every run. */
+
+static uint8_t buffer[LINUX_EEPROM_SIZE] = {0};
+static int     backing_fd                = -1;
+
+static size_t clamp_length(intptr_t offset, size_t len) {
+    if (offset >= LINUX_EEPROM_SIZE) {
+        return 0;
+    }
+    if (offset + len > LINUX_EEPROM_SIZE) {
+        len = LINUX_EEPROM_SIZE - offset;
+    }
+    return len;
+}
+
+static void write_through(intptr_t offset, size_t len) {
+    if (backing_fd >= 0 && pwrite(backing_fd, &buffer[offset], len, offset) != (ssize_t)len) {
+        // Keep going on the in-memory copy, as an MCU would on a worn out EEPROM
+        close(backing_fd);
+        backing_fd = -1;
+    }
+}
+
+void eeprom_driver_init(void) {
+    const char *path = getenv("QMK_EEPROM_FILE");
+    if (path == NULL || backing_fd >= 0) {
+        return;
+    }
+
+    backing_fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (backing_fd >= 0 && pread(backing_fd, buffer, sizeof(buffer), 0) < 0) {
+        close(backing_fd);
+        backing_fd = -1;
+    }
+}
+
+void eeprom_driver_format(bool erase) {
+    /* A new backing file reads as zeros, same as the in-memory copy, so nothing has to be done to format it */
+    if (erase) {
+        eeprom_driver_erase();
+    }
+}
+
+void eeprom_driver_erase(void) {
+    memset(buffer, 0x00, sizeof(buffer));
+    write_through(0, sizeof(buffer));
+}
+
+void eeprom_read_block(void *buf, const void *addr, size_t len) {
+    intptr_t offset = (intptr_t)addr;
+    memset(buf, 0x00, len);
+    len = clamp_length(offset, len);
+    if (len > 0) {
+        memcpy(buf, &buffer[offset], len);
+    }
+}
+
+void eeprom_write_block(const void *buf, void *addr, size_t len) {
+    intptr_t offset = (intptr_t)addr;
+    len             = clamp_length(offset, len);
+    if (len > 0) {
+        memcpy(&buffer[offset], buf, len);
+        write_through(offset, len);
+    }
+}
@@ -0,0 +1,11 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+/*
+    The size of the emulated EEPROM, the same as that of the larger AVRs by default.
+*/
+#ifndef LINUX_EEPROM_SIZE
+#    define LINUX_EEPROM_SIZE 4096
+#endif
@@ -0,0 +1,44 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Discards anything left over from a failed transaction, to start the next one with a clean slate.
+ */
+void serial_transport_driver_clear(void);
+
+/**
+ * @brief Driver specific initialization on the slave half.
+ */
+void serial_transport_driver_slave_init(void);
+
+/**
+ * @brief Driver specific initialization on the master half.
+ */
+void serial_transport_driver_master_init(void);
+
+/**
+ * @brief Receive of size * bytes, with an implicitly defined timeout.
+ *
+ * @return false on a timeout or when the link is down.
+ */
+bool serial_transport_receive(uint8_t* destination, const size_t size);
+
+/**
+ * @brief Receive of size * bytes, waiting for the master as long as it takes.
+ *
+ * @return false when the link went down.
+ */
+bool serial_transport_receive_blocking(uint8_t* destination, const size_t size);
+
+/**
+ * @brief Send of a buffer.
+ *
+ * @return false when the link is down.
+ */
+bool serial_transport_send(const uint8_t* source, const size_t size);
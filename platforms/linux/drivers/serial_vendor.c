@@ -0,0 +1,155 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <errno.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "serial_protocol.h"
+#include "wait.h"
+
+/* The split link is a Unix stream socket at the path given by QMK_SPLIT_SOCKET, which the slave listens on and the
+ * master connects to. Either half can be started first, or restarted, the master keeps trying to connect. */
+
+#if !defined(SERIAL_USART_TIMEOUT)
+#    define SERIAL_USART_TIMEOUT 20
+#endif
+
+static int listen_fd = -1;
+static int link_fd   = -1;
+
+static bool socket_address(struct sockaddr_un *address) {
+    const char *path = getenv("QMK_SPLIT_SOCKET");
+    if (path == NULL || strlen(path) >= sizeof(address->sun_path)) {
+        return false;
+    }
+    memset(address, 0, sizeof(*address));
+    address->sun_family = AF_UNIX;
+    strcpy(address->sun_path, path);
+    return true;
+}
+
+static void disconnect(void) {
+    if (link_fd >= 0) {
+        close(link_fd);
+        link_fd = -1;
+    }
+}
+
+static bool connect_to_slave(void) {
+    struct sockaddr_un address;
+    if (!socket_address(&address)) {
+        return false;
+    }
+
+    link_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (link_fd >= 0 && connect(link_fd, (struct sockaddr *)&address, sizeof(address)) < 0) {
+        disconnect();
+    }
+    return link_fd >= 0;
+}
+
+/**
+ * @brief Brings the link up if it is down. The slave waits for the master to connect only if blocking is set.
+ */
+static bool link_up(bool blocking) {
+    if (link_fd >= 0) {
+        return true;
+    }
+    if (listen_fd >= 0) {
+        if (blocking) {
+            link_fd = accept(listen_fd, NULL, NULL);
+        }
+        return link_fd >= 0;
+    }
+    return connect_to_slave();
+}
+
+static bool receive(uint8_t *destination, size_t size, int timeout) {
+    while (size > 0) {
+        struct pollfd fds = {.fd = link_fd, .events = POLLIN};
+        int           ready;
+        do {
+            ready = poll(&fds, 1, timeout);
+        } while (ready < 0 && errno == EINTR);
+        if (ready <= 0) {
+            return false;
+        }
+
+        ssize_t received = recv(link_fd, destination, size, 0);
+        if (received <= 0) {
+            // The other half went away
+            disconnect();
+            return false;
+        }
+        destination += received;
+        size -= received;
+    }
+    return true;
+}
+
+void serial_transport_driver_slave_init(void) {
+    struct sockaddr_un address;
+    if (!socket_address(&address)) {
+        return;
+    }
+
+    // Clear out the socket of a previous run
+    unlink(address.sun_path);
+    listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd >= 0 && (bind(listen_fd, (struct sockaddr *)&address, sizeof(address)) < 0 || listen(listen_fd, 1) < 0)) {
+        close(listen_fd);
+        listen_fd = -1;
+    }
+}
+
+void serial_transport_driver_master_init(void) {
+    connect_to_slave();
+}
+
+void serial_transport_driver_clear(void) {
+    if (link_fd < 0) {
+        return;
+    }
+
+    uint8_t discard[64];
+    while (recv(link_fd, discard, sizeof(discard), MSG_DONTWAIT) > 0) {
+    }
+}
+
+bool serial_transport_receive(uint8_t *destination, const size_t size) {
+    return link_up(false) && receive(destination, size, SERIAL_USART_TIMEOUT);
+}
+
+bool serial_transport_receive_blocking(uint8_t *destination, const size_t size) {
+    if (!link_up(true)) {
+        // Without a socket to listen on there is never anything to receive, don't spin on it
+        wait_ms(100);
+        return false;
+    }
+    return receive(destination, size, -1);
+}
+
+bool serial_transport_send(const uint8_t *source, const size_t size) {
+    if (!link_up(false)) {
+        return false;
+    }
+
+    size_t sent = 0;
+    while (sent < size) {
+        ssize_t result = send(link_fd, source + sent, size - sent, MSG_NOSIGNAL);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            disconnect();
+            return false;
+        }
+        sent += result;
+    }
+    return true;
+}
@@ -0,0 +1,59 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "spi_master.h"
+
+/* There are no devices on the host's bus. Every transfer succeeds instantly and reads return zeros, so display and
+ * flash drivers run their full code path without any hardware attached. */
+
+static pin_t current_slave_pin     = NO_PIN;
+static bool  current_cs_active_low = true;
+
+void spi_init(void) {}
+
+bool spi_start_extended(spi_start_config_t *start_config) {
+    if (current_slave_pin != NO_PIN || start_config->slave_pin == NO_PIN) {
+        return false;
+    }
+    current_slave_pin     = start_config->slave_pin;
+    current_cs_active_low = start_config->cs_active_low;
+    gpio_set_pin_output(current_slave_pin);
+    gpio_write_pin(current_slave_pin, !current_cs_active_low);
+    return true;
+}
+
+bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
+    spi_start_config_t start_config = {
+        .slave_pin     = slavePin,
+        .lsb_first     = lsbFirst,
+        .mode          = mode,
+        .divisor       = divisor,
+        .cs_active_low = true,
+    };
+    return spi_start_extended(&start_config);
+}
+
+spi_status_t spi_write(uint8_t data) {
+    return SPI_STATUS_SUCCESS;
+}
+
+spi_status_t spi_read(void) {
+    return 0;
+}
+
+spi_status_t spi_transmit(const uint8_t *data, uint16_t length) {
+    return SPI_STATUS_SUCCESS;
+}
+
+spi_status_t spi_receive(uint8_t *data, uint16_t length) {
+    memset(data, 0, length);
+    return SPI_STATUS_SUCCESS;
+}
+
+void spi_stop(void) {
+    if (current_slave_pin != NO_PIN) {
+        gpio_write_pin(current_slave_pin, current_cs_active_low);
+        current_slave_pin = NO_PIN;
+    }
+}
@@ -0,0 +1,32 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "ws2812.h"
+
+/* There is no strip to drive on the host. Flushing latches the colours into a second buffer, which stands in for the
+ * LEDs themselves and can be inspected from a debugger. */
+
+ws2812_led_t ws2812_leds[WS2812_LED_COUNT];
+ws2812_led_t ws2812_latched[WS2812_LED_COUNT];
+
+void ws2812_init(void) {}
+
+void ws2812_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    ws2812_leds[index].r = red;
+    ws2812_leds[index].g = green;
+    ws2812_leds[index].b = blue;
+#if defined(WS2812_RGBW)
+    ws2812_rgb_to_rgbw(&ws2812_leds[index]);
+#endif
+}
+
+void ws2812_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
+    for (int i = 0; i < WS2812_LED_COUNT; i++) {
+        ws2812_set_color(i, red, green, blue);
+    }
+}
+
+void ws2812_flush(void) {
+    memcpy(ws2812_latched, ws2812_leds, sizeof(ws2812_latched));
+}
@@ -0,0 +1,113 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gpio.h"
+
+#ifndef LINUX_GPIO_MAX_CONTACTS
+#    define LINUX_GPIO_MAX_CONTACTS 64
+#endif
+
+typedef struct {
+    pin_mode_t mode;
+    bool       level;
+} pin_state_t;
+
+typedef struct {
+    pin_t a;
+    pin_t b;
+} contact_t;
+
+static pin_state_t pins[LINUX_PIN_COUNT];
+static contact_t   contacts[LINUX_GPIO_MAX_CONTACTS];
+static uint8_t     contact_count = 0;
+
+void linux_gpio_set_mode(pin_t pin, pin_mode_t mode) {
+    if (pin < LINUX_PIN_COUNT) {
+        pins[pin].mode = mode;
+    }
+}
+
+void linux_gpio_write(pin_t pin, bool level) {
+    if (pin < LINUX_PIN_COUNT) {
+        pins[pin].level = level;
+    }
+}
+
+void linux_gpio_toggle(pin_t pin) {
+    if (pin < LINUX_PIN_COUNT) {
+        pins[pin].level = !pins[pin].level;
+    }
+}
+
+/* Whether a pin drives the line it is connected to, and to which level. Open drain outputs only ever pull low. */
+static bool pin_drives(pin_t pin, bool *level) {
+    if (pin == LINUX_PIN_GND) {
+        *level = false;
+        return true;
+    }
+    switch (pins[pin].mode) {
+        case PIN_MODE_OUTPUT_PUSHPULL:
+            *level = pins[pin].level;
+            return true;
+        case PIN_MODE_OUTPUT_OPENDRAIN:
+            *level = false;
+            return !pins[pin].level;
+        default:
+            return false;
+    }
+}
+
+bool linux_gpio_read(pin_t pin) {
+    if (pin >= LINUX_PIN_COUNT) {
+        return false;
+    }
+    if (pins[pin].mode == PIN_MODE_OUTPUT_PUSHPULL) {
+        return pins[pin].level;
+    }
+
+    bool driven_high = false;
+    for (uint8_t i = 0; i < contact_count; i++) {
+        pin_t other;
+        if (contacts[i].a == pin) {
+            other = contacts[i].b;
+        } else if (contacts[i].b == pin) {
+            other = contacts[i].a;
+        } else {
+            continue;
+        }
+
+        bool level;
+        if (pin_drives(other, &level)) {
+            // Anything pulling the line low wins
+            if (!level) {
+                return false;
+            }
+            driven_high = true;
+        }
+    }
+    if (driven_high) {
+        return true;
+    }
+
+    // Floating inputs read low
+    return pins[pin].mode == PIN_MODE_INPUT_PULLUP;
+}
+
+bool linux_gpio_set_contact(pin_t a, pin_t b, bool closed) {
+    for (uint8_t i = 0; i < contact_count; i++) {
+        if ((contacts[i].a == a && contacts[i].b == b) || (contacts[i].a == b && contacts[i].b == a)) {
+            if (!closed) {
+                contacts[i] = contacts[--contact_count];
+            }
+            return true;
+        }
+    }
+
+    if (closed) {
+        if (contact_count >= LINUX_GPIO_MAX_CONTACTS) {
+            return false;
+        }
+        contacts[contact_count++] = (contact_t){a, b};
+    }
+    return true;
+}
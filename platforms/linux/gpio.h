@@ -0,0 +1,52 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pin_defs.h"
+
+typedef uint16_t pin_t;
+
+typedef enum {
+    PIN_MODE_INPUT,
+    PIN_MODE_INPUT_PULLUP,
+    PIN_MODE_INPUT_PULLDOWN,
+    PIN_MODE_OUTPUT_PUSHPULL,
+    PIN_MODE_OUTPUT_OPENDRAIN,
+} pin_mode_t;
+
+/* Pseudo pin for switches that connect a pin to ground, as with direct pins. */
+#define LINUX_PIN_GND ((pin_t)LINUX_PIN_COUNT)
+
+void linux_gpio_set_mode(pin_t pin, pin_mode_t mode);
+void linux_gpio_write(pin_t pin, bool level);
+void linux_gpio_toggle(pin_t pin);
+bool linux_gpio_read(pin_t pin);
+
+/**
+ * @brief Closes or opens a switch between two pins, which then read each other's level while one of them is driven
+ *
+ * @param a, b the pins, either can be LINUX_PIN_GND
+ * @param closed whether the switch is closed
+ * @return false if the maximum number of closed switches, LINUX_GPIO_MAX_CONTACTS, has been reached
+ */
+bool linux_gpio_set_contact(pin_t a, pin_t b, bool closed);
+
+/* Operation of GPIO by pin. */
+
+#define gpio_set_pin_input(pin) linux_gpio_set_mode((pin), PIN_MODE_INPUT)
+#define gpio_set_pin_input_high(pin) linux_gpio_set_mode((pin), PIN_MODE_INPUT_PULLUP)
+#define gpio_set_pin_input_low(pin) linux_gpio_set_mode((pin), PIN_MODE_INPUT_PULLDOWN)
+#define gpio_set_pin_output_push_pull(pin) linux_gpio_set_mode((pin), PIN_MODE_OUTPUT_PUSHPULL)
+#define gpio_set_pin_output_open_drain(pin) linux_gpio_set_mode((pin), PIN_MODE_OUTPUT_OPENDRAIN)
+#define gpio_set_pin_output(pin) gpio_set_pin_output_push_pull(pin)
+
+#define gpio_write_pin_high(pin) linux_gpio_write((pin), true)
+#define gpio_write_pin_low(pin) linux_gpio_write((pin), false)
+#define gpio_write_pin(pin, level) linux_gpio_write((pin), !!(level))
+
+#define gpio_read_pin(pin) linux_gpio_read(pin)
+
+#define gpio_toggle_pin(pin) linux_gpio_toggle(pin)
@@ -0,0 +1,11 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <unistd.h>
+#include "hardware_id.h"
+
+hardware_id_t get_hardware_id(void) {
+    hardware_id_t id = {0};
+    id.data[0]       = (uint32_t)gethostid();
+    return id;
+}
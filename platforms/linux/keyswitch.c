@@ -0,0 +1,70 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyswitch.h"
+#include "gpio.h"
+#include "matrix.h"
+
+#ifdef SPLIT_KEYBOARD
+#    include "split_util.h"
+
+#    define ROWS_PER_HAND (MATRIX_ROWS / 2)
+#else
+#    define ROWS_PER_HAND (MATRIX_ROWS)
+#endif
+
+static inline bool is_right_hand(void) {
+#ifdef SPLIT_KEYBOARD
+    return !isLeftHand;
+#else
+    return false;
+#endif
+}
+
+#if defined(DIRECT_PINS)
+static bool switch_pins(uint8_t row, uint8_t col, pin_t *a, pin_t *b) {
+    static const pin_t direct_pins[ROWS_PER_HAND][MATRIX_COLS] = DIRECT_PINS;
+#    ifdef DIRECT_PINS_RIGHT
+    static const pin_t direct_pins_right[ROWS_PER_HAND][MATRIX_COLS] = DIRECT_PINS_RIGHT;
+
+    *a = is_right_hand() ? direct_pins_right[row][col] : direct_pins[row][col];
+#    else
+    *a = direct_pins[row][col];
+#    endif
+    *b = LINUX_PIN_GND;
+    return *a != NO_PIN;
+}
+#elif defined(MATRIX_ROW_PINS) && defined(MATRIX_COL_PINS)
+static bool switch_pins(uint8_t row, uint8_t col, pin_t *a, pin_t *b) {
+    static const pin_t row_pins[ROWS_PER_HAND] = MATRIX_ROW_PINS;
+    static const pin_t col_pins[MATRIX_COLS]   = MATRIX_COL_PINS;
+
+    *a = row_pins[row];
+    *b = col_pins[col];
+#    ifdef MATRIX_ROW_PINS_RIGHT
+    static const pin_t row_pins_right[ROWS_PER_HAND] = MATRIX_ROW_PINS_RIGHT;
+    if (is_right_hand()) {
+        *a = row_pins_right[row];
+    }
+#    endif
+#    ifdef MATRIX_COL_PINS_RIGHT
+    static const pin_t col_pins_right[MATRIX_COLS] = MATRIX_COL_PINS_RIGHT;
+    if (is_right_hand()) {
+        *b = col_pins_right[col];
+    }
+#    endif
+    return *a != NO_PIN && *b != NO_PIN;
+}
+#else
+static bool switch_pins(uint8_t row, uint8_t col, pin_t *a, pin_t *b) {
+    return false;
+}
+#endif
+
+bool keyswitch_set(uint8_t row, uint8_t col, bool pressed) {
+    pin_t a, b;
+    if (row >= ROWS_PER_HAND || col >= MATRIX_COLS || !switch_pins(row, col, &a, &b)) {
+        return false;
+    }
+    return linux_gpio_set_contact(a, b, pressed);
+}
@@ -0,0 +1,21 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Presses or releases a switch of this half's matrix
+ *
+ * The switch connects the pins the keyboard's DIRECT_PINS or MATRIX_ROW_PINS / MATRIX_COL_PINS (or their _RIGHT
+ * variants on the right half) give for it, so the matrix is scanned by the keyboard's own code as it would be on the
+ * MCU.
+ *
+ * @param row row within this half, from 0 to MATRIX_ROWS / 2 on split keyboards
+ * @param col column of the switch
+ * @param pressed whether the switch is pressed
+ * @return false if the keyboard has no such switch, or no pins configured for it
+ */
+bool keyswitch_set(uint8_t row, uint8_t col, bool pressed);
@@ -0,0 +1,18 @@
+ifneq ($(findstring linux, $(MCU)),)
+  PLATFORM_KEY := linux
+endif
+
+# Any keyboard can be built for the host with `make <keyboard>:<keymap> PLATFORM_KEY=linux`, which replaces whatever
+# the keyboard's MCU selected above with the host equivalents
+ifeq ($(strip $(PLATFORM_KEY)), linux)
+  override PROTOCOL      := LINUX
+  override EEPROM_DRIVER := vendor
+  override SERIAL_DRIVER := vendor
+  override WS2812_DRIVER := vendor
+
+  MCU_ARCH      :=
+  MCU_PORT_NAME :=
+  MCU_FAMILY    :=
+  MCU_SERIES    :=
+  BOARD         :=
+endif
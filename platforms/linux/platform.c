@@ -0,0 +1,8 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "platform_deps.h"
+
+void platform_setup(void) {
+    // do nothing
+}
@@ -0,0 +1,42 @@
+# Hey Emacs, this is a -*- makefile -*-
+##############################################################################
+# Compiler settings
+#
+CC = $(CC_PREFIX) gcc
+OBJCOPY =
+OBJDUMP =
+SIZE =
+AR = ar
+NM =
+HEX =
+EEP =
+BIN =
+
+COMPILEFLAGS += -funsigned-char
+COMPILEFLAGS += -funsigned-bitfields
+COMPILEFLAGS += -ffunction-sections
+COMPILEFLAGS += -fdata-sections
+COMPILEFLAGS += -fshort-enums
+# Frame pointers and debug info let perf and callgrind attribute time to the firmware's functions and lines
+COMPILEFLAGS += -g
+COMPILEFLAGS += -fno-omit-frame-pointer
+COMPILEFLAGS += -pthread
+
+CFLAGS += $(COMPILEFLAGS)
+CFLAGS += -fno-strict-aliasing
+
+CXXFLAGS += $(COMPILEFLAGS)
+CXXFLAGS += -fno-exceptions $(CXXSTANDARD)
+
+LDFLAGS += -Wl,--gc-sections
+LDFLAGS += -pthread
+
+MCUFLAGS =
+
+OPT_DEFS += -DPLATFORM_SUPPORTS_SYNCHRONIZATION
+
+PLATFORM_SRC += \
+	$(PLATFORM_COMMON_DIR)/gpio.c \
+	$(PLATFORM_COMMON_DIR)/keyswitch.c \
+	$(PLATFORM_COMMON_DIR)/synchronization_util.c \
+	$(PLATFORM_COMMON_DIR)/wait.c
@@ -0,0 +1,41 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "action.h"
+#include "action_util.h"
+#include "mousekey.h"
+#include "programmable_button.h"
+#include "host.h"
+#include "suspend.h"
+#include "wait.h"
+
+/** \brief suspend power down
+ *
+ * Nothing to power down on the host, this only paces the suspended loop.
+ */
+void suspend_power_down(void) {
+    suspend_power_down_quantum();
+    wait_ms(15);
+}
+
+/** \brief suspend wakeup condition
+ *
+ * run immediately after wakeup
+ */
+void suspend_wakeup_init(void) {
+    clear_mods();
+    clear_weak_mods();
+    clear_keys();
+#ifdef MOUSEKEY_ENABLE
+    mousekey_clear();
+#endif /* MOUSEKEY_ENABLE */
+#ifdef PROGRAMMABLE_BUTTON_ENABLE
+    programmable_button_clear();
+#endif /* PROGRAMMABLE_BUTTON_ENABLE */
+#ifdef EXTRAKEY_ENABLE
+    host_system_send(0);
+    host_consumer_send(0);
+#endif /* EXTRAKEY_ENABLE */
+
+    suspend_wakeup_init_quantum();
+}
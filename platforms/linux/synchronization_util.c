@@ -0,0 +1,24 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <pthread.h>
+#include "synchronization_util.h"
+
+#if defined(SPLIT_KEYBOARD)
+static pthread_mutex_t split_shared_memory_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @brief Acquire exclusive access to the split keyboard shared memory, which
+ * the split transport's thread accesses alongside the main loop.
+ */
+void split_shared_memory_lock(void) {
+    pthread_mutex_lock(&split_shared_memory_mutex);
+}
+
+/**
+ * @brief Release the split shared memory mutex that has been acquired before.
+ */
+void split_shared_memory_unlock(void) {
+    pthread_mutex_unlock(&split_shared_memory_mutex);
+}
+#endif
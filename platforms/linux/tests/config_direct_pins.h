@@ -0,0 +1,10 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#define MATRIX_ROWS 1
+#define MATRIX_COLS 2
+
+#define DIRECT_PINS \
+    { { GP4, NO_PIN } }
@@ -0,0 +1,14 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#define MATRIX_ROWS 2
+#define MATRIX_COLS 3
+
+#define MATRIX_ROW_PINS \
+    { B0, B1 }
+#define MATRIX_COL_PINS \
+    { C0, C1, NO_PIN }
+
+#define LINUX_GPIO_MAX_CONTACTS 4
@@ -0,0 +1,11 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#define SPLIT_KEYBOARD
+#define MATRIX_ROWS 2
+#define MATRIX_COLS 1
+
+// Generous, the slave runs in another process that has to be scheduled alongside whatever else the machine runs
+#define SERIAL_USART_TIMEOUT 1000
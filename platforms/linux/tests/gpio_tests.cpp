@@ -0,0 +1,145 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "gpio.h"
+#include "keyswitch.h"
+}
+
+class LinuxGpio : public ::testing::Test {
+   protected:
+    void TearDown() override {
+        // Contacts outlive a test, open all that a test may have closed
+        const pin_t pins[] = {B0, B1, C0, C1, D0, D1, D2, D3, D4, LINUX_PIN_GND};
+        for (pin_t a : pins) {
+            for (pin_t b : pins) {
+                linux_gpio_set_contact(a, b, false);
+            }
+        }
+    }
+};
+
+TEST_F(LinuxGpio, FloatingInputReadsLow) {
+    gpio_set_pin_input(D0);
+    EXPECT_FALSE(gpio_read_pin(D0));
+}
+
+TEST_F(LinuxGpio, PullsSetTheLevelOfAnOpenInput) {
+    gpio_set_pin_input_high(D0);
+    EXPECT_TRUE(gpio_read_pin(D0));
+    gpio_set_pin_input_low(D0);
+    EXPECT_FALSE(gpio_read_pin(D0));
+}
+
+TEST_F(LinuxGpio, OutputReadsItsOwnLevel) {
+    gpio_set_pin_output(D0);
+    gpio_write_pin_high(D0);
+    EXPECT_TRUE(gpio_read_pin(D0));
+    gpio_toggle_pin(D0);
+    EXPECT_FALSE(gpio_read_pin(D0));
+    gpio_write_pin(D0, 2);
+    EXPECT_TRUE(gpio_read_pin(D0));
+}
+
+TEST_F(LinuxGpio, ClosedContactConnectsInputToOutput) {
+    gpio_set_pin_output(D0);
+    gpio_write_pin_low(D0);
+    gpio_set_pin_input_high(D1);
+    EXPECT_TRUE(gpio_read_pin(D1));
+
+    EXPECT_TRUE(linux_gpio_set_contact(D0, D1, true));
+    EXPECT_FALSE(gpio_read_pin(D1));
+    gpio_write_pin_high(D0);
+    EXPECT_TRUE(gpio_read_pin(D1));
+
+    // Pulling down is overridden by the output too
+    gpio_set_pin_input_low(D1);
+    EXPECT_TRUE(gpio_read_pin(D1));
+
+    // Opening the contact from the other side
+    EXPECT_TRUE(linux_gpio_set_contact(D1, D0, false));
+    EXPECT_FALSE(gpio_read_pin(D1));
+}
+
+TEST_F(LinuxGpio, ContactToGroundPullsLow) {
+    gpio_set_pin_input_high(D0);
+    linux_gpio_set_contact(D0, LINUX_PIN_GND, true);
+    EXPECT_FALSE(gpio_read_pin(D0));
+}
+
+TEST_F(LinuxGpio, OpenDrainOutputOnlyPullsLow) {
+    gpio_set_pin_output_open_drain(D0);
+    gpio_set_pin_input_low(D1);
+    linux_gpio_set_contact(D0, D1, true);
+
+    gpio_write_pin_high(D0);
+    EXPECT_FALSE(gpio_read_pin(D1));
+    gpio_set_pin_input_high(D1);
+    EXPECT_TRUE(gpio_read_pin(D1));
+    gpio_write_pin_low(D0);
+    EXPECT_FALSE(gpio_read_pin(D1));
+}
+
+TEST_F(LinuxGpio, LowWinsOverHigh) {
+    gpio_set_pin_output(D0);
+    gpio_write_pin_high(D0);
+    gpio_set_pin_output(D1);
+    gpio_write_pin_low(D1);
+    gpio_set_pin_input(D2);
+    linux_gpio_set_contact(D0, D2, true);
+    linux_gpio_set_contact(D1, D2, true);
+
+    EXPECT_FALSE(gpio_read_pin(D2));
+    gpio_write_pin_high(D1);
+    EXPECT_TRUE(gpio_read_pin(D2));
+}
+
+TEST_F(LinuxGpio, ContactsAreLimited) {
+    // LINUX_GPIO_MAX_CONTACTS is 4 in this build
+    for (pin_t pin = D0; pin < D4; pin++) {
+        EXPECT_TRUE(linux_gpio_set_contact(pin, LINUX_PIN_GND, true));
+    }
+    EXPECT_FALSE(linux_gpio_set_contact(D4, LINUX_PIN_GND, true));
+
+    // Closing a contact that is already closed takes no room
+    EXPECT_TRUE(linux_gpio_set_contact(LINUX_PIN_GND, D0, true));
+
+    EXPECT_TRUE(linux_gpio_set_contact(D0, LINUX_PIN_GND, false));
+    EXPECT_TRUE(linux_gpio_set_contact(D4, LINUX_PIN_GND, true));
+}
+
+TEST_F(LinuxGpio, PinsOutOfRangeAreIgnored) {
+    gpio_set_pin_output(LINUX_PIN_COUNT + 1);
+    gpio_write_pin_high(LINUX_PIN_COUNT + 1);
+    EXPECT_FALSE(gpio_read_pin(LINUX_PIN_COUNT + 1));
+}
+
+TEST_F(LinuxGpio, KeyswitchConnectsRowAndColumn) {
+    // Scanning the first row of a COL2ROW matrix
+    gpio_set_pin_output(B0);
+    gpio_write_pin_low(B0);
+    gpio_set_pin_output(B1);
+    gpio_write_pin_high(B1);
+    gpio_set_pin_input_high(C0);
+    gpio_set_pin_input_high(C1);
+
+    EXPECT_TRUE(keyswitch_set(0, 1, true));
+    EXPECT_TRUE(gpio_read_pin(C0));
+    EXPECT_FALSE(gpio_read_pin(C1));
+
+    // A switch of the row that is not selected leaves the columns alone
+    EXPECT_TRUE(keyswitch_set(1, 0, true));
+    EXPECT_TRUE(gpio_read_pin(C0));
+
+    EXPECT_TRUE(keyswitch_set(0, 1, false));
+    EXPECT_TRUE(gpio_read_pin(C1));
+}
+
+TEST_F(LinuxGpio, KeyswitchRejectsMissingSwitches) {
+    EXPECT_FALSE(keyswitch_set(MATRIX_ROWS, 0, true));
+    EXPECT_FALSE(keyswitch_set(0, MATRIX_COLS, true));
+    // The last column has no pin
+    EXPECT_FALSE(keyswitch_set(0, 2, true));
+}
@@ -0,0 +1,152 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdlib>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "gpio.h"
+#include "input_script.h"
+#include "keyswitch.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+
+static uint8_t host_leds = 0;
+
+void usb_device_state_set_leds(uint8_t leds) {
+    host_leds = leds;
+}
+}
+
+class InputScript : public ::testing::Test {
+   protected:
+    std::string path;
+
+    void SetUp() override {
+        set_time(0);
+        host_leds = 0;
+
+        char name[] = "/tmp/qmk_input_script_XXXXXX";
+        int  fd     = mkstemp(name);
+        ASSERT_GE(fd, 0);
+        close(fd);
+        path = name;
+        setenv("QMK_INPUT_SCRIPT", name, 1);
+
+        // Scan the first row, the columns read low while a switch of it is pressed
+        gpio_set_pin_output(B0);
+        gpio_write_pin_low(B0);
+        gpio_set_pin_input_high(C0);
+        gpio_set_pin_input_high(C1);
+    }
+
+    void TearDown() override {
+        keyswitch_set(0, 0, false);
+        keyswitch_set(0, 1, false);
+        unsetenv("QMK_INPUT_SCRIPT");
+        unlink(path.c_str());
+    }
+
+    void write_script(const std::string &script) {
+        int fd = open(path.c_str(), O_WRONLY | O_TRUNC);
+        ASSERT_GE(fd, 0);
+        ASSERT_EQ(write(fd, script.data(), script.size()), (ssize_t)script.size());
+        close(fd);
+    }
+
+    bool pressed(uint8_t col) {
+        return !gpio_read_pin(col == 0 ? C0 : C1);
+    }
+};
+
+TEST_F(InputScript, MissingScriptFailsToOpen) {
+    setenv("QMK_INPUT_SCRIPT", "/nonexistent/script", 1);
+    EXPECT_FALSE(input_script_init());
+}
+
+TEST_F(InputScript, PressesAndReleasesSwitches) {
+    write_script("press 0 0\npress 0 1\nrelease 0 0\n");
+    ASSERT_TRUE(input_script_init());
+    input_script_task();
+    EXPECT_FALSE(pressed(0));
+    EXPECT_TRUE(pressed(1));
+}
+
+TEST_F(InputScript, WaitHoldsBackTheLinesAfterIt) {
+    write_script("press 0 0\nwait 10\nrelease 0 0\n");
+    ASSERT_TRUE(input_script_init());
+    input_script_task();
+    EXPECT_TRUE(pressed(0));
+
+    advance_time(9);
+    input_script_task();
+    EXPECT_TRUE(pressed(0));
+
+    advance_time(1);
+    input_script_task();
+    EXPECT_FALSE(pressed(0));
+}
+
+TEST_F(InputScript, SetsHostLeds) {
+    write_script("leds 2\n");
+    ASSERT_TRUE(input_script_init());
+    input_script_task();
+    EXPECT_EQ(host_leds, 2);
+}
+
+TEST_F(InputScript, SkipsCommentsBlankAndInvalidLines) {
+    write_script("# a comment\n\n   \npress 0 9\nrelease 0\nbounce 0 0\nleds 256\npress 0 1 # trailing comment\n");
+    ASSERT_TRUE(input_script_init());
+    input_script_task();
+    EXPECT_FALSE(pressed(0));
+    EXPECT_TRUE(pressed(1));
+    EXPECT_EQ(host_leds, 0);
+}
+
+TEST_F(InputScript, RunsLastLineWithoutNewline) {
+    write_script("press 0 1");
+    ASSERT_TRUE(input_script_init());
+    input_script_task();
+    EXPECT_TRUE(pressed(1));
+}
+
+TEST_F(InputScript, CutsOverlongLinesShort) {
+    // Past the default INPUT_SCRIPT_LINE_LENGTH of 128, the rest of the line is dropped rather than run as a line of its own
+    write_script("press 0 1" + std::string(200, ' ') + "press 0 0\n");
+    ASSERT_TRUE(input_script_init());
+    input_script_task();
+    EXPECT_TRUE(pressed(1));
+    EXPECT_FALSE(pressed(0));
+}
+
+TEST_F(InputScript, DoesNotBlockOnLinesYetToArrive) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    setenv("QMK_INPUT_SCRIPT", ("/dev/fd/" + std::to_string(fds[0])).c_str(), 1);
+    ASSERT_TRUE(input_script_init());
+
+    input_script_task();
+    ASSERT_EQ(write(fds[1], "press 0 1", 9), 9);
+    input_script_task();
+    EXPECT_FALSE(pressed(1));
+
+    ASSERT_EQ(write(fds[1], "\n", 1), 1);
+    input_script_task();
+    EXPECT_TRUE(pressed(1));
+
+    close(fds[1]);
+    input_script_task();
+    close(fds[0]);
+}
+
+TEST_F(InputScript, ExitEndsTheProcess) {
+    write_script("exit\npress 0 0\n");
+    ASSERT_TRUE(input_script_init());
+    EXPECT_EXIT(input_script_task(), ::testing::ExitedWithCode(EXIT_SUCCESS), "");
+}
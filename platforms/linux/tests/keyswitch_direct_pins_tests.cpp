@@ -0,0 +1,25 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "gpio.h"
+#include "keyswitch.h"
+}
+
+TEST(LinuxKeyswitchDirectPins, PressGroundsThePin) {
+    gpio_set_pin_input_high(GP4);
+    EXPECT_TRUE(gpio_read_pin(GP4));
+
+    EXPECT_TRUE(keyswitch_set(0, 0, true));
+    EXPECT_FALSE(gpio_read_pin(GP4));
+
+    EXPECT_TRUE(keyswitch_set(0, 0, false));
+    EXPECT_TRUE(gpio_read_pin(GP4));
+}
+
+TEST(LinuxKeyswitchDirectPins, RejectsSwitchWithoutPin) {
+    EXPECT_FALSE(keyswitch_set(0, 1, true));
+    EXPECT_FALSE(keyswitch_set(1, 0, true));
+}
@@ -0,0 +1,36 @@
+linux_platform_INC := \
+	$(PLATFORM_PATH)/linux \
+	$(TMK_PATH)/protocol/linux \
+	$(TMK_PATH)/protocol
+linux_platform_CONFIG := $(PLATFORM_PATH)/linux/tests/config_matrix.h
+
+linux_platform_SRC := \
+	$(PLATFORM_PATH)/linux/tests/gpio_tests.cpp \
+	$(PLATFORM_PATH)/linux/tests/input_script_tests.cpp \
+	$(PLATFORM_PATH)/linux/gpio.c \
+	$(PLATFORM_PATH)/linux/keyswitch.c \
+	$(TMK_PATH)/protocol/linux/input_script.c \
+	$(PLATFORM_PATH)/timer.c \
+	$(PLATFORM_PATH)/test/timer.c
+
+linux_platform_direct_pins_INC := $(PLATFORM_PATH)/linux
+linux_platform_direct_pins_CONFIG := $(PLATFORM_PATH)/linux/tests/config_direct_pins.h
+
+linux_platform_direct_pins_SRC := \
+	$(PLATFORM_PATH)/linux/tests/keyswitch_direct_pins_tests.cpp \
+	$(PLATFORM_PATH)/linux/gpio.c \
+	$(PLATFORM_PATH)/linux/keyswitch.c
+
+linux_split_link_DEFS := -DPLATFORM_SUPPORTS_SYNCHRONIZATION
+linux_split_link_INC := \
+	$(PLATFORM_PATH)/linux \
+	$(PLATFORM_PATH)/linux/drivers \
+	$(QUANTUM_PATH)/split_common
+linux_split_link_CONFIG := $(PLATFORM_PATH)/linux/tests/config_split_link.h
+
+linux_split_link_SRC := \
+	$(PLATFORM_PATH)/linux/tests/split_link_tests.cpp \
+	$(PLATFORM_PATH)/linux/drivers/serial_protocol.c \
+	$(PLATFORM_PATH)/linux/drivers/serial_vendor.c \
+	$(PLATFORM_PATH)/linux/synchronization_util.c \
+	$(PLATFORM_PATH)/test/timer.c
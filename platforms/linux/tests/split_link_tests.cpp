@@ -0,0 +1,122 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstddef>
+#include <cstdlib>
+#include <string>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "serial.h"
+#include "transactions.h"
+}
+
+static split_shared_memory_t shared_memory;
+
+extern "C" {
+split_shared_memory_t *const split_shmem = &shared_memory;
+split_transaction_desc_t     split_transaction_table[NUM_TOTAL_TRANSACTIONS];
+}
+
+/* The slave answers the sync timer the master sends with the next value, plus a matrix row of its own */
+static void slave_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    split_slave_matrix_sync_t *reply = (split_slave_matrix_sync_t *)target2initiator_buffer;
+
+    reply->checksum  = *(const uint32_t *)initiator2target_buffer + 1;
+    reply->matrix[0] = 0x5;
+}
+
+class LinuxSplitLink : public ::testing::Test {
+   protected:
+    std::string directory;
+    pid_t       slave = -1;
+
+    void SetUp() override {
+        split_transaction_table[GET_SLAVE_MATRIX_DATA] = {
+            sizeof(shared_memory.sync_timer), offsetof(split_shared_memory_t, sync_timer), sizeof(shared_memory.smatrix), offsetof(split_shared_memory_t, smatrix), slave_callback,
+        };
+
+        char name[] = "/tmp/qmk_split_link_XXXXXX";
+        ASSERT_NE(mkdtemp(name), nullptr);
+        directory = name;
+        setenv("QMK_SPLIT_SOCKET", (directory + "/link").c_str(), 1);
+
+        soft_serial_initiator_init();
+        start_slave();
+    }
+
+    void TearDown() override {
+        stop_slave();
+        // Also takes the master's end of the link down, before the next test forks a slave off this process
+        EXPECT_FALSE(exchange(1));
+
+        unlink((directory + "/link").c_str());
+        rmdir(directory.c_str());
+        unsetenv("QMK_SPLIT_SOCKET");
+    }
+
+    void start_slave() {
+        int ready[2];
+        ASSERT_EQ(pipe(ready), 0);
+
+        slave = fork();
+        ASSERT_GE(slave, 0);
+        if (slave == 0) {
+            soft_serial_target_init();
+            char byte = 0;
+            (void)!write(ready[1], &byte, 1);
+            while (true) {
+                pause();
+            }
+        }
+
+        char byte;
+        ASSERT_EQ(read(ready[0], &byte, 1), 1);
+        close(ready[0]);
+        close(ready[1]);
+    }
+
+    void stop_slave() {
+        if (slave > 0) {
+            kill(slave, SIGKILL);
+            waitpid(slave, NULL, 0);
+            slave = -1;
+        }
+    }
+
+    bool exchange(uint32_t value) {
+        shared_memory.sync_timer = value;
+        shared_memory.smatrix    = {};
+        return soft_serial_transaction(GET_SLAVE_MATRIX_DATA);
+    }
+};
+
+TEST_F(LinuxSplitLink, ExchangesTransactionsWithSlave) {
+    ASSERT_TRUE(exchange(41));
+    EXPECT_EQ(shared_memory.smatrix.checksum, 42);
+    EXPECT_EQ(shared_memory.smatrix.matrix[0], 0x5);
+
+    ASSERT_TRUE(exchange(7));
+    EXPECT_EQ(shared_memory.smatrix.checksum, 8);
+}
+
+TEST_F(LinuxSplitLink, RejectsInvalidTransaction) {
+    EXPECT_FALSE(soft_serial_transaction(NUM_TOTAL_TRANSACTIONS));
+    // The link is still usable
+    EXPECT_TRUE(exchange(1));
+}
+
+TEST_F(LinuxSplitLink, ReconnectsToRestartedSlave) {
+    ASSERT_TRUE(exchange(1));
+
+    stop_slave();
+    EXPECT_FALSE(exchange(2));
+
+    start_slave();
+    ASSERT_TRUE(exchange(3));
+    EXPECT_EQ(shared_memory.smatrix.checksum, 4);
+}
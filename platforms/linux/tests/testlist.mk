@@ -0,0 +1,4 @@
+TEST_LIST += \
+	linux_platform \
+	linux_platform_direct_pins \
+	linux_split_link
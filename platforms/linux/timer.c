@@ -0,0 +1,46 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <time.h>
+#include "timer.h"
+
+static uint64_t ms_offset = 0;
+static uint32_t saved_ms  = 0;
+
+static uint64_t monotonic_ms(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+void timer_init(void) {
+    timer_clear();
+}
+
+void timer_clear(void) {
+    ms_offset = monotonic_ms();
+}
+
+__attribute__((weak)) void platform_timer_save_value(uint32_t value) {
+    saved_ms = value;
+}
+
+__attribute__((weak)) uint32_t platform_timer_restore_value(void) {
+    return saved_ms;
+}
+
+void timer_restore(void) {
+    ms_offset = monotonic_ms() - platform_timer_restore_value();
+}
+
+void timer_save(void) {
+    platform_timer_save_value(timer_read32());
+}
+
+uint16_t timer_read(void) {
+    return (uint16_t)timer_read32();
+}
+
+uint32_t timer_read32(void) {
+    return (uint32_t)(monotonic_ms() - ms_offset);
+}
@@ -0,0 +1,24 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <errno.h>
+#include <time.h>
+#include "wait.h"
+
+static void sleep_ns(uint64_t ns) {
+    struct timespec duration = {
+        .tv_sec  = ns / 1000000000,
+        .tv_nsec = ns % 1000000000,
+    };
+    // Keep sleeping for the remainder when interrupted by a signal
+    while (clock_nanosleep(CLOCK_MONOTONIC, 0, &duration, &duration) == EINTR) {
+    }
+}
+
+void wait_ms(uint32_t ms) {
+    sleep_ns((uint64_t)ms * 1000000);
+}
+
+void wait_us(uint32_t us) {
+    sleep_ns((uint64_t)us * 1000);
+}
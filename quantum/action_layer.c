@@ -6,6 +6,7 @@
 #include "encoder.h"
 #include "util.h"
 #include "action_layer.h"
+#include "keymap_common.h"
 
 /** \brief Default Layer State
  */
@@ -239,28 +240,58 @@ void layer_debug(void) {
 /** \brief source layer cache
  */
 
-uint8_t source_layers_cache[((MATRIX_ROWS * MATRIX_COLS) + (CHAR_BIT)-1) / (CHAR_BIT)][MAX_LAYER_BITS] = {{0}};
+#    if defined(SOURCE_LAYERS_CACHE_BITPLANE)
+// One bit per entry in each of the MAX_LAYER_BITS planes
+typedef uint8_t source_layers_cache_t[MAX_LAYER_BITS];
+#        define SOURCE_LAYERS_CACHE_SIZE(entries) (((entries) + (CHAR_BIT)-1) / (CHAR_BIT))
+#    elif defined(SOURCE_LAYERS_CACHE_NIBBLE)
+// Two entries per byte, even entries in the low nibble
+typedef uint8_t source_layers_cache_t;
+#        define SOURCE_LAYERS_CACHE_SIZE(entries) (((entries) + 1) / 2)
+#    else
+typedef uint8_t source_layers_cache_t;
+#        define SOURCE_LAYERS_CACHE_SIZE(entries) (entries)
+#    endif
+
+source_layers_cache_t source_layers_cache[SOURCE_LAYERS_CACHE_SIZE(MATRIX_ROWS * MATRIX_COLS)];
 #    ifdef ENCODER_MAP_ENABLE
-uint8_t encoder_source_layers_cache[(NUM_ENCODERS + (CHAR_BIT)-1) / (CHAR_BIT)][MAX_LAYER_BITS] = {{0}};
+source_layers_cache_t encoder_source_layers_cache[SOURCE_LAYERS_CACHE_SIZE(NUM_ENCODERS)];
 #    endif // ENCODER_MAP_ENABLE
 
+#    ifdef SOURCE_LAYERS_CACHE_KEYCODE
+uint16_t source_keycodes_cache[MATRIX_ROWS * MATRIX_COLS];
+#        ifdef ENCODER_MAP_ENABLE
+// Each encoder resolves to distinct keycodes for either direction
+uint16_t encoder_source_keycodes_cache[NUM_ENCODERS * 2];
+#        endif // ENCODER_MAP_ENABLE
+#    endif     // SOURCE_LAYERS_CACHE_KEYCODE
+
 /** \brief update source layers cache impl
  *
  * Updates the supplied cache when changing layers
  */
-void update_source_layers_cache_impl(uint8_t layer, uint16_t entry_number, uint8_t cache[][MAX_LAYER_BITS]) {
+void update_source_layers_cache_impl(uint8_t layer, uint16_t entry_number, source_layers_cache_t cache[]) {
+#    if defined(SOURCE_LAYERS_CACHE_BITPLANE)
     const uint16_t storage_idx = entry_number / (CHAR_BIT);
     const uint8_t  storage_bit = entry_number % (CHAR_BIT);
     for (uint8_t bit_number = 0; bit_number < MAX_LAYER_BITS; bit_number++) {
         cache[storage_idx][bit_number] ^= (-((layer & (1U << bit_number)) != 0) ^ cache[storage_idx][bit_number]) & (1U << storage_bit);
     }
+#    elif defined(SOURCE_LAYERS_CACHE_NIBBLE)
+    const uint16_t storage_idx   = entry_number / 2;
+    const uint8_t  storage_shift = (entry_number % 2) * 4;
+    cache[storage_idx]           = (cache[storage_idx] & ~(0x0F << storage_shift)) | ((layer & 0x0F) << storage_shift);
+#    else
+    cache[entry_number] = layer;
+#    endif
 }
 
 /** \brief read source layers cache
  *
  * reads the cached keys stored when the layer was changed
  */
-uint8_t read_source_layers_cache_impl(uint16_t entry_number, uint8_t cache[][MAX_LAYER_BITS]) {
+uint8_t read_source_layers_cache_impl(uint16_t entry_number, source_layers_cache_t cache[]) {
+#    if defined(SOURCE_LAYERS_CACHE_BITPLANE)
     const uint16_t storage_idx = entry_number / (CHAR_BIT);
     const uint8_t  storage_bit = entry_number % (CHAR_BIT);
     uint8_t        layer       = 0;
@@ -270,6 +301,11 @@ uint8_t read_source_layers_cache_impl(uint16_t entry_number, uint8_t cache[][MAX
     }
 
     return layer;
+#    elif defined(SOURCE_LAYERS_CACHE_NIBBLE)
+    return (cache[entry_number / 2] >> ((entry_number % 2) * 4)) & 0x0F;
+#    else
+    return cache[entry_number];
+#    endif
 }
 
 /** \brief update encoder source layers cache
@@ -280,11 +316,17 @@ void update_source_layers_cache(keypos_t key, uint8_t layer) {
     if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
         const uint16_t entry_number = (uint16_t)(key.row * MATRIX_COLS) + key.col;
         update_source_layers_cache_impl(layer, entry_number, source_layers_cache);
+#    ifdef SOURCE_LAYERS_CACHE_KEYCODE
+        source_keycodes_cache[entry_number] = keymap_key_to_keycode(layer, key);
+#    endif
     }
 #    ifdef ENCODER_MAP_ENABLE
     else if (key.row == KEYLOC_ENCODER_CW || key.row == KEYLOC_ENCODER_CCW) {
         const uint16_t entry_number = key.col;
         update_source_layers_cache_impl(layer, entry_number, encoder_source_layers_cache);
+#        ifdef SOURCE_LAYERS_CACHE_KEYCODE
+        encoder_source_keycodes_cache[(entry_number * 2) + (key.row == KEYLOC_ENCODER_CCW)] = keymap_key_to_keycode(layer, key);
+#        endif
     }
 #    endif // ENCODER_MAP_ENABLE
 }
@@ -306,6 +348,28 @@ uint8_t read_source_layers_cache(keypos_t key) {
 #    endif // ENCODER_MAP_ENABLE
     return 0;
 }
+
+#    ifdef SOURCE_LAYERS_CACHE_KEYCODE
+/** \brief read source keycode cache
+ *
+ * reads the keycode resolved when the key was pressed, without consulting the keymap
+ */
+bool read_source_keycode_cache(keypos_t key, uint16_t *keycode) {
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        *keycode = source_keycodes_cache[(uint16_t)(key.row * MATRIX_COLS) + key.col];
+    }
+#        ifdef ENCODER_MAP_ENABLE
+    else if (key.row == KEYLOC_ENCODER_CW || key.row == KEYLOC_ENCODER_CCW) {
+        *keycode = encoder_source_keycodes_cache[(key.col * 2) + (key.row == KEYLOC_ENCODER_CCW)];
+    }
+#        endif // ENCODER_MAP_ENABLE
+    else {
+        return false;
+    }
+    // KC_NO doubles as "never pressed", so the caller falls back to the layer cache for those keys
+    return *keycode != KC_NO;
+}
+#    endif // SOURCE_LAYERS_CACHE_KEYCODE
 #endif
 
 /** \brief Store or get action (FIXME: Needs better summary)
@@ -321,12 +385,20 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
         return layer_switch_get_action(key);
     }
 
-    uint8_t layer;
+    uint8_t layer = 0;
 
     if (pressed) {
         layer = layer_switch_get_layer(key);
         update_source_layers_cache(key, layer);
-    } else {
+    }
+#    ifdef SOURCE_LAYERS_CACHE_KEYCODE
+    // Resolved when the key was pressed, so a hit needs neither the layer nor the keymap
+    uint16_t keycode;
+    if (read_source_keycode_cache(key, &keycode)) {
+        return action_for_keycode(keycode);
+    }
+#    endif
+    if (!pressed) {
         layer = read_source_layers_cache(key);
     }
     return action_for_key(layer, key);
@@ -161,8 +161,31 @@ layer_state_t update_tri_layer_state(layer_state_t state, uint8_t layer1, uint8_
 /* pressed actions cache */
 #if !defined(NO_ACTION_LAYER) && !defined(STRICT_LAYER_RELEASE)
 
+/*
+ * Storage layout of the source layers cache:
+ *   SOURCE_LAYERS_CACHE_BITPLANE - MAX_LAYER_BITS bits per key, spread over bit planes (smallest, slowest)
+ *   SOURCE_LAYERS_CACHE_NIBBLE   - 4 bits per key, two keys to a byte (up to 16 layers)
+ *   SOURCE_LAYERS_CACHE_BYTE     - one byte per key
+ */
+#    if !defined(SOURCE_LAYERS_CACHE_BITPLANE) && !defined(SOURCE_LAYERS_CACHE_NIBBLE) && !defined(SOURCE_LAYERS_CACHE_BYTE)
+#        ifdef __AVR__
+#            define SOURCE_LAYERS_CACHE_BITPLANE
+#        else
+#            define SOURCE_LAYERS_CACHE_BYTE
+#        endif
+#    endif
+
+#    if defined(SOURCE_LAYERS_CACHE_NIBBLE) && MAX_LAYER_BITS > 4
+#        error SOURCE_LAYERS_CACHE_NIBBLE only supports up to 16 layers, use SOURCE_LAYERS_CACHE_BYTE instead.
+#    endif
+
 void    update_source_layers_cache(keypos_t key, uint8_t layer);
 uint8_t read_source_layers_cache(keypos_t key);
+
+#    ifdef SOURCE_LAYERS_CACHE_KEYCODE
+/* Returns false if the key has no usable cache entry, in which case the keycode must be resolved from the keymap. */
+bool read_source_keycode_cache(keypos_t key, uint16_t *keycode);
+#    endif
 #endif
 action_t store_or_get_action(bool pressed, keypos_t key);
 
@@ -283,6 +283,7 @@ static uint8_t get_mods_for_report(void) {
 }
 
 void send_6kro_report(void) {
+    generate_keyboard_report_keys(keyboard_report);
     keyboard_report->mods = get_mods_for_report();
 
 #ifdef PROTOCOL_VUSB
@@ -300,6 +301,7 @@ void send_6kro_report(void) {
 
 #ifdef NKRO_ENABLE
 void send_nkro_report(void) {
+    generate_nkro_report_bits(nkro_report);
     nkro_report->mods = get_mods_for_report();
 
     static report_nkro_t last_report;
@@ -0,0 +1,163 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "analog_matrix.h"
+
+#if ANALOG_MATRIX_MIN_RANGE < 32
+#    error ANALOG_MATRIX_MIN_RANGE must be at least 32 for the gain to fit 16 bits
+#endif
+
+// Fractional bits of the per-key gain
+#define GAIN_SHIFT 12
+
+/* Per-key state is kept as one array per field, so every field is scanned as a contiguous run of memory and the
+   evaluation below has no data dependent branches. */
+static int16_t rest[ANALOG_MATRIX_KEYS];
+static int16_t range[ANALOG_MATRIX_KEYS];
+static int16_t gain[ANALOG_MATRIX_KEYS];
+static uint8_t travel[ANALOG_MATRIX_KEYS];
+static uint8_t actuation_point[ANALOG_MATRIX_KEYS];
+static uint8_t release_point[ANALOG_MATRIX_KEYS];
+static uint8_t rapid_trigger_press[ANALOG_MATRIX_KEYS];
+static uint8_t rapid_trigger_release[ANALOG_MATRIX_KEYS];
+// Deepest travel since the key was pressed, or the shallowest since it was released
+static uint8_t extreme[ANALOG_MATRIX_KEYS];
+// Rapid trigger is in effect, from the first actuation until the key is let up past its release point
+static uint8_t armed[ANALOG_MATRIX_KEYS];
+static uint8_t pressed[ANALOG_MATRIX_KEYS];
+
+static void set_range(uint16_t key, int16_t new_range) {
+    if (new_range > -ANALOG_MATRIX_MIN_RANGE && new_range < ANALOG_MATRIX_MIN_RANGE) {
+        new_range = new_range < 0 ? -ANALOG_MATRIX_MIN_RANGE : ANALOG_MATRIX_MIN_RANGE;
+    }
+    range[key] = new_range;
+
+    // Rounded up, so a key pressed by exactly its range reads as fully travelled
+    int16_t magnitude = new_range < 0 ? -new_range : new_range;
+    int16_t scale     = (((int32_t)ANALOG_MATRIX_TRAVEL_MAX << GAIN_SHIFT) + magnitude - 1) / magnitude;
+    gain[key]         = new_range < 0 ? -scale : scale;
+}
+
+static void set_thresholds(uint16_t key, const analog_matrix_thresholds_t *thresholds) {
+    actuation_point[key]     = thresholds->actuation_point;
+    release_point[key]       = thresholds->release_point < thresholds->actuation_point ? thresholds->release_point : thresholds->actuation_point - 1;
+    rapid_trigger_press[key] = thresholds->rapid_trigger_press;
+    // Releasing needs some travel, or a key would be released again as soon as it was pressed
+    rapid_trigger_release[key] = thresholds->rapid_trigger_release ? thresholds->rapid_trigger_release : thresholds->rapid_trigger_press;
+}
+
+__attribute__((weak)) void analog_matrix_sensors_init(void) {}
+
+void analog_matrix_init(void) {
+    static const analog_matrix_thresholds_t defaults = {
+        .actuation_point       = ANALOG_MATRIX_ACTUATION_POINT,
+        .release_point         = ANALOG_MATRIX_RELEASE_POINT,
+        .rapid_trigger_press   = ANALOG_MATRIX_RAPID_TRIGGER_PRESS,
+        .rapid_trigger_release = ANALOG_MATRIX_RAPID_TRIGGER_RELEASE,
+    };
+
+    int16_t samples[ANALOG_MATRIX_KEYS];
+    int32_t sum[ANALOG_MATRIX_KEYS] = {0};
+
+    for (uint8_t scan = 0; scan < ANALOG_MATRIX_CALIBRATION_SCANS; scan++) {
+        analog_matrix_read_sensors(samples);
+        for (uint16_t key = 0; key < ANALOG_MATRIX_KEYS; key++) {
+            sum[key] += samples[key];
+        }
+    }
+
+    for (uint16_t key = 0; key < ANALOG_MATRIX_KEYS; key++) {
+        rest[key] = sum[key] / ANALOG_MATRIX_CALIBRATION_SCANS;
+        set_range(key, ANALOG_MATRIX_INITIAL_RANGE);
+        set_thresholds(key, &defaults);
+        travel[key]  = 0;
+        extreme[key] = 0;
+        armed[key]   = 0;
+        pressed[key] = 0;
+    }
+}
+
+bool analog_matrix_process(const int16_t samples[], matrix_row_t current_matrix[]) {
+    uint8_t  changed = 0;
+    uint16_t key     = 0;
+
+    for (uint8_t row = 0; row < ANALOG_MATRIX_ROWS; row++) {
+        matrix_row_t row_data = 0;
+
+        for (uint8_t col = 0; col < MATRIX_COLS; col++, key++) {
+            int32_t raw = ((int32_t)(samples[key] - rest[key]) * gain[key]) >> GAIN_SHIFT;
+            // Rarely taken, the key travelled further than it has been calibrated to
+            if (raw > ANALOG_MATRIX_TRAVEL_MAX) {
+                set_range(key, samples[key] - rest[key]);
+                raw = ANALOG_MATRIX_TRAVEL_MAX;
+            }
+            uint8_t t = raw < 0 ? 0 : raw;
+
+            uint8_t was_pressed = pressed[key];
+            uint8_t was_armed   = armed[key];
+            uint8_t ext         = extreme[key];
+            uint8_t rapid       = rapid_trigger_press[key] != 0;
+
+            // Once armed, only rapid trigger presses the key again, the actuation point no longer applies
+            uint8_t press   = (was_armed & (t >= ext + rapid_trigger_press[key])) | ((was_armed ^ 1) & (t >= actuation_point[key]));
+            uint8_t release = (t < release_point[key]) | (rapid & (t + rapid_trigger_release[key] <= ext));
+            uint8_t now     = (was_pressed & (release ^ 1)) | ((was_pressed ^ 1) & press);
+
+            uint8_t deeper    = t > ext ? t : ext;
+            uint8_t shallower = t < ext ? t : ext;
+            uint8_t tracked   = now ? deeper : shallower;
+
+            travel[key]  = t;
+            pressed[key] = now;
+            armed[key]   = rapid & (was_armed | now) & (t >= release_point[key]);
+            extreme[key] = (now ^ was_pressed) ? t : tracked;
+
+            changed |= now ^ was_pressed;
+            row_data |= (matrix_row_t)now << col;
+        }
+
+        current_matrix[row] = row_data;
+    }
+
+    return changed;
+}
+
+uint8_t analog_matrix_get_travel(uint8_t row, uint8_t col) {
+    return travel[row * MATRIX_COLS + col];
+}
+
+void analog_matrix_get_calibration(uint8_t row, uint8_t col, analog_matrix_calibration_t *calibration) {
+    uint16_t key       = row * MATRIX_COLS + col;
+    calibration->rest  = rest[key];
+    calibration->range = range[key];
+}
+
+void analog_matrix_set_calibration(uint8_t row, uint8_t col, const analog_matrix_calibration_t *calibration) {
+    uint16_t key = row * MATRIX_COLS + col;
+    rest[key]    = calibration->rest;
+    set_range(key, calibration->range);
+}
+
+void analog_matrix_get_thresholds(uint8_t row, uint8_t col, analog_matrix_thresholds_t *thresholds) {
+    uint16_t key                      = row * MATRIX_COLS + col;
+    thresholds->actuation_point       = actuation_point[key];
+    thresholds->release_point         = release_point[key];
+    thresholds->rapid_trigger_press   = rapid_trigger_press[key];
+    thresholds->rapid_trigger_release = rapid_trigger_release[key];
+}
+
+void analog_matrix_set_thresholds(uint8_t row, uint8_t col, const analog_matrix_thresholds_t *thresholds) {
+    set_thresholds(row * MATRIX_COLS + col, thresholds);
+}
+
+void matrix_init_custom(void) {
+    analog_matrix_sensors_init();
+    analog_matrix_init();
+}
+
+bool matrix_scan_custom(matrix_row_t current_matrix[]) {
+    static int16_t samples[ANALOG_MATRIX_KEYS];
+
+    analog_matrix_read_sensors(samples);
+    return analog_matrix_process(samples, current_matrix);
+}
@@ -0,0 +1,116 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "matrix.h"
+
+#ifdef SPLIT_KEYBOARD
+#    define ANALOG_MATRIX_ROWS (MATRIX_ROWS / 2)
+#else
+#    define ANALOG_MATRIX_ROWS (MATRIX_ROWS)
+#endif
+
+/* Number of sensors on this half, sample arrays are indexed by `row * MATRIX_COLS + col` */
+#define ANALOG_MATRIX_KEYS (ANALOG_MATRIX_ROWS * MATRIX_COLS)
+
+/* Key travel is normalised to 0 (rest) ... ANALOG_MATRIX_TRAVEL_MAX (bottomed out) */
+#define ANALOG_MATRIX_TRAVEL_MAX 255
+
+#ifndef ANALOG_MATRIX_CALIBRATION_SCANS
+#    define ANALOG_MATRIX_CALIBRATION_SCANS 16
+#endif
+
+/* Expected change of the raw reading from rest to bottom out, negative for sensors whose reading falls as the key is
+   pressed. Keys that travel further widen their own range as they are used. */
+#ifndef ANALOG_MATRIX_INITIAL_RANGE
+#    define ANALOG_MATRIX_INITIAL_RANGE 300
+#endif
+
+/* Smallest range a key is calibrated to, so noise on an unused key can never reach the actuation point */
+#ifndef ANALOG_MATRIX_MIN_RANGE
+#    define ANALOG_MATRIX_MIN_RANGE 32
+#endif
+
+#ifndef ANALOG_MATRIX_ACTUATION_POINT
+#    define ANALOG_MATRIX_ACTUATION_POINT 128
+#endif
+
+#ifndef ANALOG_MATRIX_RELEASE_POINT
+#    define ANALOG_MATRIX_RELEASE_POINT (ANALOG_MATRIX_ACTUATION_POINT - 16)
+#endif
+
+/* Travel that presses or releases a key while rapid trigger is active, 0 disables rapid trigger */
+#ifndef ANALOG_MATRIX_RAPID_TRIGGER_PRESS
+#    define ANALOG_MATRIX_RAPID_TRIGGER_PRESS 0
+#endif
+
+#ifndef ANALOG_MATRIX_RAPID_TRIGGER_RELEASE
+#    define ANALOG_MATRIX_RAPID_TRIGGER_RELEASE ANALOG_MATRIX_RAPID_TRIGGER_PRESS
+#endif
+
+#if ANALOG_MATRIX_RELEASE_POINT >= ANALOG_MATRIX_ACTUATION_POINT
+#    error ANALOG_MATRIX_RELEASE_POINT must be below ANALOG_MATRIX_ACTUATION_POINT
+#endif
+
+typedef struct {
+    int16_t rest;  // raw reading of the released key
+    int16_t range; // change of the raw reading from rest to bottom out
+} analog_matrix_calibration_t;
+
+typedef struct {
+    uint8_t actuation_point;       // travel that presses the key
+    uint8_t release_point;         // travel below which the key is released
+    uint8_t rapid_trigger_press;   // travel back down after a partial release that presses the key again, 0 to disable
+    uint8_t rapid_trigger_release; // travel up from the deepest point that releases the key, 0 to disable
+} analog_matrix_thresholds_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Calibrates the rest position of every key and resets all thresholds to their configured defaults.
+ *
+ * All keys must be released while this runs.
+ */
+void analog_matrix_init(void);
+
+/**
+ * @brief Evaluates one set of samples.
+ *
+ * @param samples raw reading of every sensor, `ANALOG_MATRIX_KEYS` entries
+ * @param current_matrix rows to write the pressed keys to, `ANALOG_MATRIX_ROWS` entries
+ * @return true if any key changed state
+ */
+bool analog_matrix_process(const int16_t samples[], matrix_row_t current_matrix[]);
+
+/**
+ * @brief Sets up the sensors before the rest position is calibrated.
+ */
+void analog_matrix_sensors_init(void);
+
+/**
+ * @brief Reads every sensor of this half. Implemented by the selected `ANALOG_MATRIX_DRIVER`, or by the keyboard with
+ * `ANALOG_MATRIX_DRIVER = custom`.
+ *
+ * @param samples buffer of `ANALOG_MATRIX_KEYS` entries
+ */
+void analog_matrix_read_sensors(int16_t samples[]);
+
+/**
+ * @brief Current travel of a key, 0 ... `ANALOG_MATRIX_TRAVEL_MAX`.
+ */
+uint8_t analog_matrix_get_travel(uint8_t row, uint8_t col);
+
+void analog_matrix_get_calibration(uint8_t row, uint8_t col, analog_matrix_calibration_t *calibration);
+void analog_matrix_set_calibration(uint8_t row, uint8_t col, const analog_matrix_calibration_t *calibration);
+
+void analog_matrix_get_thresholds(uint8_t row, uint8_t col, analog_matrix_thresholds_t *thresholds);
+void analog_matrix_set_thresholds(uint8_t row, uint8_t col, const analog_matrix_thresholds_t *thresholds);
+
+#ifdef __cplusplus
+}
+#endif
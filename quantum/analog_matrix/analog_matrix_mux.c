@@ -0,0 +1,83 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/* Reads a matrix of analog sensors through one multiplexer per row. All multiplexers share the select lines, which pick
+   the column, and every row is read by its own ADC input in a single multi-channel sweep per column. */
+
+#include "analog_matrix.h"
+#include "analog.h"
+#include "gpio.h"
+#include "wait.h"
+
+#ifdef SPLIT_KEYBOARD
+#    include "split_common/split_util.h"
+#endif
+
+#ifndef ANALOG_MATRIX_MUX_SELECT_PINS
+#    error ANALOG_MATRIX_MUX_SELECT_PINS must be defined
+#endif
+
+#ifndef ANALOG_MATRIX_ADC_PINS
+#    error ANALOG_MATRIX_ADC_PINS must be defined
+#endif
+
+// Time for the multiplexer outputs to settle after switching channels
+#ifndef ANALOG_MATRIX_MUX_SETTLE_US
+#    define ANALOG_MATRIX_MUX_SETTLE_US 5
+#endif
+
+static const pin_t select_pins[] = ANALOG_MATRIX_MUX_SELECT_PINS;
+#define SELECT_PIN_COUNT (sizeof(select_pins) / sizeof(select_pins[0]))
+
+#ifdef ANALOG_MATRIX_ADC_PINS_RIGHT
+static pin_t adc_pins[ANALOG_MATRIX_ROWS] = ANALOG_MATRIX_ADC_PINS;
+#else
+static const pin_t adc_pins[ANALOG_MATRIX_ROWS] = ANALOG_MATRIX_ADC_PINS;
+#endif
+
+// Multiplexer channel of each column, for boards that do not route them in order
+#ifdef ANALOG_MATRIX_MUX_CHANNELS
+static const uint8_t mux_channels[MATRIX_COLS] = ANALOG_MATRIX_MUX_CHANNELS;
+#    define MUX_CHANNEL(col) mux_channels[col]
+#else
+#    define MUX_CHANNEL(col) (col)
+#endif
+
+static void select_channel(uint8_t channel) {
+    for (uint8_t i = 0; i < SELECT_PIN_COUNT; i++) {
+        gpio_write_pin(select_pins[i], (channel >> i) & 1);
+    }
+}
+
+void analog_matrix_sensors_init(void) {
+#if defined(SPLIT_KEYBOARD) && defined(ANALOG_MATRIX_ADC_PINS_RIGHT)
+    if (!isLeftHand) {
+        const pin_t adc_pins_right[ANALOG_MATRIX_ROWS] = ANALOG_MATRIX_ADC_PINS_RIGHT;
+        for (uint8_t i = 0; i < ANALOG_MATRIX_ROWS; i++) {
+            adc_pins[i] = adc_pins_right[i];
+        }
+    }
+#endif
+
+    for (uint8_t i = 0; i < SELECT_PIN_COUNT; i++) {
+        gpio_set_pin_output(select_pins[i]);
+    }
+    select_channel(MUX_CHANNEL(0));
+}
+
+void analog_matrix_read_sensors(int16_t samples[]) {
+    int16_t sweep[ANALOG_MATRIX_ROWS];
+
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        select_channel(MUX_CHANNEL(col));
+        wait_us(ANALOG_MATRIX_MUX_SETTLE_US);
+
+        // On failure the previous readings of this column are kept
+        if (!analogReadPins(adc_pins, ANALOG_MATRIX_ROWS, sweep)) {
+            continue;
+        }
+        for (uint8_t row = 0; row < ANALOG_MATRIX_ROWS; row++) {
+            samples[row * MATRIX_COLS + col] = sweep[row];
+        }
+    }
+}
@@ -0,0 +1,234 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "analog_matrix.h"
+
+bool matrix_scan_custom(matrix_row_t current_matrix[]);
+}
+
+namespace {
+
+constexpr int16_t REST  = 500;
+constexpr int16_t RANGE = ANALOG_MATRIX_INITIAL_RANGE;
+
+int16_t      samples[ANALOG_MATRIX_KEYS];
+int16_t      noise = 0;
+matrix_row_t rows[ANALOG_MATRIX_ROWS];
+
+/* Reading of a key that has travelled at least this far */
+int16_t reading(uint8_t travel) {
+    return REST + (travel * RANGE + ANALOG_MATRIX_TRAVEL_MAX - 1) / ANALOG_MATRIX_TRAVEL_MAX;
+}
+
+bool is_pressed(uint8_t row, uint8_t col) {
+    return rows[row] & (MATRIX_ROW_SHIFTER << col);
+}
+
+bool scan(int16_t key_sample, uint8_t row = 0, uint8_t col = 0) {
+    samples[row * MATRIX_COLS + col] = key_sample;
+    return analog_matrix_process(samples, rows);
+}
+
+/* Feeds a trace to one key, returning the index of every sample that changed its state */
+std::vector<size_t> play(const std::vector<int16_t> &trace, uint8_t row = 0, uint8_t col = 0) {
+    std::vector<size_t> changes;
+    for (size_t i = 0; i < trace.size(); i++) {
+        if (scan(trace[i], row, col)) {
+            changes.push_back(i);
+        }
+    }
+    return changes;
+}
+
+void enable_rapid_trigger(uint8_t row, uint8_t col, uint8_t sensitivity) {
+    analog_matrix_thresholds_t thresholds;
+    analog_matrix_get_thresholds(row, col, &thresholds);
+    thresholds.rapid_trigger_press   = sensitivity;
+    thresholds.rapid_trigger_release = sensitivity;
+    analog_matrix_set_thresholds(row, col, &thresholds);
+}
+
+} // namespace
+
+extern "C" void analog_matrix_read_sensors(int16_t out[]) {
+    static bool high = false;
+
+    high = !high;
+    for (uint16_t i = 0; i < ANALOG_MATRIX_KEYS; i++) {
+        out[i] = samples[i] + (high ? noise : -noise);
+    }
+}
+
+class AnalogMatrix : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        for (uint16_t i = 0; i < ANALOG_MATRIX_KEYS; i++) {
+            samples[i] = REST;
+        }
+        noise = 5;
+        analog_matrix_init();
+        noise = 0;
+    }
+};
+
+TEST_F(AnalogMatrix, RestCalibratedFromAverage) {
+    analog_matrix_calibration_t calibration;
+    analog_matrix_get_calibration(1, 2, &calibration);
+    EXPECT_EQ(calibration.rest, REST);
+    EXPECT_EQ(calibration.range, RANGE);
+
+    EXPECT_FALSE(scan(REST));
+    EXPECT_EQ(rows[0], 0);
+}
+
+TEST_F(AnalogMatrix, TravelScaledToRange) {
+    scan(REST + RANGE);
+    EXPECT_EQ(analog_matrix_get_travel(0, 0), ANALOG_MATRIX_TRAVEL_MAX);
+    scan(REST + RANGE / 2);
+    EXPECT_NEAR(analog_matrix_get_travel(0, 0), ANALOG_MATRIX_TRAVEL_MAX / 2, 1);
+    scan(REST - 50);
+    EXPECT_EQ(analog_matrix_get_travel(0, 0), 0);
+}
+
+TEST_F(AnalogMatrix, PressedOnScanThatCrossesActuationPoint) {
+    // A key pressed over 10 scans, the press must be reported on the first sample past the actuation point
+    std::vector<int16_t> trace;
+    size_t               crossing = 0;
+    for (int i = 0; i <= 10; i++) {
+        int16_t sample = REST + RANGE * i / 10;
+        if (!crossing && sample >= reading(ANALOG_MATRIX_ACTUATION_POINT)) {
+            crossing = i;
+        }
+        trace.push_back(sample);
+    }
+
+    EXPECT_EQ(play(trace), std::vector<size_t>({crossing}));
+    EXPECT_TRUE(is_pressed(0, 0));
+}
+
+TEST_F(AnalogMatrix, ReleasedOnScanBelowReleasePoint) {
+    scan(REST + RANGE);
+    EXPECT_FALSE(scan(reading(ANALOG_MATRIX_RELEASE_POINT)));
+    EXPECT_TRUE(is_pressed(0, 0));
+    EXPECT_TRUE(scan(reading(ANALOG_MATRIX_RELEASE_POINT) - 1));
+    EXPECT_FALSE(is_pressed(0, 0));
+}
+
+TEST_F(AnalogMatrix, NoChatterAroundActuationPoint) {
+    // Sensor noise on a key held right at the actuation point
+    int16_t              actuation = reading(ANALOG_MATRIX_ACTUATION_POINT);
+    std::vector<int16_t> trace;
+    for (int i = 0; i < 40; i++) {
+        trace.push_back(actuation + (i % 3) * 3 - 3);
+    }
+
+    EXPECT_EQ(play(trace).size(), 1);
+    EXPECT_TRUE(is_pressed(0, 0));
+}
+
+TEST_F(AnalogMatrix, RapidTriggerReleasesOnUpstroke) {
+    enable_rapid_trigger(0, 0, 20);
+
+    EXPECT_TRUE(scan(reading(200)));
+    EXPECT_FALSE(scan(reading(240)));
+    // Still far above the release point, but 20 up from the deepest point
+    EXPECT_FALSE(scan(reading(221)));
+    EXPECT_TRUE(scan(reading(220)));
+    EXPECT_FALSE(is_pressed(0, 0));
+}
+
+TEST_F(AnalogMatrix, RapidTriggerPressesOnDownstroke) {
+    enable_rapid_trigger(0, 0, 20);
+
+    scan(reading(240));
+    scan(reading(180));
+    EXPECT_FALSE(is_pressed(0, 0));
+    // Lifting further moves the point a new press is measured from
+    EXPECT_FALSE(scan(reading(150)));
+    EXPECT_FALSE(scan(reading(169)));
+    EXPECT_TRUE(scan(reading(170)));
+    EXPECT_TRUE(is_pressed(0, 0));
+}
+
+TEST_F(AnalogMatrix, RapidTriggerBelowActuationPoint) {
+    enable_rapid_trigger(0, 0, 20);
+
+    // Once armed, rapid trigger works all the way down to the release point
+    std::vector<int16_t> trace = {reading(200), reading(115), reading(140), reading(118)};
+    EXPECT_EQ(play(trace), std::vector<size_t>({0, 1, 2, 3}));
+}
+
+TEST_F(AnalogMatrix, RapidTriggerDisarmedPastReleasePoint) {
+    enable_rapid_trigger(0, 0, 20);
+
+    scan(reading(200));
+    EXPECT_TRUE(scan(reading(ANALOG_MATRIX_RELEASE_POINT - 30)));
+    // Moving down by more than the sensitivity is not enough, the actuation point applies again
+    EXPECT_FALSE(scan(reading(ANALOG_MATRIX_ACTUATION_POINT - 1)));
+    EXPECT_TRUE(scan(reading(ANALOG_MATRIX_ACTUATION_POINT)));
+}
+
+TEST_F(AnalogMatrix, InvertedSensor) {
+    analog_matrix_calibration_t calibration = {.rest = 3000, .range = -RANGE};
+    analog_matrix_set_calibration(0, 0, &calibration);
+
+    EXPECT_FALSE(scan(3000));
+    EXPECT_FALSE(scan(3000 + 100));
+    EXPECT_EQ(analog_matrix_get_travel(0, 0), 0);
+    EXPECT_TRUE(scan(3000 - RANGE));
+    EXPECT_EQ(analog_matrix_get_travel(0, 0), ANALOG_MATRIX_TRAVEL_MAX);
+}
+
+TEST_F(AnalogMatrix, RangeExtendsWithFurtherTravel) {
+    scan(REST + RANGE + 100);
+    EXPECT_EQ(analog_matrix_get_travel(0, 0), ANALOG_MATRIX_TRAVEL_MAX);
+
+    analog_matrix_calibration_t calibration;
+    analog_matrix_get_calibration(0, 0, &calibration);
+    EXPECT_EQ(calibration.range, RANGE + 100);
+
+    scan(REST + (RANGE + 100) / 2);
+    EXPECT_NEAR(analog_matrix_get_travel(0, 0), ANALOG_MATRIX_TRAVEL_MAX / 2, 1);
+}
+
+TEST_F(AnalogMatrix, MinimumRange) {
+    analog_matrix_calibration_t calibration = {.rest = REST, .range = 4};
+    analog_matrix_set_calibration(0, 0, &calibration);
+    analog_matrix_get_calibration(0, 0, &calibration);
+    EXPECT_EQ(calibration.range, ANALOG_MATRIX_MIN_RANGE);
+
+    // Noise on an unused key stays far from the actuation point
+    scan(REST + 4);
+    EXPECT_LT(analog_matrix_get_travel(0, 0), ANALOG_MATRIX_RELEASE_POINT);
+}
+
+TEST_F(AnalogMatrix, PerKeyThresholds) {
+    analog_matrix_thresholds_t thresholds = {.actuation_point = 40, .release_point = 30};
+    analog_matrix_set_thresholds(1, 2, &thresholds);
+
+    EXPECT_TRUE(scan(reading(40), 1, 2));
+    EXPECT_FALSE(scan(reading(40), 0, 0));
+    EXPECT_TRUE(is_pressed(1, 2));
+    EXPECT_FALSE(is_pressed(0, 0));
+}
+
+TEST_F(AnalogMatrix, KeysMappedToRowsAndColumns) {
+    samples[0 * MATRIX_COLS + 1] = REST + RANGE;
+    samples[1 * MATRIX_COLS + 2] = REST + RANGE;
+    EXPECT_TRUE(analog_matrix_process(samples, rows));
+    EXPECT_EQ(rows[0], MATRIX_ROW_SHIFTER << 1);
+    EXPECT_EQ(rows[1], MATRIX_ROW_SHIFTER << 2);
+
+    EXPECT_FALSE(analog_matrix_process(samples, rows));
+}
+
+TEST_F(AnalogMatrix, ScannedThroughCustomMatrix) {
+    samples[1] = REST + RANGE;
+    EXPECT_TRUE(matrix_scan_custom(rows));
+    EXPECT_EQ(rows[0], MATRIX_ROW_SHIFTER << 1);
+}
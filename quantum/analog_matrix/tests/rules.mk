@@ -0,0 +1,8 @@
+analog_matrix_DEFS := -DMATRIX_ROWS=2 -DMATRIX_COLS=3
+
+analog_matrix_SRC := \
+	$(QUANTUM_PATH)/analog_matrix/tests/analog_matrix_tests.cpp \
+	$(QUANTUM_PATH)/analog_matrix/analog_matrix.c
+
+analog_matrix_INC := \
+	$(QUANTUM_PATH)/analog_matrix
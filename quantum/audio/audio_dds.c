@@ -0,0 +1,59 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "audio_dds.h"
+
+void audio_dds_init(audio_dds_bank_t *bank, audio_dds_oscillator_t *oscillators, const uint16_t *wavetable, uint8_t wavetable_bits) {
+    bank->oscillators    = oscillators;
+    bank->wavetable      = wavetable;
+    bank->wavetable_bits = wavetable_bits;
+    bank->count          = 0;
+    bank->gain           = 0;
+}
+
+uint32_t audio_dds_phase_increment(float frequency, uint32_t sample_rate) {
+    if (frequency <= 0.0f || frequency * 2.0f >= (float)sample_rate) {
+        // Pauses, and anything which can't be represented without aliasing
+        return 0;
+    }
+
+    // Scaling by a power of two is exact, which leaves the division as the only rounding step
+    uint64_t frequency_q24 = (uint64_t)(frequency * 16777216.0f);
+    return (uint32_t)(((frequency_q24 << 8) + sample_rate / 2) / sample_rate);
+}
+
+void audio_dds_set_tones(audio_dds_bank_t *bank, const float *frequencies, uint8_t count, uint32_t sample_rate) {
+    for (uint8_t i = 0; i < count; i++) {
+        bank->oscillators[i].increment = audio_dds_phase_increment(frequencies[i], sample_rate);
+    }
+    bank->count = count;
+    bank->gain  = count ? (UINT32_C(1) << 16) / count : 0;
+}
+
+void audio_dds_reset(audio_dds_bank_t *bank, uint8_t capacity) {
+    for (uint8_t i = 0; i < capacity; i++) {
+        bank->oscillators[i] = (audio_dds_oscillator_t){0};
+    }
+    bank->count = 0;
+    bank->gain  = 0;
+}
+
+uint16_t audio_dds_next_sample(audio_dds_bank_t *bank) {
+    const uint8_t shift = 32 - bank->wavetable_bits;
+    uint32_t      sum   = 0;
+
+    for (uint8_t i = 0; i < bank->count; i++) {
+        audio_dds_oscillator_t *oscillator = &bank->oscillators[i];
+        oscillator->phase += oscillator->increment;
+        sum += bank->wavetable[oscillator->phase >> shift];
+    }
+
+    // Dividing once by the number of tones, rather than every tone's value, keeps the division out of the loop
+    return (uint16_t)((sum * bank->gain) >> 16);
+}
+
+void audio_dds_render(audio_dds_bank_t *bank, uint16_t *samples, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        samples[i] = audio_dds_next_sample(bank);
+    }
+}
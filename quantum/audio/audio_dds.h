@@ -0,0 +1,85 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+  Direct digital synthesis: a bank of fixed-point phase accumulators, each stepping through a shared wavetable at
+  the rate of one tone.
+
+  The phase of each oscillator spans one full waveform cycle over the whole uint32_t range, so it wraps around by
+  itself and the wavetable index is just its top bits. Phase increments are only calculated when the tones change,
+  which leaves an addition, a table lookup and a multiply per tone and sample.
+*/
+
+typedef struct {
+    uint32_t phase;
+    uint32_t increment;
+} audio_dds_oscillator_t;
+
+typedef struct {
+    audio_dds_oscillator_t *oscillators;
+    const uint16_t         *wavetable;
+    uint8_t                 wavetable_bits; // log2 of the wavetable length
+    uint8_t                 count;          // number of oscillators currently playing
+    uint32_t                gain;           // 1/count in Q16, so that the mixed output stays within the wavetable range
+} audio_dds_bank_t;
+
+/**
+ * @brief Sets up a bank of oscillators, with none playing
+ *
+ * @param[in] bank the bank to set up
+ * @param[in] oscillators storage for as many oscillators as will ever play at once
+ * @param[in] wavetable one full waveform cycle
+ * @param[in] wavetable_bits log2 of the wavetable length, which has to be a power of two
+ */
+void audio_dds_init(audio_dds_bank_t *bank, audio_dds_oscillator_t *oscillators, const uint16_t *wavetable, uint8_t wavetable_bits);
+
+/**
+ * @brief Converts a frequency to the phase increment per sample
+ *
+ * @param[in] frequency in Hz, below half the sample rate
+ * @param[in] sample_rate in Hz
+ * @return phase increment, where 2^32 is a full cycle
+ */
+uint32_t audio_dds_phase_increment(float frequency, uint32_t sample_rate);
+
+/**
+ * @brief Changes the tones being played
+ *
+ * Oscillators carry on from their current phase, so that tones which keep playing don't click.
+ *
+ * @param[in] bank the bank to update
+ * @param[in] frequencies in Hz, one per oscillator
+ * @param[in] count number of tones, no more than the bank was set up with
+ * @param[in] sample_rate in Hz
+ */
+void audio_dds_set_tones(audio_dds_bank_t *bank, const float *frequencies, uint8_t count, uint32_t sample_rate);
+
+/**
+ * @brief Stops all tones, and returns every oscillator to the start of the waveform
+ *
+ * @param[in] bank the bank to reset
+ * @param[in] capacity number of oscillators the bank was set up with
+ */
+void audio_dds_reset(audio_dds_bank_t *bank, uint8_t capacity);
+
+/**
+ * @brief Mixes the next sample of every playing tone
+ *
+ * @param[in] bank the bank to advance
+ * @return the average of all oscillators' wavetable values, or 0 if nothing is playing
+ */
+uint16_t audio_dds_next_sample(audio_dds_bank_t *bank);
+
+/**
+ * @brief Mixes a block of samples
+ *
+ * @param[in] bank the bank to advance
+ * @param[out] samples buffer to fill
+ * @param[in] length number of samples to render
+ */
+void audio_dds_render(audio_dds_bank_t *bank, uint16_t *samples, size_t length);
@@ -25,6 +25,15 @@
 #    define TIMESTAMP_GETTER TCNT0
 #elif defined(PROTOCOL_CHIBIOS)
 #    define TIMESTAMP_GETTER chSysGetRealtimeCounterX()
+#elif defined(PROTOCOL_LINUX)
+#    include <stdint.h>
+#    include <time.h>
+static inline uint32_t basic_profiling_timestamp_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+#    define TIMESTAMP_GETTER basic_profiling_timestamp_ns()
 #else
 #    error Unknown protocol in use
 #endif
@@ -0,0 +1,262 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stddef.h>
+#include "bus_queue.h"
+
+#ifdef BUS_QUEUE_I2C
+#    include "i2c_master.h"
+#endif
+#ifdef BUS_QUEUE_SPI
+#    include "spi_master.h"
+#endif
+
+#if defined(PROTOCOL_CHIBIOS)
+#    include <ch.h>
+
+static MUTEX_DECL(bus_queue_mutex);
+
+static inline void bus_queue_lock(void) {
+    chMtxLock(&bus_queue_mutex);
+}
+
+static inline void bus_queue_unlock(void) {
+    chMtxUnlock(&bus_queue_mutex);
+}
+#else
+static inline void bus_queue_lock(void) {}
+static inline void bus_queue_unlock(void) {}
+#endif
+
+/* every transaction waiting for the bus or its callback, in the order they were submitted */
+static bus_transaction_t *head = NULL;
+static bus_transaction_t *tail = NULL;
+/* first transaction in the list which has not been handed to the driver yet */
+static bus_transaction_t *next = NULL;
+
+bool bus_queue_submit(bus_transaction_t *transaction) {
+    bus_queue_lock();
+    if (transaction->state != BUS_TRANSACTION_IDLE) {
+        bus_queue_unlock();
+        return false;
+    }
+
+    transaction->state    = BUS_TRANSACTION_QUEUED;
+    transaction->attempts = 0;
+    transaction->next     = NULL;
+    if (tail) {
+        tail->next = transaction;
+    } else {
+        head = transaction;
+    }
+    tail = transaction;
+    if (!next) {
+        next = transaction;
+    }
+    bus_queue_unlock();
+
+    bus_queue_driver_kick();
+    return true;
+}
+
+bus_transaction_t *bus_queue_next(void) {
+    bus_queue_lock();
+    bus_transaction_t *transaction = next;
+    if (transaction) {
+        transaction->state = BUS_TRANSACTION_RUNNING;
+        next               = transaction->next;
+    }
+    bus_queue_unlock();
+    return transaction;
+}
+
+void bus_queue_complete(bus_transaction_t *transaction, int16_t status) {
+    bus_queue_lock();
+    // I2C_STATUS_SUCCESS and SPI_STATUS_SUCCESS are both 0
+    if (status != 0 && ++transaction->attempts < transaction->persistence) {
+        // Attempted again before anything queued after it, as the blocking API would
+        transaction->state = BUS_TRANSACTION_QUEUED;
+        next               = transaction;
+        bus_queue_unlock();
+        return;
+    }
+    transaction->status = status;
+    transaction->state  = BUS_TRANSACTION_DONE;
+    bus_queue_unlock();
+}
+
+void bus_queue_task(void) {
+    while (true) {
+        bus_queue_lock();
+        bus_transaction_t *transaction = head;
+        if (!transaction || transaction->state != BUS_TRANSACTION_DONE) {
+            bus_queue_unlock();
+            return;
+        }
+        head = transaction->next;
+        if (!head) {
+            tail = NULL;
+        }
+        // Released before the callback, which may submit it again
+        transaction->state = BUS_TRANSACTION_IDLE;
+        bus_queue_unlock();
+
+        if (transaction->callback) {
+            transaction->callback(transaction);
+        }
+    }
+}
+
+void bus_queue_flush(void) {
+    while (bus_queue_busy()) {
+        bus_queue_driver_wait();
+        bus_queue_task();
+    }
+}
+
+bool bus_queue_busy(void) {
+    return head != NULL;
+}
+
+int16_t bus_transaction_execute(bus_transaction_t *transaction) {
+    switch (transaction->operation) {
+#ifdef BUS_QUEUE_I2C
+        case BUS_I2C_TRANSMIT:
+            return i2c_transmit(transaction->address, transaction->tx, transaction->length, transaction->timeout);
+        case BUS_I2C_RECEIVE:
+            return i2c_receive(transaction->address, transaction->rx, transaction->length, transaction->timeout);
+        case BUS_I2C_WRITE_REGISTER:
+            return i2c_write_register(transaction->address, transaction->reg, transaction->tx, transaction->length, transaction->timeout);
+        case BUS_I2C_READ_REGISTER:
+            return i2c_read_register(transaction->address, transaction->reg, transaction->rx, transaction->length, transaction->timeout);
+#endif
+#ifdef BUS_QUEUE_SPI
+        case BUS_SPI_TRANSMIT:
+        case BUS_SPI_RECEIVE: {
+            if (!spi_start(transaction->slave_pin, transaction->lsb_first, transaction->mode, transaction->divisor)) {
+                return SPI_STATUS_ERROR;
+            }
+            spi_status_t status = transaction->operation == BUS_SPI_TRANSMIT ? spi_transmit(transaction->tx, transaction->length) : spi_receive(transaction->rx, transaction->length);
+            spi_stop();
+            return status;
+        }
+#endif
+        default:
+            return -1;
+    }
+}
+
+#ifdef BUS_QUEUE_I2C
+bool bus_queue_i2c_transmit(bus_transaction_t *transaction, uint8_t address, const uint8_t *data, uint16_t length, uint16_t timeout) {
+    transaction->operation = BUS_I2C_TRANSMIT;
+    transaction->address   = address;
+    transaction->tx        = data;
+    transaction->length    = length;
+    transaction->timeout   = timeout;
+    return bus_queue_submit(transaction);
+}
+
+bool bus_queue_i2c_receive(bus_transaction_t *transaction, uint8_t address, uint8_t *data, uint16_t length, uint16_t timeout) {
+    transaction->operation = BUS_I2C_RECEIVE;
+    transaction->address   = address;
+    transaction->rx        = data;
+    transaction->length    = length;
+    transaction->timeout   = timeout;
+    return bus_queue_submit(transaction);
+}
+
+bool bus_queue_i2c_write_register(bus_transaction_t *transaction, uint8_t devaddr, uint8_t regaddr, const uint8_t *data, uint16_t length, uint16_t timeout) {
+    transaction->operation = BUS_I2C_WRITE_REGISTER;
+    transaction->address   = devaddr;
+    transaction->reg       = regaddr;
+    transaction->tx        = data;
+    transaction->length    = length;
+    transaction->timeout   = timeout;
+    return bus_queue_submit(transaction);
+}
+
+bool bus_queue_i2c_read_register(bus_transaction_t *transaction, uint8_t devaddr, uint8_t regaddr, uint8_t *data, uint16_t length, uint16_t timeout) {
+    transaction->operation = BUS_I2C_READ_REGISTER;
+    transaction->address   = devaddr;
+    transaction->reg       = regaddr;
+    transaction->rx        = data;
+    transaction->length    = length;
+    transaction->timeout   = timeout;
+    return bus_queue_submit(transaction);
+}
+#endif
+
+#ifdef BUS_QUEUE_SPI
+bool bus_queue_spi_transmit(bus_transaction_t *transaction, pin_t slave_pin, bool lsb_first, uint8_t mode, uint16_t divisor, const uint8_t *data, uint16_t length) {
+    transaction->operation = BUS_SPI_TRANSMIT;
+    transaction->slave_pin = slave_pin;
+    transaction->lsb_first = lsb_first;
+    transaction->mode      = mode;
+    transaction->divisor   = divisor;
+    transaction->tx        = data;
+    transaction->length    = length;
+    return bus_queue_submit(transaction);
+}
+
+bool bus_queue_spi_receive(bus_transaction_t *transaction, pin_t slave_pin, bool lsb_first, uint8_t mode, uint16_t divisor, uint8_t *data, uint16_t length) {
+    transaction->operation = BUS_SPI_RECEIVE;
+    transaction->slave_pin = slave_pin;
+    transaction->lsb_first = lsb_first;
+    transaction->mode      = mode;
+    transaction->divisor   = divisor;
+    transaction->rx        = data;
+    transaction->length    = length;
+    return bus_queue_submit(transaction);
+}
+#endif
+
+#if defined(PROTOCOL_CHIBIOS)
+static BSEMAPHORE_DECL(bus_queue_wakeup, true);
+static THD_WORKING_AREA(bus_queue_wa, BUS_QUEUE_THREAD_STACK_SIZE);
+
+static THD_FUNCTION(bus_queue_thread, arg) {
+    (void)arg;
+    chRegSetThreadName("bus_queue");
+
+    while (true) {
+        chBSemWait(&bus_queue_wakeup);
+
+        // The blocking API puts this thread to sleep until the peripheral is done, rather than the main loop
+        bus_transaction_t *transaction;
+        while ((transaction = bus_queue_next())) {
+            bus_queue_complete(transaction, bus_transaction_execute(transaction));
+        }
+    }
+}
+
+/**
+ * @brief Starts the thread running the transactions
+ *
+ * The thread runs at a higher priority than the main loop, so the bus is kept busy as long as anything is queued.
+ */
+void bus_queue_init(void) {
+    chThdCreateStatic(bus_queue_wa, sizeof(bus_queue_wa), NORMALPRIO + 1, bus_queue_thread, NULL);
+}
+
+void bus_queue_driver_kick(void) {
+    chBSemSignal(&bus_queue_wakeup);
+}
+
+void bus_queue_driver_wait(void) {
+    chThdYield();
+}
+#else
+void bus_queue_init(void) {}
+
+/**
+ * @brief Runs queued transactions straight away, without threads there is nothing to overlap them with
+ */
+__attribute__((weak)) void bus_queue_driver_kick(void) {
+    bus_transaction_t *transaction;
+    while ((transaction = bus_queue_next())) {
+        bus_queue_complete(transaction, bus_transaction_execute(transaction));
+    }
+}
+
+__attribute__((weak)) void bus_queue_driver_wait(void) {}
+#endif
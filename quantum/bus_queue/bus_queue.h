@@ -0,0 +1,152 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef BUS_QUEUE_SPI
+#    include "gpio.h"
+#endif
+
+/**
+ * @file bus_queue.h
+ * @brief Queues I2C and SPI transactions, so drivers can carry on while the bus is busy.
+ *
+ * A driver fills in a transaction, submits it and returns to the main loop. Transactions run in the order they were
+ * submitted: from a thread of their own on ChibiOS, where the I2C and SPI drivers move the bytes with DMA or
+ * interrupts, and straight away on the other platforms. The completion callback of every transaction is then called
+ * from bus_queue_task() on the main loop.
+ *
+ * Transactions and their buffers belong to the caller, and must be left alone until the transaction has completed.
+ */
+
+#ifndef BUS_QUEUE_THREAD_STACK_SIZE
+#    define BUS_QUEUE_THREAD_STACK_SIZE 512
+#endif
+
+typedef enum {
+    BUS_I2C_TRANSMIT,
+    BUS_I2C_RECEIVE,
+    BUS_I2C_WRITE_REGISTER,
+    BUS_I2C_READ_REGISTER,
+    BUS_SPI_TRANSMIT,
+    BUS_SPI_RECEIVE,
+} bus_operation_t;
+
+typedef enum {
+    BUS_TRANSACTION_IDLE,
+    BUS_TRANSACTION_QUEUED,
+    BUS_TRANSACTION_RUNNING,
+    BUS_TRANSACTION_DONE,
+} bus_transaction_state_t;
+
+typedef struct bus_transaction_t bus_transaction_t;
+
+typedef void (*bus_transaction_callback_t)(bus_transaction_t *transaction);
+
+struct bus_transaction_t {
+    bus_operation_t operation;
+    uint8_t         address; // I2C device address, shifted like for i2c_transmit()
+    uint8_t         reg;     // I2C register of the register operations
+#ifdef BUS_QUEUE_SPI
+    pin_t    slave_pin;
+    bool     lsb_first;
+    uint8_t  mode;
+    uint16_t divisor;
+#endif
+    const uint8_t *tx;
+    uint8_t       *rx;
+    uint16_t       length;
+    uint16_t       timeout;
+    int16_t        status; // i2c_status_t or spi_status_t of the completed transaction
+
+    bus_transaction_callback_t callback;    // optional
+    void                      *context;     // left to the caller, eg. for the callback
+    uint8_t                    persistence; // optional, times a failing transfer is attempted before it completes
+
+    volatile bus_transaction_state_t state;
+    uint8_t                          attempts;
+    bus_transaction_t               *next;
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Sets up the queue, and starts its thread where there is one.
+ */
+void bus_queue_init(void);
+
+/**
+ * @brief Queues a transaction filled in by the caller.
+ *
+ * @return false if the transaction has not completed since it was last submitted
+ */
+bool bus_queue_submit(bus_transaction_t *transaction);
+
+/**
+ * @brief Calls the callbacks of completed transactions, in the order they were submitted.
+ */
+void bus_queue_task(void);
+
+/**
+ * @brief Waits for every queued transaction to complete, and calls their callbacks.
+ *
+ * Drivers which also use the blocking API call this first, so their transfers do not end up in between queued ones.
+ */
+void bus_queue_flush(void);
+
+/**
+ * @brief Whether any transaction is still waiting for the bus or its callback.
+ */
+bool bus_queue_busy(void);
+
+/**
+ * @brief Whether a transaction has been submitted, and has not completed yet.
+ */
+static inline bool bus_transaction_pending(const bus_transaction_t *transaction) {
+    return transaction->state != BUS_TRANSACTION_IDLE;
+}
+
+#ifdef BUS_QUEUE_I2C
+/**
+ * @brief Queued counterparts of the I2C API, taking the same arguments after the transaction to fill in.
+ */
+bool bus_queue_i2c_transmit(bus_transaction_t *transaction, uint8_t address, const uint8_t *data, uint16_t length, uint16_t timeout);
+bool bus_queue_i2c_receive(bus_transaction_t *transaction, uint8_t address, uint8_t *data, uint16_t length, uint16_t timeout);
+bool bus_queue_i2c_write_register(bus_transaction_t *transaction, uint8_t devaddr, uint8_t regaddr, const uint8_t *data, uint16_t length, uint16_t timeout);
+bool bus_queue_i2c_read_register(bus_transaction_t *transaction, uint8_t devaddr, uint8_t regaddr, uint8_t *data, uint16_t length, uint16_t timeout);
+#endif
+
+#ifdef BUS_QUEUE_SPI
+/**
+ * @brief Queued counterparts of the SPI API, each running between its own spi_start() and spi_stop().
+ */
+bool bus_queue_spi_transmit(bus_transaction_t *transaction, pin_t slave_pin, bool lsb_first, uint8_t mode, uint16_t divisor, const uint8_t *data, uint16_t length);
+bool bus_queue_spi_receive(bus_transaction_t *transaction, pin_t slave_pin, bool lsb_first, uint8_t mode, uint16_t divisor, uint8_t *data, uint16_t length);
+#endif
+
+/**
+ * @brief Interface to whatever moves the bytes, used by the queue itself and by bus mocks.
+ *
+ * bus_queue_driver_kick() is called after every submission, and runs or schedules the transactions handed out by
+ * bus_queue_next(), reporting each one through bus_queue_complete(). A failed transaction with attempts left is handed
+ * out again, ahead of the ones queued after it. bus_queue_driver_wait() is called while bus_queue_flush() waits for
+ * them. Both are weak outside of ChibiOS, where transactions run synchronously.
+ */
+void               bus_queue_driver_kick(void);
+void               bus_queue_driver_wait(void);
+bus_transaction_t *bus_queue_next(void);
+void               bus_queue_complete(bus_transaction_t *transaction, int16_t status);
+
+/**
+ * @brief Runs a transaction with the blocking API, returning its status.
+ */
+int16_t bus_transaction_execute(bus_transaction_t *transaction);
+
+#ifdef __cplusplus
+}
+#endif
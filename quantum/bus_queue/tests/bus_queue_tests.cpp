@@ -0,0 +1,238 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "bus_queue.h"
+#include "i2c_master.h"
+#include "mock_bus.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+namespace {
+
+std::vector<bus_transaction_t *> completed;
+
+void record_completion(bus_transaction_t *transaction) {
+    completed.push_back(transaction);
+}
+
+/* An LED driver writing 192 PWM registers in 12 transfers of 16 bytes, like the IS31FL3733 */
+struct pwm_driver {
+    uint8_t           pwm_buffer[192] = {0};
+    bus_transaction_t chunks[12]      = {};
+
+    void write_blocking() {
+        for (uint8_t i = 0; i < 12; i++) {
+            i2c_write_register(0x50 << 1, i * 16, &pwm_buffer[i * 16], 16, 100);
+        }
+    }
+
+    void write_queued() {
+        for (uint8_t i = 0; i < 12; i++) {
+            bus_queue_i2c_write_register(&chunks[i], 0x50 << 1, i * 16, &pwm_buffer[i * 16], 16, 100);
+        }
+    }
+};
+
+} // namespace
+
+class BusQueue : public ::testing::Test {
+   protected:
+    bus_transaction_t transactions[3] = {};
+    uint8_t           data[16]        = {0};
+
+    void SetUp() override {
+        set_time(0);
+        // 18 bytes per millisecond, so a 16 byte register write takes a millisecond
+        mock_bus_reset(18, true);
+        completed.clear();
+        for (auto &transaction : transactions) {
+            transaction.callback = record_completion;
+        }
+    }
+
+    void TearDown() override {
+        bus_queue_flush();
+    }
+};
+
+TEST_F(BusQueue, RunsInSubmissionOrder) {
+    for (uint8_t i = 0; i < 3; i++) {
+        EXPECT_TRUE(bus_queue_i2c_write_register(&transactions[i], 0x20, i, data, 16, 100));
+    }
+    EXPECT_TRUE(bus_queue_busy());
+
+    bus_queue_flush();
+
+    EXPECT_FALSE(bus_queue_busy());
+    ASSERT_EQ(mock_bus_transfer_count(), 3);
+    ASSERT_EQ(completed.size(), 3);
+    for (uint8_t i = 0; i < 3; i++) {
+        EXPECT_EQ(mock_bus_transfer(i)->reg, i);
+        EXPECT_EQ(completed[i], &transactions[i]);
+        EXPECT_EQ(completed[i]->status, I2C_STATUS_SUCCESS);
+    }
+    // Back to back on the bus
+    EXPECT_EQ(mock_bus_transfer(1)->started, mock_bus_transfer(0)->finished);
+    EXPECT_EQ(mock_bus_transfer(2)->started, mock_bus_transfer(1)->finished);
+}
+
+TEST_F(BusQueue, SubmitDoesNotWait) {
+    bus_queue_i2c_write_register(&transactions[0], 0x20, 0, data, 16, 100);
+    bus_queue_i2c_write_register(&transactions[1], 0x20, 1, data, 16, 100);
+    EXPECT_EQ(timer_read32(), 0);
+    EXPECT_TRUE(bus_transaction_pending(&transactions[0]));
+    EXPECT_EQ(transactions[0].state, BUS_TRANSACTION_RUNNING);
+    EXPECT_EQ(transactions[1].state, BUS_TRANSACTION_QUEUED);
+}
+
+TEST_F(BusQueue, CallbacksOnlyFromTask) {
+    bus_queue_i2c_write_register(&transactions[0], 0x20, 0, data, 16, 100);
+    mock_bus_work(5);
+
+    EXPECT_EQ(transactions[0].state, BUS_TRANSACTION_DONE);
+    EXPECT_TRUE(completed.empty());
+
+    bus_queue_task();
+    ASSERT_EQ(completed.size(), 1);
+    EXPECT_FALSE(bus_transaction_pending(&transactions[0]));
+    EXPECT_FALSE(bus_queue_busy());
+}
+
+TEST_F(BusQueue, CallbacksWaitForEarlierTransactions) {
+    bus_queue_i2c_write_register(&transactions[0], 0x20, 0, data, 16, 100);
+    bus_queue_i2c_write_register(&transactions[1], 0x20, 1, data, 16, 100);
+    mock_bus_work(1);
+
+    bus_queue_task();
+    ASSERT_EQ(completed.size(), 1);
+    EXPECT_EQ(completed[0], &transactions[0]);
+}
+
+TEST_F(BusQueue, PendingTransactionNotResubmitted) {
+    EXPECT_TRUE(bus_queue_i2c_write_register(&transactions[0], 0x20, 0, data, 16, 100));
+    EXPECT_FALSE(bus_queue_i2c_write_register(&transactions[0], 0x20, 1, data, 16, 100));
+    bus_queue_flush();
+
+    EXPECT_EQ(mock_bus_transfer_count(), 1);
+    EXPECT_TRUE(bus_queue_i2c_write_register(&transactions[0], 0x20, 1, data, 16, 100));
+}
+
+TEST_F(BusQueue, CallbackMaySubmitAgain) {
+    static int repeats;
+    repeats                  = 0;
+    transactions[0].callback = [](bus_transaction_t *transaction) {
+        if (++repeats < 3) {
+            bus_queue_submit(transaction);
+        }
+    };
+
+    bus_queue_i2c_transmit(&transactions[0], 0x20, data, 4, 100);
+    bus_queue_flush();
+
+    EXPECT_EQ(repeats, 3);
+    EXPECT_EQ(mock_bus_transfer_count(), 3);
+}
+
+TEST_F(BusQueue, StatusReported) {
+    mock_bus_set_status(I2C_STATUS_TIMEOUT);
+    bus_queue_i2c_read_register(&transactions[0], 0x20, 0, data, 2, 100);
+    bus_queue_flush();
+
+    ASSERT_EQ(completed.size(), 1);
+    EXPECT_EQ(completed[0]->status, I2C_STATUS_TIMEOUT);
+}
+
+TEST_F(BusQueue, PersistenceRetriesInPlace) {
+    transactions[0].persistence = 3;
+    mock_bus_fail(2);
+    bus_queue_i2c_write_register(&transactions[0], 0x20, 0, data, 16, 100);
+    bus_queue_i2c_write_register(&transactions[1], 0x20, 1, data, 16, 100);
+    bus_queue_flush();
+
+    // Both failed attempts come before the transaction queued after it, and only the last one completes
+    ASSERT_EQ(mock_bus_transfer_count(), 4);
+    EXPECT_EQ(mock_bus_transfer(2)->reg, 0);
+    EXPECT_EQ(mock_bus_transfer(3)->reg, 1);
+    ASSERT_EQ(completed.size(), 2);
+    EXPECT_EQ(completed[0]->status, I2C_STATUS_SUCCESS);
+}
+
+TEST_F(BusQueue, PersistenceRunsOut) {
+    transactions[0].persistence = 3;
+    mock_bus_fail(5);
+    bus_queue_i2c_write_register(&transactions[0], 0x20, 0, data, 16, 100);
+    bus_queue_flush();
+
+    EXPECT_EQ(mock_bus_transfer_count(), 3);
+    ASSERT_EQ(completed.size(), 1);
+    EXPECT_EQ(completed[0]->status, I2C_STATUS_ERROR);
+
+    // Attempts start over with every submission
+    mock_bus_fail(2);
+    bus_queue_submit(&transactions[0]);
+    bus_queue_flush();
+    EXPECT_EQ(mock_bus_transfer_count(), 6);
+    EXPECT_EQ(transactions[0].status, I2C_STATUS_SUCCESS);
+}
+
+TEST_F(BusQueue, PersistenceWithoutThread) {
+    mock_bus_reset(18, false);
+    transactions[0].persistence = 2;
+    mock_bus_fail(1);
+    bus_queue_i2c_write_register(&transactions[0], 0x20, 0, data, 16, 100);
+
+    EXPECT_EQ(mock_bus_transfer_count(), 2);
+    EXPECT_EQ(transactions[0].state, BUS_TRANSACTION_DONE);
+    EXPECT_EQ(transactions[0].status, I2C_STATUS_SUCCESS);
+}
+
+TEST_F(BusQueue, SynchronousFallback) {
+    mock_bus_reset(18, false);
+
+    bus_queue_i2c_write_register(&transactions[0], 0x20, 0, data, 16, 100);
+    EXPECT_EQ(timer_read32(), 1);
+    EXPECT_EQ(transactions[0].state, BUS_TRANSACTION_DONE);
+    EXPECT_TRUE(completed.empty());
+
+    bus_queue_task();
+    EXPECT_EQ(completed.size(), 1);
+}
+
+TEST_F(BusQueue, OverlapsMainLoop) {
+    // Every frame takes 10ms of main loop work and 12ms of PWM writes
+    const int  frames = 20;
+    pwm_driver driver;
+
+    mock_bus_reset(18, false);
+    for (int i = 0; i < frames; i++) {
+        driver.write_blocking();
+        mock_bus_work(10);
+    }
+    uint32_t blocking = timer_read32();
+
+    set_time(0);
+    mock_bus_reset(18, true);
+    for (int i = 0; i < frames; i++) {
+        // The previous frame has to be on the bus before its buffer is written again
+        bus_queue_flush();
+        driver.write_queued();
+        mock_bus_work(10);
+    }
+    bus_queue_flush();
+    uint32_t queued = timer_read32();
+
+    EXPECT_EQ(blocking, frames * 22);
+    // Only the bus time is left, the main loop work happens while it runs
+    EXPECT_EQ(queued, frames * 12);
+    EXPECT_EQ(mock_bus_transfer_count(), frames * 12);
+    RecordProperty("blocking_ms", blocking);
+    RecordProperty("queued_ms", queued);
+}
@@ -0,0 +1,8 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#define OLED_TRANSPORT_I2C
+#define OLED_TIMEOUT 0
+#define OLED_UPDATE_PROCESS_LIMIT 2
@@ -0,0 +1,118 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "is31fl3733.h"
+#include "i2c_master.h"
+#include "mock_bus.h"
+
+void set_time(uint32_t t);
+
+const is31fl3733_led_t PROGMEM g_is31fl3733_leds[IS31FL3733_LED_COUNT] = {
+    {0, SW1_CS1, SW1_CS2, SW1_CS3},
+};
+}
+
+/* The page select and the 12 PWM transfers of a flush */
+static const uint16_t flush_transfers = 14;
+
+class BusQueueIS31FL3733 : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        set_time(0);
+        mock_bus_reset(18, true);
+    }
+
+    void TearDown() override {
+        bus_queue_flush();
+    }
+
+    // Leaves the buffer dirty, with a colour of its own for every call
+    void change_colour() {
+        static uint8_t red = 0;
+        is31fl3733_set_color(0, ++red, 0, 0);
+    }
+
+    void expect_flush(uint16_t first) {
+        ASSERT_GE(mock_bus_transfer_count(), first + flush_transfers);
+        EXPECT_EQ(mock_bus_transfer(first)->reg, IS31FL3733_REG_COMMAND_WRITE_LOCK);
+        EXPECT_EQ(mock_bus_transfer(first + 1)->reg, IS31FL3733_REG_COMMAND);
+        for (uint8_t i = 0; i < 12; i++) {
+            const mock_bus_transfer_t *transfer = mock_bus_transfer(first + 2 + i);
+            EXPECT_EQ(transfer->address, IS31FL3733_I2C_ADDRESS_GND_GND << 1);
+            EXPECT_EQ(transfer->reg, i * 16);
+            EXPECT_EQ(transfer->length, 16);
+        }
+    }
+};
+
+TEST_F(BusQueueIS31FL3733, QueuesPageSelectAndPwm) {
+    change_colour();
+    is31fl3733_update_pwm_buffers(0);
+    // Nothing has made it onto the bus yet
+    EXPECT_EQ(mock_bus_transfer_count(), 0);
+
+    bus_queue_flush();
+    EXPECT_EQ(mock_bus_transfer_count(), flush_transfers);
+    expect_flush(0);
+
+    // Nothing left to send
+    is31fl3733_update_pwm_buffers(0);
+    bus_queue_flush();
+    EXPECT_EQ(mock_bus_transfer_count(), flush_transfers);
+}
+
+TEST_F(BusQueueIS31FL3733, PendingFlushLeavesChangesForTheNext) {
+    change_colour();
+    is31fl3733_update_pwm_buffers(0);
+    change_colour();
+    is31fl3733_update_pwm_buffers(0);
+    bus_queue_flush();
+    EXPECT_EQ(mock_bus_transfer_count(), flush_transfers);
+
+    is31fl3733_update_pwm_buffers(0);
+    bus_queue_flush();
+    EXPECT_EQ(mock_bus_transfer_count(), 2 * flush_transfers);
+    expect_flush(flush_transfers);
+}
+
+TEST_F(BusQueueIS31FL3733, PersistenceRetriesFailedTransfers) {
+    change_colour();
+    mock_bus_fail(2);
+    is31fl3733_update_pwm_buffers(0);
+    bus_queue_flush();
+
+    // The write lock went through on its third attempt, ahead of the page select
+    EXPECT_EQ(mock_bus_transfer_count(), 2 + flush_transfers);
+    expect_flush(2);
+
+    is31fl3733_update_pwm_buffers(0);
+    bus_queue_flush();
+    EXPECT_EQ(mock_bus_transfer_count(), 2 + flush_transfers);
+}
+
+TEST_F(BusQueueIS31FL3733, ResendsOnceOutOfAttempts) {
+    change_colour();
+    mock_bus_fail(IS31FL3733_I2C_PERSISTENCE);
+    is31fl3733_update_pwm_buffers(0);
+    bus_queue_flush();
+    EXPECT_EQ(mock_bus_transfer_count(), IS31FL3733_I2C_PERSISTENCE - 1 + flush_transfers);
+
+    is31fl3733_update_pwm_buffers(0);
+    bus_queue_flush();
+    EXPECT_EQ(mock_bus_transfer_count(), IS31FL3733_I2C_PERSISTENCE - 1 + 2 * flush_transfers);
+    expect_flush(IS31FL3733_I2C_PERSISTENCE - 1 + flush_transfers);
+}
+
+TEST_F(BusQueueIS31FL3733, BlockingPageSelectWaitsForQueue) {
+    change_colour();
+    is31fl3733_update_pwm_buffers(0);
+    is31fl3733_select_page(0, IS31FL3733_COMMAND_LED_CONTROL);
+
+    ASSERT_EQ(mock_bus_transfer_count(), flush_transfers + 2);
+    expect_flush(0);
+    EXPECT_EQ(mock_bus_transfer(flush_transfers)->reg, IS31FL3733_REG_COMMAND_WRITE_LOCK);
+    EXPECT_EQ(mock_bus_transfer(flush_transfers + 1)->reg, IS31FL3733_REG_COMMAND);
+}
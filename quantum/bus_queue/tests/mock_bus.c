@@ -0,0 +1,141 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stddef.h>
+#include "mock_bus.h"
+#include "i2c_master.h"
+#include "timer.h"
+
+void advance_time(uint32_t ms);
+
+static uint16_t            bytes_per_ms = 1;
+static bool                async        = false;
+static int16_t             status       = I2C_STATUS_SUCCESS;
+static uint16_t            failures     = 0;
+static mock_bus_transfer_t transfers[MOCK_BUS_MAX_TRANSFERS];
+static uint16_t            transfer_count = 0;
+
+/* queued transaction on the bus, and when it ends */
+static bus_transaction_t *in_flight = NULL;
+static uint32_t           in_flight_start;
+static uint32_t           in_flight_end;
+
+static uint32_t transfer_time(bus_operation_t operation, uint16_t length) {
+    // Address byte, plus the register and the repeated address of the register operations
+    uint16_t bytes = length + 1;
+    if (operation == BUS_I2C_WRITE_REGISTER) {
+        bytes += 1;
+    } else if (operation == BUS_I2C_READ_REGISTER) {
+        bytes += 2;
+    }
+    return (bytes + bytes_per_ms - 1) / bytes_per_ms;
+}
+
+static void record(bus_operation_t operation, uint8_t address, uint8_t reg, uint16_t length, uint32_t started, uint32_t finished) {
+    if (transfer_count < MOCK_BUS_MAX_TRANSFERS) {
+        transfers[transfer_count++] = (mock_bus_transfer_t){operation, address, reg, length, started, finished};
+    }
+}
+
+static int16_t transfer_status(void) {
+    if (failures) {
+        failures--;
+        return I2C_STATUS_ERROR;
+    }
+    return status;
+}
+
+static i2c_status_t blocking_transfer(bus_operation_t operation, uint8_t address, uint8_t reg, uint16_t length) {
+    uint32_t started = timer_read32();
+    advance_time(transfer_time(operation, length));
+    record(operation, address, reg, length, started, timer_read32());
+    return transfer_status();
+}
+
+static void start(bus_transaction_t *transaction, uint32_t now) {
+    in_flight = transaction;
+    if (transaction) {
+        in_flight_start = now;
+        in_flight_end   = now + transfer_time(transaction->operation, transaction->length);
+    }
+}
+
+void mock_bus_reset(uint16_t rate, bool run_async) {
+    bytes_per_ms   = rate ? rate : 1;
+    async          = run_async;
+    status         = I2C_STATUS_SUCCESS;
+    failures       = 0;
+    transfer_count = 0;
+    in_flight      = NULL;
+}
+
+void mock_bus_set_status(int16_t new_status) {
+    status = new_status;
+}
+
+void mock_bus_fail(uint16_t count) {
+    failures = count;
+}
+
+void mock_bus_update(void) {
+    while (in_flight && timer_read32() >= in_flight_end) {
+        bus_transaction_t *transaction = in_flight;
+        uint32_t           end         = in_flight_end;
+
+        record(transaction->operation, transaction->address, transaction->reg, transaction->length, in_flight_start, end);
+        bus_queue_complete(transaction, transfer_status());
+        // The next transfer follows straight on from the last one
+        start(bus_queue_next(), end);
+    }
+}
+
+void mock_bus_work(uint32_t ms) {
+    while (ms--) {
+        advance_time(1);
+        mock_bus_update();
+    }
+}
+
+uint16_t mock_bus_transfer_count(void) {
+    return transfer_count;
+}
+
+const mock_bus_transfer_t *mock_bus_transfer(uint16_t index) {
+    return index < transfer_count ? &transfers[index] : NULL;
+}
+
+void bus_queue_driver_kick(void) {
+    if (!async) {
+        bus_transaction_t *transaction;
+        while ((transaction = bus_queue_next())) {
+            bus_queue_complete(transaction, bus_transaction_execute(transaction));
+        }
+        return;
+    }
+
+    if (!in_flight) {
+        start(bus_queue_next(), timer_read32());
+    }
+}
+
+void bus_queue_driver_wait(void) {
+    mock_bus_work(1);
+}
+
+void i2c_init(void) {}
+
+i2c_status_t i2c_transmit(uint8_t address, const uint8_t *data, uint16_t length, uint16_t timeout) {
+    return blocking_transfer(BUS_I2C_TRANSMIT, address, 0, length);
+}
+
+i2c_status_t i2c_receive(uint8_t address, uint8_t *data, uint16_t length, uint16_t timeout) {
+    return blocking_transfer(BUS_I2C_RECEIVE, address, 0, length);
+}
+
+i2c_status_t i2c_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t *data, uint16_t length, uint16_t timeout) {
+    return blocking_transfer(BUS_I2C_WRITE_REGISTER, devaddr, regaddr, length);
+}
+
+i2c_status_t i2c_read_register(uint8_t devaddr, uint8_t regaddr, uint8_t *data, uint16_t length, uint16_t timeout) {
+    return blocking_transfer(BUS_I2C_READ_REGISTER, devaddr, regaddr, length);
+}
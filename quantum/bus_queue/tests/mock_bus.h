@@ -0,0 +1,62 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "bus_queue.h"
+
+/**
+ * @brief I2C bus which takes a simulated time for every transfer, so the time saved by queueing can be measured.
+ *
+ * The blocking I2C API advances the test timer by the time of the transfer. Queued transactions run on the simulated
+ * bus instead, and complete once the timer has passed their end, while the test carries on with mock_bus_work().
+ */
+
+typedef struct {
+    bus_operation_t operation;
+    uint8_t         address;
+    uint8_t         reg;
+    uint16_t        length;
+    uint32_t        started;
+    uint32_t        finished;
+} mock_bus_transfer_t;
+
+#define MOCK_BUS_MAX_TRANSFERS 256
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Starts over with an idle bus moving `bytes_per_ms`, running queued transactions in the background if `async`.
+ */
+void mock_bus_reset(uint16_t bytes_per_ms, bool async);
+
+/**
+ * @brief Status returned by the transfers from now on.
+ */
+void mock_bus_set_status(int16_t status);
+
+/**
+ * @brief Fails the next `count` transfers with I2C_STATUS_ERROR, before going back to the status set above.
+ */
+void mock_bus_fail(uint16_t count);
+
+/**
+ * @brief Completes the queued transactions whose transfer has ended by now.
+ */
+void mock_bus_update(void);
+
+/**
+ * @brief Spends `ms` on something else, while the bus carries on.
+ */
+void mock_bus_work(uint32_t ms);
+
+uint16_t                   mock_bus_transfer_count(void);
+const mock_bus_transfer_t *mock_bus_transfer(uint16_t index);
+
+#ifdef __cplusplus
+}
+#endif
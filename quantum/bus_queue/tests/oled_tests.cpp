@@ -0,0 +1,106 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "oled_driver.h"
+#include "i2c_master.h"
+#include "mock_bus.h"
+
+void set_time(uint32_t t);
+
+extern OLED_BLOCK_TYPE oled_dirty;
+}
+
+class BusQueueOled : public ::testing::Test {
+   protected:
+    uint16_t init_transfers;
+
+    void SetUp() override {
+        set_time(0);
+        mock_bus_reset(18, true);
+        ASSERT_TRUE(oled_init(OLED_ROTATION_0));
+        oled_clear();
+        oled_render_dirty(true);
+        bus_queue_flush();
+        init_transfers = mock_bus_transfer_count();
+    }
+
+    void TearDown() override {
+        bus_queue_flush();
+    }
+
+    // The position command and the data of a block
+    void expect_block(uint16_t first) {
+        ASSERT_GE(mock_bus_transfer_count(), first + 2);
+        EXPECT_EQ(mock_bus_transfer(first)->operation, BUS_I2C_TRANSMIT);
+        EXPECT_EQ(mock_bus_transfer(first)->length, 7);
+        EXPECT_EQ(mock_bus_transfer(first + 1)->operation, BUS_I2C_WRITE_REGISTER);
+        EXPECT_EQ(mock_bus_transfer(first + 1)->reg, 0x40);
+        EXPECT_EQ(mock_bus_transfer(first + 1)->length, OLED_BLOCK_SIZE);
+    }
+};
+
+TEST_F(BusQueueOled, QueuesBlocks) {
+    oled_write_raw_byte(0xFF, 0);
+    oled_render_dirty(false);
+    // The block is on its way, and no longer dirty
+    EXPECT_EQ(mock_bus_transfer_count(), init_transfers);
+    EXPECT_EQ(oled_dirty, 0);
+
+    bus_queue_flush();
+    EXPECT_EQ(mock_bus_transfer_count(), init_transfers + 2);
+    expect_block(init_transfers);
+}
+
+TEST_F(BusQueueOled, BusyBlocksWaitForTheNextRender) {
+    // Three dirty blocks, and two transfers of blocks to queue them in
+    oled_write_raw_byte(0xFF, 0);
+    oled_write_raw_byte(0xFF, OLED_BLOCK_SIZE);
+    oled_write_raw_byte(0xFF, 2 * OLED_BLOCK_SIZE);
+    oled_render_dirty(false);
+    oled_render_dirty(false);
+    EXPECT_EQ(oled_dirty, 1 << 2);
+
+    bus_queue_flush();
+    EXPECT_EQ(mock_bus_transfer_count(), init_transfers + 4);
+    oled_render_dirty(false);
+    bus_queue_flush();
+    EXPECT_EQ(oled_dirty, 0);
+    EXPECT_EQ(mock_bus_transfer_count(), init_transfers + 6);
+}
+
+TEST_F(BusQueueOled, RenderAllWaitsForTransfers) {
+    oled_clear();
+    oled_render_dirty(true);
+    EXPECT_EQ(oled_dirty, 0);
+
+    bus_queue_flush();
+    EXPECT_EQ(mock_bus_transfer_count(), init_transfers + 2 * OLED_BLOCK_COUNT);
+    for (uint8_t i = 0; i < OLED_BLOCK_COUNT; i++) {
+        expect_block(init_transfers + 2 * i);
+    }
+}
+
+TEST_F(BusQueueOled, FailedBlockIsDirtyAgain) {
+    oled_write_raw_byte(0xFF, OLED_BLOCK_SIZE);
+    mock_bus_fail(1);
+    oled_render_dirty(false);
+    bus_queue_flush();
+    EXPECT_EQ(oled_dirty, 1 << 1);
+
+    oled_render_dirty(false);
+    bus_queue_flush();
+    EXPECT_EQ(oled_dirty, 0);
+}
+
+TEST_F(BusQueueOled, CommandsWaitForQueuedBlocks) {
+    oled_write_raw_byte(0xFF, 0);
+    oled_render_dirty(false);
+    oled_set_brightness(0x10);
+
+    ASSERT_EQ(mock_bus_transfer_count(), init_transfers + 3);
+    expect_block(init_transfers);
+    EXPECT_EQ(mock_bus_transfer(init_transfers + 2)->length, 3);
+}
@@ -0,0 +1,44 @@
+bus_queue_DEFS := -DBUS_QUEUE_I2C
+
+bus_queue_SRC := \
+	$(QUANTUM_PATH)/bus_queue/tests/bus_queue_tests.cpp \
+	$(QUANTUM_PATH)/bus_queue/tests/mock_bus.c \
+	$(QUANTUM_PATH)/bus_queue/bus_queue.c \
+	$(PLATFORM_PATH)/timer.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+
+bus_queue_INC := \
+	$(QUANTUM_PATH)/bus_queue \
+	$(QUANTUM_PATH)/bus_queue/tests
+
+bus_queue_is31fl3733_DEFS := -DBUS_QUEUE_ENABLE -DBUS_QUEUE_I2C
+bus_queue_is31fl3733_CONFIG := $(QUANTUM_PATH)/bus_queue/tests/config_is31fl3733.h
+
+bus_queue_is31fl3733_SRC := \
+	$(QUANTUM_PATH)/bus_queue/tests/is31fl3733_tests.cpp \
+	$(QUANTUM_PATH)/bus_queue/tests/mock_bus.c \
+	$(QUANTUM_PATH)/bus_queue/bus_queue.c \
+	$(DRIVER_PATH)/led/issi/is31fl3733.c \
+	$(PLATFORM_PATH)/timer.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+
+bus_queue_is31fl3733_INC := \
+	$(QUANTUM_PATH)/bus_queue \
+	$(QUANTUM_PATH)/bus_queue/tests \
+	$(DRIVER_PATH)/led/issi
+
+bus_queue_oled_DEFS := -DBUS_QUEUE_ENABLE -DBUS_QUEUE_I2C -DNO_PRINT
+bus_queue_oled_CONFIG := $(QUANTUM_PATH)/bus_queue/tests/config_oled.h
+
+bus_queue_oled_SRC := \
+	$(QUANTUM_PATH)/bus_queue/tests/oled_tests.cpp \
+	$(QUANTUM_PATH)/bus_queue/tests/mock_bus.c \
+	$(QUANTUM_PATH)/bus_queue/bus_queue.c \
+	$(DRIVER_PATH)/oled/oled_driver.c \
+	$(PLATFORM_PATH)/timer.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+
+bus_queue_oled_INC := \
+	$(QUANTUM_PATH)/bus_queue \
+	$(QUANTUM_PATH)/bus_queue/tests \
+	$(DRIVER_PATH)/oled
@@ -0,0 +1,3 @@
+TEST_LIST += bus_queue
+TEST_LIST += bus_queue_is31fl3733
+TEST_LIST += bus_queue_oled
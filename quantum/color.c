@@ -108,3 +108,72 @@ rgb_t hsv_to_rgb(hsv_t hsv) {
 rgb_t hsv_to_rgb_nocie(hsv_t hsv) {
     return hsv_to_rgb_impl(hsv, false);
 }
+
+#if !defined(__AVR__)
+// Which of v, p, q and t go into red, green and blue for each sixth of the hue
+// circle. A hue of 255 rounds up into a seventh that matches the first, and
+// the last row is used for greys.
+static const uint8_t hsv_region_channels[8][3] = {
+    {0, 3, 1}, // v, t, p
+    {2, 0, 1}, // q, v, p
+    {1, 0, 3}, // p, v, t
+    {1, 2, 0}, // p, q, v
+    {3, 1, 0}, // t, p, v
+    {0, 1, 2}, // v, p, q
+    {0, 3, 1}, // v, t, p
+    {0, 0, 0}, // v, v, v
+};
+#endif
+
+static void hsv_to_rgb_batch_impl(const hsv_t *hsv, rgb_t *rgb, uint16_t count, bool use_cie) {
+#if defined(__AVR__)
+    // Without a fast 32 bit multiply there is nothing to gain over converting one at a time
+    for (uint16_t i = 0; i < count; i++) {
+        rgb[i] = hsv_to_rgb_impl(hsv[i], use_cie);
+    }
+#else
+    for (uint16_t i = 0; i < count; i++) {
+        uint32_t h = hsv[i].h;
+        uint32_t s = hsv[i].s;
+        uint32_t v = hsv[i].v;
+#    ifdef USE_CIE1931_CURVE
+        if (use_cie) {
+            v = pgm_read_byte(&CIE1931_CURVE[v]);
+        }
+#    endif
+
+        // Same as h * 6 / 255 for every hue, without the division
+        uint32_t region    = (h * 6 + 1 + ((h * 6) >> 8)) >> 8;
+        uint32_t remainder = (uint8_t)((h * 2 - region * 85) * 3);
+
+        // The products for q and t never exceed 16 bits, so both are worked out
+        // side by side in the two halves of a single 32 bit multiply
+        uint32_t scaled = (remainder | ((255 - remainder) << 16)) * s;
+        uint32_t qt     = ((255 - ((scaled & 0xFFFF) >> 8)) | ((255 - (scaled >> 24)) << 16)) * v;
+
+        uint8_t values[4] = {
+            v,
+            (v * (255 - s)) >> 8,
+            (qt & 0xFFFF) >> 8,
+            qt >> 24,
+        };
+        const uint8_t *channels = hsv_region_channels[s ? region : 7];
+
+        rgb[i].r = values[channels[0]];
+        rgb[i].g = values[channels[1]];
+        rgb[i].b = values[channels[2]];
+    }
+#endif
+}
+
+void hsv_to_rgb_batch(const hsv_t *hsv, rgb_t *rgb, uint16_t count) {
+#ifdef USE_CIE1931_CURVE
+    hsv_to_rgb_batch_impl(hsv, rgb, count, true);
+#else
+    hsv_to_rgb_batch_impl(hsv, rgb, count, false);
+#endif
+}
+
+void hsv_to_rgb_batch_nocie(const hsv_t *hsv, rgb_t *rgb, uint16_t count) {
+    hsv_to_rgb_batch_impl(hsv, rgb, count, false);
+}
@@ -95,3 +95,13 @@ typedef hsv_t HSV;
 
 rgb_t hsv_to_rgb(hsv_t hsv);
 rgb_t hsv_to_rgb_nocie(hsv_t hsv);
+
+/**
+ * @brief Converts an array of colours at once, with the same results as hsv_to_rgb()
+ *
+ * @param hsv The colours to convert
+ * @param rgb Receives the converted colours, may not overlap hsv
+ * @param count Number of colours to convert
+ */
+void hsv_to_rgb_batch(const hsv_t *hsv, rgb_t *rgb, uint16_t count);
+void hsv_to_rgb_batch_nocie(const hsv_t *hsv, rgb_t *rgb, uint16_t count);
@@ -0,0 +1,199 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "dynamic_macro.h"
+
+#define HEADER_PRESSED (1 << 7)
+#define HEADER_TYPE_SHIFT 4
+#define HEADER_TYPE_MASK 0x07
+#define HEADER_EXTRA (1 << 3)
+#define HEADER_DELAY_MASK 0x07
+
+#define EXTRA_KEYCODE (1 << 7)
+#define EXTRA_INTERRUPTED (1 << 4)
+#define EXTRA_COUNT_MASK 0x0F
+
+#if MATRIX_ROWS <= 16 && MATRIX_COLS <= 16
+#    define PACKED_KEYPOS
+#endif
+
+static inline uint8_t *macro_at(const dynamic_macro_t *macro, uint16_t offset) {
+    return macro->direction > 0 ? macro->start + offset : macro->start - offset;
+}
+
+static uint8_t encode_event(const keyrecord_t *record, uint16_t delay, uint8_t *out) {
+    uint8_t size  = 1;
+    uint8_t extra = 0;
+#ifndef NO_ACTION_TAPPING
+    extra |= (record->tap.interrupted ? EXTRA_INTERRUPTED : 0) | (record->tap.count & EXTRA_COUNT_MASK);
+#endif
+#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+    extra |= record->keycode ? EXTRA_KEYCODE : 0;
+#endif
+
+    out[0] = (record->event.pressed ? HEADER_PRESSED : 0) | ((record->event.type & HEADER_TYPE_MASK) << HEADER_TYPE_SHIFT) | (extra ? HEADER_EXTRA : 0);
+    if (delay < HEADER_DELAY_MASK) {
+        out[0] |= delay;
+    } else {
+        out[0] |= HEADER_DELAY_MASK;
+        delay -= HEADER_DELAY_MASK;
+        do {
+            out[size++] = (delay & 0x7F) | (delay > 0x7F ? 0x80 : 0);
+            delay >>= 7;
+        } while (delay);
+    }
+
+    switch (record->event.type) {
+        case KEY_EVENT:
+#ifdef PACKED_KEYPOS
+            out[size++] = (record->event.key.row << 4) | (record->event.key.col & 0x0F);
+#else
+            out[size++] = record->event.key.row;
+            out[size++] = record->event.key.col;
+#endif
+            break;
+        case ENCODER_CW_EVENT:
+        case ENCODER_CCW_EVENT:
+        case DIP_SWITCH_ON_EVENT:
+        case DIP_SWITCH_OFF_EVENT:
+            // The row is implied by the event type
+            out[size++] = record->event.key.col;
+            break;
+        case COMBO_EVENT:
+            break;
+        default:
+            out[size++] = record->event.key.row;
+            out[size++] = record->event.key.col;
+            break;
+    }
+
+    if (extra) {
+        out[size++] = extra;
+    }
+#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+    if (extra & EXTRA_KEYCODE) {
+        out[size++] = record->keycode & 0xFF;
+        out[size++] = record->keycode >> 8;
+    }
+#endif
+    return size;
+}
+
+bool dynamic_macro_append(dynamic_macro_t *macro, uint16_t capacity, const keyrecord_t *record, uint16_t delay) {
+    uint8_t encoded[DYNAMIC_MACRO_MAX_EVENT_SIZE];
+    uint8_t size = encode_event(record, delay, encoded);
+
+    if (macro->length + size > capacity) {
+        return false;
+    }
+    for (uint8_t i = 0; i < size; i++) {
+        *macro_at(macro, macro->length++) = encoded[i];
+    }
+    return true;
+}
+
+typedef struct {
+    const dynamic_macro_t *macro;
+    uint16_t               offset;
+    bool                   truncated;
+} macro_reader_t;
+
+static uint8_t read_byte(macro_reader_t *reader) {
+    if (reader->offset >= reader->macro->length) {
+        reader->truncated = true;
+        return 0;
+    }
+    return *macro_at(reader->macro, reader->offset++);
+}
+
+uint16_t dynamic_macro_read(const dynamic_macro_t *macro, uint16_t offset, keyrecord_t *record, uint16_t *delay) {
+    if (offset >= macro->length) {
+        return 0;
+    }
+
+    macro_reader_t reader = {.macro = macro, .offset = offset};
+    uint8_t        header = read_byte(&reader);
+
+    *record               = (keyrecord_t){0};
+    record->event.pressed = header & HEADER_PRESSED;
+    record->event.type    = (header >> HEADER_TYPE_SHIFT) & HEADER_TYPE_MASK;
+
+    *delay = header & HEADER_DELAY_MASK;
+    if (*delay == HEADER_DELAY_MASK) {
+        uint16_t extra_delay = 0;
+        uint8_t  shift       = 0;
+        uint8_t  byte;
+        do {
+            byte = read_byte(&reader);
+            extra_delay |= (uint16_t)(byte & 0x7F) << shift;
+            shift += 7;
+        } while ((byte & 0x80) && shift < 16);
+        *delay += extra_delay;
+    }
+
+    switch (record->event.type) {
+        case KEY_EVENT: {
+#ifdef PACKED_KEYPOS
+            uint8_t keypos        = read_byte(&reader);
+            record->event.key.row = keypos >> 4;
+            record->event.key.col = keypos & 0x0F;
+#else
+            record->event.key.row = read_byte(&reader);
+            record->event.key.col = read_byte(&reader);
+#endif
+            break;
+        }
+        case ENCODER_CW_EVENT:
+            record->event.key = MAKE_KEYPOS(KEYLOC_ENCODER_CW, read_byte(&reader));
+            break;
+        case ENCODER_CCW_EVENT:
+            record->event.key = MAKE_KEYPOS(KEYLOC_ENCODER_CCW, read_byte(&reader));
+            break;
+        case DIP_SWITCH_ON_EVENT:
+            record->event.key = MAKE_KEYPOS(KEYLOC_DIP_SWITCH_ON, read_byte(&reader));
+            break;
+        case DIP_SWITCH_OFF_EVENT:
+            record->event.key = MAKE_KEYPOS(KEYLOC_DIP_SWITCH_OFF, read_byte(&reader));
+            break;
+        case COMBO_EVENT:
+            break;
+        default:
+            record->event.key.row = read_byte(&reader);
+            record->event.key.col = read_byte(&reader);
+            break;
+    }
+
+    if (header & HEADER_EXTRA) {
+        uint8_t extra = read_byte(&reader);
+#ifndef NO_ACTION_TAPPING
+        record->tap.interrupted = extra & EXTRA_INTERRUPTED;
+        record->tap.count       = extra & EXTRA_COUNT_MASK;
+#endif
+        if (extra & EXTRA_KEYCODE) {
+            uint16_t keycode = read_byte(&reader);
+            keycode |= (uint16_t)read_byte(&reader) << 8;
+#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+            record->keycode = keycode;
+#else
+            (void)keycode;
+#endif
+        }
+    }
+
+    // Only possible with a corrupt buffer, eg. one restored from NVM after the firmware changed
+    return reader.truncated ? 0 : reader.offset;
+}
+
+void dynamic_macro_trim(dynamic_macro_t *macro) {
+    keyrecord_t record;
+    uint16_t    delay;
+    uint16_t    offset = 0;
+    uint16_t    end    = 0;
+
+    for (uint16_t next; (next = dynamic_macro_read(macro, offset, &record, &delay)); offset = next) {
+        if (!record.event.pressed) {
+            end = next;
+        }
+    }
+    macro->length = end;
+}
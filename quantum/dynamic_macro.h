@@ -0,0 +1,68 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "action.h"
+
+/*
+  Compact encoding of recorded dynamic macro events.
+
+  Rather than whole keyrecord_t structs, a macro is stored as a stream of variable length events. Every event starts
+  with a header byte:
+
+    bit 7     pressed
+    bits 6-4  keyevent_type_t
+    bit 3     an extra byte follows the key position
+    bits 2-0  milliseconds since the previous event, where 7 means the rest of the delay follows as a varint
+
+  followed by the key position -- a single byte for key events on matrices of up to 16x16, just the index for encoders
+  and DIP switches, and nothing at all for combos. The extra byte holds the tap state and a flag for a keycode, which
+  is then appended as two bytes. A plain key press or release takes two bytes.
+*/
+
+/* Longest possible encoding of a single event: header, varint delay, key position, extra byte and keycode */
+#define DYNAMIC_MACRO_MAX_EVENT_SIZE 9
+
+/* A macro being recorded into, or played back from, a byte buffer. Two macros can share the same buffer by having
+ * them grow towards each other from both ends. */
+typedef struct {
+    uint8_t *start;     // first byte of the macro
+    int8_t   direction; // +1 if the macro grows upwards from start, -1 if downwards
+    uint16_t length;    // number of bytes in use
+} dynamic_macro_t;
+
+/**
+ * @brief Appends an event to a macro
+ *
+ * @param[in,out] macro the macro to append to
+ * @param[in] capacity number of bytes the macro may grow to
+ * @param[in] record the event to store
+ * @param[in] delay milliseconds since the previous event
+ * @return false if the event did not fit, in which case the macro is left untouched
+ */
+bool dynamic_macro_append(dynamic_macro_t *macro, uint16_t capacity, const keyrecord_t *record, uint16_t delay);
+
+/**
+ * @brief Decodes the event at an offset into a macro
+ *
+ * The event time is left at 0 for the caller to fill in.
+ *
+ * @param[in] macro the macro to read from
+ * @param[in] offset where the event starts, 0 for the first event
+ * @param[out] record the decoded event
+ * @param[out] delay milliseconds between the previous event and this one
+ * @return offset of the next event, or 0 if there is no complete event at the offset
+ */
+uint16_t dynamic_macro_read(const dynamic_macro_t *macro, uint16_t offset, keyrecord_t *record, uint16_t *delay);
+
+/**
+ * @brief Drops any key presses at the end of a macro
+ *
+ * These are the keys still held when the recording is stopped, eg. the layer key used to reach DM_RSTP.
+ *
+ * @param[in,out] macro the macro to trim
+ */
+void dynamic_macro_trim(dynamic_macro_t *macro);
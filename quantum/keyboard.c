@@ -17,6 +17,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <stdint.h>
 #include "keyboard.h"
+#include "keyevent_queue.h"
 #include "keycode_config.h"
 #include "matrix.h"
 #include "keymap_introspection.h"
@@ -74,6 +75,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef TAP_DANCE_ENABLE
 #    include "process_tap_dance.h"
 #endif
+#ifdef DYNAMIC_MACRO_ENABLE
+#    include "process_dynamic_macro.h"
+#endif
 #ifdef STENO_ENABLE
 #    include "process_steno.h"
 #endif
@@ -98,6 +102,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef OLED_ENABLE
 #    include "oled_driver.h"
 #endif
+#ifdef BUS_QUEUE_ENABLE
+#    include "bus_queue.h"
+#endif
 #ifdef ST7565_ENABLE
 #    include "st7565.h"
 #endif
@@ -122,6 +129,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef SPLIT_KEYBOARD
 #    include "split_util.h"
 #endif
+#ifdef DEFERRED_LOG_ENABLE
+#    include "deferred_log.h"
+#endif
 #ifdef BATTERY_DRIVER
 #    include "battery.h"
 #endif
@@ -457,6 +467,9 @@ void quantum_init(void) {
 void keyboard_init(void) {
     timer_init();
     sync_timer_init();
+#ifdef BUS_QUEUE_ENABLE
+    bus_queue_init();
+#endif
 #ifdef VIA_ENABLE
     via_init();
 #endif
@@ -541,6 +554,9 @@ void keyboard_init(void) {
 #ifdef HAPTIC_ENABLE
     haptic_init();
 #endif
+#ifdef DYNAMIC_MACRO_ENABLE
+    dynamic_macro_init();
+#endif
 
 #if defined(DEBUG_MATRIX_SCAN_RATE) && defined(CONSOLE_ENABLE)
     debug_enable = true;
@@ -555,11 +571,19 @@ void keyboard_init(void) {
  * This is differnet than keycode events as no layer processing, or filtering occurs.
  */
 void switch_events(uint8_t row, uint8_t col, bool pressed) {
+    const uint16_t time = sync_timer_read();
+#if defined(SPLIT_KEYBOARD) && defined(SPLIT_SWITCH_EVENTS_ENABLE)
+    if (!split_forward_switch_event(row, col, pressed, time)) return;
+#endif
+    switch_events_at(row, col, pressed, time);
+}
+
+void switch_events_at(uint8_t row, uint8_t col, bool pressed, uint16_t time) {
 #if defined(LED_MATRIX_ENABLE)
-    led_matrix_handle_key_event(row, col, pressed);
+    led_matrix_handle_key_event_at(row, col, pressed, time);
 #endif
 #if defined(RGB_MATRIX_ENABLE)
-    rgb_matrix_handle_key_event(row, col, pressed);
+    rgb_matrix_handle_key_event_at(row, col, pressed, time);
 #endif
 }
 
@@ -576,6 +600,18 @@ static inline void generate_tick_event(void) {
     }
 }
 
+/**
+ * @brief Queues a key event, processing the oldest queued event first if
+ * there is no room.
+ */
+static void queue_key_event(keyevent_t event) {
+    while (!keyevent_queue_push(event)) {
+        keyevent_t oldest;
+        keyevent_queue_pop(&oldest);
+        action_exec(oldest);
+    }
+}
+
 /**
  * @brief This task scans the keyboards matrix and processes any key presses
  * that occur.
@@ -610,6 +646,8 @@ static bool matrix_task(void) {
     }
 
     const bool process_keypress = should_process_keypress();
+    // Every change found by this scan is stamped with the time it was scanned, however long processing the others takes
+    const uint16_t scan_time = timer_read();
 
     for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
         const matrix_row_t current_row = matrix_get_row(row);
@@ -625,7 +663,7 @@ static bool matrix_task(void) {
                 const bool key_pressed = current_row & col_mask;
 
                 if (process_keypress) {
-                    action_exec(MAKE_KEYEVENT(row, col, key_pressed));
+                    queue_key_event(MAKE_KEYEVENT_AT(row, col, key_pressed, scan_time));
                 }
 
                 switch_events(row, col, key_pressed);
@@ -635,6 +673,11 @@ static bool matrix_task(void) {
         matrix_previous[row] = current_row;
     }
 
+    keyevent_t event;
+    while (keyevent_queue_pop(&event)) {
+        action_exec(event);
+    }
+
     return matrix_changed;
 }
 
@@ -688,6 +731,10 @@ void quantum_task(void) {
     combo_task();
 #endif
 
+#ifdef DYNAMIC_MACRO_ENABLE
+    dynamic_macro_task();
+#endif
+
 #ifdef LEADER_ENABLE
     leader_task();
 #endif
@@ -727,6 +774,10 @@ void keyboard_task(void) {
 
     quantum_task();
 
+#ifdef BUS_QUEUE_ENABLE
+    bus_queue_task();
+#endif
+
 #if defined(SPLIT_WATCHDOG_ENABLE)
     split_watchdog_task();
 #endif
@@ -812,4 +863,8 @@ void keyboard_task(void) {
 #ifdef OS_DETECTION_ENABLE
     os_detection_task();
 #endif
+
+#ifdef DEFERRED_LOG_ENABLE
+    deferred_log_task();
+#endif
 }
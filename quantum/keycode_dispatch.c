@@ -0,0 +1,86 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode_dispatch.h"
+#include "keycodes.h"
+#include "progmem.h"
+
+// Keycode ranges each range-bound processor acts upon -- a processor may be listed more than once.
+// clang-format off
+#ifdef UCIS_ENABLE
+// UCIS consumes arbitrary keys while an input sequence is active
+#    define PROCESS_HANDLER_UNICODE_RANGES(X, lo, hi) \
+    X(UNICODE, 0x0000, 0xFFFF, lo, hi)
+#else
+#    define PROCESS_HANDLER_UNICODE_RANGES(X, lo, hi) \
+    X(UNICODE, QK_QUANTUM, QK_QUANTUM_MAX, lo, hi) \
+    X(UNICODE, QK_UNICODE, QK_UNICODE_MAX, lo, hi)
+#endif
+
+#define PROCESS_HANDLER_RANGES(X, lo, hi) \
+    X(VIA,                  QK_MACRO,                QK_MACRO_MAX,                lo, hi) \
+    X(SEQUENCER,            QK_SEQUENCER,            QK_SEQUENCER_MAX,            lo, hi) \
+    X(MIDI,                 QK_MIDI,                 QK_MIDI_MAX,                 lo, hi) \
+    X(AUDIO,                QK_AUDIO,                QK_AUDIO_MAX,                lo, hi) \
+    X(BACKLIGHT,            QK_LIGHTING,             QK_LIGHTING_MAX,             lo, hi) \
+    X(LED_MATRIX,           QK_LIGHTING,             QK_LIGHTING_MAX,             lo, hi) \
+    X(STENO,                QK_STENO,                QK_STENO_MAX,                lo, hi) \
+    X(DYNAMIC_TAPPING_TERM, QK_QUANTUM,              QK_QUANTUM_MAX,              lo, hi) \
+    X(MAGIC,                QK_MAGIC,                QK_MAGIC_MAX,                lo, hi) \
+    X(GRAVE_ESC,            QK_QUANTUM,              QK_QUANTUM_MAX,              lo, hi) \
+    X(UNDERGLOW,            QK_LIGHTING,             QK_LIGHTING_MAX,             lo, hi) \
+    X(RGB_MATRIX,           QK_LIGHTING,             QK_LIGHTING_MAX,             lo, hi) \
+    X(JOYSTICK,             QK_JOYSTICK,             QK_JOYSTICK_MAX,             lo, hi) \
+    X(PROGRAMMABLE_BUTTON,  QK_PROGRAMMABLE_BUTTON,  QK_PROGRAMMABLE_BUTTON_MAX,  lo, hi) \
+    X(TRI_LAYER,            QK_QUANTUM,              QK_QUANTUM_MAX,              lo, hi) \
+    X(DEFAULT_LAYER,        QK_PERSISTENT_DEF_LAYER, QK_PERSISTENT_DEF_LAYER_MAX, lo, hi) \
+    X(CONNECTION,           QK_CONNECTION,           QK_CONNECTION_MAX,           lo, hi) \
+    X(REPEAT_KEY,           QK_QUANTUM,              QK_QUANTUM_MAX,              lo, hi) \
+    X(COMMUNITY_MODULE,     QK_COMMUNITY_MODULE,     QK_COMMUNITY_MODULE_MAX,     lo, hi) \
+    PROCESS_HANDLER_UNICODE_RANGES(X, lo, hi)
+
+#define HANDLER_IF_OVERLAPPING(handler, range_lo, range_hi, segment_lo, segment_hi) \
+    | (((segment_lo) <= (range_hi) && (range_lo) <= (segment_hi)) ? PROCESS_HANDLER_BIT(handler) : 0)
+
+#define SEGMENT_START(lo, hi) lo,
+#define SEGMENT_MASK(lo, hi) (0 PROCESS_HANDLER_RANGES(HANDLER_IF_OVERLAPPING, lo, hi)),
+
+static const uint16_t PROGMEM segment_start[QK_KEYCODE_SEGMENT_COUNT] = {
+    QK_KEYCODE_SEGMENTS(SEGMENT_START)
+};
+
+static const process_handler_mask_t PROGMEM segment_mask[QK_KEYCODE_SEGMENT_COUNT] = {
+    QK_KEYCODE_SEGMENTS(SEGMENT_MASK)
+};
+// clang-format on
+
+process_handler_mask_t keycode_dispatch_mask(uint16_t keycode) {
+    // Find the last segment starting at or below the keycode -- segment 0 always starts at 0x0000
+    uint8_t lo = 0;
+    uint8_t hi = QK_KEYCODE_SEGMENT_COUNT - 1;
+    while (lo < hi) {
+        uint8_t mid = (lo + hi + 1) / 2;
+        if (pgm_read_word(&segment_start[mid]) <= keycode) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return pgm_read_dword(&segment_mask[lo]);
+}
+
+bool keycode_dispatch(const process_record_handler_t *handlers, uint8_t count, uint16_t keycode, keyrecord_t *record) {
+    const process_handler_mask_t wanted = keycode_dispatch_mask(keycode);
+    for (uint8_t i = 0; i < count; i++) {
+        process_handler_mask_t keycodes = pgm_read_dword(&handlers[i].keycodes);
+        if (keycodes != PROCESS_ALL_KEYCODES && (keycodes & wanted) == 0) {
+            continue;
+        }
+
+        bool (*process)(uint16_t, keyrecord_t *) = pgm_read_ptr(&handlers[i].process);
+        if (!process(keycode, record)) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,94 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "compiler_support.h"
+#include "action.h"
+
+/**
+ * @brief Keycode processors which only ever act on a fixed set of keycode ranges.
+ *
+ * The ranges each of these consumes are declared in keycode_dispatch.c. Processors which need to observe every key
+ * (tap dance, caps word, leader, ...) are not listed here, and are registered with `PROCESS_RECORD_ALL_KEYCODES()`.
+ */
+enum process_handler_t {
+    PROCESS_HANDLER_VIA,
+    PROCESS_HANDLER_SEQUENCER,
+    PROCESS_HANDLER_MIDI,
+    PROCESS_HANDLER_AUDIO,
+    PROCESS_HANDLER_BACKLIGHT,
+    PROCESS_HANDLER_LED_MATRIX,
+    PROCESS_HANDLER_STENO,
+    PROCESS_HANDLER_UNICODE,
+    PROCESS_HANDLER_DYNAMIC_TAPPING_TERM,
+    PROCESS_HANDLER_MAGIC,
+    PROCESS_HANDLER_GRAVE_ESC,
+    PROCESS_HANDLER_UNDERGLOW,
+    PROCESS_HANDLER_RGB_MATRIX,
+    PROCESS_HANDLER_JOYSTICK,
+    PROCESS_HANDLER_PROGRAMMABLE_BUTTON,
+    PROCESS_HANDLER_TRI_LAYER,
+    PROCESS_HANDLER_DEFAULT_LAYER,
+    PROCESS_HANDLER_CONNECTION,
+    PROCESS_HANDLER_REPEAT_KEY,
+    PROCESS_HANDLER_COMMUNITY_MODULE,
+    PROCESS_HANDLER_COUNT,
+};
+
+typedef uint32_t process_handler_mask_t;
+
+STATIC_ASSERT(PROCESS_HANDLER_COUNT <= sizeof(process_handler_mask_t) * 8, "Too many keycode processors for process_handler_mask_t");
+
+#define PROCESS_HANDLER_BIT(handler) ((process_handler_mask_t)1 << PROCESS_HANDLER_##handler)
+
+/**
+ * @brief Test whether a processor needs to be invoked for a given dispatch mask.
+ */
+#define PROCESS_HANDLER_WANTS(mask, handler) (((mask) & PROCESS_HANDLER_BIT(handler)) != 0)
+
+/**
+ * @brief Look up the set of range-bound processors interested in the supplied keycode.
+ *
+ * The lookup is a binary search over the keycode range segments generated into keycodes.h, with the per-segment
+ * masks resolved at compile time.
+ *
+ * @param keycode[in] the keycode being processed
+ * @return mask of `PROCESS_HANDLER_BIT()` values
+ */
+process_handler_mask_t keycode_dispatch_mask(uint16_t keycode);
+
+/**
+ * @brief Registration of a keycode processor with keycode_dispatch().
+ */
+typedef struct process_record_handler_t {
+    bool (*process)(uint16_t keycode, keyrecord_t *record);
+    process_handler_mask_t keycodes;
+} process_record_handler_t;
+
+#define PROCESS_ALL_KEYCODES 0
+
+/**
+ * @brief Register a processor which only acts on the keycode ranges declared for `handler`.
+ */
+#define PROCESS_RECORD_HANDLER(function, handler) {.process = (function), .keycodes = PROCESS_HANDLER_BIT(handler)}
+
+/**
+ * @brief Register a processor which needs to observe every key event.
+ */
+#define PROCESS_RECORD_ALL_KEYCODES(function) {.process = (function), .keycodes = PROCESS_ALL_KEYCODES}
+
+/**
+ * @brief Run a keycode through a table of registered processors, in order.
+ *
+ * Processors registered for specific keycode ranges are skipped entirely when the keycode falls outside of them.
+ *
+ * @param handlers[in] PROGMEM table of processors
+ * @param count[in] number of entries in `handlers`
+ * @param keycode[in] the keycode being processed
+ * @param record[in] the key event being processed
+ * @return false if a processor handled the keycode and processing should stop
+ */
+bool keycode_dispatch(const process_record_handler_t *handlers, uint8_t count, uint16_t keycode, keyrecord_t *record);
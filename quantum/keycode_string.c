@@ -14,6 +14,7 @@
 
 #include "keycode_string.h"
 
+#include <stdbool.h>
 #include <string.h>
 #include "bitwise.h"
 #include "keycode.h"
@@ -31,7 +32,7 @@ typedef int_fast8_t index_t;
     ((uint16_t)c5) | (((uint16_t)c6) << 8)
 
 /**
- * @brief Names of some common keycodes.
+ * @brief Names of some common keycodes, sorted by keycode.
  *
  * Each (keycode, name) entry is stored flat in 8 bytes in PROGMEM. Names in
  * this table must be at most 7 chars long and have an underscore '_' for the
@@ -39,6 +40,9 @@ typedef int_fast8_t index_t;
  *
  * To save memory, feature-specific key entries are ifdef'd to include them only
  * when their feature is enabled.
+ *
+ * The table is binary searched, so entries must be kept in ascending keycode
+ * order, as laid out in quantum/keycodes.h.
  */
 static const uint16_t common_names[] PROGMEM = {
     KC_TRNS, KEYCODE_NAME7('K', 'C', '_', 'T', 'R', 'N', 'S'),
@@ -73,70 +77,70 @@ static const uint16_t common_names[] PROGMEM = {
     KC_DOWN, KEYCODE_NAME7('K', 'C', '_', 'D', 'O', 'W', 'N'),
     KC_UP  , KEYCODE_NAME7('K', 'C', '_', 'U', 'P',  0 ,  0 ),
     KC_NUBS, KEYCODE_NAME7('K', 'C', '_', 'N', 'U', 'B', 'S'),
-    KC_HYPR, KEYCODE_NAME7('K', 'C', '_', 'H', 'Y', 'P', 'R'),
-    KC_MEH , KEYCODE_NAME7('K', 'C', '_', 'M', 'E', 'H',  0 ),
 #ifdef EXTRAKEY_ENABLE
+    KC_MUTE, KEYCODE_NAME7('K', 'C', '_', 'M', 'U', 'T', 'E'),
+    KC_VOLU, KEYCODE_NAME7('K', 'C', '_', 'V', 'O', 'L', 'U'),
+    KC_VOLD, KEYCODE_NAME7('K', 'C', '_', 'V', 'O', 'L', 'D'),
+    KC_MNXT, KEYCODE_NAME7('K', 'C', '_', 'M', 'N', 'X', 'T'),
+    KC_MPRV, KEYCODE_NAME7('K', 'C', '_', 'M', 'P', 'R', 'V'),
+    KC_MPLY, KEYCODE_NAME7('K', 'C', '_', 'M', 'P', 'L', 'Y'),
     KC_WHOM, KEYCODE_NAME7('K', 'C', '_', 'W', 'H', 'O', 'M'),
     KC_WBAK, KEYCODE_NAME7('K', 'C', '_', 'W', 'B', 'A', 'K'),
     KC_WFWD, KEYCODE_NAME7('K', 'C', '_', 'W', 'F', 'W', 'D'),
     KC_WSTP, KEYCODE_NAME7('K', 'C', '_', 'W', 'S', 'T', 'P'),
     KC_WREF, KEYCODE_NAME7('K', 'C', '_', 'W', 'R', 'E', 'F'),
-    KC_MNXT, KEYCODE_NAME7('K', 'C', '_', 'M', 'N', 'X', 'T'),
-    KC_MPRV, KEYCODE_NAME7('K', 'C', '_', 'M', 'P', 'R', 'V'),
-    KC_MPLY, KEYCODE_NAME7('K', 'C', '_', 'M', 'P', 'L', 'Y'),
-    KC_MUTE, KEYCODE_NAME7('K', 'C', '_', 'M', 'U', 'T', 'E'),
-    KC_VOLU, KEYCODE_NAME7('K', 'C', '_', 'V', 'O', 'L', 'U'),
-    KC_VOLD, KEYCODE_NAME7('K', 'C', '_', 'V', 'O', 'L', 'D'),
 #endif // EXTRAKEY_ENABLE
 #ifdef MOUSEKEY_ENABLE
-    MS_LEFT, KEYCODE_NAME7('M', 'S', '_', 'L', 'E', 'F', 'T'),
-    MS_RGHT, KEYCODE_NAME7('M', 'S', '_', 'R', 'G', 'H', 'T'),
     MS_UP  , KEYCODE_NAME7('M', 'S', '_', 'U', 'P',  0 ,  0 ),
     MS_DOWN, KEYCODE_NAME7('M', 'S', '_', 'D', 'O', 'W', 'N'),
-    MS_WHLL, KEYCODE_NAME7('M', 'S', '_', 'W', 'H', 'L', 'L'),
-    MS_WHLR, KEYCODE_NAME7('M', 'S', '_', 'W', 'H', 'L', 'R'),
+    MS_LEFT, KEYCODE_NAME7('M', 'S', '_', 'L', 'E', 'F', 'T'),
+    MS_RGHT, KEYCODE_NAME7('M', 'S', '_', 'R', 'G', 'H', 'T'),
     MS_WHLU, KEYCODE_NAME7('M', 'S', '_', 'W', 'H', 'L', 'U'),
     MS_WHLD, KEYCODE_NAME7('M', 'S', '_', 'W', 'H', 'L', 'D'),
+    MS_WHLL, KEYCODE_NAME7('M', 'S', '_', 'W', 'H', 'L', 'L'),
+    MS_WHLR, KEYCODE_NAME7('M', 'S', '_', 'W', 'H', 'L', 'R'),
 #endif // MOUSEKEY_ENABLE
+    KC_MEH , KEYCODE_NAME7('K', 'C', '_', 'M', 'E', 'H',  0 ),
+    KC_HYPR, KEYCODE_NAME7('K', 'C', '_', 'H', 'Y', 'P', 'R'),
 #ifdef SWAP_HANDS_ENABLE
-    SH_ON  , KEYCODE_NAME7('S', 'H', '_', 'O', 'N',  0 ,  0 ),
-    SH_OFF , KEYCODE_NAME7('S', 'H', '_', 'O', 'F', 'F',  0 ),
-    SH_MON , KEYCODE_NAME7('S', 'H', '_', 'M', 'O', 'N',  0 ),
-    SH_MOFF, KEYCODE_NAME7('S', 'H', '_', 'M', 'O', 'F', 'F'),
     SH_TOGG, KEYCODE_NAME7('S', 'H', '_', 'T', 'O', 'G', 'G'),
     SH_TT  , KEYCODE_NAME7('S', 'H', '_', 'T', 'T',  0 ,  0 ),
+    SH_MON , KEYCODE_NAME7('S', 'H', '_', 'M', 'O', 'N',  0 ),
+    SH_MOFF, KEYCODE_NAME7('S', 'H', '_', 'M', 'O', 'F', 'F'),
+    SH_OFF , KEYCODE_NAME7('S', 'H', '_', 'O', 'F', 'F',  0 ),
+    SH_ON  , KEYCODE_NAME7('S', 'H', '_', 'O', 'N',  0 ,  0 ),
 #    if !defined(NO_ACTION_ONESHOT)
     SH_OS  , KEYCODE_NAME7('S', 'H', '_', 'O', 'S',  0 ,  0 ),
 #    endif // !defined(NO_ACTION_ONESHOT)
 #endif // SWAP_HANDS_ENABLE
+    QK_BOOT, KEYCODE_NAME7('Q', 'K', '_', 'B', 'O', 'O', 'T'),
+    DB_TOGG, KEYCODE_NAME7('D', 'B', '_', 'T', 'O', 'G', 'G'),
+    EE_CLR , KEYCODE_NAME7('E', 'E', '_', 'C', 'L', 'R',  0 ),
+#ifdef GRAVE_ESC_ENABLE
+    QK_GESC, KEYCODE_NAME7('Q', 'K', '_', 'G', 'E', 'S', 'C'),
+#endif // GRAVE_ESC_ENABLE
 #ifdef LEADER_ENABLE
     QK_LEAD, KEYCODE_NAME7('Q', 'K', '_', 'L', 'E', 'A', 'D'),
 #endif // LEADER_ENABLE
 #ifdef KEY_LOCK_ENABLE
     QK_LOCK, KEYCODE_NAME7('Q', 'K', '_', 'L', 'O', 'C', 'K'),
 #endif // KEY_LOCK_ENABLE
-#ifdef TRI_LAYER_ENABLE
-    TL_LOWR, KEYCODE_NAME7('T', 'L', '_', 'L', 'O', 'W', 'R'),
-    TL_UPPR, KEYCODE_NAME7('T', 'L', '_', 'U', 'P', 'P', 'R'),
-#endif // TRI_LAYER_ENABLE
-#ifdef GRAVE_ESC_ENABLE
-    QK_GESC, KEYCODE_NAME7('Q', 'K', '_', 'G', 'E', 'S', 'C'),
-#endif // GRAVE_ESC_ENABLE
-#ifdef CAPS_WORD_ENABLE
-    CW_TOGG, KEYCODE_NAME7('C', 'W', '_', 'T', 'O', 'G', 'G'),
-#endif // CAPS_WORD_ENABLE
 #ifdef SECURE_ENABLE
     SE_LOCK, KEYCODE_NAME7('S', 'E', '_', 'L', 'O', 'C', 'K'),
     SE_UNLK, KEYCODE_NAME7('S', 'E', '_', 'U', 'N', 'L', 'K'),
     SE_TOGG, KEYCODE_NAME7('S', 'E', '_', 'T', 'O', 'G', 'G'),
     SE_REQ , KEYCODE_NAME7('S', 'E', '_', 'R', 'E', 'Q',  0 ),
 #endif // SECURE_ENABLE
+#ifdef CAPS_WORD_ENABLE
+    CW_TOGG, KEYCODE_NAME7('C', 'W', '_', 'T', 'O', 'G', 'G'),
+#endif // CAPS_WORD_ENABLE
+#ifdef TRI_LAYER_ENABLE
+    TL_LOWR, KEYCODE_NAME7('T', 'L', '_', 'L', 'O', 'W', 'R'),
+    TL_UPPR, KEYCODE_NAME7('T', 'L', '_', 'U', 'P', 'P', 'R'),
+#endif // TRI_LAYER_ENABLE
 #ifdef LAYER_LOCK_ENABLE
     QK_LLCK, KEYCODE_NAME7('Q', 'K', '_', 'L', 'L', 'C', 'K'),
 #endif // LAYER_LOCK_ENABLE
-    EE_CLR , KEYCODE_NAME7('E', 'E', '_', 'C', 'L', 'R',  0 ),
-    QK_BOOT, KEYCODE_NAME7('Q', 'K', '_', 'B', 'O', 'O', 'T'),
-    DB_TOGG, KEYCODE_NAME7('D', 'B', '_', 'T', 'O', 'G', 'G'),
 };
 // clang-format on
 
@@ -153,44 +157,110 @@ static char buffer[32];
 #define BUFFER_MAX_LEN (sizeof(buffer) - 1)
 static index_t buffer_len;
 
+/** Copies the name of the `common_names` entry at `offset` to a buffer. */
+static const char* common_name_at(int_fast16_t offset) {
+    static uint8_t name[8];
+
+    const uint16_t w0 = pgm_read_word(common_names + offset + 1);
+    const uint16_t w1 = pgm_read_word(common_names + offset + 2);
+    const uint16_t w2 = pgm_read_word(common_names + offset + 3);
+    name[0]           = (uint8_t)w0;
+    name[1]           = (uint8_t)(w0 >> 8);
+    name[2]           = '_';
+    name[3]           = (uint8_t)w1;
+    name[4]           = (uint8_t)(w1 >> 8);
+    name[5]           = (uint8_t)w2;
+    name[6]           = (uint8_t)(w2 >> 8);
+    name[7]           = 0;
+    return (const char*)name;
+}
+
 /** Finds the name of a keycode in `common_names` or returns NULL. */
 static const char* search_common_names(uint16_t keycode) {
-    static uint8_t buffer[8];
-
-    for (int_fast16_t offset = 0; offset < ARRAY_SIZE(common_names); offset += 4) {
-        if (keycode == pgm_read_word(common_names + offset)) {
-            const uint16_t w0 = pgm_read_word(common_names + offset + 1);
-            const uint16_t w1 = pgm_read_word(common_names + offset + 2);
-            const uint16_t w2 = pgm_read_word(common_names + offset + 3);
-            buffer[0]         = (uint8_t)w0;
-            buffer[1]         = (uint8_t)(w0 >> 8);
-            buffer[2]         = '_';
-            buffer[3]         = (uint8_t)w1;
-            buffer[4]         = (uint8_t)(w1 >> 8);
-            buffer[5]         = (uint8_t)w2;
-            buffer[6]         = (uint8_t)(w2 >> 8);
-            buffer[7]         = 0;
-            return (const char*)buffer;
+    int_fast16_t lo = 0;
+    int_fast16_t hi = ARRAY_SIZE(common_names) / 4;
+
+    while (lo < hi) {
+        const int_fast16_t mid         = (lo + hi) / 2;
+        const uint16_t     mid_keycode = pgm_read_word(common_names + 4 * mid);
+        if (mid_keycode < keycode) {
+            lo = mid + 1;
+        } else if (mid_keycode > keycode) {
+            hi = mid;
+        } else {
+            return common_name_at(4 * mid);
         }
     }
 
     return NULL;
 }
 
+/** Whether a table of names is sorted by keycode, as last checked. */
+typedef struct {
+    const keycode_string_name_t* data;
+    uint16_t                     size;
+    bool                         sorted;
+} table_order_t;
+
+static table_order_t user_table_order;
+static table_order_t kb_table_order;
+
+/**
+ * @brief Checks whether a table is sorted by keycode, without duplicates.
+ *
+ * The result is kept in `order`, so the table is only checked again once it
+ * has been swapped for another one.
+ */
+static bool is_table_sorted(const keycode_string_name_t* data, uint16_t size, table_order_t* order) {
+    if (order->data != data || order->size != size) {
+        order->data   = data;
+        order->size   = size;
+        order->sorted = true;
+        for (uint16_t i = 1; i < size; ++i) {
+            if (data[i - 1].keycode >= data[i].keycode) {
+                order->sorted = false;
+                break;
+            }
+        }
+    }
+    return order->sorted;
+}
+
 /**
  * @brief Finds the name of a keycode in table or returns NULL.
  *
+ * Tables sorted by keycode are binary searched, others are searched linearly.
+ *
  * @param data   Pointer to table to be searched.
  * @param size   Numer of entries in the table.
+ * @param order  Cached order of the table.
  * @return Name string for the keycode, or NULL if not found.
  */
-static const char* search_table(const keycode_string_name_t* data, uint16_t size, uint16_t keycode) {
-    if (data != NULL) {
-        for (uint16_t i = 0; i < size; ++i) {
-            if (data[i].keycode == keycode) {
-                return data[i].name;
+static const char* search_table(const keycode_string_name_t* data, uint16_t size, table_order_t* order, uint16_t keycode) {
+    if (data == NULL) {
+        return NULL;
+    }
+
+    if (is_table_sorted(data, size, order)) {
+        uint16_t lo = 0;
+        uint16_t hi = size;
+        while (lo < hi) {
+            const uint16_t mid = lo + (hi - lo) / 2;
+            if (data[mid].keycode < keycode) {
+                lo = mid + 1;
+            } else if (data[mid].keycode > keycode) {
+                hi = mid;
+            } else {
+                return data[mid].name;
             }
         }
+        return NULL;
+    }
+
+    for (uint16_t i = 0; i < size; ++i) {
+        if (data[i].keycode == keycode) {
+            return data[i].name;
+        }
     }
     return NULL;
 }
@@ -289,12 +359,12 @@ static void append_numbered_keycode(const char* name, uint16_t number) {
 static void append_keycode(uint16_t keycode) {
     // In case there is overlap among tables, search `keycode_string_names_user`
     // first so that it takes precedence.
-    const char* keycode_name = search_table(keycode_string_names_data_user, keycode_string_names_size_user, keycode);
+    const char* keycode_name = search_table(keycode_string_names_data_user, keycode_string_names_size_user, &user_table_order, keycode);
     if (keycode_name) {
         append(keycode_name);
         return;
     }
-    keycode_name = search_table(keycode_string_names_data_kb, keycode_string_names_size_kb, keycode);
+    keycode_name = search_table(keycode_string_names_data_kb, keycode_string_names_size_kb, &kb_table_order, keycode);
     if (keycode_name) {
         append(keycode_name);
         return;
@@ -562,3 +632,384 @@ const char* get_keycode_string(uint16_t keycode) {
     append_keycode(keycode);
     return buffer;
 }
+
+/** Returns the 5-bit mods of the mod at `index` from KC_LCTL. */
+static uint8_t mod_bits(uint8_t index) {
+    return (index > 3 ? 0x10 : 0) | (1 << (index & 3));
+}
+
+/** Finds the end of the name starting at `str`, at a '(', ')', ',' or the end of the string. */
+static const char* token_end(const char* str) {
+    while (*str != '\0' && *str != '(' && *str != ')' && *str != ',') {
+        ++str;
+    }
+    return str;
+}
+
+/**
+ * @brief Whether the name from `str` to `end` equals `name`.
+ * @note `name` is a PROGMEM string.
+ */
+static bool token_equals(const char* str, const char* end, const char* name) {
+    for (; str < end; ++str, ++name) {
+        if (*str != (char)pgm_read_byte(name)) {
+            return false;
+        }
+    }
+    return pgm_read_byte(name) == '\0';
+}
+
+/**
+ * @brief Consumes `prefix` if `*str` starts with it.
+ * @note `prefix` is a PROGMEM string.
+ */
+static bool parse_prefix(const char** str, const char* prefix) {
+    const char* s = *str;
+    for (char c; (c = (char)pgm_read_byte(prefix)) != '\0'; ++prefix, ++s) {
+        if (*s != c) {
+            return false;
+        }
+    }
+    *str = s;
+    return true;
+}
+
+/** Consumes the char `c` if `*str` starts with it. */
+static bool parse_char(const char** str, char c) {
+    if (**str != c) {
+        return false;
+    }
+    ++*str;
+    return true;
+}
+
+/** Consumes a number in `base`, either 10 or 16, as formatted by number_string(). */
+static bool parse_number(const char** str, int8_t base, uint16_t* number) {
+    const char* s = *str;
+    if (base == 16 && !parse_prefix(&s, PSTR("0x"))) {
+        return false;
+    }
+
+    const char* digits = s;
+    uint32_t    value  = 0;
+    for (;; ++s) {
+        uint8_t digit;
+        if (*s >= '0' && *s <= '9') {
+            digit = *s - '0';
+        } else if (base == 16 && *s >= 'A' && *s <= 'F') {
+            digit = *s - ('A' - 10);
+        } else {
+            break;
+        }
+        value = value * base + digit;
+        if (value > UINT16_MAX) {
+            return false;
+        }
+    }
+    if (s == digits) {
+        return false;
+    }
+
+    *number = (uint16_t)value;
+    *str    = s;
+    return true;
+}
+
+/** Consumes a mod name like "LSFT" or "RCTL", as the index of the mod from KC_LCTL. */
+static bool parse_mod_name(const char** str, uint8_t* index) {
+    const bool is_rhs = **str == 'R';
+    if (!is_rhs && **str != 'L') {
+        return false;
+    }
+    for (uint8_t i = 0; i < 4; ++i) {
+        const char* s = *str + 1;
+        if (parse_prefix(&s, &mod_names[4 * i])) {
+            *index = (is_rhs ? 4 : 0) + i;
+            *str   = s;
+            return true;
+        }
+    }
+    return false;
+}
+
+/** Consumes 5-bit mods, as formatted by append_5_bit_mods(). */
+static bool parse_5_bit_mods(const char** str, uint8_t* mods) {
+    const char* s = *str;
+    uint8_t     index;
+    uint16_t    number;
+    if (parse_prefix(&s, PSTR("MOD_"))) {
+        if (!parse_mod_name(&s, &index)) {
+            return false;
+        }
+        *mods = mod_bits(index);
+    } else if (parse_number(&s, 16, &number) && number <= 0x1F) {
+        *mods = (uint8_t)number;
+    } else {
+        return false;
+    }
+    *str = s;
+    return true;
+}
+
+/** Finds the keycode named from `str` to `end` in a table of names. */
+static bool find_table_name(const keycode_string_name_t* data, uint16_t size, const char* str, const char* end, uint16_t* keycode) {
+    const size_t length = end - str;
+    for (uint16_t i = 0; data != NULL && i < size; ++i) {
+        if (strncmp(data[i].name, str, length) == 0 && data[i].name[length] == '\0') {
+            *keycode = data[i].keycode;
+            return true;
+        }
+    }
+    return false;
+}
+
+/** Finds the keycode named from `str` to `end` in `common_names`. */
+static bool find_common_name(const char* str, const char* end, uint16_t* keycode) {
+    const size_t length = end - str;
+    if (length > 7) {
+        return false;
+    }
+    for (int_fast16_t offset = 0; offset < (int_fast16_t)ARRAY_SIZE(common_names); offset += 4) {
+        const char* name = common_name_at(offset);
+        if (strncmp(name, str, length) == 0 && name[length] == '\0') {
+            *keycode = pgm_read_word(common_names + offset);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Parses a name of the format `prefix` + `number`, for the keycodes
+ * `min` to `max` numbered from `first`.
+ * @note `prefix` is a PROGMEM string.
+ */
+static bool parse_numbered_name(const char* str, const char* end, const char* prefix, uint16_t first, uint16_t min, uint16_t max, uint16_t* keycode) {
+    uint16_t number;
+    if (!parse_prefix(&str, prefix) || !parse_number(&str, 10, &number) || str != end || number < first || number - first > max - min) {
+        return false;
+    }
+    *keycode = min + (number - first);
+    return true;
+}
+
+/** Parses the keycode named from `str` to `end`, as formatted by append_keycode(). */
+static bool parse_name(const char* str, const char* end, uint16_t* keycode) {
+    // Same precedence as when formatting.
+    if (find_table_name(keycode_string_names_data_user, keycode_string_names_size_user, str, end, keycode) || find_table_name(keycode_string_names_data_kb, keycode_string_names_size_kb, str, end, keycode) || find_common_name(str, end, keycode)) {
+        return true;
+    }
+
+    const char* s = str;
+    uint16_t    number;
+    if (parse_number(&s, 16, &number) && s == end) {
+        *keycode = number;
+        return true;
+    }
+
+    s = str;
+    if (parse_prefix(&s, PSTR("KC_"))) {
+        uint8_t index;
+        if (end - s == 1 && *s >= 'A' && *s <= 'Z') {
+            *keycode = KC_A + (*s - 'A');
+            return true;
+        }
+        if (parse_mod_name(&s, &index) && s == end) {
+            *keycode = KC_LCTL + index;
+            return true;
+        }
+    }
+
+    // clang-format off
+    return parse_numbered_name(str, end, PSTR("KC_"), 1, KC_1, KC_9, keycode)
+        || parse_numbered_name(str, end, PSTR("KC_"), 0, KC_0, KC_0, keycode)
+        || parse_numbered_name(str, end, PSTR("KC_KP_"), 1, KC_KP_1, KC_KP_9, keycode)
+        || parse_numbered_name(str, end, PSTR("KC_KP_"), 0, KC_KP_0, KC_KP_0, keycode)
+        || parse_numbered_name(str, end, PSTR("KC_F"), 1, KC_F1, KC_F12, keycode)
+        || parse_numbered_name(str, end, PSTR("KC_F"), 13, KC_F13, KC_F24, keycode)
+        || parse_numbered_name(str, end, PSTR("MS_BTN"), 1, MS_BTN1, MS_BTN8, keycode)
+        || parse_numbered_name(str, end, PSTR("JS_"), 0, JS_0, JS_31, keycode)
+        || parse_numbered_name(str, end, PSTR("PB_"), 1, PB_1, PB_32, keycode)
+        || parse_numbered_name(str, end, PSTR("MC_"), 0, MC_0, MC_31, keycode)
+        || parse_numbered_name(str, end, PSTR("QK_KB_"), 0, QK_KB_0, QK_KB_31, keycode)
+        || parse_numbered_name(str, end, PSTR("QK_USER_"), 0, QK_USER_0, QK_USER_31, keycode)
+        || parse_numbered_name(str, end, PSTR("QK_MAGIC+"), 0, QK_MAGIC, QK_MAGIC_MAX, keycode)
+        || parse_numbered_name(str, end, PSTR("QK_MIDI+"), 0, QK_MIDI, QK_MIDI_MAX, keycode)
+        || parse_numbered_name(str, end, PSTR("QK_SEQUENCER+"), 0, QK_SEQUENCER, QK_SEQUENCER_MAX, keycode)
+        || parse_numbered_name(str, end, PSTR("QK_AUDIO+"), 0, QK_AUDIO, QK_AUDIO_MAX, keycode)
+        || parse_numbered_name(str, end, PSTR("QK_LIGHTING+"), 0, QK_LIGHTING, QK_LIGHTING_MAX, keycode)
+        || parse_numbered_name(str, end, PSTR("QK_STENO+"), 0, QK_STENO, QK_STENO_MAX, keycode)
+        || parse_numbered_name(str, end, PSTR("QK_CONNECTION+"), 0, QK_CONNECTION, QK_CONNECTION_MAX, keycode)
+        || parse_numbered_name(str, end, PSTR("QK_QUANTUM+"), 0, QK_QUANTUM, QK_QUANTUM_MAX, keycode);
+    // clang-format on
+}
+
+/** Keycodes of the format `name` + "(" + `number` + ")", for the keycodes `min` to `max`. */
+typedef struct {
+    char     name[4];
+    uint16_t min;
+    uint16_t max;
+    int8_t   base;
+} unary_keycode_t;
+
+// clang-format off
+static const unary_keycode_t unary_keycodes[] PROGMEM = {
+    {"TO",  QK_TO,                   QK_TO_MAX,                   10},
+    {"MO",  QK_MOMENTARY,            QK_MOMENTARY_MAX,            10},
+    {"DF",  QK_DEF_LAYER,            QK_DEF_LAYER_MAX,            10},
+    {"TG",  QK_TOGGLE_LAYER,         QK_TOGGLE_LAYER_MAX,         10},
+    {"OSL", QK_ONE_SHOT_LAYER,       QK_ONE_SHOT_LAYER_MAX,       10},
+    {"TT",  QK_LAYER_TAP_TOGGLE,     QK_LAYER_TAP_TOGGLE_MAX,     10},
+    {"PDF", QK_PERSISTENT_DEF_LAYER, QK_PERSISTENT_DEF_LAYER_MAX, 10},
+    {"TD",  QK_TAP_DANCE,            QK_TAP_DANCE_MAX,            10},
+    {"UC",  QK_UNICODE,              QK_UNICODE_MAX,              16},
+    {"UM",  QK_UNICODEMAP,           QK_UNICODEMAP_MAX,           10},
+};
+// clang-format on
+
+static bool parse_keycode(const char** str, uint16_t* keycode);
+
+/** Consumes a basic keycode, the argument of modified and tap keycodes. */
+static bool parse_basic_keycode(const char** str, uint16_t* keycode) {
+    return parse_keycode(str, keycode) && *keycode <= 0xFF;
+}
+
+/**
+ * @brief Parses the arguments of a keycode of the format `name` + "(" +
+ * arguments + ")", with `*args` just past the opening parenthesis.
+ */
+static bool parse_call(const char* name, const char* end, const char** args, uint16_t* keycode) {
+    uint16_t number;
+    uint16_t basic;
+    uint8_t  mods;
+    uint8_t  index;
+
+    for (uint8_t i = 0; i < ARRAY_SIZE(unary_keycodes); ++i) {
+        const unary_keycode_t* unary = &unary_keycodes[i];
+        if (token_equals(name, end, unary->name)) {
+            const uint16_t min = pgm_read_word(&unary->min);
+            if (!parse_number(args, (int8_t)pgm_read_byte(&unary->base), &number) || number > pgm_read_word(&unary->max) - min) {
+                return false;
+            }
+            *keycode = min + number;
+            return true;
+        }
+    }
+
+    if (token_equals(name, end, PSTR("OSM"))) {
+        if (!parse_5_bit_mods(args, &mods)) {
+            return false;
+        }
+        *keycode = OSM(mods);
+        return true;
+    }
+
+    if (token_equals(name, end, PSTR("LT"))) {
+        if (!parse_number(args, 10, &number) || number > 15 || !parse_char(args, ',') || !parse_basic_keycode(args, &basic)) {
+            return false;
+        }
+        *keycode = LT(number, basic);
+        return true;
+    }
+
+    if (token_equals(name, end, PSTR("LM"))) {
+        if (!parse_number(args, 10, &number) || number > 15 || !parse_char(args, ',') || !parse_5_bit_mods(args, &mods)) {
+            return false;
+        }
+        *keycode = LM(number, mods);
+        return true;
+    }
+
+    if (token_equals(name, end, PSTR("UP"))) {
+        uint16_t shifted;
+        if (!parse_number(args, 10, &number) || number > 127 || !parse_char(args, ',') || !parse_number(args, 10, &shifted) || shifted > 127) {
+            return false;
+        }
+        *keycode = UP(number, shifted);
+        return true;
+    }
+
+    if (token_equals(name, end, PSTR("SH_T"))) {
+        if (!parse_basic_keycode(args, &basic) || IS_SWAP_HANDS_KEYCODE(SH_T(basic))) {
+            return false;
+        }
+        *keycode = SH_T(basic);
+        return true;
+    }
+
+    // Mod-tap keys MT(mod,kc), LSFT_T(kc), HYPR_T(kc), etc.
+    const char* s          = name;
+    bool        is_mod_tap = true;
+    if (token_equals(name, end, PSTR("MT"))) {
+        if (!parse_number(args, 16, &number) || number > 0x1F || !parse_char(args, ',')) {
+            return false;
+        }
+        mods = (uint8_t)number;
+    } else if (parse_mod_name(&s, &index) && token_equals(s, end, PSTR("_T"))) {
+        mods = mod_bits(index);
+    } else if (token_equals(name, end, PSTR("HYPR_T"))) {
+        mods = MOD_HYPR;
+    } else if (token_equals(name, end, PSTR("MEH_T"))) {
+        mods = MOD_MEH;
+    } else {
+        is_mod_tap = false;
+    }
+    if (is_mod_tap) {
+        if (!parse_basic_keycode(args, &basic)) {
+            return false;
+        }
+        *keycode = MT(mods, basic);
+        return true;
+    }
+
+    // Modified keys, written either S(kc) or RSFT(kc).
+    s = name;
+    if (parse_mod_name(&s, &index) && s == end) {
+        mods = mod_bits(index);
+    } else if (end - name == 1) {
+        for (index = 0; index < 4 && *name != (char)pgm_read_byte(&mod_names[4 * index]); ++index) {
+        }
+        if (index == 4) {
+            return false;
+        }
+        mods = mod_bits(index);
+    } else {
+        return false;
+    }
+    if (!parse_basic_keycode(args, &basic)) {
+        return false;
+    }
+    // The mods are the high byte as is, like for QK_LCTL, QK_LSFT, etc.
+    *keycode = ((uint16_t)mods << 8) | basic;
+    return true;
+}
+
+/** Consumes a keycode, as formatted by append_keycode(). */
+static bool parse_keycode(const char** str, uint16_t* keycode) {
+    const char* name = *str;
+    const char* end  = token_end(name);
+    const char* s    = end;
+
+    if (!parse_char(&s, '(')) {
+        if (!parse_name(name, end, keycode)) {
+            return false;
+        }
+        *str = end;
+        return true;
+    }
+
+    if (!parse_call(name, end, &s, keycode) || !parse_char(&s, ')')) {
+        return false;
+    }
+    *str = s;
+    return true;
+}
+
+bool parse_keycode_string(const char* str, uint16_t* keycode) {
+    uint16_t result;
+    if (!parse_keycode(&str, &result) || *str != '\0') {
+        return false;
+    }
+    *keycode = result;
+    return true;
+}
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #if KEYCODE_STRING_ENABLE
@@ -70,6 +71,23 @@
  */
 const char* get_keycode_string(uint16_t keycode);
 
+/**
+ * @brief Parses a keycode from a string, the reverse of `get_keycode_string()`.
+ *
+ * Given a string, like "LT(2,KC_SPC)", this function finds the keycode it
+ * names, like `LT(2, KC_SPC)`. This is useful for textual commands naming
+ * keycodes, for instance to change a keymap over raw HID.
+ *
+ * Any string formatted by `get_keycode_string()` is understood, including the
+ * names in `keycode_string_names_user` and `keycode_string_names_kb`, along
+ * with hex values like "0x1ABC". Spaces are not allowed.
+ *
+ * @param str      String to parse.
+ * @param keycode  Where to write the keycode, left alone if `str` is invalid.
+ * @return         Whether `str` names a keycode.
+ */
+bool parse_keycode_string(const char* str, uint16_t* keycode);
+
 /** Defines a human-readable name for a keycode. */
 typedef struct {
     uint16_t    keycode;
@@ -93,6 +111,9 @@ typedef struct {
  *
  * The above defines names for `MYMACRO1` and `MYMACRO2`, and overrides
  * `KC_EXLM` to format as "KC_EXLM" instead of the default "S(KC_1)".
+ *
+ * Tables listing their keycodes in ascending order are binary searched, others
+ * are searched linearly.
  */
 #    define KEYCODE_STRING_NAMES_USER(...)                                          \
     static const keycode_string_name_t keycode_string_names_user[] = {__VA_ARGS__}; \
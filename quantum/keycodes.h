@@ -100,6 +100,45 @@ enum qk_keycode_ranges {
     QK_UNICODEMAP_PAIR_MAX         = 0xFFFF,
 };
 
+// Range Segments
+#define QK_KEYCODE_SEGMENT_COUNT 35
+#define QK_KEYCODE_SEGMENTS(X) \
+    X(0x0000, 0x00FF) \
+    X(0x0100, 0x1FFF) \
+    X(0x2000, 0x3FFF) \
+    X(0x4000, 0x4FFF) \
+    X(0x5000, 0x51FF) \
+    X(0x5200, 0x521F) \
+    X(0x5220, 0x523F) \
+    X(0x5240, 0x525F) \
+    X(0x5260, 0x527F) \
+    X(0x5280, 0x529F) \
+    X(0x52A0, 0x52BF) \
+    X(0x52C0, 0x52DF) \
+    X(0x52E0, 0x52FF) \
+    X(0x5300, 0x55FF) \
+    X(0x5600, 0x56FF) \
+    X(0x5700, 0x57FF) \
+    X(0x5800, 0x6FFF) \
+    X(0x7000, 0x70FF) \
+    X(0x7100, 0x71FF) \
+    X(0x7200, 0x73FF) \
+    X(0x7400, 0x743F) \
+    X(0x7440, 0x747F) \
+    X(0x7480, 0x74BF) \
+    X(0x74C0, 0x74FF) \
+    X(0x7500, 0x76FF) \
+    X(0x7700, 0x777F) \
+    X(0x7780, 0x77BF) \
+    X(0x77C0, 0x77FF) \
+    X(0x7800, 0x78FF) \
+    X(0x7900, 0x7BFF) \
+    X(0x7C00, 0x7DFF) \
+    X(0x7E00, 0x7E3F) \
+    X(0x7E40, 0x7FFF) \
+    X(0x8000, 0xBFFF) \
+    X(0xC000, 0xFFFF)
+
 enum qk_keycode_defines {
 // Keycodes
     KC_NO = 0x0000,
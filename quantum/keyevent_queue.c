@@ -0,0 +1,45 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyevent_queue.h"
+
+static keyevent_t queue[KEYEVENT_QUEUE_SIZE];
+static uint8_t    head       = 0;
+static uint8_t    depth      = 0;
+static uint8_t    high_water = 0;
+
+bool keyevent_queue_push(keyevent_t event) {
+    if (depth == KEYEVENT_QUEUE_SIZE) {
+        return false;
+    }
+
+    queue[(head + depth) % KEYEVENT_QUEUE_SIZE] = event;
+    depth++;
+    if (depth > high_water) {
+        high_water = depth;
+    }
+    return true;
+}
+
+bool keyevent_queue_pop(keyevent_t *event) {
+    if (depth == 0) {
+        return false;
+    }
+
+    *event = queue[head];
+    head   = (head + 1) % KEYEVENT_QUEUE_SIZE;
+    depth--;
+    return true;
+}
+
+uint8_t keyevent_queue_depth(void) {
+    return depth;
+}
+
+uint8_t keyevent_queue_high_water(void) {
+    return high_water;
+}
+
+void keyevent_queue_reset_high_water(void) {
+    high_water = depth;
+}
@@ -0,0 +1,57 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "keyboard.h"
+
+/**
+ * @def Number of key events that can wait between a matrix scan and their processing. When the queue is full, the oldest
+ * event is processed to make room, so no events are lost.
+ */
+#ifndef KEYEVENT_QUEUE_SIZE
+#    define KEYEVENT_QUEUE_SIZE 16
+#endif
+
+#if KEYEVENT_QUEUE_SIZE < 1 || KEYEVENT_QUEUE_SIZE > 255
+#    error KEYEVENT_QUEUE_SIZE must be between 1 and 255
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Adds an event to the end of the queue.
+ *
+ * @return false if the queue is full
+ */
+bool keyevent_queue_push(keyevent_t event);
+
+/**
+ * @brief Takes the oldest event off the queue.
+ *
+ * @return false if the queue is empty
+ */
+bool keyevent_queue_pop(keyevent_t *event);
+
+/**
+ * @brief Number of events currently waiting.
+ */
+uint8_t keyevent_queue_depth(void);
+
+/**
+ * @brief Most events that have been waiting at once, since startup or the last `keyevent_queue_reset_high_water()`.
+ *
+ * A high water mark close to `KEYEVENT_QUEUE_SIZE` means events were processed early to make room.
+ */
+uint8_t keyevent_queue_high_water(void);
+
+void keyevent_queue_reset_high_water(void);
+
+#ifdef __cplusplus
+}
+#endif
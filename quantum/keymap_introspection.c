@@ -109,16 +109,28 @@ __attribute__((weak)) uint16_t combo_count(void) {
 
 STATIC_ASSERT(ARRAY_SIZE(key_combos) <= (QK_KB), "Number of combos is abnormally high. Are you using SAFE_RANGE in an enum for combos?");
 
-combo_t* combo_get_raw(uint16_t combo_idx) {
+const combo_t* combo_get_raw(uint16_t combo_idx) {
     if (combo_idx >= combo_count_raw()) {
         return NULL;
     }
     return &key_combos[combo_idx];
 }
-__attribute__((weak)) combo_t* combo_get(uint16_t combo_idx) {
+__attribute__((weak)) const combo_t* combo_get(uint16_t combo_idx) {
     return combo_get_raw(combo_idx);
 }
 
+#    ifndef COMBO_MAX_COUNT
+#        define COMBO_MAX_COUNT ARRAY_SIZE(key_combos)
+#    endif
+
+STATIC_ASSERT(ARRAY_SIZE(key_combos) <= COMBO_MAX_COUNT, "COMBO_MAX_COUNT is smaller than the number of combos in key_combos");
+
+uint8_t combo_disabled_bitset[(COMBO_MAX_COUNT + 7) / 8];
+
+uint16_t combo_count_max(void) {
+    return COMBO_MAX_COUNT;
+}
+
 #endif // defined(COMBO_ENABLE)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -136,14 +148,14 @@ __attribute__((weak)) uint16_t tap_dance_count(void) {
 
 STATIC_ASSERT(ARRAY_SIZE(tap_dance_actions) <= (QK_TAP_DANCE_MAX - QK_TAP_DANCE), "Number of tap dance actions exceeds maximum. Are you using SAFE_RANGE in tap dance enum?");
 
-tap_dance_action_t* tap_dance_get_raw(uint16_t tap_dance_idx) {
+const tap_dance_action_t* tap_dance_get_raw(uint16_t tap_dance_idx) {
     if (tap_dance_idx >= tap_dance_count_raw()) {
         return NULL;
     }
     return &tap_dance_actions[tap_dance_idx];
 }
 
-__attribute__((weak)) tap_dance_action_t* tap_dance_get(uint16_t tap_dance_idx) {
+__attribute__((weak)) const tap_dance_action_t* tap_dance_get(uint16_t tap_dance_idx) {
     return tap_dance_get_raw(tap_dance_idx);
 }
 
@@ -62,9 +62,15 @@ uint16_t combo_count_raw(void);
 uint16_t combo_count(void);
 
 // Get the combo definition, stored in firmware rather than any other persistent storage
-combo_t* combo_get_raw(uint16_t combo_idx);
+const combo_t* combo_get_raw(uint16_t combo_idx);
 // Get the combo definition, potentially stored dynamically
-combo_t* combo_get(uint16_t combo_idx);
+const combo_t* combo_get(uint16_t combo_idx);
+
+// The most combos combo_count() may return, COMBO_MAX_COUNT or the number of combos in key_combos by default
+uint16_t combo_count_max(void);
+
+// One bit per combo, set while the combo is disabled. Sized for combo_count_max() combos.
+extern uint8_t combo_disabled_bitset[];
 
 #endif // defined(COMBO_ENABLE)
 
@@ -83,9 +89,9 @@ uint16_t tap_dance_count_raw(void);
 uint16_t tap_dance_count(void);
 
 // Get the tap dance definitions, stored in firmware rather than any other persistent storage
-tap_dance_action_t* tap_dance_get_raw(uint16_t tap_dance_idx);
+const tap_dance_action_t* tap_dance_get_raw(uint16_t tap_dance_idx);
 // Get the tap dance definitions, potentially stored dynamically
-tap_dance_action_t* tap_dance_get(uint16_t tap_dance_idx);
+const tap_dance_action_t* tap_dance_get(uint16_t tap_dance_idx);
 
 #endif // defined(TAP_DANCE_ENABLE)
 
@@ -23,6 +23,7 @@
 #include "keyboard.h"
 #include "sync_timer.h"
 #include "debug.h"
+#include "render_budget.h"
 #include <string.h>
 #include <math.h>
 #include <stdlib.h>
@@ -88,6 +89,8 @@ static last_hit_t last_hit_buffer;
 const uint8_t k_led_matrix_split[2] = LED_MATRIX_SPLIT;
 #endif
 
+static render_budget_t led_render_budget;
+
 EECONFIG_DEBOUNCE_HELPER(led_matrix, led_matrix_eeconfig);
 
 void eeconfig_force_flush_led_matrix(void) {
@@ -171,6 +174,10 @@ void led_matrix_set_value_all(uint8_t value) {
 }
 
 void led_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed) {
+    led_matrix_handle_key_event_at(row, col, pressed, sync_timer_read());
+}
+
+void led_matrix_handle_key_event_at(uint8_t row, uint8_t col, bool pressed, uint16_t time) {
 #ifndef LED_MATRIX_SPLIT
     if (!is_keyboard_master()) return;
 #endif
@@ -201,7 +208,7 @@ void led_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed) {
         last_hit_buffer.x[index]     = g_led_config.point[led[i]].x;
         last_hit_buffer.y[index]     = g_led_config.point[led[i]].y;
         last_hit_buffer.index[index] = led[i];
-        last_hit_buffer.tick[index]  = 0;
+        last_hit_buffer.tick[index]  = sync_timer_elapsed(time);
         last_hit_buffer.count++;
     }
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
@@ -250,6 +257,13 @@ static void led_task_sync(void) {
 static void led_task_start(void) {
     // reset iter
     led_effect_params.iter = 0;
+#if LED_MATRIX_RENDER_BUDGET_US > 0
+#    if defined(LED_MATRIX_SPLIT)
+    render_budget_start_frame(&led_render_budget, is_keyboard_left() ? 0 : k_led_matrix_split[0]);
+#    else
+    render_budget_start_frame(&led_render_budget, 0);
+#    endif
+#endif // LED_MATRIX_RENDER_BUDGET_US > 0
 
     // update double buffers
     g_led_timer = led_timer_buffer;
@@ -269,6 +283,14 @@ static void led_task_render(uint8_t effect) {
         led_matrix_set_value_all(0);
     }
 
+#if LED_MATRIX_RENDER_BUDGET_US > 0
+#    if defined(LED_MATRIX_SPLIT)
+    render_budget_begin(&led_render_budget, is_keyboard_left() ? k_led_matrix_split[0] : LED_MATRIX_LED_COUNT);
+#    else
+    render_budget_begin(&led_render_budget, LED_MATRIX_LED_COUNT);
+#    endif
+#endif // LED_MATRIX_RENDER_BUDGET_US > 0
+
     // each effect can opt to do calculations
     // and/or request PWM buffer updates.
     switch (effect) {
@@ -311,6 +333,10 @@ static void led_task_render(uint8_t effect) {
             // ---------------------------------------------
     }
 
+#if LED_MATRIX_RENDER_BUDGET_US > 0
+    render_budget_end(&led_render_budget);
+#endif // LED_MATRIX_RENDER_BUDGET_US > 0
+
     led_effect_params.iter++;
 
     // next task
@@ -330,6 +356,7 @@ static void led_task_flush(uint8_t effect) {
 
     // update pwm buffers
     led_matrix_update_pwm_buffers();
+    render_budget_frame_done(&led_render_budget);
 
     // next task
     led_task_state = SYNCING;
@@ -412,7 +439,11 @@ __attribute__((weak)) bool led_matrix_indicators_advanced_user(uint8_t led_min,
 
 struct led_matrix_limits_t led_matrix_get_limits(uint8_t iter) {
     struct led_matrix_limits_t limits = {0};
-#if defined(LED_MATRIX_LED_PROCESS_LIMIT) && LED_MATRIX_LED_PROCESS_LIMIT > 0 && LED_MATRIX_LED_PROCESS_LIMIT < LED_MATRIX_LED_COUNT
+#if LED_MATRIX_RENDER_BUDGET_US > 0
+    // Chunks are sized as they are rendered, so only the current one is known. It already respects the split.
+    limits.led_min_index = led_render_budget.led_min;
+    limits.led_max_index = led_render_budget.led_max;
+#elif defined(LED_MATRIX_LED_PROCESS_LIMIT) && LED_MATRIX_LED_PROCESS_LIMIT > 0 && LED_MATRIX_LED_PROCESS_LIMIT < LED_MATRIX_LED_COUNT
 #    if defined(LED_MATRIX_SPLIT)
     limits.led_min_index = LED_MATRIX_LED_PROCESS_LIMIT * (iter);
     limits.led_max_index = limits.led_min_index + LED_MATRIX_LED_PROCESS_LIMIT;
@@ -440,6 +471,7 @@ struct led_matrix_limits_t led_matrix_get_limits(uint8_t iter) {
 
 void led_matrix_init(void) {
     led_matrix_driver.init();
+    render_budget_init(&led_render_budget, LED_MATRIX_RENDER_BUDGET_US, LED_MATRIX_LED_PROCESS_LIMIT);
 
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
@@ -475,6 +507,10 @@ bool led_matrix_get_suspend_state(void) {
     return suspend_state;
 }
 
+uint16_t led_matrix_get_frame_rate(void) {
+    return render_budget_frame_rate(&led_render_budget);
+}
+
 void led_matrix_toggle_eeprom_helper(bool write_to_eeprom) {
     led_matrix_eeconfig.enable ^= 1;
     led_task_state = STARTING;
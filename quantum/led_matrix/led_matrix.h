@@ -70,6 +70,10 @@
 #    define LED_MATRIX_LED_PROCESS_LIMIT ((LED_MATRIX_LED_COUNT + 4) / 5)
 #endif
 
+#ifndef LED_MATRIX_RENDER_BUDGET_US
+#    define LED_MATRIX_RENDER_BUDGET_US 0
+#endif
+
 struct led_matrix_limits_t {
     uint8_t led_min_index;
     uint8_t led_max_index;
@@ -133,6 +137,8 @@ void led_matrix_set_value(int index, uint8_t value);
 void led_matrix_set_value_all(uint8_t value);
 
 void led_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed);
+/* Same as led_matrix_handle_key_event(), for a switch that changed at the given sync_timer_read() time */
+void led_matrix_handle_key_event_at(uint8_t row, uint8_t col, bool pressed, uint16_t time);
 
 void led_matrix_task(void);
 
@@ -152,6 +158,7 @@ void led_matrix_reload_from_eeprom(void);
 
 void        led_matrix_set_suspend_state(bool state);
 bool        led_matrix_get_suspend_state(void);
+uint16_t    led_matrix_get_frame_rate(void);
 void        led_matrix_toggle(void);
 void        led_matrix_toggle_noeeprom(void);
 void        led_matrix_enable(void);
@@ -0,0 +1,180 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stdarg.h>
+#include <string.h>
+#include "deferred_log.h"
+#include "atomic_util.h"
+
+#if DEFERRED_LOG_STRING_MAX > 127
+#    error DEFERRED_LOG_STRING_MAX must fit the 7 bit length of a string argument
+#endif
+
+#if DEFERRED_LOG_RECORD_MAX > 253
+#    error DEFERRED_LOG_RECORD_MAX must fit a single COBS block
+#endif
+
+// Encoded size of a record, its COBS overhead and the delimiter
+#define ENCODED_MAX (DEFERRED_LOG_RECORD_MAX + 2)
+
+static uint8_t  buffer[DEFERRED_LOG_BUFFER_SIZE];
+static uint16_t head    = 0;
+static uint16_t tail    = 0;
+static uint16_t dropped = 0;
+
+static sendchar_func_t send = sendchar;
+
+static uint16_t buffer_free(void) {
+    return (tail + DEFERRED_LOG_BUFFER_SIZE - head - 1) % DEFERRED_LOG_BUFFER_SIZE;
+}
+
+static uint8_t put_varint64(uint8_t *dst, uint8_t space, uint64_t value) {
+    uint8_t size = 0;
+    do {
+        if (size == space) {
+            return 0;
+        }
+        uint8_t byte = value & 0x7F;
+        value >>= 7;
+        dst[size++] = value ? byte | 0x80 : byte;
+    } while (value);
+    return size;
+}
+
+static uint8_t put_string(uint8_t *dst, uint8_t space, const char *string) {
+    if (string == NULL) {
+        string = "(null)";
+    }
+    uint8_t length = strnlen(string, DEFERRED_LOG_STRING_MAX + 1);
+    uint8_t flags  = 0;
+    if (length > DEFERRED_LOG_STRING_MAX) {
+        length = DEFERRED_LOG_STRING_MAX;
+        flags  = 0x80;
+    }
+    if (length + 1 > space) {
+        return 0;
+    }
+    dst[0] = length | flags;
+    memcpy(&dst[1], string, length);
+    return length + 1;
+}
+
+/* COBS encodes a record into the queue, followed by its zero delimiter. Records are shorter than a COBS block, so every
+   zero in the data is simply replaced by the distance to the next one. */
+static void push(const uint8_t *record, uint8_t size) {
+    uint8_t encoded[ENCODED_MAX];
+    uint8_t code_index = 0;
+    uint8_t length     = 1;
+
+    for (uint8_t i = 0; i < size; i++) {
+        if (record[i] == 0) {
+            encoded[code_index] = length - code_index;
+            code_index          = length++;
+        } else {
+            encoded[length++] = record[i];
+        }
+    }
+    encoded[code_index] = length - code_index;
+    encoded[length++]   = 0;
+
+    for (uint8_t i = 0; i < length; i++) {
+        buffer[head] = encoded[i];
+        head         = (head + 1) % DEFERRED_LOG_BUFFER_SIZE;
+    }
+}
+
+static bool reserve(uint8_t size) {
+    uint8_t report[4];
+    uint8_t report_size = 0;
+
+    if (dropped) {
+        report[0]   = 0;
+        report_size = 1 + put_varint64(&report[1], sizeof(report) - 1, dropped);
+    }
+
+    // Records may hold up to one extra byte of COBS codes plus the delimiter
+    if (buffer_free() < size + 2 + (report_size ? report_size + 2 : 0)) {
+        if (dropped < UINT16_MAX) {
+            dropped++;
+        }
+        return false;
+    }
+
+    if (report_size) {
+        push(report, report_size);
+        dropped = 0;
+    }
+    return true;
+}
+
+void deferred_log_write(const char *format, uint64_t types, ...) {
+    uint8_t record[DEFERRED_LOG_RECORD_MAX];
+    uint8_t size  = put_varint64(record, sizeof(record), (uintptr_t)format);
+    uint8_t count = types & 0x0F;
+
+    va_list args;
+    va_start(args, types);
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t *dst   = &record[size];
+        uint8_t  space = sizeof(record) - size;
+        uint8_t  used  = 0;
+
+        switch ((types >> (4 + 3 * i)) & 0x07) {
+            case DEFERRED_LOG_ARG_INT: {
+                int32_t value = va_arg(args, int);
+                used          = put_varint64(dst, space, ((uint32_t)value << 1) ^ (uint32_t)(value >> 31));
+                break;
+            }
+            case DEFERRED_LOG_ARG_LONG: {
+                int64_t value = va_arg(args, long);
+                used          = put_varint64(dst, space, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+                break;
+            }
+            case DEFERRED_LOG_ARG_INT64: {
+                int64_t value = va_arg(args, long long);
+                used          = put_varint64(dst, space, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+                break;
+            }
+            case DEFERRED_LOG_ARG_DOUBLE: {
+                float value = va_arg(args, double);
+                if (space >= sizeof(value)) {
+                    memcpy(dst, &value, sizeof(value));
+                    used = sizeof(value);
+                }
+                break;
+            }
+            case DEFERRED_LOG_ARG_STRING:
+                used = put_string(dst, space, va_arg(args, const char *));
+                break;
+        }
+
+        // Out of room, the decoder shows the remaining arguments as missing
+        if (used == 0) {
+            break;
+        }
+        size += used;
+    }
+    va_end(args);
+
+    // xprintf() is also called from threads, the record has to go in whole before anything else is queued
+    ATOMIC_BLOCK_RESTORESTATE {
+        if (reserve(size)) {
+            push(record, size);
+        }
+    }
+}
+
+void deferred_log_task(void) {
+    for (uint8_t i = 0; i < DEFERRED_LOG_DRAIN_SIZE && tail != head; i++) {
+        send(buffer[tail]);
+        tail = (tail + 1) % DEFERRED_LOG_BUFFER_SIZE;
+    }
+}
+
+void deferred_log_set_sendchar(sendchar_func_t func) {
+    send = func;
+}
+
+bool deferred_log_is_empty(void) {
+    return tail == head;
+}
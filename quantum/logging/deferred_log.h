@@ -0,0 +1,140 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sendchar.h"
+
+/*
+  Deferred logging, enabled with DEFERRED_LOG_ENABLE = yes.
+
+  Rather than formatting on the device, xprintf() -- and so dprintf(), ac_dprintf(), qp_dprintf() and friends -- stores
+  the format string in the firmware ELF and queues a compact record of its address and the raw arguments. The queue is
+  drained to the console from the main loop, and `qmk console-decode` formats the records on the host using the ELF.
+
+  Records are COBS encoded and terminated by a zero byte, which keeps them apart from the zero padding of console
+  reports. A record is
+
+    id    varint, address of the format string; 0 is a report of records dropped because the queue was full
+    args  one per argument:
+            integers      zigzag varint
+            double        float, little endian
+            strings       length byte, bit 7 set when truncated, followed by the characters
+*/
+
+#ifndef DEFERRED_LOG_BUFFER_SIZE
+#    define DEFERRED_LOG_BUFFER_SIZE 256
+#endif
+
+#ifndef DEFERRED_LOG_RECORD_MAX
+#    define DEFERRED_LOG_RECORD_MAX 64
+#endif
+
+#ifndef DEFERRED_LOG_STRING_MAX
+#    define DEFERRED_LOG_STRING_MAX 24
+#endif
+
+// A multiple of the console report size, so that the zero padding of a partially filled report only ever follows the end
+// of a record
+#ifndef DEFERRED_LOG_DRAIN_SIZE
+#    define DEFERRED_LOG_DRAIN_SIZE 32
+#endif
+
+// Format strings are only ever read by the host, keep them in flash with the other constants
+#if defined(__AVR__)
+#    define DEFERRED_LOG_SECTION ".progmem.qmk_log"
+#else
+#    define DEFERRED_LOG_SECTION ".rodata.qmk_log"
+#endif
+
+#define DEFERRED_LOG_ARG_INT 0
+#define DEFERRED_LOG_ARG_INT64 1
+#define DEFERRED_LOG_ARG_DOUBLE 2
+#define DEFERRED_LOG_ARG_STRING 3
+#define DEFERRED_LOG_ARG_LONG 4
+
+#define DEFERRED_LOG_MAX_ARGS 14
+
+// Classifies an argument after the default argument promotions, `+ 0` also takes care of bit-fields and arrays. Each
+// class is read back with the va_arg() type of the same size, so long stays apart from long long where int is narrower.
+#define DEFERRED_LOG_ARG_TYPE(arg)                  \
+    _Generic((arg) + 0,                             \
+        char *: DEFERRED_LOG_ARG_STRING,            \
+        const char *: DEFERRED_LOG_ARG_STRING,      \
+        float: DEFERRED_LOG_ARG_DOUBLE,             \
+        double: DEFERRED_LOG_ARG_DOUBLE,            \
+        long: DEFERRED_LOG_ARG_LONG,                \
+        unsigned long: DEFERRED_LOG_ARG_LONG,       \
+        long long: DEFERRED_LOG_ARG_INT64,          \
+        unsigned long long: DEFERRED_LOG_ARG_INT64, \
+        default: (sizeof((arg) + 0) <= sizeof(int) ? DEFERRED_LOG_ARG_INT : sizeof((arg) + 0) == sizeof(long long) ? DEFERRED_LOG_ARG_INT64 : DEFERRED_LOG_ARG_LONG))
+
+#define DEFERRED_LOG_ARG(arg, index) ((uint64_t)DEFERRED_LOG_ARG_TYPE(arg) << (4 + 3 * (index)))
+
+/* clang-format off */
+#define DEFERRED_LOG_NARGS(...) DEFERRED_LOG_NARGS_(_, ##__VA_ARGS__, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define DEFERRED_LOG_NARGS_(_, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, n, ...) n
+
+#define DEFERRED_LOG_TYPES_0()
+#define DEFERRED_LOG_TYPES_1(a) | DEFERRED_LOG_ARG(a, 0)
+#define DEFERRED_LOG_TYPES_2(a, b) DEFERRED_LOG_TYPES_1(a) | DEFERRED_LOG_ARG(b, 1)
+#define DEFERRED_LOG_TYPES_3(a, b, c) DEFERRED_LOG_TYPES_2(a, b) | DEFERRED_LOG_ARG(c, 2)
+#define DEFERRED_LOG_TYPES_4(a, b, c, d) DEFERRED_LOG_TYPES_3(a, b, c) | DEFERRED_LOG_ARG(d, 3)
+#define DEFERRED_LOG_TYPES_5(a, b, c, d, e) DEFERRED_LOG_TYPES_4(a, b, c, d) | DEFERRED_LOG_ARG(e, 4)
+#define DEFERRED_LOG_TYPES_6(a, b, c, d, e, f) DEFERRED_LOG_TYPES_5(a, b, c, d, e) | DEFERRED_LOG_ARG(f, 5)
+#define DEFERRED_LOG_TYPES_7(a, b, c, d, e, f, g) DEFERRED_LOG_TYPES_6(a, b, c, d, e, f) | DEFERRED_LOG_ARG(g, 6)
+#define DEFERRED_LOG_TYPES_8(a, b, c, d, e, f, g, h) DEFERRED_LOG_TYPES_7(a, b, c, d, e, f, g) | DEFERRED_LOG_ARG(h, 7)
+#define DEFERRED_LOG_TYPES_9(a, b, c, d, e, f, g, h, i) DEFERRED_LOG_TYPES_8(a, b, c, d, e, f, g, h) | DEFERRED_LOG_ARG(i, 8)
+#define DEFERRED_LOG_TYPES_10(a, b, c, d, e, f, g, h, i, j) DEFERRED_LOG_TYPES_9(a, b, c, d, e, f, g, h, i) | DEFERRED_LOG_ARG(j, 9)
+#define DEFERRED_LOG_TYPES_11(a, b, c, d, e, f, g, h, i, j, k) DEFERRED_LOG_TYPES_10(a, b, c, d, e, f, g, h, i, j) | DEFERRED_LOG_ARG(k, 10)
+#define DEFERRED_LOG_TYPES_12(a, b, c, d, e, f, g, h, i, j, k, l) DEFERRED_LOG_TYPES_11(a, b, c, d, e, f, g, h, i, j, k) | DEFERRED_LOG_ARG(l, 11)
+#define DEFERRED_LOG_TYPES_13(a, b, c, d, e, f, g, h, i, j, k, l, m) DEFERRED_LOG_TYPES_12(a, b, c, d, e, f, g, h, i, j, k, l) | DEFERRED_LOG_ARG(m, 12)
+#define DEFERRED_LOG_TYPES_14(a, b, c, d, e, f, g, h, i, j, k, l, m, n) DEFERRED_LOG_TYPES_13(a, b, c, d, e, f, g, h, i, j, k, l, m) | DEFERRED_LOG_ARG(n, 13)
+/* clang-format on */
+
+#define DEFERRED_LOG_CONCAT(a, b) DEFERRED_LOG_CONCAT_(a, b)
+#define DEFERRED_LOG_CONCAT_(a, b) a##b
+
+/**
+ * @brief Packs the argument count and the type of each argument into a single constant
+ */
+#define DEFERRED_LOG_ARG_TYPES(...) ((uint64_t)DEFERRED_LOG_NARGS(__VA_ARGS__) DEFERRED_LOG_CONCAT(DEFERRED_LOG_TYPES_, DEFERRED_LOG_NARGS(__VA_ARGS__))(__VA_ARGS__))
+
+/**
+ * @brief Queues a log record, the replacement for xprintf()
+ *
+ * The format has to be a string literal. The arguments are checked against it as they would be by printf().
+ */
+#define deferred_log_printf(fmt, ...)                                                                      \
+    do {                                                                                                   \
+        static const char deferred_log_format[] __attribute__((section(DEFERRED_LOG_SECTION))) = "" fmt;   \
+        if (0) deferred_log_check_format(fmt, ##__VA_ARGS__);                                              \
+        deferred_log_write(deferred_log_format, DEFERRED_LOG_ARG_TYPES(__VA_ARGS__), ##__VA_ARGS__);       \
+    } while (0)
+
+static inline __attribute__((format(printf, 1, 2))) void deferred_log_check_format(const char *format, ...) {}
+
+/**
+ * @brief Encodes a record and queues it for the console
+ *
+ * @param format the format string, its address identifies the record
+ * @param types argument count in bits 0-3, followed by the type of each argument in 3 bits
+ */
+void deferred_log_write(const char *format, uint64_t types, ...);
+
+/**
+ * @brief Hands queued records to the console, at most DEFERRED_LOG_DRAIN_SIZE bytes per call
+ */
+void deferred_log_task(void);
+
+/**
+ * @brief Sets where records are sent to, the console by default
+ */
+void deferred_log_set_sendchar(sendchar_func_t func);
+
+/**
+ * @return true if nothing is waiting to be sent
+ */
+bool deferred_log_is_empty(void);
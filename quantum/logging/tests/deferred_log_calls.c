@@ -0,0 +1,45 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <inttypes.h>
+#include "deferred_log.h"
+#include "deferred_log_calls.h"
+
+void log_no_args(void) {
+    deferred_log_printf("hello\n");
+}
+
+void log_integers(int a, unsigned b, uint8_t c, int16_t d) {
+    deferred_log_printf("%d %u %u %d\n", a, b, c, d);
+}
+
+void log_mixed(long long a, const char *b, double c) {
+    deferred_log_printf("%lld %s %f\n", a, b, c);
+}
+
+void log_longs(uint32_t a, long b, long long c, int d) {
+    deferred_log_printf("%" PRIu32 " %ld %lld %d\n", a, b, c, d);
+}
+
+void log_string(const char *s) {
+    deferred_log_printf("%s\n", s);
+}
+
+void log_bits(void) {
+    struct {
+        unsigned a : 1;
+        unsigned b : 3;
+    } bits = {1, 5};
+    deferred_log_printf("%u %u\n", bits.a, bits.b);
+}
+
+uint64_t arg_types_mixed(void) {
+    char buffer[4] = "abc";
+    struct {
+        unsigned flag : 1;
+    } bits         = {1};
+    uint8_t   byte = 1;
+    long long wide = 1;
+    long      word = 1;
+    return DEFERRED_LOG_ARG_TYPES(bits.flag, buffer, 1.0f, wide, byte, "literal", word);
+}
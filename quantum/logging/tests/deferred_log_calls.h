@@ -0,0 +1,16 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+
+// The logging macros rely on _Generic, so the calls under test are made from C
+
+void     log_no_args(void);
+void     log_integers(int a, unsigned b, uint8_t c, int16_t d);
+void     log_mixed(long long a, const char *b, double c);
+void     log_longs(uint32_t a, long b, long long c, int d);
+void     log_string(const char *s);
+void     log_bits(void);
+uint64_t arg_types_mixed(void);
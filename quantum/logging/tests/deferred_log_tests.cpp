@@ -0,0 +1,240 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "deferred_log.h"
+#include "deferred_log_calls.h"
+}
+
+namespace {
+
+std::vector<uint8_t> console;
+
+struct record_t {
+    uintptr_t            id;
+    std::vector<uint8_t> args;
+};
+
+std::vector<uint8_t> cobs_decode(const std::vector<uint8_t> &frame) {
+    std::vector<uint8_t> out;
+    size_t               i = 0;
+    while (i < frame.size()) {
+        uint8_t code = frame[i];
+        EXPECT_NE(code, 0);
+        EXPECT_LE(i + code, frame.size());
+        out.insert(out.end(), frame.begin() + i + 1, frame.begin() + i + code);
+        i += code;
+        if (code < 0xFF && i < frame.size()) {
+            out.push_back(0);
+        }
+    }
+    return out;
+}
+
+uint64_t read_varint(const std::vector<uint8_t> &data, size_t &pos) {
+    uint64_t value = 0;
+    for (int shift = 0; pos < data.size(); shift += 7) {
+        uint8_t byte = data[pos++];
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            break;
+        }
+    }
+    return value;
+}
+
+int64_t read_signed(const std::vector<uint8_t> &data, size_t &pos) {
+    uint64_t value = read_varint(data, pos);
+    return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+/* Splits what was sent to the console into records */
+std::vector<record_t> records() {
+    std::vector<record_t> result;
+    std::vector<uint8_t>  frame;
+    for (uint8_t byte : console) {
+        if (byte != 0) {
+            frame.push_back(byte);
+            continue;
+        }
+        auto   record = cobs_decode(frame);
+        size_t pos    = 0;
+        auto   id     = read_varint(record, pos);
+        result.push_back({(uintptr_t)id, std::vector<uint8_t>(record.begin() + pos, record.end())});
+        frame.clear();
+    }
+    EXPECT_TRUE(frame.empty());
+    return result;
+}
+
+int8_t capture(uint8_t c) {
+    console.push_back(c);
+    return 0;
+}
+
+void drain() {
+    while (!deferred_log_is_empty()) {
+        deferred_log_task();
+    }
+}
+
+} // namespace
+
+class DeferredLog : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        deferred_log_set_sendchar(capture);
+        drain();
+        console.clear();
+    }
+};
+
+TEST_F(DeferredLog, FormatStringIdentifiesRecord) {
+    log_no_args();
+    drain();
+
+    auto result = records();
+    ASSERT_EQ(result.size(), 1);
+    EXPECT_STREQ((const char *)result[0].id, "hello\n");
+    EXPECT_TRUE(result[0].args.empty());
+}
+
+TEST_F(DeferredLog, IntegerArguments) {
+    log_integers(-2, 300, 0, -32768);
+    drain();
+
+    auto result = records();
+    ASSERT_EQ(result.size(), 1);
+    EXPECT_STREQ((const char *)result[0].id, "%d %u %u %d\n");
+
+    auto  &args = result[0].args;
+    size_t pos  = 0;
+    EXPECT_EQ(read_signed(args, pos), -2);
+    EXPECT_EQ(read_signed(args, pos), 300);
+    EXPECT_EQ(read_signed(args, pos), 0);
+    EXPECT_EQ(read_signed(args, pos), -32768);
+    EXPECT_EQ(pos, args.size());
+}
+
+TEST_F(DeferredLog, MixedArguments) {
+    log_mixed(-(1LL << 40), "abc", 1.5);
+    drain();
+
+    auto result = records();
+    ASSERT_EQ(result.size(), 1);
+
+    auto  &args = result[0].args;
+    size_t pos  = 0;
+    EXPECT_EQ(read_signed(args, pos), -(1LL << 40));
+    ASSERT_EQ(args[pos], 3);
+    EXPECT_EQ(std::string(args.begin() + pos + 1, args.begin() + pos + 4), "abc");
+    pos += 4;
+    float value;
+    ASSERT_EQ(args.size() - pos, sizeof(value));
+    memcpy(&value, &args[pos], sizeof(value));
+    EXPECT_EQ(value, 1.5f);
+}
+
+TEST_F(DeferredLog, LongArguments) {
+    // Where int is 16 bits these are read back as long, not as long long
+    log_longs(UINT32_MAX, -100000L, -(1LL << 40), -1);
+    drain();
+
+    auto result = records();
+    ASSERT_EQ(result.size(), 1);
+    EXPECT_STREQ((const char *)result[0].id, "%" PRIu32 " %ld %lld %d\n");
+
+    auto  &args = result[0].args;
+    size_t pos  = 0;
+    EXPECT_EQ((uint32_t)read_signed(args, pos), UINT32_MAX);
+    EXPECT_EQ(read_signed(args, pos), -100000);
+    EXPECT_EQ(read_signed(args, pos), -(1LL << 40));
+    EXPECT_EQ(read_signed(args, pos), -1);
+    EXPECT_EQ(pos, args.size());
+}
+
+TEST_F(DeferredLog, LongStringTruncated) {
+    std::string long_string(DEFERRED_LOG_STRING_MAX + 10, 'x');
+    log_string(long_string.c_str());
+    drain();
+
+    auto result = records();
+    ASSERT_EQ(result.size(), 1);
+    auto &args = result[0].args;
+    EXPECT_EQ(args[0], DEFERRED_LOG_STRING_MAX | 0x80);
+    EXPECT_EQ(args.size(), DEFERRED_LOG_STRING_MAX + 1);
+}
+
+TEST_F(DeferredLog, BitFieldArguments) {
+    log_bits();
+    drain();
+
+    auto result = records();
+    ASSERT_EQ(result.size(), 1);
+    size_t pos = 0;
+    EXPECT_EQ(read_signed(result[0].args, pos), 1);
+    EXPECT_EQ(read_signed(result[0].args, pos), 5);
+}
+
+TEST_F(DeferredLog, ArgumentTypes) {
+    uint64_t types = arg_types_mixed();
+    EXPECT_EQ(types & 0x0F, 7);
+    EXPECT_EQ((types >> 4) & 0x07, DEFERRED_LOG_ARG_INT);
+    EXPECT_EQ((types >> 7) & 0x07, DEFERRED_LOG_ARG_STRING);
+    EXPECT_EQ((types >> 10) & 0x07, DEFERRED_LOG_ARG_DOUBLE);
+    EXPECT_EQ((types >> 13) & 0x07, DEFERRED_LOG_ARG_INT64);
+    EXPECT_EQ((types >> 16) & 0x07, DEFERRED_LOG_ARG_INT);
+    EXPECT_EQ((types >> 19) & 0x07, DEFERRED_LOG_ARG_STRING);
+    EXPECT_EQ((types >> 22) & 0x07, DEFERRED_LOG_ARG_LONG);
+}
+
+TEST_F(DeferredLog, ZerosOnlyDelimitRecords) {
+    log_integers(0, 0, 0, 0);
+    log_no_args();
+    drain();
+
+    EXPECT_EQ(std::count(console.begin(), console.end(), 0), 2);
+    EXPECT_EQ(console.back(), 0);
+    EXPECT_EQ(records().size(), 2);
+}
+
+TEST_F(DeferredLog, DrainLimitedPerTask) {
+    for (int i = 0; i < 8; i++) {
+        log_integers(i, i, i, i);
+    }
+    deferred_log_task();
+    EXPECT_EQ(console.size(), DEFERRED_LOG_DRAIN_SIZE);
+
+    drain();
+    EXPECT_EQ(records().size(), 8);
+}
+
+TEST_F(DeferredLog, DroppedRecordsReported) {
+    int logged = 0;
+    for (; logged < DEFERRED_LOG_BUFFER_SIZE; logged++) {
+        log_no_args();
+    }
+    drain();
+    auto queued = records().size();
+    EXPECT_LT(queued, logged);
+
+    // The next record that fits is preceded by the number that did not
+    console.clear();
+    log_no_args();
+    drain();
+
+    auto result = records();
+    ASSERT_EQ(result.size(), 2);
+    EXPECT_EQ(result[0].id, 0);
+    size_t pos = 0;
+    EXPECT_EQ(read_varint(result[0].args, pos), logged - queued);
+    EXPECT_STREQ((const char *)result[1].id, "hello\n");
+}
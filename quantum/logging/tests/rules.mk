@@ -0,0 +1,9 @@
+deferred_log_DEFS := -DNO_DEBUG -DIGNORE_ATOMIC_BLOCK -DDEFERRED_LOG_BUFFER_SIZE=128
+
+deferred_log_SRC := \
+	$(QUANTUM_PATH)/logging/tests/deferred_log_tests.cpp \
+	$(QUANTUM_PATH)/logging/tests/deferred_log_calls.c \
+	$(QUANTUM_PATH)/logging/deferred_log.c
+
+deferred_log_INC := \
+	$(QUANTUM_PATH)/logging
@@ -23,7 +23,13 @@
 #endif
 
 #ifndef DYNAMIC_KEYMAP_EEPROM_MAX_ADDR
-#    define DYNAMIC_KEYMAP_EEPROM_MAX_ADDR (TOTAL_EEPROM_BYTE_COUNT - 1)
+#    if defined(DYNAMIC_MACRO_ENABLE) && defined(DYNAMIC_MACRO_PERSIST)
+// Leave room for the recorded dynamic macros at the end
+#        include "nvm_eeprom_dynamic_macro_internal.h"
+#        define DYNAMIC_KEYMAP_EEPROM_MAX_ADDR (DYNAMIC_MACRO_EEPROM_ADDR - 1)
+#    else
+#        define DYNAMIC_KEYMAP_EEPROM_MAX_ADDR (TOTAL_EEPROM_BYTE_COUNT - 1)
+#    endif
 #endif
 
 STATIC_ASSERT(DYNAMIC_KEYMAP_EEPROM_MAX_ADDR <= (TOTAL_EEPROM_BYTE_COUNT - 1), "DYNAMIC_KEYMAP_EEPROM_MAX_ADDR is configured to use more space than what is available for the selected EEPROM driver");
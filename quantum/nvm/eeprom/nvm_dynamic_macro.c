@@ -0,0 +1,39 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "compiler_support.h"
+#include "eeprom.h"
+#include "nvm_dynamic_macro.h"
+#include "nvm_eeprom_eeconfig_internal.h"
+#include "nvm_eeprom_dynamic_macro_internal.h"
+
+#ifdef DYNAMIC_MACRO_PERSIST
+STATIC_ASSERT(DYNAMIC_MACRO_EEPROM_ADDR >= EECONFIG_SIZE, "Dynamic macros are configured to use more EEPROM than is available, reduce DYNAMIC_MACRO_BUFFER_SIZE.");
+STATIC_ASSERT(DYNAMIC_MACRO_EEPROM_ADDR + DYNAMIC_MACRO_EEPROM_SIZE <= TOTAL_EEPROM_BYTE_COUNT, "DYNAMIC_MACRO_EEPROM_ADDR is configured to use more space than what is available for the selected EEPROM driver");
+#endif
+
+void nvm_dynamic_macro_erase(void) {
+    // No-op, nvm_eeconfig_erase() will have already erased EEPROM if necessary.
+}
+
+bool nvm_dynamic_macro_read_lengths(uint16_t *length1, uint16_t *length2) {
+    *length1 = eeprom_read_word((void *)(uintptr_t)(DYNAMIC_MACRO_EEPROM_ADDR));
+    *length2 = eeprom_read_word((void *)(uintptr_t)(DYNAMIC_MACRO_EEPROM_ADDR + 2));
+    // Freshly erased EEPROM reads back as all ones on some drivers
+    return (uint32_t)*length1 + *length2 <= DYNAMIC_MACRO_BUFFER_SIZE;
+}
+
+void nvm_dynamic_macro_update_lengths(uint16_t length1, uint16_t length2) {
+    eeprom_update_word((void *)(uintptr_t)(DYNAMIC_MACRO_EEPROM_ADDR), length1);
+    eeprom_update_word((void *)(uintptr_t)(DYNAMIC_MACRO_EEPROM_ADDR + 2), length2);
+}
+
+void nvm_dynamic_macro_read_buffer(uint32_t offset, uint32_t size, uint8_t *data) {
+    if (offset + size > DYNAMIC_MACRO_BUFFER_SIZE) return;
+    eeprom_read_block(data, (void *)(uintptr_t)(DYNAMIC_MACRO_EEPROM_BUFFER_ADDR + offset), size);
+}
+
+void nvm_dynamic_macro_update_buffer(uint32_t offset, uint32_t size, const uint8_t *data) {
+    if (offset + size > DYNAMIC_MACRO_BUFFER_SIZE) return;
+    eeprom_update_block(data, (void *)(uintptr_t)(DYNAMIC_MACRO_EEPROM_BUFFER_ADDR + offset), size);
+}
@@ -0,0 +1,16 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include "process_dynamic_macro.h"
+
+// The lengths of both macros, followed by an image of the macro buffer
+#define DYNAMIC_MACRO_EEPROM_SIZE (4 + DYNAMIC_MACRO_BUFFER_SIZE)
+
+// Dynamic macros are kept at the very end of EEPROM, as the dynamic keymap
+// otherwise grows to fill whatever is left after it.
+#ifndef DYNAMIC_MACRO_EEPROM_ADDR
+#    define DYNAMIC_MACRO_EEPROM_ADDR (TOTAL_EEPROM_BYTE_COUNT - DYNAMIC_MACRO_EEPROM_SIZE)
+#endif
+
+#define DYNAMIC_MACRO_EEPROM_BUFFER_ADDR (DYNAMIC_MACRO_EEPROM_ADDR + 4)
@@ -88,6 +88,24 @@
 #    define QUANTUM_PAINTER_SUPPORTS_NATIVE_COLORS FALSE
 #endif
 
+#ifndef QUANTUM_PAINTER_IMAGE_CACHE_ENABLE
+/**
+ * @def This controls whether each loaded image keeps a cache of its parsed frame metadata, and whether converted
+ *      palettes are reused across frames and redraws. Animated images also gain the ability to keep fully decoded
+ *      frames in caller-supplied surfaces, see \ref qp_image_cache_frames. Costs RAM per loaded image, sized by
+ *      \ref QUANTUM_PAINTER_IMAGE_CACHE_FRAMES.
+ */
+#    define QUANTUM_PAINTER_IMAGE_CACHE_ENABLE FALSE
+#endif // QUANTUM_PAINTER_IMAGE_CACHE_ENABLE
+
+#ifndef QUANTUM_PAINTER_IMAGE_CACHE_FRAMES
+/**
+ * @def This controls the number of frames per image whose metadata is cached when
+ *      \ref QUANTUM_PAINTER_IMAGE_CACHE_ENABLE is set to TRUE. Frames beyond this count are parsed on every draw.
+ */
+#    define QUANTUM_PAINTER_IMAGE_CACHE_FRAMES 8
+#endif // QUANTUM_PAINTER_IMAGE_CACHE_FRAMES
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter types
 
@@ -429,6 +447,48 @@ deferred_token qp_animate_recolor(painter_device_t device, uint16_t x, uint16_t
  */
 void qp_stop_animation(deferred_token anim_token);
 
+#if QUANTUM_PAINTER_IMAGE_CACHE_ENABLE
+
+/**
+ * @typedef Cache statistics for a loaded image, as returned by \ref qp_image_cache_stats.
+ */
+typedef struct qp_image_cache_stats_t {
+    uint32_t frame_info_hits;      ///< Frame draws which reused cached frame metadata
+    uint32_t frame_info_misses;    ///< Frame draws which had to parse the frame metadata from the image
+    uint32_t palette_hits;         ///< Frame draws which reused the already-converted palette
+    uint32_t palette_misses;       ///< Frame draws which had to load and convert a palette
+    uint32_t decoded_frame_hits;   ///< Frame draws which were copied from a decoded frame surface
+    uint32_t decoded_frame_misses; ///< Frame draws which had to be decoded into a frame surface
+} qp_image_cache_stats_t;
+
+/**
+ * Retrieves the cache statistics for an image. Statistics are reset when the image is loaded.
+ *
+ * @param image[in] the handle of the image
+ * @param stats[out] the statistics for the image
+ * @return true if the image was valid
+ */
+bool qp_image_cache_stats(painter_image_handle_t image, qp_image_cache_stats_t *stats);
+
+#    ifdef QUANTUM_PAINTER_SURFACE_ENABLE
+/**
+ * Supplies surfaces to hold fully decoded frames of an image, one surface per frame. Once a frame has been decoded,
+ * subsequent draws of that frame are a single copy from its surface to the target device.
+ *
+ * @note Each surface must be at least as large as the image, and must match the native pixel format of the devices
+ *       the image is drawn on. Frames beyond `num_surfaces` are decoded on every draw. Passing NULL detaches the
+ *       surfaces.
+ *
+ * @param image[in] the handle of the image
+ * @param frame_surfaces[in] the surfaces to use, indexed by frame number -- must outlive the image handle
+ * @param num_surfaces[in] the number of entries in `frame_surfaces`
+ * @return true if the surfaces were attached
+ */
+bool qp_image_cache_frames(painter_image_handle_t image, const painter_device_t *frame_surfaces, uint16_t num_surfaces);
+#    endif // QUANTUM_PAINTER_SURFACE_ENABLE
+
+#endif // QUANTUM_PAINTER_IMAGE_CACHE_ENABLE
+
 /**
  * Loads a font into memory.
  *
@@ -27,13 +27,19 @@ bool qp_internal_setpixel_impl(painter_device_t device, uint16_t x, uint16_t y);
 // qp_rect internal implementation, but uses the global pixdata buffer with pre-converted native pixels.
 bool qp_internal_fillrect_helper_impl(painter_device_t device, uint16_t l, uint16_t t, uint16_t r, uint16_t b);
 
+// Appends a run of identical pixels to the global pixdata buffer, using the driver's append_pixel_span if available
+bool qp_internal_append_pixel_span(painter_device_t device, qp_pixel_t* palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t palette_index);
+
 // Convert from input pixel data + palette to equivalent pixels
 typedef int16_t (*qp_internal_byte_input_callback)(void* cb_arg);
-typedef bool (*qp_internal_pixel_output_callback)(qp_pixel_t* palette, uint8_t index, void* cb_arg);
+// Returns the next byte, and via run_length how many consecutive copies of it were consumed from the input
+typedef int16_t (*qp_internal_run_input_callback)(void* cb_arg, uint32_t* run_length);
+// Receives `count` consecutive pixels sharing the same palette index
+typedef bool (*qp_internal_pixel_output_callback)(qp_pixel_t* palette, uint8_t index, uint32_t count, void* cb_arg);
 typedef bool (*qp_internal_byte_output_callback)(uint8_t byte, void* cb_arg);
-bool qp_internal_decode_palette(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void* input_arg, qp_pixel_t* palette, qp_internal_pixel_output_callback output_callback, void* output_arg);
-bool qp_internal_decode_grayscale(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void* input_arg, qp_internal_pixel_output_callback output_callback, void* output_arg);
-bool qp_internal_decode_recolor(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void* input_arg, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, qp_internal_pixel_output_callback output_callback, void* output_arg);
+bool qp_internal_decode_palette(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_run_input_callback input_callback, void* input_arg, qp_pixel_t* palette, qp_internal_pixel_output_callback output_callback, void* output_arg);
+bool qp_internal_decode_grayscale(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_run_input_callback input_callback, void* input_arg, qp_internal_pixel_output_callback output_callback, void* output_arg);
+bool qp_internal_decode_recolor(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_run_input_callback input_callback, void* input_arg, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, qp_internal_pixel_output_callback output_callback, void* output_arg);
 bool qp_internal_send_bytes(painter_device_t device, uint32_t byte_count, qp_internal_byte_input_callback input_callback, void* input_arg, qp_internal_byte_output_callback output_callback, void* output_arg);
 
 // Global variable used for interpolated pixel lookup table.
@@ -54,6 +60,24 @@ void qp_internal_invalidate_palette(void);
 // Helper shared between image and font rendering -- sets up the global palette to match the palette block specified in the asset. Expects the stream to be positioned at the start of the block header.
 bool qp_internal_load_qgf_palette(qp_stream_t* stream, uint8_t bpp);
 
+#if QUANTUM_PAINTER_IMAGE_CACHE_ENABLE
+// Identifies what the global palette currently holds, so that an already-converted palette can be reused
+typedef struct qp_internal_palette_key_t {
+    painter_device_t device;    // the device the palette was converted for
+    const void*      source;    // the asset the palette belongs to
+    uint32_t         offset;    // the location of the palette block within the asset, or 0 if interpolated
+    uint8_t          bpp;       // the number of bits per pixel the palette was generated for
+    qp_pixel_t       fg_hsv888; // the interpolation endpoints, unused for palettes loaded from the asset
+    qp_pixel_t       bg_hsv888;
+} qp_internal_palette_key_t;
+
+// Checks whether the global palette was last generated and converted to match the supplied key
+bool qp_internal_palette_key_matches(const qp_internal_palette_key_t* key);
+
+// Records the key matching the current contents of the global palette. Cleared whenever the palette is regenerated.
+void qp_internal_palette_key_set(const qp_internal_palette_key_t* key);
+#endif // QUANTUM_PAINTER_IMAGE_CACHE_ENABLE
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter codec functions
 
@@ -64,9 +88,11 @@ enum qp_internal_rle_mode_t {
 };
 
 typedef struct qp_internal_byte_input_state_t {
-    painter_device_t device;
-    qp_stream_t*     src_stream;
-    int16_t          curr;
+    painter_device_t                device;
+    qp_stream_t*                    src_stream;
+    int16_t                         curr;
+    qp_internal_byte_input_callback byte_callback; // set by qp_internal_prepare_input_state
+    qp_internal_run_input_callback  run_callback;  // set by qp_internal_prepare_input_state
     union {
         // RLE-specific
         struct {
@@ -82,7 +108,7 @@ typedef struct qp_internal_pixel_output_state_t {
     uint32_t         max_pixels;
 } qp_internal_pixel_output_state_t;
 
-bool qp_internal_pixel_appender(qp_pixel_t* palette, uint8_t index, void* cb_arg);
+bool qp_internal_pixel_appender(qp_pixel_t* palette, uint8_t index, uint32_t count, void* cb_arg);
 
 typedef struct qp_internal_byte_output_state_t {
     painter_device_t device;
@@ -95,6 +121,8 @@ bool qp_internal_byte_appender(uint8_t byteval, void* cb_arg);
 // Helper shared between image and font rendering, sends pixels to the display using:
 //     - qp_internal_decode_palette + qp_internal_pixel_appender (bpp <= 8)
 //     - qp_internal_send_bytes                                  (bpp > 8)
-bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_count, qp_internal_byte_input_callback input_callback, void* input_state);
+// The input state must have been set up with qp_internal_prepare_input_state.
+bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_count, qp_internal_byte_input_state_t* input_state);
 
+// Sets up the input state's decoders for the supplied compression scheme, returning the byte decoder (or NULL if unsupported)
 qp_internal_byte_input_callback qp_internal_prepare_input_state(qp_internal_byte_input_state_t* input_state, painter_compression_t compression);
@@ -29,32 +29,73 @@ bool qp_internal_bpp_capable(uint8_t bits_per_pixel) {
     return true;
 }
 
-bool qp_internal_decode_palette(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void* input_arg, qp_pixel_t* palette, qp_internal_pixel_output_callback output_callback, void* output_arg) {
-    const uint8_t pixel_bitmask    = (1 << bits_per_pixel) - 1;
-    const uint8_t pixels_per_byte  = 8 / bits_per_pixel;
-    uint32_t      remaining_pixels = pixel_count; // don't try to derive from byte_count, we may not use an entire byte
+// Consecutive pixels sharing the same palette index, accumulated before being output as a single span
+typedef struct qp_internal_pixel_span_t {
+    uint8_t  index;
+    uint32_t length;
+} qp_internal_pixel_span_t;
+
+static inline bool qp_internal_extend_span(qp_internal_pixel_span_t* span, uint8_t index, uint32_t count, qp_pixel_t* palette, qp_internal_pixel_output_callback output_callback, void* output_arg) {
+    if (span->length > 0 && span->index != index) {
+        if (!output_callback(palette, span->index, span->length, output_arg)) {
+            return false;
+        }
+        span->length = 0;
+    }
+    span->index = index;
+    span->length += count;
+    return true;
+}
+
+bool qp_internal_decode_palette(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_run_input_callback input_callback, void* input_arg, qp_pixel_t* palette, qp_internal_pixel_output_callback output_callback, void* output_arg) {
+    const uint8_t            pixel_bitmask    = (1 << bits_per_pixel) - 1;
+    const uint8_t            pixels_per_byte  = 8 / bits_per_pixel;
+    const uint8_t            uniform_multiple = 0xFF / pixel_bitmask; // byte value with every packed pixel set to index 1
+    uint32_t                 remaining_pixels = pixel_count;          // don't try to derive from byte_count, we may not use an entire byte
+    qp_internal_pixel_span_t span             = {.index = 0, .length = 0};
     while (remaining_pixels > 0) {
-        int16_t byteval = input_callback(input_arg);
+        uint32_t run_length;
+        int16_t  byteval = input_callback(input_arg, &run_length);
         if (byteval < 0) {
             return false;
         }
-        uint8_t loop_pixels = remaining_pixels < pixels_per_byte ? remaining_pixels : pixels_per_byte;
-        for (uint8_t q = 0; q < loop_pixels; ++q) {
-            if (!output_callback(palette, byteval & pixel_bitmask, output_arg)) {
+
+        // If every pixel packed into the byte is the same, the whole run extends the current span
+        uint8_t first_index = byteval & pixel_bitmask;
+        if (byteval == first_index * uniform_multiple) {
+            uint32_t run_pixels = run_length * pixels_per_byte;
+            if (run_pixels > remaining_pixels) {
+                run_pixels = remaining_pixels;
+            }
+            if (!qp_internal_extend_span(&span, first_index, run_pixels, palette, output_callback, output_arg)) {
                 return false;
             }
-            byteval >>= bits_per_pixel;
+            remaining_pixels -= run_pixels;
+            continue;
+        }
+
+        for (; run_length > 0 && remaining_pixels > 0; --run_length) {
+            uint8_t loop_pixels = remaining_pixels < pixels_per_byte ? remaining_pixels : pixels_per_byte;
+            uint8_t pixels      = byteval;
+            for (uint8_t q = 0; q < loop_pixels; ++q) {
+                if (!qp_internal_extend_span(&span, pixels & pixel_bitmask, 1, palette, output_callback, output_arg)) {
+                    return false;
+                }
+                pixels >>= bits_per_pixel;
+            }
+            remaining_pixels -= loop_pixels;
         }
-        remaining_pixels -= loop_pixels;
     }
-    return true;
+
+    // Flush whatever is left over
+    return span.length == 0 || output_callback(palette, span.index, span.length, output_arg);
 }
 
-bool qp_internal_decode_grayscale(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void* input_arg, qp_internal_pixel_output_callback output_callback, void* output_arg) {
+bool qp_internal_decode_grayscale(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_run_input_callback input_callback, void* input_arg, qp_internal_pixel_output_callback output_callback, void* output_arg) {
     return qp_internal_decode_recolor(device, pixel_count, bits_per_pixel, input_callback, input_arg, qp_pixel_white, qp_pixel_black, output_callback, output_arg);
 }
 
-bool qp_internal_decode_recolor(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void* input_arg, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, qp_internal_pixel_output_callback output_callback, void* output_arg) {
+bool qp_internal_decode_recolor(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_run_input_callback input_callback, void* input_arg, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, qp_internal_pixel_output_callback output_callback, void* output_arg) {
     painter_driver_t* driver = (painter_driver_t*)device;
     int16_t           steps  = 1 << bits_per_pixel; // number of items we need to interpolate
     if (qp_internal_interpolate_palette(fg_hsv888, bg_hsv888, steps)) {
@@ -90,21 +131,30 @@ static inline int16_t qp_drawimage_byte_uncompressed_decoder(void* cb_arg) {
     return state->curr;
 }
 
+static int16_t qp_drawimage_run_uncompressed_decoder(void* cb_arg, uint32_t* run_length) {
+    *run_length = 1;
+    return qp_drawimage_byte_uncompressed_decoder(cb_arg);
+}
+
+static inline void qp_drawimage_rle_read_marker(qp_internal_byte_input_state_t* state) {
+    uint8_t c = qp_stream_get(state->src_stream);
+    if (c >= 128) {
+        state->rle.mode   = NON_REPEATING_RUN; // non-repeated run
+        state->rle.remain = c - 127;
+    } else {
+        state->rle.mode   = REPEATING_RUN; // repeated run
+        state->rle.remain = c;
+    }
+
+    state->curr = qp_stream_get(state->src_stream);
+}
+
 static inline int16_t qp_drawimage_byte_rle_decoder(void* cb_arg) {
     qp_internal_byte_input_state_t* state = (qp_internal_byte_input_state_t*)cb_arg;
 
     // Work out if we're parsing the initial marker byte
     if (state->rle.mode == MARKER_BYTE) {
-        uint8_t c = qp_stream_get(state->src_stream);
-        if (c >= 128) {
-            state->rle.mode   = NON_REPEATING_RUN; // non-repeated run
-            state->rle.remain = c - 127;
-        } else {
-            state->rle.mode   = REPEATING_RUN; // repeated run
-            state->rle.remain = c;
-        }
-
-        state->curr = qp_stream_get(state->src_stream);
+        qp_drawimage_rle_read_marker(state);
     }
 
     // Work out which byte we're returning
@@ -126,20 +176,64 @@ static inline int16_t qp_drawimage_byte_rle_decoder(void* cb_arg) {
     return c;
 }
 
-bool qp_internal_pixel_appender(qp_pixel_t* palette, uint8_t index, void* cb_arg) {
-    qp_internal_pixel_output_state_t* state  = (qp_internal_pixel_output_state_t*)cb_arg;
-    painter_driver_t*                 driver = (painter_driver_t*)state->device;
+static int16_t qp_drawimage_run_rle_decoder(void* cb_arg, uint32_t* run_length) {
+    qp_internal_byte_input_state_t* state = (qp_internal_byte_input_state_t*)cb_arg;
 
-    if (!driver->driver_vtable->append_pixels(state->device, qp_internal_global_pixdata_buffer, palette, state->pixel_write_pos++, 1, &index)) {
-        return false;
+    // Repeated runs are handed out in their entirety, rather than a byte at a time
+    if (state->rle.mode == MARKER_BYTE) {
+        qp_drawimage_rle_read_marker(state);
     }
 
-    // If we've hit the transmit limit, send out the entire buffer and reset the write position
-    if (state->pixel_write_pos == state->max_pixels) {
-        if (!driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, state->pixel_write_pos)) {
+    if (state->rle.mode == REPEATING_RUN) {
+        uint8_t c         = state->curr;
+        *run_length       = state->rle.remain;
+        state->rle.remain = 0;
+        state->rle.mode   = MARKER_BYTE;
+        return c;
+    }
+
+    *run_length = 1;
+    return qp_drawimage_byte_rle_decoder(cb_arg);
+}
+
+bool qp_internal_append_pixel_span(painter_device_t device, qp_pixel_t* palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t palette_index) {
+    painter_driver_t* driver = (painter_driver_t*)device;
+    if (driver->driver_vtable->append_pixel_span) {
+        return driver->driver_vtable->append_pixel_span(device, qp_internal_global_pixdata_buffer, palette, pixel_offset, pixel_count, palette_index);
+    }
+
+    // Driver can't fill spans itself, so feed it one pixel at a time
+    for (uint32_t i = 0; i < pixel_count; ++i) {
+        if (!driver->driver_vtable->append_pixels(device, qp_internal_global_pixdata_buffer, palette, pixel_offset + i, 1, &palette_index)) {
             return false;
         }
-        state->pixel_write_pos = 0;
+    }
+    return true;
+}
+
+bool qp_internal_pixel_appender(qp_pixel_t* palette, uint8_t index, uint32_t count, void* cb_arg) {
+    qp_internal_pixel_output_state_t* state  = (qp_internal_pixel_output_state_t*)cb_arg;
+    painter_driver_t*                 driver = (painter_driver_t*)state->device;
+
+    while (count > 0) {
+        // Fill as much of the span as will fit in the buffer
+        uint32_t span = state->max_pixels - state->pixel_write_pos;
+        if (span > count) {
+            span = count;
+        }
+        if (!qp_internal_append_pixel_span(state->device, palette, state->pixel_write_pos, span, index)) {
+            return false;
+        }
+        state->pixel_write_pos += span;
+        count -= span;
+
+        // If we've hit the transmit limit, send out the entire buffer and reset the write position
+        if (state->pixel_write_pos == state->max_pixels) {
+            if (!driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, state->pixel_write_pos)) {
+                return false;
+            }
+            state->pixel_write_pos = 0;
+        }
     }
 
     return true;
@@ -166,7 +260,7 @@ bool qp_internal_byte_appender(uint8_t byteval, void* cb_arg) {
 }
 
 // Helper shared between image and font rendering -- uses either (qp_internal_decode_palette + qp_internal_pixel_appender) or (qp_internal_send_bytes) to send data data to the display based on the asset's native-ness
-bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_count, qp_internal_byte_input_callback input_callback, void* input_state) {
+bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_count, qp_internal_byte_input_state_t* input_state) {
     painter_driver_t* driver = (painter_driver_t*)device;
 
     bool ret = false;
@@ -177,7 +271,7 @@ bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_c
         qp_internal_pixel_output_state_t output_state = {.device = device, .pixel_write_pos = 0, .max_pixels = qp_internal_num_pixels_in_buffer(device)};
 
         // Decode the pixel data and stream to the display
-        ret = qp_internal_decode_palette(device, pixel_count, bpp, input_callback, input_state, qp_internal_global_pixel_lookup_table, qp_internal_pixel_appender, &output_state);
+        ret = qp_internal_decode_palette(device, pixel_count, bpp, input_state->run_callback, input_state, qp_internal_global_pixel_lookup_table, qp_internal_pixel_appender, &output_state);
         // Any leftovers need transmission as well.
         if (ret && output_state.pixel_write_pos > 0) {
             ret &= driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.pixel_write_pos);
@@ -194,7 +288,7 @@ bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_c
 
         // Stream the raw pixel data to the display
         uint32_t byte_count = pixel_count * bpp / 8;
-        ret                 = qp_internal_send_bytes(device, byte_count, input_callback, input_state, qp_internal_byte_appender, &output_state);
+        ret                 = qp_internal_send_bytes(device, byte_count, input_state->byte_callback, input_state, qp_internal_byte_appender, &output_state);
         // Any leftovers need transmission as well.
         if (ret && output_state.byte_write_pos > 0) {
             ret &= driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.byte_write_pos * 8 / driver->native_bits_per_pixel);
@@ -207,12 +301,19 @@ bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_c
 qp_internal_byte_input_callback qp_internal_prepare_input_state(qp_internal_byte_input_state_t* input_state, painter_compression_t compression) {
     switch (compression) {
         case IMAGE_UNCOMPRESSED:
-            return qp_drawimage_byte_uncompressed_decoder;
+            input_state->byte_callback = qp_drawimage_byte_uncompressed_decoder;
+            input_state->run_callback  = qp_drawimage_run_uncompressed_decoder;
+            break;
         case IMAGE_COMPRESSED_RLE:
-            input_state->rle.mode   = MARKER_BYTE;
-            input_state->rle.remain = 0;
-            return qp_drawimage_byte_rle_decoder;
+            input_state->rle.mode      = MARKER_BYTE;
+            input_state->rle.remain    = 0;
+            input_state->byte_callback = qp_drawimage_byte_rle_decoder;
+            input_state->run_callback  = qp_drawimage_run_rle_decoder;
+            break;
         default:
-            return NULL;
+            input_state->byte_callback = NULL;
+            input_state->run_callback  = NULL;
+            break;
     }
+    return input_state->byte_callback;
 }
@@ -33,6 +33,10 @@ __attribute__((__aligned__(4))) qp_pixel_t qp_internal_global_pixel_lookup_table
 #else
 __attribute__((__aligned__(4))) qp_pixel_t qp_internal_global_pixel_lookup_table[16];
 #endif
+#if QUANTUM_PAINTER_IMAGE_CACHE_ENABLE
+static qp_internal_palette_key_t palette_key;
+static bool                      palette_key_valid = false;
+#endif // QUANTUM_PAINTER_IMAGE_CACHE_ENABLE
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Helpers
@@ -59,18 +63,29 @@ void qp_internal_fill_pixdata(painter_device_t device, uint32_t num_pixels, uint
     driver->driver_vtable->palette_convert(device, 1, &color);
 
     // Append the required number of pixels
-    uint8_t palette_idx = 0;
-    for (uint32_t i = 0; i < num_pixels; ++i) {
-        driver->driver_vtable->append_pixels(device, qp_internal_global_pixdata_buffer, &color, i, 1, &palette_idx);
-    }
+    qp_internal_append_pixel_span(device, &color, 0, num_pixels, 0);
 }
 
 // Resets the global palette so that it can be regenerated. Only needed if the colors are identical, but a different display is used with a different internal pixel format.
 void qp_internal_invalidate_palette(void) {
     generated_palette = false;
     generated_steps   = -1;
+#if QUANTUM_PAINTER_IMAGE_CACHE_ENABLE
+    palette_key_valid = false;
+#endif // QUANTUM_PAINTER_IMAGE_CACHE_ENABLE
+}
+
+#if QUANTUM_PAINTER_IMAGE_CACHE_ENABLE
+bool qp_internal_palette_key_matches(const qp_internal_palette_key_t *key) {
+    return palette_key_valid && palette_key.device == key->device && palette_key.source == key->source && palette_key.offset == key->offset && palette_key.bpp == key->bpp && memcmp(&palette_key.fg_hsv888.hsv888, &key->fg_hsv888.hsv888, sizeof(key->fg_hsv888.hsv888)) == 0 && memcmp(&palette_key.bg_hsv888.hsv888, &key->bg_hsv888.hsv888, sizeof(key->bg_hsv888.hsv888)) == 0;
 }
 
+void qp_internal_palette_key_set(const qp_internal_palette_key_t *key) {
+    palette_key       = *key;
+    palette_key_valid = true;
+}
+#endif // QUANTUM_PAINTER_IMAGE_CACHE_ENABLE
+
 // Interpolates between two colors to generate a palette
 bool qp_internal_interpolate_palette(qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, int16_t steps) {
     // Check if we need to generate a new palette -- if the input parameters match then assume the palette can stay unchanged.
@@ -80,6 +95,11 @@ bool qp_internal_interpolate_palette(qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888,
         return false;
     }
 
+#if QUANTUM_PAINTER_IMAGE_CACHE_ENABLE
+    // The lookup table is about to be overwritten
+    palette_key_valid = false;
+#endif // QUANTUM_PAINTER_IMAGE_CACHE_ENABLE
+
     // Save the parameters so we know whether we can skip generation
     generated_palette      = true;
     generated_steps        = steps;
@@ -7,12 +7,53 @@
 #include "qgf.h"
 #include "deferred_exec.h"
 
+#if QUANTUM_PAINTER_IMAGE_CACHE_ENABLE && defined(QUANTUM_PAINTER_SURFACE_ENABLE)
+#    include "qp_surface_internal.h"
+#endif // QUANTUM_PAINTER_IMAGE_CACHE_ENABLE && defined(QUANTUM_PAINTER_SURFACE_ENABLE)
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // QGF image handles
 
+typedef struct qgf_frame_info_t {
+    painter_compression_t compression_scheme;
+    uint8_t               bpp;
+    bool                  has_palette;
+    bool                  is_panel_native;
+    bool                  is_delta;
+    uint16_t              left;
+    uint16_t              top;
+    uint16_t              right;
+    uint16_t              bottom;
+    uint16_t              delay;
+} qgf_frame_info_t;
+
+#if QUANTUM_PAINTER_IMAGE_CACHE_ENABLE
+typedef struct qgf_frame_cache_entry_t {
+    qgf_frame_info_t info;
+    uint32_t         palette_offset; // location of the palette block, pointing at the previous frame's copy if identical
+    uint32_t         data_offset;    // location of the pixel data
+    bool             valid;
+} qgf_frame_cache_entry_t;
+
+typedef struct qgf_image_cache_t {
+    qgf_frame_cache_entry_t frames[QUANTUM_PAINTER_IMAGE_CACHE_FRAMES];
+    qp_image_cache_stats_t  stats;
+#    ifdef QUANTUM_PAINTER_SURFACE_ENABLE
+    const painter_device_t *frame_surfaces;
+    uint16_t                num_frame_surfaces;
+    uint16_t                decoded_frames; // frames below this number are held decoded in their surfaces
+    qp_pixel_t              decoded_fg_hsv888;
+    qp_pixel_t              decoded_bg_hsv888;
+#    endif // QUANTUM_PAINTER_SURFACE_ENABLE
+} qgf_image_cache_t;
+#endif // QUANTUM_PAINTER_IMAGE_CACHE_ENABLE
+
 typedef struct qgf_image_handle_t {
     painter_image_desc_t base;
     bool                 validate_ok;
+#if QUANTUM_PAINTER_IMAGE_CACHE_ENABLE
+    qgf_image_cache_t cache;
+#endif // QUANTUM_PAINTER_IMAGE_CACHE_ENABLE
     union {
         qp_stream_t        stream;
         qp_memory_stream_t mem_stream;
@@ -59,6 +100,11 @@ static painter_image_handle_t qp_load_image_internal(bool (*stream_factory)(qgf_
     // Fill out the QP image descriptor
     qgf_read_graphics_descriptor(&image->stream, &image->base.width, &image->base.height, &image->base.frame_count, NULL);
 
+#if QUANTUM_PAINTER_IMAGE_CACHE_ENABLE
+    // Drop anything cached for the previous occupant of this slot
+    memset(&image->cache, 0, sizeof(image->cache));
+#endif // QUANTUM_PAINTER_IMAGE_CACHE_ENABLE
+
     // Validation success, we can return the handle
     image->validate_ok = true;
     qp_dprintf("qp_load_image: ok\n");
@@ -98,6 +144,11 @@ bool qp_close_image(painter_image_handle_t image) {
     // Free up this image for use elsewhere.
     qgf_image->validate_ok = false;
     qp_stream_close(&qgf_image->stream);
+
+#if QUANTUM_PAINTER_IMAGE_CACHE_ENABLE
+    // The global palette may be keyed on this handle, which is about to be reused
+    qp_internal_invalidate_palette();
+#endif // QUANTUM_PAINTER_IMAGE_CACHE_ENABLE
     return true;
 }
 
@@ -111,28 +162,8 @@ bool qp_drawimage(painter_device_t device, uint16_t x, uint16_t y, painter_image
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter External API: qp_drawimage_recolor
 
-typedef struct qgf_frame_info_t {
-    painter_compression_t compression_scheme;
-    uint8_t               bpp;
-    bool                  has_palette;
-    bool                  is_panel_native;
-    bool                  is_delta;
-    uint16_t              left;
-    uint16_t              top;
-    uint16_t              right;
-    uint16_t              bottom;
-    uint16_t              delay;
-} qgf_frame_info_t;
-
-static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device, qgf_image_handle_t *qgf_image, uint16_t frame_number, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, qgf_frame_info_t *info) {
-    painter_driver_t *driver = (painter_driver_t *)device;
-
-    // Drop out if we can't actually place the data we read out anywhere
-    if (!info) {
-        qp_dprintf("Failed to prepare stream for read, output info buffer unavailable\n");
-        return false;
-    }
-
+// Reads the frame's metadata, leaving the stream positioned at the start of the pixel data
+static bool qp_drawimage_read_frame_info(qgf_image_handle_t *qgf_image, uint16_t frame_number, qgf_frame_info_t *info, uint32_t *palette_offset) {
     // Seek to the frame
     qgf_seek_to_frame_descriptor(&qgf_image->stream, frame_number);
 
@@ -148,39 +179,11 @@ static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device,
         return false;
     }
 
-    // Ensure we aren't reusing any palette
-    qp_internal_invalidate_palette();
-
-    if (!qp_internal_bpp_capable(info->bpp)) {
-        qp_dprintf("qp_drawimage_recolor: fail (image bpp too high (%d), check QUANTUM_PAINTER_SUPPORTS_256_PALETTE or QUANTUM_PAINTER_SUPPORTS_NATIVE_COLORS)\n", (int)info->bpp);
-        qp_comms_stop(device);
-        return false;
-    }
-
-    // Handle palette if needed
-    const uint16_t palette_entries  = 1u << info->bpp;
-    bool           needs_pixconvert = false;
+    // Skip over the palette, it gets loaded separately
+    *palette_offset = 0;
     if (info->has_palette) {
-        // Load the palette from the stream
-        if (!qp_internal_load_qgf_palette((qp_stream_t *)&qgf_image->stream, info->bpp)) {
-            return false;
-        }
-
-        needs_pixconvert = true;
-    } else {
-        if (info->bpp <= 8) {
-            // Interpolate from fg/bg
-            needs_pixconvert = qp_internal_interpolate_palette(fg_hsv888, bg_hsv888, palette_entries);
-        }
-    }
-
-    if (needs_pixconvert) {
-        // Convert the palette to native format
-        if (!driver->driver_vtable->palette_convert(device, palette_entries, qp_internal_global_pixel_lookup_table)) {
-            qp_dprintf("qp_drawimage_recolor: fail (could not convert pixels to native)\n");
-            qp_comms_stop(device);
-            return false;
-        }
+        *palette_offset = qp_stream_tell(&qgf_image->stream);
+        qp_stream_seek(&qgf_image->stream, sizeof(qgf_palette_v1_t) + (1u << info->bpp) * sizeof(qgf_palette_entry_v1_t), SEEK_CUR);
     }
 
     // Handle delta if needed
@@ -204,24 +207,162 @@ static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device,
         return false;
     }
 
-    // Stream is now at the point of being able to read pixdata
     return true;
 }
 
-static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint16_t y, painter_image_handle_t image, int frame_number, qgf_frame_info_t *frame_info, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888) {
-    qp_dprintf("qp_drawimage_recolor: entry\n");
-    painter_driver_t *driver = (painter_driver_t *)device;
-    if (!driver || !driver->validate_ok) {
-        qp_dprintf("qp_drawimage_recolor: fail (validation_ok == false)\n");
+#if QUANTUM_PAINTER_IMAGE_CACHE_ENABLE
+static bool qgf_image_palettes_equal(qgf_image_handle_t *qgf_image, uint32_t offset_a, uint32_t offset_b, uint8_t bpp) {
+    const uint16_t palette_entries = 1u << bpp;
+    for (uint16_t i = 0; i < palette_entries; ++i) {
+        const uint32_t         entry_offset = sizeof(qgf_palette_v1_t) + i * sizeof(qgf_palette_entry_v1_t);
+        qgf_palette_entry_v1_t entry_a;
+        qgf_palette_entry_v1_t entry_b;
+
+        qp_stream_setpos(&qgf_image->stream, offset_a + entry_offset);
+        if (qp_stream_read(&entry_a, sizeof(qgf_palette_entry_v1_t), 1, &qgf_image->stream) != 1) {
+            return false;
+        }
+
+        qp_stream_setpos(&qgf_image->stream, offset_b + entry_offset);
+        if (qp_stream_read(&entry_b, sizeof(qgf_palette_entry_v1_t), 1, &qgf_image->stream) != 1) {
+            return false;
+        }
+
+        if (memcmp(&entry_a, &entry_b, sizeof(qgf_palette_entry_v1_t)) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Retrieves the frame's metadata from the cache, parsing it on first use. Leaves the stream positioned at the start of the pixel data.
+static bool qgf_image_cache_frame_info(qgf_image_handle_t *qgf_image, uint16_t frame_number, qgf_frame_info_t *info, uint32_t *palette_offset) {
+    qgf_image_cache_t       *cache = &qgf_image->cache;
+    qgf_frame_cache_entry_t *entry = frame_number < QUANTUM_PAINTER_IMAGE_CACHE_FRAMES ? &cache->frames[frame_number] : NULL;
+
+    if (entry && entry->valid) {
+        cache->stats.frame_info_hits++;
+        *info           = entry->info;
+        *palette_offset = entry->palette_offset;
+        qp_stream_setpos(&qgf_image->stream, entry->data_offset);
+        return true;
+    }
+
+    cache->stats.frame_info_misses++;
+    if (!qp_drawimage_read_frame_info(qgf_image, frame_number, info, palette_offset)) {
         return false;
     }
 
-    qgf_image_handle_t *qgf_image = (qgf_image_handle_t *)image;
-    if (!qgf_image || !qgf_image->validate_ok) {
-        qp_dprintf("qp_drawimage_recolor: fail (invalid image)\n");
+    if (entry) {
+        entry->info           = *info;
+        entry->palette_offset = *palette_offset;
+        entry->data_offset    = qp_stream_tell(&qgf_image->stream);
+
+        // Animations generally repeat the same palette in every frame -- refer back to the earliest copy so that the
+        // converted palette can be reused from one frame to the next
+        if (info->has_palette && frame_number > 0) {
+            qgf_frame_cache_entry_t *previous = &cache->frames[frame_number - 1];
+            if (previous->valid && previous->info.has_palette && previous->info.bpp == info->bpp && qgf_image_palettes_equal(qgf_image, previous->palette_offset, entry->palette_offset, info->bpp)) {
+                entry->palette_offset = previous->palette_offset;
+            }
+        }
+
+        entry->valid    = true;
+        *palette_offset = entry->palette_offset;
+        qp_stream_setpos(&qgf_image->stream, entry->data_offset);
+    }
+
+    return true;
+}
+#endif // QUANTUM_PAINTER_IMAGE_CACHE_ENABLE
+
+static bool qp_drawimage_prepare_palette(painter_device_t device, qgf_image_handle_t *qgf_image, qgf_frame_info_t *info, uint32_t palette_offset, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888) {
+    painter_driver_t *driver          = (painter_driver_t *)device;
+    const uint16_t    palette_entries = 1u << info->bpp;
+
+    // Ensure we aren't reusing any palette
+    qp_internal_invalidate_palette();
+
+    if (info->has_palette) {
+        // Load the palette from the stream
+        qp_stream_setpos(&qgf_image->stream, palette_offset);
+        if (!qp_internal_load_qgf_palette((qp_stream_t *)&qgf_image->stream, info->bpp)) {
+            return false;
+        }
+    } else {
+        // Interpolate from fg/bg
+        qp_internal_interpolate_palette(fg_hsv888, bg_hsv888, palette_entries);
+    }
+
+    // Convert the palette to native format
+    if (!driver->driver_vtable->palette_convert(device, palette_entries, qp_internal_global_pixel_lookup_table)) {
+        qp_dprintf("qp_drawimage_recolor: fail (could not convert pixels to native)\n");
+        qp_comms_stop(device);
+        return false;
+    }
+
+    return true;
+}
+
+static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device, qgf_image_handle_t *qgf_image, uint16_t frame_number, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, qgf_frame_info_t *info) {
+    // Drop out if we can't actually place the data we read out anywhere
+    if (!info) {
+        qp_dprintf("Failed to prepare stream for read, output info buffer unavailable\n");
+        return false;
+    }
+
+    // Read the frame info
+    uint32_t palette_offset;
+#if QUANTUM_PAINTER_IMAGE_CACHE_ENABLE
+    if (!qgf_image_cache_frame_info(qgf_image, frame_number, info, &palette_offset)) {
+        return false;
+    }
+#else
+    if (!qp_drawimage_read_frame_info(qgf_image, frame_number, info, &palette_offset)) {
+        return false;
+    }
+#endif // QUANTUM_PAINTER_IMAGE_CACHE_ENABLE
+    const uint32_t data_offset = qp_stream_tell(&qgf_image->stream);
+
+    if (!qp_internal_bpp_capable(info->bpp)) {
+        qp_dprintf("qp_drawimage_recolor: fail (image bpp too high (%d), check QUANTUM_PAINTER_SUPPORTS_256_PALETTE or QUANTUM_PAINTER_SUPPORTS_NATIVE_COLORS)\n", (int)info->bpp);
+        qp_comms_stop(device);
         return false;
     }
 
+    // Handle palette if needed -- native images have none
+    if (info->bpp <= 8) {
+#if QUANTUM_PAINTER_IMAGE_CACHE_ENABLE
+        qp_internal_palette_key_t key = {.device = device, .source = qgf_image, .offset = palette_offset, .bpp = info->bpp};
+        if (!info->has_palette) {
+            key.fg_hsv888 = fg_hsv888;
+            key.bg_hsv888 = bg_hsv888;
+        }
+
+        if (qp_internal_palette_key_matches(&key)) {
+            qgf_image->cache.stats.palette_hits++;
+        } else {
+            qgf_image->cache.stats.palette_misses++;
+            if (!qp_drawimage_prepare_palette(device, qgf_image, info, palette_offset, fg_hsv888, bg_hsv888)) {
+                return false;
+            }
+            qp_internal_palette_key_set(&key);
+        }
+#else
+        if (!qp_drawimage_prepare_palette(device, qgf_image, info, palette_offset, fg_hsv888, bg_hsv888)) {
+            return false;
+        }
+#endif // QUANTUM_PAINTER_IMAGE_CACHE_ENABLE
+    }
+
+    // Stream is now at the point of being able to read pixdata
+    qp_stream_setpos(&qgf_image->stream, data_offset);
+    return true;
+}
+
+static bool qp_drawimage_decode_impl(painter_device_t device, uint16_t x, uint16_t y, qgf_image_handle_t *qgf_image, int frame_number, qgf_frame_info_t *frame_info, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+
     // Read the frame info
     if (!qp_drawimage_prepare_frame_for_stream_read(device, qgf_image, frame_number, fg_hsv888, bg_hsv888, frame_info)) {
         qp_dprintf("qp_drawimage_recolor: fail (could not read frame %d)\n", frame_number);
@@ -242,8 +383,8 @@ static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint1
     } else {
         l = x;
         t = y;
-        r = x + image->width - 1;
-        b = y + image->height - 1;
+        r = x + qgf_image->base.width - 1;
+        b = y + qgf_image->base.height - 1;
     }
     uint32_t pixel_count = ((uint32_t)(r - l + 1)) * (b - t + 1);
 
@@ -264,13 +405,89 @@ static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint1
     }
 
     // Decode and stream pixels
-    bool ret = qp_internal_appender(device, frame_info->bpp, pixel_count, input_callback, &input_state);
+    bool ret = qp_internal_appender(device, frame_info->bpp, pixel_count, &input_state);
 
     qp_dprintf("qp_drawimage_recolor: %s\n", ret ? "ok" : "fail");
     qp_comms_stop(device);
     return ret;
 }
 
+#if QUANTUM_PAINTER_IMAGE_CACHE_ENABLE && defined(QUANTUM_PAINTER_SURFACE_ENABLE)
+// Draws a frame by copying it from its frame surface, decoding it into the surface first if needed
+static bool qgf_image_cache_draw_frame(painter_device_t device, uint16_t x, uint16_t y, qgf_image_handle_t *qgf_image, uint16_t frame_number, qgf_frame_info_t *frame_info, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888) {
+    qgf_image_cache_t *cache  = &qgf_image->cache;
+    const uint16_t     right  = qgf_image->base.width - 1;
+    const uint16_t     bottom = qgf_image->base.height - 1;
+
+    // Recoloring changes the pixels of every decoded frame
+    if (memcmp(&cache->decoded_fg_hsv888.hsv888, &fg_hsv888.hsv888, sizeof(fg_hsv888.hsv888)) != 0 || memcmp(&cache->decoded_bg_hsv888.hsv888, &bg_hsv888.hsv888, sizeof(bg_hsv888.hsv888)) != 0) {
+        cache->decoded_frames    = 0;
+        cache->decoded_fg_hsv888 = fg_hsv888;
+        cache->decoded_bg_hsv888 = bg_hsv888;
+    }
+
+    // Delta frames are decoded on top of their predecessor, so frames can only be added to the cache in order
+    if (frame_number > cache->decoded_frames) {
+        return qp_drawimage_decode_impl(device, x, y, qgf_image, frame_number, frame_info, fg_hsv888, bg_hsv888);
+    }
+
+    painter_device_t surface = cache->frame_surfaces[frame_number];
+    if (frame_number < cache->decoded_frames) {
+        cache->stats.decoded_frame_hits++;
+        uint32_t palette_offset;
+        if (!qgf_image_cache_frame_info(qgf_image, frame_number, frame_info, &palette_offset)) {
+            return false;
+        }
+    } else {
+        cache->stats.decoded_frame_misses++;
+        if (frame_number > 0) {
+            // Start from the previous frame, so that delta frames only need their changed region decoded
+            painter_device_t previous = cache->frame_surfaces[frame_number - 1];
+            qp_surface_set_dirty(previous, 0, 0, right, bottom);
+            if (!qp_surface_draw(previous, surface, 0, 0, false)) {
+                qp_dprintf("qp_drawimage_recolor: fail (could not copy previous frame surface)\n");
+                return false;
+            }
+        }
+        if (!qp_drawimage_decode_impl(surface, 0, 0, qgf_image, frame_number, frame_info, fg_hsv888, bg_hsv888)) {
+            return false;
+        }
+        cache->decoded_frames++;
+    }
+
+    // Only transfer the region changed by this frame
+    if (frame_info->is_delta) {
+        qp_surface_set_dirty(surface, frame_info->left, frame_info->top, frame_info->right, frame_info->bottom);
+    } else {
+        qp_surface_set_dirty(surface, 0, 0, right, bottom);
+    }
+    return qp_surface_draw(surface, device, x, y, false);
+}
+#endif // QUANTUM_PAINTER_IMAGE_CACHE_ENABLE && defined(QUANTUM_PAINTER_SURFACE_ENABLE)
+
+static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint16_t y, painter_image_handle_t image, int frame_number, qgf_frame_info_t *frame_info, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888) {
+    qp_dprintf("qp_drawimage_recolor: entry\n");
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver || !driver->validate_ok) {
+        qp_dprintf("qp_drawimage_recolor: fail (validation_ok == false)\n");
+        return false;
+    }
+
+    qgf_image_handle_t *qgf_image = (qgf_image_handle_t *)image;
+    if (!qgf_image || !qgf_image->validate_ok) {
+        qp_dprintf("qp_drawimage_recolor: fail (invalid image)\n");
+        return false;
+    }
+
+#if QUANTUM_PAINTER_IMAGE_CACHE_ENABLE && defined(QUANTUM_PAINTER_SURFACE_ENABLE)
+    if (frame_number < qgf_image->cache.num_frame_surfaces) {
+        return qgf_image_cache_draw_frame(device, x, y, qgf_image, frame_number, frame_info, fg_hsv888, bg_hsv888);
+    }
+#endif // QUANTUM_PAINTER_IMAGE_CACHE_ENABLE && defined(QUANTUM_PAINTER_SURFACE_ENABLE)
+
+    return qp_drawimage_decode_impl(device, x, y, qgf_image, frame_number, frame_info, fg_hsv888, bg_hsv888);
+}
+
 bool qp_drawimage_recolor(painter_device_t device, uint16_t x, uint16_t y, painter_image_handle_t image, uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg) {
     qgf_frame_info_t frame_info = {0};
     qp_pixel_t       fg_hsv888  = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}};
@@ -278,6 +495,57 @@ bool qp_drawimage_recolor(painter_device_t device, uint16_t x, uint16_t y, paint
     return qp_drawimage_recolor_impl(device, x, y, image, 0, &frame_info, fg_hsv888, bg_hsv888);
 }
 
+#if QUANTUM_PAINTER_IMAGE_CACHE_ENABLE
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_image_cache_stats
+
+bool qp_image_cache_stats(painter_image_handle_t image, qp_image_cache_stats_t *stats) {
+    qgf_image_handle_t *qgf_image = (qgf_image_handle_t *)image;
+    if (!qgf_image || !qgf_image->validate_ok || !stats) {
+        qp_dprintf("qp_image_cache_stats: fail (invalid image)\n");
+        return false;
+    }
+
+    *stats = qgf_image->cache.stats;
+    return true;
+}
+
+#    ifdef QUANTUM_PAINTER_SURFACE_ENABLE
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_image_cache_frames
+
+bool qp_image_cache_frames(painter_image_handle_t image, const painter_device_t *frame_surfaces, uint16_t num_surfaces) {
+    qgf_image_handle_t *qgf_image = (qgf_image_handle_t *)image;
+    if (!qgf_image || !qgf_image->validate_ok) {
+        qp_dprintf("qp_image_cache_frames: fail (invalid image)\n");
+        return false;
+    }
+
+    if (!frame_surfaces) {
+        num_surfaces = 0;
+    }
+
+    for (uint16_t i = 0; i < num_surfaces; ++i) {
+        painter_driver_t *surface = (painter_driver_t *)frame_surfaces[i];
+        if (!surface || !surface->validate_ok) {
+            qp_dprintf("qp_image_cache_frames: fail (surface %d not initialised)\n", (int)i);
+            return false;
+        }
+        if (surface->panel_width < image->width || surface->panel_height < image->height) {
+            qp_dprintf("qp_image_cache_frames: fail (surface %d smaller than image)\n", (int)i);
+            return false;
+        }
+    }
+
+    qgf_image->cache.frame_surfaces     = frame_surfaces;
+    qgf_image->cache.num_frame_surfaces = num_surfaces;
+    qgf_image->cache.decoded_frames     = 0;
+    qp_dprintf("qp_image_cache_frames: ok\n");
+    return true;
+}
+#    endif // QUANTUM_PAINTER_SURFACE_ENABLE
+#endif // QUANTUM_PAINTER_IMAGE_CACHE_ENABLE
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter External API: qp_animate
 
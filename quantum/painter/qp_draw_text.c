@@ -342,7 +342,6 @@ typedef struct code_point_iter_drawglyph_state_t {
     painter_device_t                  device;
     int16_t                           xpos;
     int16_t                           ypos;
-    qp_internal_byte_input_callback   input_callback;
     qp_internal_byte_input_state_t *  input_state;
     qp_internal_pixel_output_state_t *output_state;
 } code_point_iter_drawglyph_state_t;
@@ -366,7 +365,7 @@ static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_f
 
     // Decode the pixel data for the glyph, and stream it
     uint32_t pixel_count = ((uint32_t)width) * height;
-    return qp_internal_appender(state->device, qff_font->bpp, pixel_count, state->input_callback, state->input_state);
+    return qp_internal_appender(state->device, qff_font->bpp, pixel_count, state->input_state);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -434,8 +433,7 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
                                                .xpos   = x,
                                                .ypos   = y,
                                                // Input
-                                               .input_callback = input_callback,
-                                               .input_state    = &input_state,
+                                               .input_state = &input_state,
                                                // Output
                                                .output_state = &output_state};
 
@@ -33,6 +33,15 @@
 #    error More than one rotation selected.  This is not supported.
 #endif
 
+#if defined(POINTING_DEVICE_MOTION_ACCUMULATOR_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+#    error POINTING_DEVICE_MOTION_ACCUMULATOR_ENABLE not supported when sharing the pointing device report between sides.
+#endif
+
+#ifndef POINTING_DEVICE_SAMPLING_TASK_ENABLE
+#    define pointing_device_sampling_lock()
+#    define pointing_device_sampling_unlock()
+#endif
+
 #if defined(POINTING_DEVICE_LEFT) || defined(POINTING_DEVICE_RIGHT) || defined(POINTING_DEVICE_COMBINED)
 #    ifndef SPLIT_POINTING_ENABLE
 #        error "Using POINTING_DEVICE_LEFT or POINTING_DEVICE_RIGHT or POINTING_DEVICE_COMBINED, then SPLIT_POINTING_ENABLE is required but has not been defined"
@@ -186,6 +195,9 @@ __attribute__((weak)) void pointing_device_init(void) {
 #    else
         gpio_set_pin_input(POINTING_DEVICE_MOTION_PIN);
 #    endif
+#endif
+#ifdef POINTING_DEVICE_SAMPLING_TASK_ENABLE
+        pointing_device_sampling_start();
 #endif
     }
 #ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
@@ -258,12 +270,109 @@ report_mouse_t pointing_device_adjust_by_defines(report_mouse_t mouse_report) {
     return mouse_report;
 }
 
+#ifdef POINTING_DEVICE_MOTION_ACCUMULATOR_ENABLE
+#    ifdef POINTING_DEVICE_MOTION_PIN
+/**
+ * @brief Whether the sensor signals motion on its motion pin
+ */
+static bool pointing_device_motion_pin_active(void) {
+#        ifdef POINTING_DEVICE_MOTION_PIN_ACTIVE_LOW
+    return !gpio_read_pin(POINTING_DEVICE_MOTION_PIN);
+#        else
+    return gpio_read_pin(POINTING_DEVICE_MOTION_PIN);
+#        endif
+}
+#    endif
+
+/**
+ * @brief Reads the pointing device driver once
+ *
+ * Rotation and inversion are applied to the reading, buttons are taken as they are.
+ *
+ * @param[in] mouse_report report_mouse_t passed on to the driver
+ * @param[out] sensor_report report_mouse_t to fill with the reading
+ * @return true if the sensor was read
+ */
+static bool pointing_device_read_motion(report_mouse_t mouse_report, report_mouse_t *sensor_report) {
+#    ifdef POINTING_DEVICE_MOTION_PIN
+    if (!pointing_device_motion_pin_active()) {
+        return false;
+    }
+#    endif
+
+    *sensor_report = pointing_device_driver->get_report(mouse_report);
+    return true;
+}
+
+#    ifdef POINTING_DEVICE_SAMPLING_TASK_ENABLE
+/**
+ * @brief Reads the pointing device driver from the sampling context
+ *
+ * Called from the sampling thread, or on platforms without threads from pointing_device_task(). Never call it from an
+ * interrupt, as it talks to the sensor over its bus -- see pointing_device_sampling_motion_isr() instead. The reading
+ * is queued for pointing_device_task().
+ *
+ * @return true if the sensor should be read again straight away, as it still signals motion or some of the motion
+ * read so far has not fit in the queue
+ */
+bool pointing_device_sample(void) {
+    static uint8_t buttons = 0;
+
+    // Only the buttons carry over between reads, as with the report passed in from pointing_device_task()
+    report_mouse_t sensor_report = {.buttons = buttons};
+    pointing_device_sampling_lock();
+    bool has_report = pointing_device_read_motion(sensor_report, &sensor_report);
+    pointing_device_sampling_unlock();
+    if (has_report) {
+        buttons       = sensor_report.buttons;
+        sensor_report = pointing_device_adjust_by_defines(sensor_report);
+    }
+
+    // Queued even without a reading, to flush any motion still waiting for room in the queue
+    bool queued = pointing_device_sampling_push(sensor_report);
+#        ifdef POINTING_DEVICE_MOTION_PIN
+    return !queued || pointing_device_motion_pin_active();
+#        else
+    return !queued;
+#        endif
+}
+#    endif
+
+/**
+ * @brief Accumulates the motion read since the last call
+ *
+ * Either reads the pointing device driver directly, or with POINTING_DEVICE_SAMPLING_TASK_ENABLE takes every sample
+ * queued by the sampling context, after reading the sensor itself on platforms without threads.
+ *
+ */
+static void pointing_device_accumulate_motion(void) {
+    report_mouse_t sensor_report;
+#    ifdef POINTING_DEVICE_SAMPLING_TASK_ENABLE
+    pointing_device_sampling_task();
+
+    // Samples left in the queue push back on the sampling context, which holds on to any motion that no longer fits
+    while (!pointing_device_accumulator_is_backlogged() && pointing_device_sampling_take(&sensor_report)) {
+        local_mouse_report.buttons = sensor_report.buttons;
+        pointing_device_accumulator_add(sensor_report);
+    }
+#    else
+    if (pointing_device_read_motion(local_mouse_report, &sensor_report)) {
+        local_mouse_report.buttons = sensor_report.buttons;
+        pointing_device_accumulator_add(pointing_device_adjust_by_defines(sensor_report));
+    }
+#    endif
+}
+#endif
+
 /**
  * @brief Retrieves and processes pointing device data.
  *
  * This function is part of the keyboard loop and retrieves the mouse report from the pointing device driver.
  * It applies any optional configuration e.g. rotation or axis inversion and then initiates a send.
  *
+ * With POINTING_DEVICE_MOTION_ACCUMULATOR_ENABLE, the driver is read on every call and its motion is coalesced
+ * until the next report is due, as set by POINTING_DEVICE_TASK_THROTTLE_MS.
+ *
  */
 __attribute__((weak)) bool pointing_device_task(void) {
 #if defined(SPLIT_POINTING_ENABLE)
@@ -273,6 +382,10 @@ __attribute__((weak)) bool pointing_device_task(void) {
     };
 #endif
 
+#ifdef POINTING_DEVICE_MOTION_ACCUMULATOR_ENABLE
+    pointing_device_accumulate_motion();
+#endif
+
 #if (POINTING_DEVICE_TASK_THROTTLE_MS > 0)
     static uint32_t last_exec = 0;
     if (timer_elapsed32(last_exec) < POINTING_DEVICE_TASK_THROTTLE_MS) {
@@ -281,40 +394,43 @@ __attribute__((weak)) bool pointing_device_task(void) {
     last_exec = timer_read32();
 #endif
 
+#ifdef POINTING_DEVICE_MOTION_ACCUMULATOR_ENABLE
+    local_mouse_report = pointing_device_accumulator_take(local_mouse_report);
+#else
     // Gather report info
-#ifdef POINTING_DEVICE_MOTION_PIN
-#    if defined(SPLIT_POINTING_ENABLE)
-#        error POINTING_DEVICE_MOTION_PIN not supported when sharing the pointing device report between sides.
-#    endif
-#    ifdef POINTING_DEVICE_MOTION_PIN_ACTIVE_LOW
+#    ifdef POINTING_DEVICE_MOTION_PIN
+#        if defined(SPLIT_POINTING_ENABLE)
+#            error POINTING_DEVICE_MOTION_PIN not supported when sharing the pointing device report between sides.
+#        endif
+#        ifdef POINTING_DEVICE_MOTION_PIN_ACTIVE_LOW
     if (!gpio_read_pin(POINTING_DEVICE_MOTION_PIN))
-#    else
+#        else
     if (gpio_read_pin(POINTING_DEVICE_MOTION_PIN))
-#    endif
+#        endif
     {
-#endif
+#    endif
 
-#if defined(SPLIT_POINTING_ENABLE)
-#    if defined(POINTING_DEVICE_COMBINED)
+#    if defined(SPLIT_POINTING_ENABLE)
+#        if defined(POINTING_DEVICE_COMBINED)
         static uint8_t old_buttons = 0;
         local_mouse_report.buttons = old_buttons;
         local_mouse_report         = pointing_device_driver->get_report(local_mouse_report);
         old_buttons                = local_mouse_report.buttons;
-#    elif defined(POINTING_DEVICE_LEFT) || defined(POINTING_DEVICE_RIGHT)
+#        elif defined(POINTING_DEVICE_LEFT) || defined(POINTING_DEVICE_RIGHT)
         local_mouse_report = POINTING_DEVICE_THIS_SIDE ? pointing_device_driver->get_report(local_mouse_report) : shared_mouse_report;
+#        else
+#            error "You need to define the side(s) the pointing device is on. POINTING_DEVICE_COMBINED / POINTING_DEVICE_LEFT / POINTING_DEVICE_RIGHT"
+#        endif
 #    else
-#        error "You need to define the side(s) the pointing device is on. POINTING_DEVICE_COMBINED / POINTING_DEVICE_LEFT / POINTING_DEVICE_RIGHT"
-#    endif
-#else
     local_mouse_report = pointing_device_driver->get_report(local_mouse_report);
-#endif // defined(SPLIT_POINTING_ENABLE)
+#    endif // defined(SPLIT_POINTING_ENABLE)
 
-#ifdef POINTING_DEVICE_MOTION_PIN
+#    ifdef POINTING_DEVICE_MOTION_PIN
     }
-#endif
+#    endif
 
     // allow kb to intercept and modify report
-#if defined(SPLIT_POINTING_ENABLE) && defined(POINTING_DEVICE_COMBINED)
+#    if defined(SPLIT_POINTING_ENABLE) && defined(POINTING_DEVICE_COMBINED)
     if (is_keyboard_left()) {
         local_mouse_report  = pointing_device_adjust_by_defines(local_mouse_report);
         shared_mouse_report = pointing_device_adjust_by_defines_right(shared_mouse_report);
@@ -323,9 +439,10 @@ __attribute__((weak)) bool pointing_device_task(void) {
         shared_mouse_report = pointing_device_adjust_by_defines(shared_mouse_report);
     }
     local_mouse_report = is_keyboard_left() ? pointing_device_task_combined_kb(local_mouse_report, shared_mouse_report) : pointing_device_task_combined_kb(shared_mouse_report, local_mouse_report);
-#else
+#    else
     local_mouse_report = pointing_device_adjust_by_defines(local_mouse_report);
-#endif
+#    endif
+#endif // POINTING_DEVICE_MOTION_ACCUMULATOR_ENABLE
     local_mouse_report = pointing_device_task_modules(local_mouse_report);
     local_mouse_report = pointing_device_task_kb(local_mouse_report);
     // automatic mouse layer function
@@ -374,7 +491,10 @@ uint16_t pointing_device_get_cpi(void) {
 #if defined(SPLIT_POINTING_ENABLE)
     return POINTING_DEVICE_THIS_SIDE ? pointing_device_driver->get_cpi() : shared_cpi;
 #else
-    return pointing_device_driver->get_cpi();
+    pointing_device_sampling_lock();
+    uint16_t cpi = pointing_device_driver->get_cpi();
+    pointing_device_sampling_unlock();
+    return cpi;
 #endif
 }
 
@@ -393,7 +513,9 @@ void pointing_device_set_cpi(uint16_t cpi) {
         shared_cpi = cpi;
     }
 #else
+    pointing_device_sampling_lock();
     pointing_device_driver->set_cpi(cpi);
+    pointing_device_sampling_unlock();
 #endif
 }
 
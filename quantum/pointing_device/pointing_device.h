@@ -33,6 +33,14 @@ typedef struct {
 #    include "pointing_device_auto_mouse.h"
 #endif
 
+#ifdef POINTING_DEVICE_MOTION_ACCUMULATOR_ENABLE
+#    include "pointing_device_accumulator.h"
+#endif
+
+#ifdef POINTING_DEVICE_SAMPLING_TASK_ENABLE
+#    include "pointing_device_sampling.h"
+#endif
+
 #if defined(POINTING_DEVICE_DRIVER_adns5050)
 #    include "drivers/sensors/adns5050.h"
 #    define POINTING_DEVICE_MOTION_PIN_ACTIVE_LOW
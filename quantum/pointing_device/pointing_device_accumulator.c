@@ -0,0 +1,122 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifdef POINTING_DEVICE_MOTION_ACCUMULATOR_ENABLE
+
+#    include <stdlib.h>
+#    include "pointing_device_accumulator.h"
+
+#    define XY_CARRY_MAX ((int32_t)MOUSE_REPORT_XY_MAX * POINTING_DEVICE_MOTION_CARRY_REPORTS * POINTING_DEVICE_MOTION_SCALE_ONE)
+#    define HV_CARRY_MAX ((int32_t)MOUSE_REPORT_HV_MAX * POINTING_DEVICE_MOTION_CARRY_REPORTS)
+
+/* local data structure for tracking motion not yet reported */
+typedef struct {
+    int32_t x; // fixed point, with POINTING_DEVICE_MOTION_FRACTION_BITS fractional bits
+    int32_t y;
+    int32_t h; // whole units, scrolling is never scaled
+    int32_t v;
+} motion_accumulator_t;
+
+static motion_accumulator_t motion_accumulator = {0};
+static uint16_t             motion_scale       = POINTING_DEVICE_MOTION_SCALE_DEFAULT;
+
+static inline int32_t saturate(int32_t value, int32_t limit) {
+    return value < -limit ? -limit : (value > limit ? limit : value);
+}
+
+/**
+ * @brief Moves as much of the accumulated motion as fits into a single report field
+ *
+ * Truncates towards zero so that the remainder always has the same sign as the motion, then leaves anything beyond
+ * the range of the report in the accumulator for the next report.
+ *
+ * @param[in] accumulated pointer to the accumulated value
+ * @param[in] shift number of fractional bits in the accumulated value
+ * @param[in] min smallest value the report field can hold
+ * @param[in] max largest value the report field can hold
+ * @return int32_t whole units to report
+ */
+static int32_t take_whole_units(int32_t *accumulated, uint8_t shift, int32_t min, int32_t max) {
+    int32_t whole = *accumulated / (1L << shift);
+    if (whole < min) {
+        whole = min;
+    } else if (whole > max) {
+        whole = max;
+    }
+    *accumulated -= whole * (1L << shift);
+    return whole;
+}
+
+/**
+ * @brief Adds a sensor reading to the motion not yet reported
+ *
+ * Movement is scaled by the current motion scale without discarding the fractional part, so that slow movements
+ * and non-integer scales still add up correctly over several reads.
+ *
+ * @param[in] mouse_report report_mouse_t holding the reading
+ */
+void pointing_device_accumulator_add(report_mouse_t mouse_report) {
+    // A full range reading multiplied by the largest scale still fits within int32_t
+    motion_accumulator.x = saturate(motion_accumulator.x + saturate((int32_t)mouse_report.x * motion_scale, XY_CARRY_MAX), XY_CARRY_MAX);
+    motion_accumulator.y = saturate(motion_accumulator.y + saturate((int32_t)mouse_report.y * motion_scale, XY_CARRY_MAX), XY_CARRY_MAX);
+    motion_accumulator.h = saturate(motion_accumulator.h + mouse_report.h, HV_CARRY_MAX);
+    motion_accumulator.v = saturate(motion_accumulator.v + mouse_report.v, HV_CARRY_MAX);
+}
+
+/**
+ * @brief Fills a report with the accumulated motion
+ *
+ * Sub-pixel remainders, and any motion exceeding the range of a single report, are kept for the next report.
+ *
+ * @param[in] mouse_report report_mouse_t to fill, buttons are left as they are
+ * @return report_mouse_t with the movement fields replaced
+ */
+report_mouse_t pointing_device_accumulator_take(report_mouse_t mouse_report) {
+    mouse_report.x = take_whole_units(&motion_accumulator.x, POINTING_DEVICE_MOTION_FRACTION_BITS, MOUSE_REPORT_XY_MIN, MOUSE_REPORT_XY_MAX);
+    mouse_report.y = take_whole_units(&motion_accumulator.y, POINTING_DEVICE_MOTION_FRACTION_BITS, MOUSE_REPORT_XY_MIN, MOUSE_REPORT_XY_MAX);
+    mouse_report.h = take_whole_units(&motion_accumulator.h, 0, MOUSE_REPORT_HV_MIN, MOUSE_REPORT_HV_MAX);
+    mouse_report.v = take_whole_units(&motion_accumulator.v, 0, MOUSE_REPORT_HV_MIN, MOUSE_REPORT_HV_MAX);
+    return mouse_report;
+}
+
+/**
+ * @brief Checks whether more than a full report's worth of motion is waiting to be reported
+ *
+ * Callers with motion of their own to hold on to can stop adding to the accumulator until this clears, rather than
+ * letting it saturate.
+ *
+ * @return true if any axis exceeds the range of a single report
+ */
+bool pointing_device_accumulator_is_backlogged(void) {
+    return abs(motion_accumulator.x) > ((int32_t)MOUSE_REPORT_XY_MAX << POINTING_DEVICE_MOTION_FRACTION_BITS) || abs(motion_accumulator.y) > ((int32_t)MOUSE_REPORT_XY_MAX << POINTING_DEVICE_MOTION_FRACTION_BITS) || abs(motion_accumulator.h) > MOUSE_REPORT_HV_MAX || abs(motion_accumulator.v) > MOUSE_REPORT_HV_MAX;
+}
+
+/**
+ * @brief Discards any motion not yet reported, including sub-pixel remainders
+ */
+void pointing_device_accumulator_clear(void) {
+    motion_accumulator = (motion_accumulator_t){0};
+}
+
+/**
+ * @brief Sets the scale applied to sensor movement
+ *
+ * The scale is fixed point, with POINTING_DEVICE_MOTION_SCALE_ONE representing 1.0 -- for example,
+ * `POINTING_DEVICE_MOTION_SCALE_ONE / 4` moves the cursor at a quarter of the sensor's resolution.
+ *
+ * @param[in] scale uint16_t fixed point scale
+ */
+void pointing_device_set_motion_scale(uint16_t scale) {
+    motion_scale = scale;
+}
+
+/**
+ * @brief Gets the scale applied to sensor movement
+ *
+ * @return uint16_t fixed point scale
+ */
+uint16_t pointing_device_get_motion_scale(void) {
+    return motion_scale;
+}
+
+#endif // POINTING_DEVICE_MOTION_ACCUMULATOR_ENABLE
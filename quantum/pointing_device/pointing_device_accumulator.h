@@ -0,0 +1,32 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "report.h"
+
+#ifndef POINTING_DEVICE_MOTION_ACCUMULATOR_ENABLE
+#    error "POINTING_DEVICE_MOTION_ACCUMULATOR_ENABLE not defined! check config settings"
+#endif
+
+/* number of fractional bits kept for sub-pixel motion */
+#define POINTING_DEVICE_MOTION_FRACTION_BITS 8
+/* motion scale of 1.0, as used by pointing_device_set_motion_scale() */
+#define POINTING_DEVICE_MOTION_SCALE_ONE (1 << POINTING_DEVICE_MOTION_FRACTION_BITS)
+
+#ifndef POINTING_DEVICE_MOTION_SCALE_DEFAULT
+#    define POINTING_DEVICE_MOTION_SCALE_DEFAULT POINTING_DEVICE_MOTION_SCALE_ONE
+#endif
+/* the number of full reports worth of motion which may be carried over, beyond which motion is dropped */
+#ifndef POINTING_DEVICE_MOTION_CARRY_REPORTS
+#    define POINTING_DEVICE_MOTION_CARRY_REPORTS 8
+#endif
+
+void           pointing_device_accumulator_add(report_mouse_t mouse_report);
+report_mouse_t pointing_device_accumulator_take(report_mouse_t mouse_report);
+bool           pointing_device_accumulator_is_backlogged(void);
+void           pointing_device_accumulator_clear(void);
+void           pointing_device_set_motion_scale(uint16_t scale);
+uint16_t       pointing_device_get_motion_scale(void);
@@ -0,0 +1,251 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifdef POINTING_DEVICE_SAMPLING_TASK_ENABLE
+
+#    include "pointing_device_sampling.h"
+
+#    if defined(PROTOCOL_CHIBIOS)
+#        include <ch.h>
+#        ifdef POINTING_DEVICE_SAMPLING_MOTION_INTERRUPT
+#            include <hal.h>
+#            if !PAL_USE_CALLBACKS
+#                error "POINTING_DEVICE_SAMPLING_MOTION_INTERRUPT requires PAL_USE_CALLBACKS in halconf.h"
+#            endif
+#        endif
+#    endif
+
+#    define SAMPLE_QUEUE_MASK (POINTING_DEVICE_SAMPLE_QUEUE_SIZE - 1)
+
+_Static_assert(POINTING_DEVICE_SAMPLE_QUEUE_SIZE >= 2 && POINTING_DEVICE_SAMPLE_QUEUE_SIZE <= 128 && (POINTING_DEVICE_SAMPLE_QUEUE_SIZE & SAMPLE_QUEUE_MASK) == 0, "POINTING_DEVICE_SAMPLE_QUEUE_SIZE must be a power of two, no larger than 128");
+
+/* single producer, single consumer queue -- head is only written by the consumer, tail only by the producer */
+typedef struct {
+    report_mouse_t samples[POINTING_DEVICE_SAMPLE_QUEUE_SIZE];
+    uint8_t        head;
+    uint8_t        tail;
+} sample_queue_t;
+
+/* motion read by the producer which has not made it into the queue yet */
+typedef struct {
+    int32_t x;
+    int32_t y;
+    int32_t h;
+    int32_t v;
+    uint8_t buttons;
+    bool    dirty;
+} pending_sample_t;
+
+static sample_queue_t   sample_queue   = {0};
+static pending_sample_t pending_sample = {0};
+
+static inline int32_t take_clamped(int32_t *pending, int32_t min, int32_t max) {
+    int32_t value = *pending < min ? min : (*pending > max ? max : *pending);
+    *pending -= value;
+    return value;
+}
+
+static inline int32_t add_saturated(int32_t pending, int32_t value) {
+    if (value > 0 && pending > INT32_MAX - value) {
+        return INT32_MAX;
+    }
+    if (value < 0 && pending < INT32_MIN - value) {
+        return INT32_MIN;
+    }
+    return pending + value;
+}
+
+/**
+ * @brief Queues a sensor reading for pointing_device_task()
+ *
+ * Must only be called from the sampling context. When the queue is full, the motion is held back and added to the
+ * next sample instead, so that nothing is lost while the main loop is busy. Motion beyond the range of a single
+ * report is split across as many queue entries as it takes.
+ *
+ * @param[in] sample report_mouse_t holding the reading
+ * @return true if all pending motion has been queued
+ */
+bool pointing_device_sampling_push(report_mouse_t sample) {
+    pending_sample.x       = add_saturated(pending_sample.x, sample.x);
+    pending_sample.y       = add_saturated(pending_sample.y, sample.y);
+    pending_sample.h       = add_saturated(pending_sample.h, sample.h);
+    pending_sample.v       = add_saturated(pending_sample.v, sample.v);
+    pending_sample.dirty  |= pending_sample.buttons != sample.buttons;
+    pending_sample.buttons = sample.buttons;
+
+    uint8_t tail = sample_queue.tail;
+    while (pending_sample.x || pending_sample.y || pending_sample.h || pending_sample.v || pending_sample.dirty) {
+        if ((uint8_t)(tail - __atomic_load_n(&sample_queue.head, __ATOMIC_ACQUIRE)) == POINTING_DEVICE_SAMPLE_QUEUE_SIZE) {
+            return false;
+        }
+
+        report_mouse_t *slot = &sample_queue.samples[tail & SAMPLE_QUEUE_MASK];
+        slot->buttons        = pending_sample.buttons;
+        slot->x              = take_clamped(&pending_sample.x, MOUSE_REPORT_XY_MIN, MOUSE_REPORT_XY_MAX);
+        slot->y              = take_clamped(&pending_sample.y, MOUSE_REPORT_XY_MIN, MOUSE_REPORT_XY_MAX);
+        slot->h              = take_clamped(&pending_sample.h, MOUSE_REPORT_HV_MIN, MOUSE_REPORT_HV_MAX);
+        slot->v              = take_clamped(&pending_sample.v, MOUSE_REPORT_HV_MIN, MOUSE_REPORT_HV_MAX);
+        pending_sample.dirty = false;
+
+        // Publish the filled slot to the consumer
+        __atomic_store_n(&sample_queue.tail, ++tail, __ATOMIC_RELEASE);
+    }
+    return true;
+}
+
+/**
+ * @brief Takes the oldest queued sample
+ *
+ * Must only be called from the main loop.
+ *
+ * @param[out] sample report_mouse_t to fill
+ * @return true if a sample was available
+ */
+bool pointing_device_sampling_take(report_mouse_t *sample) {
+    uint8_t head = sample_queue.head;
+    if (head == __atomic_load_n(&sample_queue.tail, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+
+    *sample = sample_queue.samples[head & SAMPLE_QUEUE_MASK];
+
+    // Hand the slot back to the producer only once it has been copied
+    __atomic_store_n(&sample_queue.head, (uint8_t)(head + 1), __ATOMIC_RELEASE);
+    return true;
+}
+
+/**
+ * @brief Discards all queued and pending motion
+ *
+ * Only safe while nothing is sampling, eg. before pointing_device_sampling_start().
+ */
+void pointing_device_sampling_clear(void) {
+    sample_queue   = (sample_queue_t){0};
+    pending_sample = (pending_sample_t){0};
+}
+
+#    if defined(PROTOCOL_CHIBIOS)
+static MUTEX_DECL(pointing_device_driver_mutex);
+static THD_WORKING_AREA(pointing_device_sampling_wa, POINTING_DEVICE_SAMPLING_THREAD_STACK_SIZE);
+
+/**
+ * @brief Serialises access to the pointing device driver between the sampling thread and the main loop
+ */
+void pointing_device_sampling_lock(void) {
+    chMtxLock(&pointing_device_driver_mutex);
+}
+
+void pointing_device_sampling_unlock(void) {
+    chMtxUnlock(&pointing_device_driver_mutex);
+}
+
+#        ifdef POINTING_DEVICE_SAMPLING_MOTION_INTERRUPT
+static BSEMAPHORE_DECL(pointing_device_motion, true);
+
+/**
+ * @brief Wakes the sampling thread, which reads the sensor
+ *
+ * Must be called from an interrupt, with the kernel unlocked.
+ */
+void pointing_device_sampling_motion_isr(void) {
+    chSysLockFromISR();
+    chBSemSignalI(&pointing_device_motion);
+    chSysUnlockFromISR();
+}
+
+static void pointing_device_motion_pin_callback(void *arg) {
+    (void)arg;
+    pointing_device_sampling_motion_isr();
+}
+#        endif
+
+static THD_FUNCTION(pointing_device_sampling_thread, arg) {
+    (void)arg;
+    chRegSetThreadName("pointing");
+
+#        ifdef POINTING_DEVICE_SAMPLING_MOTION_INTERRUPT
+    while (true) {
+        // Asleep until the motion pin fires, then read at the interval for as long as there is motion to read
+        chBSemWait(&pointing_device_motion);
+        systime_t next = chVTGetSystemTimeX();
+        while (pointing_device_sample()) {
+            next = chThdSleepUntilWindowed(next, chTimeAddX(next, TIME_US2I(POINTING_DEVICE_SAMPLING_INTERVAL_US)));
+        }
+    }
+#        else
+    systime_t next = chVTGetSystemTimeX();
+    while (true) {
+        pointing_device_sample();
+        next = chThdSleepUntilWindowed(next, chTimeAddX(next, TIME_US2I(POINTING_DEVICE_SAMPLING_INTERVAL_US)));
+    }
+#        endif
+}
+
+/**
+ * @brief Starts reading the sensor from a thread of its own
+ *
+ * The thread runs at a higher priority than the main loop, so that sampling carries on at a steady rate while the
+ * main loop is busy rendering lighting or flushing a display. It reads the sensor every
+ * POINTING_DEVICE_SAMPLING_INTERVAL_US, or with POINTING_DEVICE_SAMPLING_MOTION_INTERRUPT only once the motion pin
+ * has fired.
+ */
+void pointing_device_sampling_start(void) {
+#        ifdef POINTING_DEVICE_SAMPLING_MOTION_INTERRUPT
+#            ifdef POINTING_DEVICE_MOTION_PIN_ACTIVE_LOW
+    palEnableLineEvent(POINTING_DEVICE_MOTION_PIN, PAL_EVENT_MODE_FALLING_EDGE);
+#            else
+    palEnableLineEvent(POINTING_DEVICE_MOTION_PIN, PAL_EVENT_MODE_RISING_EDGE);
+#            endif
+    palSetLineCallback(POINTING_DEVICE_MOTION_PIN, pointing_device_motion_pin_callback, NULL);
+    // Motion signalled before the interrupt was enabled raises no edge
+    chBSemSignal(&pointing_device_motion);
+#        endif
+    chThdCreateStatic(pointing_device_sampling_wa, sizeof(pointing_device_sampling_wa), NORMALPRIO + 1, pointing_device_sampling_thread, NULL);
+}
+
+#    else
+#        ifdef POINTING_DEVICE_SAMPLING_MOTION_INTERRUPT
+/* set by the motion interrupt, cleared once the main loop has read the sensor */
+static volatile bool motion_pending = true;
+
+/**
+ * @brief Marks the sensor as having motion, for pointing_device_sampling_task() to read it
+ *
+ * Safe to call from the interrupt of the motion pin, as it does not talk to the sensor itself.
+ */
+void pointing_device_sampling_motion_isr(void) {
+    motion_pending = true;
+}
+#        endif
+
+/**
+ * @brief Starts sampling the sensor
+ *
+ * Without threads the sensor is read by pointing_device_sampling_task(), so there is nothing to start.
+ */
+__attribute__((weak)) void pointing_device_sampling_start(void) {}
+
+/**
+ * @brief Reads the sensor from the main loop, on platforms without threads
+ *
+ * With POINTING_DEVICE_SAMPLING_MOTION_INTERRUPT, the read is deferred from the motion interrupt to here, and skipped
+ * while the sensor has no motion. The sensor is then only ever talked to from the main loop, so nothing races with
+ * other users of its bus.
+ */
+void pointing_device_sampling_task(void) {
+#        ifdef POINTING_DEVICE_SAMPLING_MOTION_INTERRUPT
+    if (!motion_pending) {
+        return;
+    }
+    // Cleared first, so motion signalled while the sensor is read is not missed
+    motion_pending = false;
+    if (pointing_device_sample()) {
+        motion_pending = true;
+    }
+#        else
+    pointing_device_sample();
+#        endif
+}
+#    endif
+
+#endif // POINTING_DEVICE_SAMPLING_TASK_ENABLE
@@ -0,0 +1,53 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "report.h"
+
+#ifndef POINTING_DEVICE_SAMPLING_TASK_ENABLE
+#    error "POINTING_DEVICE_SAMPLING_TASK_ENABLE not defined! check config settings"
+#endif
+
+#ifndef POINTING_DEVICE_MOTION_ACCUMULATOR_ENABLE
+#    error "POINTING_DEVICE_SAMPLING_TASK_ENABLE requires POINTING_DEVICE_MOTION_ACCUMULATOR_ENABLE"
+#endif
+
+/* number of samples which may be waiting for pointing_device_task(), must be a power of two */
+#ifndef POINTING_DEVICE_SAMPLE_QUEUE_SIZE
+#    define POINTING_DEVICE_SAMPLE_QUEUE_SIZE 16
+#endif
+/* time between sensor reads in the sampling thread */
+#ifndef POINTING_DEVICE_SAMPLING_INTERVAL_US
+#    define POINTING_DEVICE_SAMPLING_INTERVAL_US 1000
+#endif
+#ifndef POINTING_DEVICE_SAMPLING_THREAD_STACK_SIZE
+#    define POINTING_DEVICE_SAMPLING_THREAD_STACK_SIZE 512
+#endif
+
+#if defined(PROTOCOL_CHIBIOS) && defined(POINTING_DEVICE_SAMPLING_MOTION_INTERRUPT) && !defined(POINTING_DEVICE_MOTION_PIN)
+#    error "POINTING_DEVICE_SAMPLING_MOTION_INTERRUPT requires POINTING_DEVICE_MOTION_PIN"
+#endif
+
+bool pointing_device_sample(void);
+void pointing_device_sampling_start(void);
+#ifdef POINTING_DEVICE_SAMPLING_MOTION_INTERRUPT
+void pointing_device_sampling_motion_isr(void);
+#endif
+bool pointing_device_sampling_push(report_mouse_t sample);
+bool pointing_device_sampling_take(report_mouse_t *sample);
+void pointing_device_sampling_clear(void);
+
+#if defined(PROTOCOL_CHIBIOS)
+void pointing_device_sampling_lock(void);
+void pointing_device_sampling_unlock(void);
+/* the sampling thread reads the sensor, rather than the main loop */
+static inline void pointing_device_sampling_task(void) {}
+#else
+void pointing_device_sampling_task(void);
+/* without threads the sensor is only read from the main loop, so there is nothing to serialise */
+static inline void pointing_device_sampling_lock(void) {}
+static inline void pointing_device_sampling_unlock(void) {}
+#endif
@@ -16,6 +16,7 @@
 
 #include "process_combo.h"
 #include <stddef.h>
+#include <string.h>
 #include "process_auto_shift.h"
 #include "caps_word.h"
 #include "timer.h"
@@ -36,43 +37,43 @@ __attribute__((weak)) uint8_t combo_ref_from_layer(uint8_t layer) {
 #endif
 
 #ifdef COMBO_MUST_HOLD_PER_COMBO
-__attribute__((weak)) bool get_combo_must_hold(uint16_t combo_index, combo_t *combo) {
+__attribute__((weak)) bool get_combo_must_hold(uint16_t combo_index, const combo_t *combo) {
     return false;
 }
 #endif
 
 #ifdef COMBO_MUST_TAP_PER_COMBO
-__attribute__((weak)) bool get_combo_must_tap(uint16_t combo_index, combo_t *combo) {
+__attribute__((weak)) bool get_combo_must_tap(uint16_t combo_index, const combo_t *combo) {
     return false;
 }
 #endif
 
 #ifdef COMBO_TERM_PER_COMBO
-__attribute__((weak)) uint16_t get_combo_term(uint16_t combo_index, combo_t *combo) {
+__attribute__((weak)) uint16_t get_combo_term(uint16_t combo_index, const combo_t *combo) {
     return COMBO_TERM;
 }
 #endif
 
 #ifdef COMBO_MUST_PRESS_IN_ORDER_PER_COMBO
-__attribute__((weak)) bool get_combo_must_press_in_order(uint16_t combo_index, combo_t *combo) {
+__attribute__((weak)) bool get_combo_must_press_in_order(uint16_t combo_index, const combo_t *combo) {
     return true;
 }
 #endif
 
 #ifdef COMBO_PROCESS_KEY_RELEASE
-__attribute__((weak)) bool process_combo_key_release(uint16_t combo_index, combo_t *combo, uint8_t key_index, uint16_t keycode) {
+__attribute__((weak)) bool process_combo_key_release(uint16_t combo_index, const combo_t *combo, uint8_t key_index, uint16_t keycode) {
     return false;
 }
 #endif
 
 #ifdef COMBO_PROCESS_KEY_REPRESS
-__attribute__((weak)) bool process_combo_key_repress(uint16_t combo_index, combo_t *combo, uint8_t key_index, uint16_t keycode) {
+__attribute__((weak)) bool process_combo_key_repress(uint16_t combo_index, const combo_t *combo, uint8_t key_index, uint16_t keycode) {
     return false;
 }
 #endif
 
 #ifdef COMBO_SHOULD_TRIGGER
-__attribute__((weak)) bool combo_should_trigger(uint16_t combo_index, combo_t *combo, uint16_t keycode, keyrecord_t *record) {
+__attribute__((weak)) bool combo_should_trigger(uint16_t combo_index, const combo_t *combo, uint16_t keycode, keyrecord_t *record) {
     return true;
 }
 #endif
@@ -89,6 +90,7 @@ typedef struct {
     keyrecord_t record;
     uint16_t    combo_index;
     uint16_t    keycode;
+    bool        released; // the key went up again before the buffer was dumped
 } queued_record_t;
 static uint8_t         key_buffer_size = 0;
 static queued_record_t key_buffer[COMBO_KEY_BUFFER_LENGTH];
@@ -102,54 +104,60 @@ static queued_combo_t combo_buffer[COMBO_BUFFER_LENGTH];
 
 #define INCREMENT_MOD(i) i = (i + 1) % COMBO_BUFFER_LENGTH
 
-#ifndef EXTRA_SHORT_COMBOS
-/* flags are their own elements in combo_t struct. */
-#    define COMBO_ACTIVE(combo) (combo->active)
-#    define COMBO_DISABLED(combo) (combo->disabled)
-#    define COMBO_STATE(combo) (combo->state)
-
-#    define ACTIVATE_COMBO(combo) \
-        do {                      \
-            combo->active = true; \
-        } while (0)
-#    define DEACTIVATE_COMBO(combo) \
-        do {                        \
-            combo->active = false;  \
-        } while (0)
-#    define DISABLE_COMBO(combo)    \
-        do {                        \
-            combo->disabled = true; \
-        } while (0)
-#    define RESET_COMBO_STATE(combo) \
-        do {                         \
-            combo->disabled = false; \
-            combo->state    = 0;     \
-        } while (0)
-#else
-/* flags are at the two high bits of state. */
-#    define COMBO_ACTIVE(combo) (combo->state & 0x80)
-#    define COMBO_DISABLED(combo) (combo->state & 0x40)
-#    define COMBO_STATE(combo) (combo->state & 0x3F)
-
-#    define ACTIVATE_COMBO(combo) \
-        do {                      \
-            combo->state |= 0x80; \
-        } while (0)
-#    define DEACTIVATE_COMBO(combo) \
-        do {                        \
-            combo->state &= ~0x80;  \
-        } while (0)
-#    define DISABLE_COMBO(combo)  \
-        do {                      \
-            combo->state |= 0x40; \
-        } while (0)
-#    define RESET_COMBO_STATE(combo) \
-        do {                         \
-            combo->state &= ~0x7F;   \
-        } while (0)
-#endif
-
-static inline void release_combo(uint16_t combo_index, combo_t *combo) {
+/* Combos that have fired keep an entry until all of their keys are released. The key state of the other combos is
+ * worked out from the keys in key_buffer, and whether they are disabled is kept in combo_disabled_bitset. */
+typedef struct {
+    uint16_t          combo_index;
+    combo_key_state_t keys; // one bit per key of the combo that is down
+    bool              used : 1;
+    bool              active : 1;
+} combo_state_t;
+static combo_state_t combo_states[COMBO_STATE_BUFFER_LENGTH];
+
+#define COMBO_ACTIVE(state) ((state) && (state)->active)
+
+/* Combos past combo_count_max() have no bit in combo_disabled_bitset and are left out */
+static uint16_t combo_count_tracked(void) {
+    uint16_t count = combo_count();
+    return count < combo_count_max() ? count : combo_count_max();
+}
+
+static inline bool combo_is_disabled(uint16_t combo_index) {
+    return combo_disabled_bitset[combo_index / 8] & (1 << (combo_index % 8));
+}
+
+static inline void disable_combo(uint16_t combo_index) {
+    combo_disabled_bitset[combo_index / 8] |= 1 << (combo_index % 8);
+}
+
+static combo_state_t *combo_state_get(uint16_t combo_index) {
+    for (uint8_t i = 0; i < COMBO_STATE_BUFFER_LENGTH; i++) {
+        if (combo_states[i].used && combo_states[i].combo_index == combo_index) {
+            return &combo_states[i];
+        }
+    }
+    return NULL;
+}
+
+/* Returns NULL if the state buffer is full, in which case the combo cannot fire. */
+static combo_state_t *combo_state_acquire(uint16_t combo_index) {
+    combo_state_t *state = combo_state_get(combo_index);
+    if (state) {
+        return state;
+    }
+    for (uint8_t i = 0; i < COMBO_STATE_BUFFER_LENGTH; i++) {
+        if (!combo_states[i].used) {
+            combo_states[i] = (combo_state_t){
+                .combo_index = combo_index,
+                .used        = true,
+            };
+            return &combo_states[i];
+        }
+    }
+    return NULL;
+}
+
+static inline void release_combo(uint16_t combo_index, const combo_t *combo) {
     if (combo->keycode) {
         keyrecord_t record = {
             .event   = MAKE_COMBOEVENT(false),
@@ -163,10 +171,13 @@ static inline void release_combo(uint16_t combo_index, combo_t *combo) {
     } else {
         process_combo_event(combo_index, false);
     }
-    DEACTIVATE_COMBO(combo);
+    combo_state_t *state = combo_state_get(combo_index);
+    if (state) {
+        state->active = false;
+    }
 }
 
-static inline bool _get_combo_must_hold(uint16_t combo_index, combo_t *combo) {
+static inline bool _get_combo_must_hold(uint16_t combo_index, const combo_t *combo) {
 #ifdef COMBO_NO_TIMER
     return false;
 #elif defined(COMBO_MUST_HOLD_PER_COMBO)
@@ -177,7 +188,7 @@ static inline bool _get_combo_must_hold(uint16_t combo_index, combo_t *combo) {
     return false;
 }
 
-static inline uint16_t _get_wait_time(uint16_t combo_index, combo_t *combo) {
+static inline uint16_t _get_wait_time(uint16_t combo_index, const combo_t *combo) {
     if (_get_combo_must_hold(combo_index, combo)
 #ifdef COMBO_MUST_TAP_PER_COMBO
         || get_combo_must_tap(combo_index, combo)
@@ -191,7 +202,7 @@ static inline uint16_t _get_wait_time(uint16_t combo_index, combo_t *combo) {
     return longest_term;
 }
 
-static inline uint16_t _get_combo_term(uint16_t combo_index, combo_t *combo) {
+static inline uint16_t _get_combo_term(uint16_t combo_index, const combo_t *combo) {
 #if defined(COMBO_TERM_PER_COMBO)
     return get_combo_term(combo_index, combo);
 #endif
@@ -200,12 +211,14 @@ static inline uint16_t _get_combo_term(uint16_t combo_index, combo_t *combo) {
 }
 
 void clear_combos(void) {
-    uint16_t index = 0;
-    longest_term   = 0;
-    for (index = 0; index < combo_count(); ++index) {
-        combo_t *combo = combo_get(index);
-        if (!COMBO_ACTIVE(combo)) {
-            RESET_COMBO_STATE(combo);
+    longest_term = 0;
+    memset(combo_disabled_bitset, 0, (combo_count_max() + 7) / 8);
+    for (uint8_t i = 0; i < COMBO_STATE_BUFFER_LENGTH; i++) {
+        if (!combo_states[i].active) {
+            combo_states[i].used = false;
+        } else if (combo_states[i].used) {
+            // Combos that are held stay disabled until they are released
+            disable_combo(combo_states[i].combo_index);
         }
     }
 }
@@ -264,7 +277,6 @@ static inline void dump_key_buffer(void) {
     key_buffer_next = key_buffer_size = 0;
 }
 
-#define NO_COMBO_KEYS_ARE_DOWN (0 == COMBO_STATE(combo))
 #define ALL_COMBO_KEYS_ARE_DOWN(state, key_count) (((1 << key_count) - 1) == state)
 #define ONLY_ONE_KEY_IS_DOWN(state) !(state & (state - 1))
 #define KEY_NOT_YET_RELEASED(state, key_index) ((1 << key_index) & state)
@@ -286,6 +298,21 @@ static inline void _find_key_index_and_count(const uint16_t *keys, uint16_t keyc
     }
 }
 
+/* Keys of a combo that has not fired which are down, from the keys pressed since the combos were last cleared. */
+static combo_key_state_t combo_keys_down(const combo_t *combo) {
+    combo_key_state_t state = 0;
+    uint16_t          key;
+    for (uint8_t key_index = 0; (key = pgm_read_word(&combo->keys[key_index])) != COMBO_END; key_index++) {
+        for (uint8_t key_buffer_i = 0; key_buffer_i < key_buffer_size; key_buffer_i++) {
+            if (key_buffer[key_buffer_i].keycode == key && !key_buffer[key_buffer_i].released) {
+                KEY_STATE_DOWN(state, key_index);
+                break;
+            }
+        }
+    }
+    return state;
+}
+
 void drop_combo_from_buffer(uint16_t combo_index) {
     /* Mark a combo as processed from the buffer. If the buffer is in the
      * beginning of the buffer, drop it.  */
@@ -294,8 +321,7 @@ void drop_combo_from_buffer(uint16_t combo_index) {
         queued_combo_t *qcombo = &combo_buffer[i];
 
         if (qcombo->combo_index == combo_index) {
-            combo_t *combo = combo_get(combo_index);
-            DISABLE_COMBO(combo);
+            disable_combo(combo_index);
 
             if (i == combo_buffer_read) {
                 INCREMENT_MOD(combo_buffer_read);
@@ -306,13 +332,21 @@ void drop_combo_from_buffer(uint16_t combo_index) {
     }
 }
 
-void apply_combo(uint16_t combo_index, combo_t *combo) {
+void apply_combo(uint16_t combo_index, const combo_t *combo) {
     /* Apply combo's result keycode to the last chord key of the combo and
      * disable the other keys. */
 
-    if (COMBO_DISABLED(combo)) {
+    if (combo_is_disabled(combo_index)) {
+        return;
+    }
+
+    combo_state_t *combo_state = combo_state_acquire(combo_index);
+    if (!combo_state) {
+        /* No room to hold another combo, see COMBO_STATE_BUFFER_LENGTH. Its keys are sent as they are. */
+        drop_combo_from_buffer(combo_index);
         return;
     }
+    combo_state->keys = combo_keys_down(combo);
 
     // state to check against so we find the last key of the combo from the buffer
 #if defined(EXTRA_EXTRA_LONG_COMBOS)
@@ -345,7 +379,7 @@ void apply_combo(uint16_t combo_index, combo_t *combo) {
             record->event.key  = MAKE_KEYPOS(0, 0);
 
             qrecord->combo_index = combo_index;
-            ACTIVATE_COMBO(combo);
+            combo_state->active  = true;
 
             break;
         } else {
@@ -361,7 +395,7 @@ static inline void apply_combos(void) {
     // Apply all buffered normal combos.
     for (uint8_t i = combo_buffer_read; i != combo_buffer_write; INCREMENT_MOD(i)) {
         queued_combo_t *buffered_combo = &combo_buffer[i];
-        combo_t *       combo          = combo_get(buffered_combo->combo_index);
+        const combo_t * combo          = combo_get(buffered_combo->combo_index);
 
 #ifdef COMBO_MUST_TAP_PER_COMBO
         if (get_combo_must_tap(buffered_combo->combo_index, combo)) {
@@ -376,7 +410,7 @@ static inline void apply_combos(void) {
     clear_combos();
 }
 
-combo_t *overlaps(combo_t *combo1, combo_t *combo2) {
+const combo_t *overlaps(const combo_t *combo1, const combo_t *combo2) {
     /* Checks if the combos overlap and returns the combo that should be
      * dropped from the combo buffer.
      * The combo that has less keys will be dropped. If they have the same
@@ -401,7 +435,7 @@ combo_t *overlaps(combo_t *combo1, combo_t *combo2) {
 }
 
 #if defined(COMBO_MUST_PRESS_IN_ORDER) || defined(COMBO_MUST_PRESS_IN_ORDER_PER_COMBO)
-static bool keys_pressed_in_order(uint16_t combo_index, combo_t *combo, uint16_t key_index, uint16_t keycode, keyrecord_t *record) {
+static bool keys_pressed_in_order(uint16_t combo_index, const combo_t *combo, combo_key_state_t keys_down, uint16_t key_index, uint16_t keycode, keyrecord_t *record) {
 #    ifdef COMBO_MUST_PRESS_IN_ORDER_PER_COMBO
     if (!get_combo_must_press_in_order(combo_index, combo)) {
         return true;
@@ -411,7 +445,7 @@ static bool keys_pressed_in_order(uint16_t combo_index, combo_t *combo, uint16_t
         // The `state` bit for the key being pressed.
         (1 << key_index) ==
         // The *next* combo key's bit.
-        (COMBO_STATE(combo) + 1)
+        (keys_down + 1)
         // E.g. two keys already pressed: `state == 11`.
         // Next possible `state` is `111`.
         // So the needed bit is `100` which we get with `11 + 1`.
@@ -422,7 +456,7 @@ static bool keys_pressed_in_order(uint16_t combo_index, combo_t *combo, uint16_t
 }
 #endif
 
-static combo_key_action_t process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *record, uint16_t combo_index) {
+static combo_key_action_t process_single_combo(const combo_t *combo, uint16_t keycode, keyrecord_t *record, uint16_t combo_index) {
     uint8_t  key_count = 0;
     uint16_t key_index = -1;
     _find_key_index_and_count(combo->keys, keycode, &key_index, &key_count);
@@ -432,44 +466,61 @@ static combo_key_action_t process_single_combo(combo_t *combo, uint16_t keycode,
         return COMBO_KEY_NOT_PRESSED;
     }
 
-    bool key_is_part_of_combo = (!COMBO_DISABLED(combo) && is_combo_enabled()
+    combo_state_t *   state    = combo_state_get(combo_index);
+    combo_key_state_t keys     = state ? state->keys : combo_keys_down(combo);
+    bool              disabled = combo_is_disabled(combo_index);
+
+    bool key_is_part_of_combo = (!disabled && is_combo_enabled()
 #if defined(COMBO_MUST_PRESS_IN_ORDER) || defined(COMBO_MUST_PRESS_IN_ORDER_PER_COMBO)
-                                 && keys_pressed_in_order(combo_index, combo, key_index, keycode, record)
+                                 && keys_pressed_in_order(combo_index, combo, keys, key_index, keycode, record)
 #endif
 #ifdef COMBO_SHOULD_TRIGGER
                                  && combo_should_trigger(combo_index, combo, keycode, record)
 #endif
     );
 
+#if defined(COMBO_MUST_PRESS_IN_ORDER) || defined(COMBO_MUST_PRESS_IN_ORDER_PER_COMBO) || defined(COMBO_SHOULD_TRIGGER)
+    if (record->event.pressed && !key_is_part_of_combo && !disabled && is_combo_enabled()) {
+        /* A rejected key is not down as far as this combo is concerned, so the combo cannot be completed until the key
+         * is released, which clears the combos. */
+        disable_combo(combo_index);
+    }
+#endif
+
+    if (!keys && !(record->event.pressed && key_is_part_of_combo)) {
+        /* None of the keys of this combo are down and this one won't be tracked either. */
+        return COMBO_KEY_NOT_PRESSED;
+    }
+
     if (record->event.pressed && key_is_part_of_combo) {
         uint16_t time = _get_combo_term(combo_index, combo);
-        if (!COMBO_ACTIVE(combo)) {
-            KEY_STATE_DOWN(combo->state, key_index);
+        if (!COMBO_ACTIVE(state)) {
+            KEY_STATE_DOWN(keys, key_index);
             if (longest_term < time) {
                 longest_term = time;
             }
         }
-        if (ALL_COMBO_KEYS_ARE_DOWN(COMBO_STATE(combo), key_count)) {
+        if (ALL_COMBO_KEYS_ARE_DOWN(keys, key_count)) {
             /* Combo was fully pressed */
             /* Buffer the combo so we can fire it after COMBO_TERM */
 
 #ifndef COMBO_NO_TIMER
             /* Don't buffer this combo if its combo term has passed. */
             if (timer && timer_elapsed(timer) > time) {
-                DISABLE_COMBO(combo);
+                disable_combo(combo_index);
                 return COMBO_KEY_PRESSED;
             } else
 #endif
             {
 
                 // disable readied combos that overlap with this combo
-                combo_t *drop = NULL;
+                const combo_t *drop = NULL;
                 for (uint8_t combo_buffer_i = combo_buffer_read; combo_buffer_i != combo_buffer_write; INCREMENT_MOD(combo_buffer_i)) {
                     queued_combo_t *qcombo         = &combo_buffer[combo_buffer_i];
-                    combo_t *       buffered_combo = combo_get(qcombo->combo_index);
+                    const combo_t * buffered_combo = combo_get(qcombo->combo_index);
 
                     if ((drop = overlaps(buffered_combo, combo))) {
-                        DISABLE_COMBO(drop);
+                        disable_combo(drop == combo ? combo_index : qcombo->combo_index);
                         if (drop == combo) {
                             // stop checking for overlaps if dropped combo was current combo.
                             break;
@@ -495,18 +546,18 @@ static combo_key_action_t process_single_combo(combo_t *combo, uint16_t keycode,
         }
 #ifdef COMBO_PROCESS_KEY_REPRESS
     } else if (record->event.pressed) {
-        if (COMBO_ACTIVE(combo)) {
+        if (COMBO_ACTIVE(state)) {
             if (process_combo_key_repress(combo_index, combo, key_index, keycode)) {
-                KEY_STATE_DOWN(combo->state, key_index);
+                KEY_STATE_DOWN(state->keys, key_index);
                 return COMBO_KEY_REPRESSED;
             }
         }
 #endif
     } else {
         // chord releases
-        if (!COMBO_ACTIVE(combo) && ALL_COMBO_KEYS_ARE_DOWN(COMBO_STATE(combo), key_count)) {
+        if (!COMBO_ACTIVE(state) && ALL_COMBO_KEYS_ARE_DOWN(keys, key_count)) {
             /* First key quickly released */
-            if (COMBO_DISABLED(combo) || _get_combo_must_hold(combo_index, combo)) {
+            if (disabled || _get_combo_must_hold(combo_index, combo)) {
                 // combo wasn't tappable, disable it and drop it from buffer.
                 drop_combo_from_buffer(combo_index);
                 key_is_part_of_combo = false;
@@ -523,7 +574,7 @@ static combo_key_action_t process_single_combo(combo_t *combo, uint16_t keycode,
 #    endif
             }
 #endif
-        } else if (COMBO_ACTIVE(combo) && ONLY_ONE_KEY_IS_DOWN(COMBO_STATE(combo)) && KEY_NOT_YET_RELEASED(COMBO_STATE(combo), key_index)) {
+        } else if (COMBO_ACTIVE(state) && ONLY_ONE_KEY_IS_DOWN(keys) && KEY_NOT_YET_RELEASED(keys, key_index)) {
             /* last key released */
             release_combo(combo_index, combo);
             key_is_part_of_combo = true;
@@ -531,7 +582,7 @@ static combo_key_action_t process_single_combo(combo_t *combo, uint16_t keycode,
 #ifdef COMBO_PROCESS_KEY_RELEASE
             process_combo_key_release(combo_index, combo, key_index, keycode);
 #endif
-        } else if (COMBO_ACTIVE(combo) && KEY_NOT_YET_RELEASED(COMBO_STATE(combo), key_index)) {
+        } else if (COMBO_ACTIVE(state) && KEY_NOT_YET_RELEASED(keys, key_index)) {
             /* first or middle key released */
             key_is_part_of_combo = true;
 
@@ -545,15 +596,16 @@ static combo_key_action_t process_single_combo(combo_t *combo, uint16_t keycode,
             key_is_part_of_combo = false;
         }
 
-        KEY_STATE_UP(combo->state, key_index);
+        if (state) {
+            KEY_STATE_UP(state->keys, key_index);
+        }
     }
 
     return key_is_part_of_combo ? COMBO_KEY_PRESSED : COMBO_KEY_NOT_PRESSED;
 }
 
 bool process_combo(uint16_t keycode, keyrecord_t *record) {
-    uint8_t is_combo_key          = COMBO_KEY_NOT_PRESSED;
-    bool    no_combo_keys_pressed = true;
+    uint8_t is_combo_key = COMBO_KEY_NOT_PRESSED;
 
     if (keycode == QK_COMBO_ON && record->event.pressed) {
         combo_enable();
@@ -581,10 +633,17 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
     }
 #endif
 
-    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
-        combo_t *combo = combo_get(idx);
-        is_combo_key |= process_single_combo(combo, keycode, record, idx);
-        no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+    for (uint16_t idx = 0, count = combo_count_tracked(); idx < count; ++idx) {
+        is_combo_key |= process_single_combo(combo_get(idx), keycode, record, idx);
+    }
+
+    if (!record->event.pressed) {
+        /* The key is up for any combo that is applied from here on. */
+        for (uint8_t key_buffer_i = 0; key_buffer_i < key_buffer_size; key_buffer_i++) {
+            if (key_buffer[key_buffer_i].keycode == keycode) {
+                key_buffer[key_buffer_i].released = true;
+            }
+        }
     }
 
     if (record->event.pressed && is_combo_key) {
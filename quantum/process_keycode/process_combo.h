@@ -39,22 +39,24 @@
 #    define COMBO_BUFFER_LENGTH 4
 #endif
 
+// Number of combos that can be held down at the same time
+#ifndef COMBO_STATE_BUFFER_LENGTH
+#    define COMBO_STATE_BUFFER_LENGTH 8
+#endif
+
+#if defined(EXTRA_EXTRA_LONG_COMBOS)
+typedef uint32_t combo_key_state_t;
+#elif defined(EXTRA_LONG_COMBOS)
+typedef uint16_t combo_key_state_t;
+#else
+typedef uint8_t combo_key_state_t;
+#endif
+
+// Definitions are not written to, so key_combos can be const. The state of the combos that have fired is kept
+// separately, in a buffer of COMBO_STATE_BUFFER_LENGTH entries, plus a disabled bit per combo.
 typedef struct combo_t {
     const uint16_t *keys;
     uint16_t        keycode;
-#ifdef EXTRA_SHORT_COMBOS
-    uint8_t state;
-#else
-    bool     disabled;
-    bool     active;
-#    if defined(EXTRA_EXTRA_LONG_COMBOS)
-    uint32_t state;
-#    elif defined(EXTRA_LONG_COMBOS)
-    uint16_t state;
-#    else
-    uint8_t state;
-#    endif
-#endif
 } combo_t;
 
 #define COMBO(ck, ca) \
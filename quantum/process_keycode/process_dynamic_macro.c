@@ -19,10 +19,17 @@
 #include "process_dynamic_macro.h"
 #include <stddef.h>
 #include "action_layer.h"
+#include "compiler_support.h"
+#include "dynamic_macro.h"
 #include "keycodes.h"
 #include "debug.h"
+#include "timer.h"
 #include "wait.h"
 
+#ifdef DYNAMIC_MACRO_PERSIST
+#    include "nvm_dynamic_macro.h"
+#endif
+
 #ifdef BACKLIGHT_ENABLE
 #    include "backlight.h"
 #endif
@@ -82,163 +89,276 @@ __attribute__((weak)) bool dynamic_macro_valid_key_user(uint16_t keycode, keyrec
     return true;
 }
 
+/* Both macros use the same buffer but read/write on different
+ * ends of it.
+ *
+ * Macro1 is written left-to-right starting from the beginning of
+ * the buffer.
+ *
+ * Macro2 is written right-to-left starting from the end of the
+ * buffer.
+ *
+ * macro_buffer
+ *  v
+ * +------------------------------------------------------------+
+ * |>>>>>> MACRO1 >>>>>>      <<<<<<<<<<<<< MACRO2 <<<<<<<<<<<<<|
+ * +------------------------------------------------------------+
+ *
+ * During the recording when one macro encounters the end of the
+ * other macro, the recording is stopped. Apart from this, there
+ * are no arbitrary limits for the macros' length in relation to
+ * each other: for example one can either have two medium sized
+ * macros or one long macro and one short macro. Or even one empty
+ * and one using the whole buffer.
+ *
+ * The events themselves are stored in the compact encoding
+ * described in dynamic_macro.h.
+ */
+static uint8_t macro_buffer[DYNAMIC_MACRO_BUFFER_SIZE];
+
+STATIC_ASSERT(DYNAMIC_MACRO_BUFFER_SIZE <= UINT16_MAX, "DYNAMIC_MACRO_BUFFER_SIZE must be no larger than 65535 bytes");
+
+static dynamic_macro_t macros[] = {
+    {.start = macro_buffer, .direction = +1, .length = 0},
+    {.start = macro_buffer + DYNAMIC_MACRO_BUFFER_SIZE - 1, .direction = -1, .length = 0},
+};
+
+/* 0   - no macro is being recorded right now
+ * 1,2 - either macro 1 or 2 is being recorded */
+static uint8_t macro_id = 0;
+
+/* Time of the last recorded event, to store the delays between them. */
+static uint16_t last_record_time = 0;
+
+/* Macros being played back, innermost last. A macro can trigger
+ * the playback of the other one, but not of itself. Layers are only
+ * restored where the playback changed them, keys pressed while it
+ * runs may change the others. */
+typedef struct {
+    int8_t        direction;
+    uint16_t      offset;
+    layer_state_t saved_layer_state;
+    layer_state_t changed_layers;
+} dynamic_macro_playback_t;
+
+static dynamic_macro_playback_t playback[2];
+static uint8_t                  playback_depth = 0;
+static uint16_t                 playback_timer = 0;
+
 /* Convenience macros used for retrieving the debug info. All of them
  * need a `direction` variable accessible at the call site.
  */
 #define DYNAMIC_MACRO_CURRENT_SLOT() (direction > 0 ? 1 : 2)
-#define DYNAMIC_MACRO_CURRENT_LENGTH(BEGIN, POINTER) ((int)(direction * ((POINTER) - (BEGIN))))
-#define DYNAMIC_MACRO_CURRENT_CAPACITY(BEGIN, END2) ((int)(direction * ((END2) - (BEGIN)) + 1))
+
+static inline dynamic_macro_t *get_macro(int8_t direction) {
+    return &macros[direction > 0 ? 0 : 1];
+}
+
+static inline uint16_t get_capacity(int8_t direction) {
+    return DYNAMIC_MACRO_BUFFER_SIZE - get_macro(-direction)->length;
+}
+
+#ifdef DYNAMIC_MACRO_PERSIST
+static void dynamic_macro_save(void) {
+    nvm_dynamic_macro_update_buffer(0, macros[0].length, macro_buffer);
+    nvm_dynamic_macro_update_buffer(DYNAMIC_MACRO_BUFFER_SIZE - macros[1].length, macros[1].length, macro_buffer + DYNAMIC_MACRO_BUFFER_SIZE - macros[1].length);
+    nvm_dynamic_macro_update_lengths(macros[0].length, macros[1].length);
+}
+
+/* Checks that a macro restored from NVM decodes cleanly, right up to its end. */
+static bool dynamic_macro_is_valid(const dynamic_macro_t *macro) {
+    keyrecord_t record;
+    uint16_t    delay;
+    uint16_t    offset = 0;
+
+    for (uint16_t next; (next = dynamic_macro_read(macro, offset, &record, &delay)); offset = next) {
+    }
+    return offset == macro->length;
+}
+#endif
+
+/**
+ * Restore the macros saved by a previous session, if persistence is
+ * enabled.
+ */
+void dynamic_macro_init(void) {
+#ifdef DYNAMIC_MACRO_PERSIST
+    uint16_t length1, length2;
+    if (!nvm_dynamic_macro_read_lengths(&length1, &length2)) {
+        return;
+    }
+
+    nvm_dynamic_macro_read_buffer(0, length1, macro_buffer);
+    nvm_dynamic_macro_read_buffer(DYNAMIC_MACRO_BUFFER_SIZE - length2, length2, macro_buffer + DYNAMIC_MACRO_BUFFER_SIZE - length2);
+    macros[0].length = length1;
+    macros[1].length = length2;
+
+    for (uint8_t i = 0; i < 2; i++) {
+        if (!dynamic_macro_is_valid(&macros[i])) {
+            dprintf("dynamic macro: discarding invalid saved macro %d\n", i + 1);
+            macros[i].length = 0;
+        }
+    }
+#endif
+}
 
 /**
  * Start recording of the dynamic macro.
  *
- * @param[out] macro_pointer The new macro buffer iterator.
- * @param[in]  macro_buffer  The macro buffer used to initialize macro_pointer.
+ * @param direction[in]  Either +1 or -1, which macro to record.
  */
-void dynamic_macro_record_start(keyrecord_t **macro_pointer, keyrecord_t *macro_buffer, int8_t direction) {
+void dynamic_macro_record_start(int8_t direction) {
     dprintln("dynamic macro recording: started");
 
     dynamic_macro_record_start_kb(direction);
 
     clear_keyboard();
     layer_clear();
-    *macro_pointer = macro_buffer;
+    get_macro(direction)->length = 0;
 }
 
 /**
- * Play the dynamic macro.
+ * Start playing the dynamic macro. The events are sent one at a time
+ * by dynamic_macro_task(), so that the keyboard keeps scanning while
+ * long macros play.
  *
- * @param macro_buffer[in] The beginning of the macro buffer being played.
- * @param macro_end[in]    The element after the last macro buffer element.
- * @param direction[in]    Either +1 or -1, which way to iterate the buffer.
+ * @param direction[in]  Either +1 or -1, which macro to play.
  */
-void dynamic_macro_play(keyrecord_t *macro_buffer, keyrecord_t *macro_end, int8_t direction) {
+void dynamic_macro_play(int8_t direction) {
+    for (uint8_t i = 0; i < playback_depth; i++) {
+        if (playback[i].direction == direction) {
+            dprintln("dynamic macro: ignoring recursive playback");
+            return;
+        }
+    }
+
     dprintf("dynamic macro: slot %d playback\n", DYNAMIC_MACRO_CURRENT_SLOT());
 
-    layer_state_t saved_layer_state = layer_state;
+    playback[playback_depth++] = (dynamic_macro_playback_t){
+        .direction         = direction,
+        .offset            = 0,
+        .saved_layer_state = layer_state,
+        .changed_layers    = layer_state, // cleared below
+    };
+    playback_timer = timer_read();
 
     clear_keyboard();
     layer_clear();
+}
 
-    while (macro_buffer != macro_end) {
-        process_record(macro_buffer);
-        macro_buffer += direction;
-#ifdef DYNAMIC_MACRO_DELAY
-        wait_ms(DYNAMIC_MACRO_DELAY);
-#endif
-    }
+/**
+ * Check whether a dynamic macro is currently being played back.
+ */
+bool dynamic_macro_is_playing(void) {
+    return playback_depth > 0;
+}
+
+static void dynamic_macro_play_end(void) {
+    dynamic_macro_playback_t *current = &playback[--playback_depth];
 
     clear_keyboard();
 
-    layer_state_set(saved_layer_state);
+    layer_state_set((layer_state & ~current->changed_layers) | (current->saved_layer_state & current->changed_layers));
 
-    dynamic_macro_play_kb(direction);
+    dynamic_macro_play_kb(current->direction);
+}
+
+/**
+ * Send the next event of the macro being played back, once its delay
+ * has passed.
+ */
+void dynamic_macro_task(void) {
+    if (playback_depth == 0) {
+        return;
+    }
+
+    dynamic_macro_playback_t *current = &playback[playback_depth - 1];
+    keyrecord_t               record;
+    uint16_t                  delay;
+    uint16_t                  next = dynamic_macro_read(get_macro(current->direction), current->offset, &record, &delay);
+
+    if (!next) {
+        dynamic_macro_play_end();
+        return;
+    }
+
+#ifndef DYNAMIC_MACRO_RECORDED_TIMING
+#    ifdef DYNAMIC_MACRO_DELAY
+    delay = current->offset ? DYNAMIC_MACRO_DELAY : 0;
+#    else
+    delay = 0;
+#    endif
+#endif
+    if (timer_elapsed(playback_timer) < delay) {
+        return;
+    }
+
+    current->offset   = next;
+    playback_timer    = timer_read();
+    record.event.time = playback_timer;
+
+    layer_state_t before = layer_state;
+    process_record(&record);
+    current->changed_layers |= before ^ layer_state;
 }
 
 /**
  * Record a single key in a dynamic macro.
  *
- * @param macro_buffer[in] The start of the used macro buffer.
- * @param macro_pointer[in,out] The current buffer position.
- * @param macro2_end[in] The end of the other macro.
- * @param direction[in]  Either +1 or -1, which way to iterate the buffer.
+ * @param direction[in]  Either +1 or -1, which macro to record into.
  * @param record[in]     The current keypress.
  */
-void dynamic_macro_record_key(keyrecord_t *macro_buffer, keyrecord_t **macro_pointer, keyrecord_t *macro2_end, int8_t direction, keyrecord_t *record) {
+void dynamic_macro_record_key(int8_t direction, keyrecord_t *record) {
+    dynamic_macro_t *macro = get_macro(direction);
+
     /* If we've just started recording, ignore all the key releases. */
-    if (!record->event.pressed && *macro_pointer == macro_buffer) {
+    if (!record->event.pressed && macro->length == 0) {
         dprintln("dynamic macro: ignoring a leading key-up event");
         return;
     }
 
-    /* The other end of the other macro is the last buffer element it
-     * is safe to use before overwriting the other macro.
+    /* The macro may grow up to the end of the other macro. Once
+     * full, further keys are still processed but not recorded.
      */
-    if (*macro_pointer - direction != macro2_end) {
-        **macro_pointer = *record;
-        *macro_pointer += direction;
+    uint16_t delay = macro->length ? TIMER_DIFF_16(record->event.time, last_record_time) : 0;
+    if (dynamic_macro_append(macro, get_capacity(direction), record, delay)) {
+        last_record_time = record->event.time;
     }
     dynamic_macro_record_key_kb(direction, record);
 
-    dprintf("dynamic macro: slot %d length: %d/%d\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, *macro_pointer), DYNAMIC_MACRO_CURRENT_CAPACITY(macro_buffer, macro2_end));
+    dprintf("dynamic macro: slot %d length: %d/%d\n", DYNAMIC_MACRO_CURRENT_SLOT(), macro->length, get_capacity(direction));
 }
 
 /**
- * End recording of the dynamic macro. Essentially just update the
- * pointer to the end of the macro.
+ * End recording of the dynamic macro.
  */
-void dynamic_macro_record_end(keyrecord_t *macro_buffer, keyrecord_t *macro_pointer, int8_t direction, keyrecord_t **macro_end) {
+void dynamic_macro_record_end(int8_t direction) {
+    dynamic_macro_t *macro = get_macro(direction);
+
     dynamic_macro_record_end_kb(direction);
 
     /* Do not save the keys being held when stopping the recording,
      * i.e. the keys used to access the layer DM_RSTP is on.
      */
-    while (macro_pointer != macro_buffer && (macro_pointer - direction)->event.pressed) {
-        dprintln("dynamic macro: trimming a trailing key-down event");
-        macro_pointer -= direction;
-    }
+    dynamic_macro_trim(macro);
 
-    dprintf("dynamic macro: slot %d saved, length: %d\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, macro_pointer));
+    dprintf("dynamic macro: slot %d saved, length: %d\n", DYNAMIC_MACRO_CURRENT_SLOT(), macro->length);
 
-    *macro_end = macro_pointer;
+#ifdef DYNAMIC_MACRO_PERSIST
+    dynamic_macro_save();
+#endif
 }
 
-/* Both macros use the same buffer but read/write on different
- * ends of it.
- *
- * Macro1 is written left-to-right starting from the beginning of
- * the buffer.
- *
- * Macro2 is written right-to-left starting from the end of the
- * buffer.
- *
- * &macro_buffer   macro_end
- *  v                   v
- * +------------------------------------------------------------+
- * |>>>>>> MACRO1 >>>>>>      <<<<<<<<<<<<< MACRO2 <<<<<<<<<<<<<|
- * +------------------------------------------------------------+
- *                           ^                                 ^
- *                         r_macro_end                  r_macro_buffer
- *
- * During the recording when one macro encounters the end of the
- * other macro, the recording is stopped. Apart from this, there
- * are no arbitrary limits for the macros' length in relation to
- * each other: for example one can either have two medium sized
- * macros or one long macro and one short macro. Or even one empty
- * and one using the whole buffer.
- */
-static keyrecord_t macro_buffer[DYNAMIC_MACRO_SIZE];
-
-/* Pointer to the first buffer element after the first macro.
- * Initially points to the very beginning of the buffer since the
- * macro is empty. */
-static keyrecord_t *macro_end = macro_buffer;
-
-/* The other end of the macro buffer. Serves as the beginning of
- * the second macro. */
-static keyrecord_t *const r_macro_buffer = macro_buffer + DYNAMIC_MACRO_SIZE - 1;
-
-/* Like macro_end but for the second macro. */
-static keyrecord_t *r_macro_end = macro_buffer + DYNAMIC_MACRO_SIZE - 1;
-
-/* A persistent pointer to the current macro position (iterator)
- * used during the recording. */
-static keyrecord_t *macro_pointer = NULL;
-
-/* 0   - no macro is being recorded right now
- * 1,2 - either macro 1 or 2 is being recorded */
-static uint8_t macro_id = 0;
-
 /**
  * If a dynamic macro is currently being recorded, stop recording.
  */
 void dynamic_macro_stop_recording(void) {
     switch (macro_id) {
         case 1:
-            dynamic_macro_record_end(macro_buffer, macro_pointer, +1, &macro_end);
+            dynamic_macro_record_end(+1);
             break;
         case 2:
-            dynamic_macro_record_end(r_macro_buffer, macro_pointer, -1, &r_macro_end);
+            dynamic_macro_record_end(-1);
             break;
     }
     macro_id = 0;
@@ -252,18 +372,18 @@ bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record) {
         if (!record->event.pressed) {
             switch (keycode) {
                 case QK_DYNAMIC_MACRO_RECORD_START_1:
-                    dynamic_macro_record_start(&macro_pointer, macro_buffer, +1);
+                    dynamic_macro_record_start(+1);
                     macro_id = 1;
                     return false;
                 case QK_DYNAMIC_MACRO_RECORD_START_2:
-                    dynamic_macro_record_start(&macro_pointer, r_macro_buffer, -1);
+                    dynamic_macro_record_start(-1);
                     macro_id = 2;
                     return false;
                 case QK_DYNAMIC_MACRO_PLAY_1:
-                    dynamic_macro_play(macro_buffer, macro_end, +1);
+                    dynamic_macro_play(+1);
                     return false;
                 case QK_DYNAMIC_MACRO_PLAY_2:
-                    dynamic_macro_play(r_macro_buffer, r_macro_end, -1);
+                    dynamic_macro_play(-1);
                     return false;
             }
         }
@@ -291,10 +411,10 @@ bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record) {
                     /* Store the key in the macro buffer and process it normally. */
                     switch (macro_id) {
                         case 1:
-                            dynamic_macro_record_key(macro_buffer, &macro_pointer, r_macro_end, +1, record);
+                            dynamic_macro_record_key(+1, record);
                             break;
                         case 2:
-                            dynamic_macro_record_key(r_macro_buffer, &macro_pointer, macro_end, -1, record);
+                            dynamic_macro_record_key(-1, record);
                             break;
                     }
                 }
@@ -22,10 +22,10 @@
 #include <stdbool.h>
 #include "action.h"
 
-/* May be overridden with a custom value. Be aware that the effective
- * macro length is half of this value: each keypress is recorded twice
- * because of the down-event and up-event. This is not a bug, it's the
- * intended behavior.
+/* May be overridden with a custom value. The macro buffer takes as much
+ * RAM as this many keyrecord_t structs would. Events are stored in a
+ * compact encoding though, so that a plain key press or release only
+ * takes two bytes of it, and a lot more events fit than this value.
  *
  * Usually it should be fine to set the macro size to at least 256 but
  * there have been reports of it being too much in some users' cases,
@@ -35,6 +35,11 @@
 #    define DYNAMIC_MACRO_SIZE 128
 #endif
 
+/* Size of the macro buffer in bytes, shared by both macros. */
+#ifndef DYNAMIC_MACRO_BUFFER_SIZE
+#    define DYNAMIC_MACRO_BUFFER_SIZE (DYNAMIC_MACRO_SIZE * sizeof(keyrecord_t))
+#endif
+
 void dynamic_macro_led_blink(void);
 bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record);
 bool dynamic_macro_record_start_kb(int8_t direction);
@@ -48,3 +53,6 @@ bool dynamic_macro_record_end_user(int8_t direction);
 bool dynamic_macro_valid_key_kb(uint16_t keycode, keyrecord_t *record);
 bool dynamic_macro_valid_key_user(uint16_t keycode, keyrecord_t *record);
 void dynamic_macro_stop_recording(void);
+void dynamic_macro_init(void);
+void dynamic_macro_task(void);
+bool dynamic_macro_is_playing(void);
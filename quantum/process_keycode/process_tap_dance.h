@@ -21,8 +21,17 @@
 #include "action.h"
 #include "quantum_keycodes.h"
 
+#ifndef TAP_DANCE_MAX_SIMULTANEOUS
+#    define TAP_DANCE_MAX_SIMULTANEOUS 3
+#endif
+
+#if TAP_DANCE_MAX_SIMULTANEOUS > 8
+#    error TAP_DANCE_MAX_SIMULTANEOUS must not be greater than 8
+#endif
+
 typedef struct {
     uint16_t interrupting_keycode;
+    uint8_t  index; // of the tap dance in tap_dance_actions
     uint8_t  count;
     uint8_t  weak_mods;
 #ifndef NO_ACTION_ONESHOT
@@ -35,8 +44,8 @@ typedef struct {
 
 typedef void (*tap_dance_user_fn_t)(tap_dance_state_t *state, void *user_data);
 
+// Definitions are not written to, so tap_dance_actions can be const. The state of a dance in progress is kept separately.
 typedef struct tap_dance_action_t {
-    tap_dance_state_t state;
     struct {
         tap_dance_user_fn_t on_each_tap;
         tap_dance_user_fn_t on_dance_finished;
@@ -76,10 +85,18 @@ typedef struct {
     { .fn = {user_fn_on_each_tap, user_fn_on_dance_finished, user_fn_on_dance_reset, user_fn_on_each_release}, .user_data = NULL, }
 
 #define TD_INDEX(code) QK_TAP_DANCE_GET_INDEX(code)
-#define TAP_DANCE_KEYCODE(state) TD(((tap_dance_action_t *)state) - tap_dance_actions)
+#define TAP_DANCE_KEYCODE(state) TD((state)->index)
 
 void reset_tap_dance(tap_dance_state_t *state);
 
+/**
+ * @brief Gets the state of a tap dance
+ *
+ * @param tap_dance_idx index of the tap dance in tap_dance_actions
+ * @return the state, or NULL if the tap dance is not in progress
+ */
+tap_dance_state_t *tap_dance_get_state(uint8_t tap_dance_idx);
+
 /* To be used internally */
 
 bool preprocess_tap_dance(uint16_t keycode, keyrecord_t *record);
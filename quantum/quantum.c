@@ -15,6 +15,7 @@
  */
 
 #include "quantum.h"
+#include "keycode_dispatch.h"
 
 #ifdef BACKLIGHT_ENABLE
 #    include "process_backlight.h"
@@ -262,12 +263,21 @@ uint16_t get_event_keycode(keyevent_t event, bool update_layer_cache) {
 #if !defined(NO_ACTION_LAYER) && !defined(STRICT_LAYER_RELEASE)
     /* TODO: Use store_or_get_action() or a similar function. */
     if (!disable_action_cache) {
-        uint8_t layer;
+        const bool update = event.pressed && update_layer_cache;
+        uint8_t    layer  = 0;
 
-        if (event.pressed && update_layer_cache) {
+        if (update) {
             layer = layer_switch_get_layer(event.key);
             update_source_layers_cache(event.key, layer);
-        } else {
+        }
+#    ifdef SOURCE_LAYERS_CACHE_KEYCODE
+        // Resolved when the key was pressed, so a hit needs neither the layer nor the keymap
+        uint16_t keycode;
+        if (read_source_keycode_cache(event.key, &keycode)) {
+            return keycode;
+        }
+#    endif
+        if (!update) {
             layer = read_source_layers_cache(event.key);
         }
         return keymap_key_to_keycode(layer, event.key);
@@ -292,154 +302,170 @@ void post_process_record_quantum(keyrecord_t *record) {
     post_process_record_kb(keycode, record);
 }
 
-/* Core keycode function, hands off handling to other functions,
-    then processes internal quantum keycodes, and then processes
-    ACTIONs.                                                      */
-bool process_record_quantum(keyrecord_t *record) {
-    uint16_t keycode = get_record_keycode(record, true);
-
-    // This is how you use actions here
-    // if (keycode == QK_LEADER) {
-    //   action_t action;
-    //   action.code = ACTION_DEFAULT_LAYER_SET(0);
-    //   process_action(record, action);
-    //   return false;
-    // }
-
-#if defined(SECURE_ENABLE)
-    if (!preprocess_secure(keycode, record)) {
-        return false;
-    }
-#endif
-
-#ifdef TAP_DANCE_ENABLE
-    if (preprocess_tap_dance(keycode, record)) {
-        // The tap dance might have updated the layer state, therefore the
-        // result of the keycode lookup might change.
-        keycode = get_record_keycode(record, true);
-    }
-#endif
-
-#ifdef RGBLIGHT_ENABLE
-    if (record->event.pressed) {
-        preprocess_rgblight();
-    }
-#endif
-
-#ifdef WPM_ENABLE
-    if (record->event.pressed) {
-        update_wpm(keycode);
-    }
-#endif
-
-    if (!(
-#if defined(KEY_LOCK_ENABLE)
-            // Must run first to be able to mask key_up events.
-            process_key_lock(&keycode, record) &&
-#endif
+/* Keycode processors, in the order they are invoked by process_record_quantum().
+ * Each entry either observes every key, or names the keycode ranges it consumes
+ * (see keycode_dispatch.c) and is skipped for keycodes outside of them. */
+// clang-format off
+static const process_record_handler_t PROGMEM process_record_handlers[] = {
 #if defined(DYNAMIC_MACRO_ENABLE) && !defined(DYNAMIC_MACRO_USER_CALL)
-            // Must run asap to ensure all keypresses are recorded.
-            process_dynamic_macro(keycode, record) &&
+    // Must run asap to ensure all keypresses are recorded.
+    PROCESS_RECORD_ALL_KEYCODES(process_dynamic_macro),
 #endif
 #ifdef REPEAT_KEY_ENABLE
-            process_last_key(keycode, record) && process_repeat_key(keycode, record) &&
+    PROCESS_RECORD_ALL_KEYCODES(process_last_key),
+    PROCESS_RECORD_HANDLER(process_repeat_key, REPEAT_KEY),
 #endif
 #if defined(AUDIO_ENABLE) && defined(AUDIO_CLICKY)
-            process_clicky(keycode, record) &&
+    PROCESS_RECORD_ALL_KEYCODES(process_clicky),
 #endif
 #ifdef HAPTIC_ENABLE
-            process_haptic(keycode, record) &&
+    PROCESS_RECORD_ALL_KEYCODES(process_haptic),
 #endif
 #if defined(POINTING_DEVICE_ENABLE) && defined(POINTING_DEVICE_AUTO_MOUSE_ENABLE)
-            process_auto_mouse(keycode, record) &&
+    PROCESS_RECORD_ALL_KEYCODES(process_auto_mouse),
+#endif
+#ifdef COMMUNITY_MODULES_ENABLE
+    // modules must run before kb
+    COMMUNITY_MODULES_PROCESS_RECORD_HANDLERS
+#else
+    PROCESS_RECORD_ALL_KEYCODES(process_record_modules), // modules must run before kb
 #endif
-            process_record_modules(keycode, record) && // modules must run before kb
-            process_record_kb(keycode, record) &&
+    PROCESS_RECORD_ALL_KEYCODES(process_record_kb),
 #if defined(VIA_ENABLE)
-            process_record_via(keycode, record) &&
+    PROCESS_RECORD_HANDLER(process_record_via, VIA),
 #endif
 #if defined(SECURE_ENABLE)
-            process_secure(keycode, record) &&
+    PROCESS_RECORD_ALL_KEYCODES(process_secure),
 #endif
 #if defined(SEQUENCER_ENABLE)
-            process_sequencer(keycode, record) &&
+    PROCESS_RECORD_HANDLER(process_sequencer, SEQUENCER),
 #endif
 #if defined(MIDI_ENABLE) && defined(MIDI_ADVANCED)
-            process_midi(keycode, record) &&
+    PROCESS_RECORD_HANDLER(process_midi, MIDI),
 #endif
 #ifdef AUDIO_ENABLE
-            process_audio(keycode, record) &&
+    PROCESS_RECORD_HANDLER(process_audio, AUDIO),
 #endif
 #if defined(BACKLIGHT_ENABLE)
-            process_backlight(keycode, record) &&
+    PROCESS_RECORD_HANDLER(process_backlight, BACKLIGHT),
 #endif
 #if defined(LED_MATRIX_ENABLE)
-            process_led_matrix(keycode, record) &&
+    PROCESS_RECORD_HANDLER(process_led_matrix, LED_MATRIX),
 #endif
 #ifdef STENO_ENABLE
-            process_steno(keycode, record) &&
+    PROCESS_RECORD_HANDLER(process_steno, STENO),
 #endif
 #if (defined(AUDIO_ENABLE) || (defined(MIDI_ENABLE) && defined(MIDI_BASIC))) && !defined(NO_MUSIC_MODE)
-            process_music(keycode, record) &&
+    PROCESS_RECORD_ALL_KEYCODES(process_music),
 #endif
 #ifdef CAPS_WORD_ENABLE
-            process_caps_word(keycode, record) &&
+    PROCESS_RECORD_ALL_KEYCODES(process_caps_word),
 #endif
 #ifdef KEY_OVERRIDE_ENABLE
-            process_key_override(keycode, record) &&
+    PROCESS_RECORD_ALL_KEYCODES(process_key_override),
 #endif
 #ifdef TAP_DANCE_ENABLE
-            process_tap_dance(keycode, record) &&
+    PROCESS_RECORD_ALL_KEYCODES(process_tap_dance),
 #endif
 #if defined(UNICODE_COMMON_ENABLE)
-            process_unicode_common(keycode, record) &&
+    PROCESS_RECORD_HANDLER(process_unicode_common, UNICODE),
 #endif
 #ifdef LEADER_ENABLE
-            process_leader(keycode, record) &&
+    PROCESS_RECORD_ALL_KEYCODES(process_leader),
 #endif
 #ifdef AUTO_SHIFT_ENABLE
-            process_auto_shift(keycode, record) &&
+    PROCESS_RECORD_ALL_KEYCODES(process_auto_shift),
 #endif
 #ifdef DYNAMIC_TAPPING_TERM_ENABLE
-            process_dynamic_tapping_term(keycode, record) &&
+    PROCESS_RECORD_HANDLER(process_dynamic_tapping_term, DYNAMIC_TAPPING_TERM),
 #endif
 #ifdef SPACE_CADET_ENABLE
-            process_space_cadet(keycode, record) &&
+    PROCESS_RECORD_ALL_KEYCODES(process_space_cadet),
 #endif
 #ifdef MAGIC_ENABLE
-            process_magic(keycode, record) &&
+    PROCESS_RECORD_HANDLER(process_magic, MAGIC),
 #endif
 #ifdef GRAVE_ESC_ENABLE
-            process_grave_esc(keycode, record) &&
+    PROCESS_RECORD_HANDLER(process_grave_esc, GRAVE_ESC),
 #endif
 #if defined(RGBLIGHT_ENABLE) || defined(RGB_MATRIX_ENABLE)
-            process_underglow(keycode, record) &&
+    PROCESS_RECORD_HANDLER(process_underglow, UNDERGLOW),
 #endif
 #if defined(RGB_MATRIX_ENABLE)
-            process_rgb_matrix(keycode, record) &&
+    PROCESS_RECORD_HANDLER(process_rgb_matrix, RGB_MATRIX),
 #endif
 #ifdef JOYSTICK_ENABLE
-            process_joystick(keycode, record) &&
+    PROCESS_RECORD_HANDLER(process_joystick, JOYSTICK),
 #endif
 #ifdef PROGRAMMABLE_BUTTON_ENABLE
-            process_programmable_button(keycode, record) &&
+    PROCESS_RECORD_HANDLER(process_programmable_button, PROGRAMMABLE_BUTTON),
 #endif
 #ifdef AUTOCORRECT_ENABLE
-            process_autocorrect(keycode, record) &&
+    PROCESS_RECORD_ALL_KEYCODES(process_autocorrect),
 #endif
 #ifdef TRI_LAYER_ENABLE
-            process_tri_layer(keycode, record) &&
+    PROCESS_RECORD_HANDLER(process_tri_layer, TRI_LAYER),
 #endif
 #if !defined(NO_ACTION_LAYER)
-            process_default_layer(keycode, record) &&
+    PROCESS_RECORD_HANDLER(process_default_layer, DEFAULT_LAYER),
 #endif
 #ifdef LAYER_LOCK_ENABLE
-            process_layer_lock(keycode, record) &&
+    PROCESS_RECORD_ALL_KEYCODES(process_layer_lock),
 #endif
 #ifdef CONNECTION_ENABLE
-            process_connection(keycode, record) &&
+    PROCESS_RECORD_HANDLER(process_connection, CONNECTION),
 #endif
-            true)) {
+};
+// clang-format on
+
+/* Core keycode function, hands off handling to other functions,
+    then processes internal quantum keycodes, and then processes
+    ACTIONs.                                                      */
+bool process_record_quantum(keyrecord_t *record) {
+    uint16_t keycode = get_record_keycode(record, true);
+
+    // This is how you use actions here
+    // if (keycode == QK_LEADER) {
+    //   action_t action;
+    //   action.code = ACTION_DEFAULT_LAYER_SET(0);
+    //   process_action(record, action);
+    //   return false;
+    // }
+
+#if defined(SECURE_ENABLE)
+    if (!preprocess_secure(keycode, record)) {
+        return false;
+    }
+#endif
+
+#ifdef TAP_DANCE_ENABLE
+    if (preprocess_tap_dance(keycode, record)) {
+        // The tap dance might have updated the layer state, therefore the
+        // result of the keycode lookup might change.
+        keycode = get_record_keycode(record, true);
+    }
+#endif
+
+#ifdef RGBLIGHT_ENABLE
+    if (record->event.pressed) {
+        preprocess_rgblight();
+    }
+#endif
+
+#ifdef WPM_ENABLE
+    if (record->event.pressed) {
+        update_wpm(keycode);
+    }
+#endif
+
+#if defined(KEY_LOCK_ENABLE)
+    // Must run first to be able to mask key_up events.
+    if (!process_key_lock(&keycode, record)) {
+        return false;
+    }
+#endif
+
+    if (!keycode_dispatch(process_record_handlers, ARRAY_SIZE(process_record_handlers), keycode, record)) {
         return false;
     }
 
@@ -0,0 +1,114 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "render_budget.h"
+#include "timer.h"
+
+#if defined(PROTOCOL_CHIBIOS)
+#    include <ch.h>
+#    define RENDER_BUDGET_CLOCK_US
+
+static inline uint32_t clock_read(void) {
+    return chVTGetSystemTimeX();
+}
+
+static inline uint32_t clock_elapsed_us(uint32_t start) {
+    return TIME_I2US(chTimeDiffX((systime_t)start, chVTGetSystemTimeX()));
+}
+#elif defined(PROTOCOL_LINUX)
+#    include <time.h>
+#    define RENDER_BUDGET_CLOCK_US
+
+static inline uint32_t clock_read(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+static inline uint32_t clock_elapsed_us(uint32_t start) {
+    return clock_read() - start;
+}
+#elif defined(RENDER_BUDGET_TESTS)
+#    define RENDER_BUDGET_CLOCK_US
+
+// The test platform's timer only moves when a test advances it, which stands in for a microsecond clock
+static inline uint32_t clock_read(void) {
+    return timer_read32();
+}
+
+static inline uint32_t clock_elapsed_us(uint32_t start) {
+    return timer_elapsed32(start) * 1000;
+}
+#endif
+
+void render_budget_init(render_budget_t *budget, uint16_t budget_us, uint8_t initial_chunk) {
+    budget->budget_us    = budget_us;
+    budget->cost         = 0;
+    budget->chunk        = initial_chunk ? initial_chunk : 1;
+    budget->next         = 0;
+    budget->led_min      = 0;
+    budget->led_max      = 0;
+    budget->measured     = false;
+    budget->frames       = 0;
+    budget->frame_rate   = 0;
+    budget->frame_window = timer_read32();
+}
+
+void render_budget_start_frame(render_budget_t *budget, uint8_t first_led) {
+    budget->next = first_led;
+}
+
+void render_budget_begin(render_budget_t *budget, uint8_t led_end) {
+    uint16_t led_max = budget->next + budget->chunk;
+
+    budget->led_min = budget->next < led_end ? budget->next : led_end;
+    budget->led_max = led_max < led_end ? led_max : led_end;
+#ifdef RENDER_BUDGET_CLOCK_US
+    budget->started = clock_read();
+#endif
+}
+
+void render_budget_end(render_budget_t *budget) {
+    // Without a microsecond clock the chunk keeps its initial size. The millisecond timer would measure most chunks
+    // as taking no time at all, and grow them to the whole frame.
+#ifdef RENDER_BUDGET_CLOCK_US
+    render_budget_adapt(budget, budget->led_max - budget->led_min, clock_elapsed_us(budget->started));
+#endif
+    budget->next = budget->led_max;
+}
+
+void render_budget_adapt(render_budget_t *budget, uint8_t leds, uint32_t elapsed_us) {
+    if (leds == 0) {
+        return;
+    }
+
+    uint32_t sample = elapsed_us * RENDER_BUDGET_COST_SCALE / leds;
+    if (sample > UINT16_MAX) {
+        sample = UINT16_MAX;
+    }
+
+    if (budget->measured) {
+        budget->cost += ((int32_t)sample - budget->cost) / (1 << RENDER_BUDGET_COST_SMOOTHING);
+    } else {
+        budget->cost     = sample;
+        budget->measured = true;
+    }
+
+    uint32_t chunk = budget->cost ? (uint32_t)budget->budget_us * RENDER_BUDGET_COST_SCALE / budget->cost : UINT8_MAX;
+    budget->chunk  = chunk < 1 ? 1 : chunk > UINT8_MAX ? UINT8_MAX : chunk;
+}
+
+void render_budget_frame_done(render_budget_t *budget) {
+    budget->frames++;
+
+    uint32_t elapsed = timer_elapsed32(budget->frame_window);
+    if (elapsed >= 1000) {
+        budget->frame_rate   = (uint32_t)budget->frames * 1000 / elapsed;
+        budget->frames       = 0;
+        budget->frame_window = timer_read32();
+    }
+}
+
+uint16_t render_budget_frame_rate(const render_budget_t *budget) {
+    return budget->frame_rate;
+}
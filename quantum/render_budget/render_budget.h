@@ -0,0 +1,89 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @file render_budget.h
+ * @brief Splits the rendering of an LED frame over several task runs, so each run stays within a time budget.
+ *
+ * Every run renders one chunk of LEDs and measures how long it took. The cost of one LED is averaged over the
+ * chunks, and the next chunk is sized to as many LEDs as that cost allows within the budget.
+ *
+ * Measuring needs a microsecond clock, which ChibiOS and the Linux host have. On other platforms, such as AVR, every
+ * chunk keeps the initial size and the budget has no effect.
+ */
+
+/**
+ * @brief Weight of a new measurement in the averaged cost, as a power of two. Higher values react slower.
+ */
+#ifndef RENDER_BUDGET_COST_SMOOTHING
+#    define RENDER_BUDGET_COST_SMOOTHING 2
+#endif
+
+/**
+ * @brief Cost of one LED is kept in 1/16 µs, so cheap effects do not round down to nothing.
+ */
+#define RENDER_BUDGET_COST_SCALE 16
+
+typedef struct {
+    uint16_t budget_us;
+    uint16_t cost;  // of one LED, in 1/RENDER_BUDGET_COST_SCALE µs
+    uint8_t  chunk; // LEDs rendered per run
+    uint8_t  next;  // first LED of the next chunk
+    uint8_t  led_min;
+    uint8_t  led_max;
+    bool     measured;
+    uint32_t started;
+    uint16_t frames;
+    uint16_t frame_rate;
+    uint32_t frame_window;
+} render_budget_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Sets up a budget, rendering `initial_chunk` LEDs per run until the first measurement.
+ */
+void render_budget_init(render_budget_t *budget, uint16_t budget_us, uint8_t initial_chunk);
+
+/**
+ * @brief Starts a new frame from `first_led`.
+ */
+void render_budget_start_frame(render_budget_t *budget, uint8_t first_led);
+
+/**
+ * @brief Picks the LEDs of the next chunk, which stops at `led_end`, and starts timing it.
+ *
+ * The chunk is then available in `led_min` and `led_max`.
+ */
+void render_budget_begin(render_budget_t *budget, uint8_t led_end);
+
+/**
+ * @brief Stops timing the current chunk, and sizes the next one from it if there is a microsecond clock.
+ */
+void render_budget_end(render_budget_t *budget);
+
+/**
+ * @brief Takes a measurement of `leds` LEDs rendered in `elapsed_us`, and sizes the next chunk from it.
+ */
+void render_budget_adapt(render_budget_t *budget, uint8_t leds, uint32_t elapsed_us);
+
+/**
+ * @brief Counts a completed frame towards the frame rate.
+ */
+void render_budget_frame_done(render_budget_t *budget);
+
+/**
+ * @brief Frames completed over the last second.
+ */
+uint16_t render_budget_frame_rate(const render_budget_t *budget);
+
+#ifdef __cplusplus
+}
+#endif
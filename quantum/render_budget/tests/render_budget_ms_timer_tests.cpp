@@ -0,0 +1,38 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "render_budget.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+/* Built without a microsecond clock, as on AVR */
+class RenderBudgetMsTimer : public ::testing::Test {
+   protected:
+    render_budget_t budget;
+
+    void SetUp() override {
+        set_time(0);
+        render_budget_init(&budget, 500, 10);
+    }
+};
+
+TEST_F(RenderBudgetMsTimer, ChunksKeepInitialSize) {
+    render_budget_start_frame(&budget, 0);
+    for (uint8_t led = 0; led < 40; led += 10) {
+        render_budget_begin(&budget, 40);
+        EXPECT_EQ(budget.led_min, led);
+        EXPECT_EQ(budget.led_max, led + 10);
+
+        // Chunks within a timer tick, and across several, are both left alone
+        advance_time(led % 20 ? 0 : 5);
+        render_budget_end(&budget);
+        EXPECT_EQ(budget.chunk, 10);
+        EXPECT_FALSE(budget.measured);
+    }
+}
@@ -0,0 +1,135 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "render_budget.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+namespace {
+
+/* Renders a frame chunk by chunk, each chunk taking `ms_per_chunk`, returning the LEDs of every chunk */
+std::vector<std::pair<uint8_t, uint8_t>> render_frame(render_budget_t *budget, uint8_t first_led, uint8_t led_end, uint32_t ms_per_chunk = 0) {
+    std::vector<std::pair<uint8_t, uint8_t>> chunks;
+    render_budget_start_frame(budget, first_led);
+    do {
+        render_budget_begin(budget, led_end);
+        advance_time(ms_per_chunk);
+        render_budget_end(budget);
+        chunks.push_back({budget->led_min, budget->led_max});
+    } while (budget->led_max < led_end);
+    return chunks;
+}
+
+} // namespace
+
+class RenderBudget : public ::testing::Test {
+   protected:
+    render_budget_t budget;
+
+    void SetUp() override {
+        set_time(0);
+        render_budget_init(&budget, 500, 10);
+    }
+};
+
+TEST_F(RenderBudget, FirstChunkUsesInitialSize) {
+    render_budget_start_frame(&budget, 0);
+    render_budget_begin(&budget, 100);
+    EXPECT_EQ(budget.led_min, 0);
+    EXPECT_EQ(budget.led_max, 10);
+}
+
+TEST_F(RenderBudget, ChunkSizedFromMeasuredCost) {
+    // 10µs per LED fits 50 in the budget
+    render_budget_adapt(&budget, 10, 100);
+    EXPECT_EQ(budget.chunk, 50);
+}
+
+TEST_F(RenderBudget, CostAveragedOverChunks) {
+    render_budget_adapt(&budget, 10, 100);
+    // A single slow chunk only moves the cost a quarter of the way, to 12.5µs per LED
+    render_budget_adapt(&budget, 10, 200);
+    EXPECT_EQ(budget.chunk, 40);
+
+    for (int i = 0; i < 20; i++) {
+        render_budget_adapt(&budget, 10, 300);
+    }
+    EXPECT_NEAR(budget.chunk, 500 / 30, 1);
+}
+
+TEST_F(RenderBudget, CheapLedsNotRoundedAway) {
+    // 0.5µs per LED
+    render_budget_adapt(&budget, 200, 100);
+    EXPECT_EQ(budget.chunk, 255);
+
+    render_budget_init(&budget, 50, 10);
+    render_budget_adapt(&budget, 200, 100);
+    EXPECT_EQ(budget.chunk, 100);
+}
+
+TEST_F(RenderBudget, ChunkClampedToRange) {
+    render_budget_adapt(&budget, 1, 10000);
+    EXPECT_EQ(budget.chunk, 1);
+
+    render_budget_init(&budget, 500, 10);
+    render_budget_adapt(&budget, 10, 0);
+    EXPECT_EQ(budget.chunk, 255);
+}
+
+TEST_F(RenderBudget, EmptyChunkIgnored) {
+    render_budget_adapt(&budget, 0, 1000);
+    EXPECT_EQ(budget.chunk, 10);
+    EXPECT_FALSE(budget.measured);
+}
+
+TEST_F(RenderBudget, ChunksCoverFrame) {
+    // Every chunk takes a millisecond, so they shrink towards the 500µs budget
+    auto chunks = render_frame(&budget, 0, 40, 1);
+
+    ASSERT_GT(chunks.size(), 1);
+    EXPECT_EQ(chunks.front().first, 0);
+    EXPECT_EQ(chunks.front().second, 10);
+    // 100µs per LED fits 5 in the budget
+    EXPECT_EQ(chunks[1].second - chunks[1].first, 5);
+    for (size_t i = 1; i < chunks.size(); i++) {
+        EXPECT_EQ(chunks[i].first, chunks[i - 1].second);
+        EXPECT_LE(chunks[i].second - chunks[i].first, chunks[i - 1].second - chunks[i - 1].first);
+    }
+    EXPECT_EQ(chunks.back().second, 40);
+}
+
+TEST_F(RenderBudget, FrameStartsAtFirstLed) {
+    // The right half of a split keyboard
+    auto chunks = render_frame(&budget, 20, 40);
+    EXPECT_EQ(chunks.front().first, 20);
+    EXPECT_EQ(chunks.back().second, 40);
+
+    // The next frame starts over
+    chunks = render_frame(&budget, 20, 40);
+    EXPECT_EQ(chunks.front().first, 20);
+}
+
+TEST_F(RenderBudget, FrameRate) {
+    EXPECT_EQ(render_budget_frame_rate(&budget), 0);
+
+    for (int i = 0; i < 100; i++) {
+        advance_time(10);
+        render_budget_frame_done(&budget);
+    }
+    EXPECT_EQ(render_budget_frame_rate(&budget), 100);
+
+    for (int i = 0; i < 25; i++) {
+        advance_time(40);
+        render_budget_frame_done(&budget);
+    }
+    EXPECT_EQ(render_budget_frame_rate(&budget), 25);
+}
@@ -0,0 +1,19 @@
+render_budget_DEFS := -DRENDER_BUDGET_TESTS
+
+render_budget_SRC := \
+	$(QUANTUM_PATH)/render_budget/tests/render_budget_tests.cpp \
+	$(QUANTUM_PATH)/render_budget/render_budget.c \
+	$(PLATFORM_PATH)/timer.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+
+render_budget_INC := \
+	$(QUANTUM_PATH)/render_budget
+
+render_budget_ms_timer_SRC := \
+	$(QUANTUM_PATH)/render_budget/tests/render_budget_ms_timer_tests.cpp \
+	$(QUANTUM_PATH)/render_budget/render_budget.c \
+	$(PLATFORM_PATH)/timer.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+
+render_budget_ms_timer_INC := \
+	$(QUANTUM_PATH)/render_budget
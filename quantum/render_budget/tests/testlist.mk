@@ -0,0 +1 @@
+TEST_LIST += render_budget render_budget_ms_timer
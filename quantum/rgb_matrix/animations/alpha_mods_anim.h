@@ -5,6 +5,7 @@ RGB_MATRIX_EFFECT(ALPHAS_MODS)
 // alphas = color1, mods = color2
 bool ALPHAS_MODS(effect_params_t* params) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
+    RGB_MATRIX_SKIP_UNCHANGED(led_max, RGB_MATRIX_HSV_SPEED_INPUTS(rgb_matrix_config.hsv, rgb_matrix_config.speed));
 
     hsv_t hsv  = rgb_matrix_config.hsv;
     rgb_t rgb1 = rgb_matrix_hsv_to_rgb(hsv);
@@ -8,6 +8,12 @@ hsv_t BREATHING_math(hsv_t hsv, uint8_t i, uint8_t time) {
 }
 
 bool BREATHING(effect_params_t* params) {
+    RGB_MATRIX_USE_LIMITS(led_min, led_max);
+
+    // Every LED has the same colour, which at slower speeds stays the same for several frames
+    uint8_t time = scale16by8(g_rgb_timer, qadd8(rgb_matrix_config.speed / 4, 1));
+    RGB_MATRIX_SKIP_UNCHANGED(led_max, RGB_MATRIX_HSV_SPEED_INPUTS(BREATHING_math(rgb_matrix_config.hsv, 0, time), 0));
+
     return effect_runner_i(params, &BREATHING_math);
 }
 
@@ -4,6 +4,7 @@ RGB_MATRIX_EFFECT(GRADIENT_UP_DOWN)
 
 bool GRADIENT_UP_DOWN(effect_params_t* params) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
+    RGB_MATRIX_SKIP_UNCHANGED(led_max, RGB_MATRIX_HSV_SPEED_INPUTS(rgb_matrix_config.hsv, rgb_matrix_config.speed));
 
     hsv_t   hsv   = rgb_matrix_config.hsv;
     uint8_t scale = scale8(64, rgb_matrix_config.speed);
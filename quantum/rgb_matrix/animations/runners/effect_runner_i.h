@@ -6,10 +6,18 @@ bool effect_runner_i(effect_params_t* params, i_f effect_func) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
 
     uint8_t time = scale16by8(g_rgb_timer, qadd8(rgb_matrix_config.speed / 4, 1));
+    uint8_t leds[RGB_MATRIX_HSV_BATCH_SIZE];
+    hsv_t   hsv[RGB_MATRIX_HSV_BATCH_SIZE];
+    uint8_t count = 0;
     for (uint8_t i = led_min; i < led_max; i++) {
         RGB_MATRIX_TEST_LED_FLAGS();
-        rgb_t rgb = rgb_matrix_hsv_to_rgb(effect_func(rgb_matrix_config.hsv, i, time));
-        rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
+        leds[count]  = i;
+        hsv[count++] = effect_func(rgb_matrix_config.hsv, i, time);
+        if (count == RGB_MATRIX_HSV_BATCH_SIZE) {
+            rgb_matrix_set_color_hsv_batch(leds, hsv, count);
+            count = 0;
+        }
     }
+    rgb_matrix_set_color_hsv_batch(leds, hsv, count);
     return rgb_matrix_check_finished_leds(led_max);
 }
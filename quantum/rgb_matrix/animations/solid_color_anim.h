@@ -3,6 +3,7 @@ RGB_MATRIX_EFFECT(SOLID_COLOR)
 
 bool SOLID_COLOR(effect_params_t* params) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
+    RGB_MATRIX_SKIP_UNCHANGED(led_max, RGB_MATRIX_HSV_SPEED_INPUTS(rgb_matrix_config.hsv, 0));
 
     rgb_t rgb = rgb_matrix_hsv_to_rgb(rgb_matrix_config.hsv);
     for (uint8_t i = led_min; i < led_max; i++) {
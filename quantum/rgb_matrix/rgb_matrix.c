@@ -22,6 +22,7 @@
 #include "keyboard.h"
 #include "sync_timer.h"
 #include "debug.h"
+#include "render_budget.h"
 #include <string.h>
 #include <math.h>
 #include <stdlib.h>
@@ -34,10 +35,52 @@ const led_point_t k_rgb_matrix_center = {112, 32};
 const led_point_t k_rgb_matrix_center = RGB_MATRIX_CENTER;
 #endif
 
-__attribute__((weak)) rgb_t rgb_matrix_hsv_to_rgb(hsv_t hsv) {
+static rgb_t rgb_matrix_hsv_to_rgb_default(hsv_t hsv) {
     return hsv_to_rgb(hsv);
 }
 
+// Weak alias rather than a weak definition, so the batch conversion below can
+// tell whether a keyboard has overridden it
+rgb_t rgb_matrix_hsv_to_rgb(hsv_t hsv) __attribute__((weak, alias("rgb_matrix_hsv_to_rgb_default")));
+
+// Number of colours effect runners work out before converting them in one go
+#ifndef RGB_MATRIX_HSV_BATCH_SIZE
+#    define RGB_MATRIX_HSV_BATCH_SIZE 8
+#endif
+
+// Converts and sets the colours of several LEDs, through hsv_to_rgb_batch()
+// unless rgb_matrix_hsv_to_rgb() has been overridden
+static void rgb_matrix_set_color_hsv_batch(const uint8_t *leds, const hsv_t *hsv, uint8_t count) {
+    rgb_t rgb[RGB_MATRIX_HSV_BATCH_SIZE];
+    if (rgb_matrix_hsv_to_rgb == rgb_matrix_hsv_to_rgb_default) {
+        hsv_to_rgb_batch(hsv, rgb, count);
+    } else {
+        for (uint8_t i = 0; i < count; i++) {
+            rgb[i] = rgb_matrix_hsv_to_rgb(hsv[i]);
+        }
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        rgb_matrix_set_color(leds[i], rgb[i].r, rgb[i].g, rgb[i].b);
+    }
+}
+
+#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+// Reactive effects give most LEDs the same colour, so the last conversion is
+// remembered until the next frame
+static hsv_t rgb_cached_hsv;
+static rgb_t rgb_cached_rgb;
+static bool  rgb_cache_valid = false;
+
+static rgb_t rgb_matrix_hsv_to_rgb_cached(hsv_t hsv) {
+    if (!rgb_cache_valid || memcmp(&hsv, &rgb_cached_hsv, sizeof(hsv)) != 0) {
+        rgb_cached_hsv  = hsv;
+        rgb_cached_rgb  = rgb_matrix_hsv_to_rgb(hsv);
+        rgb_cache_valid = true;
+    }
+    return rgb_cached_rgb;
+}
+#endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+
 // Generic effect runners
 #include "rgb_matrix_runners.inc"
 
@@ -90,6 +133,32 @@ static last_hit_t last_hit_buffer;
 const uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;
 #endif
 
+static render_budget_t rgb_render_budget;
+
+#ifdef RGB_MATRIX_LED_BUFFER
+#    define LED_BITMAP_SIZE ((RGB_MATRIX_LED_COUNT + 7) / 8)
+#    define LED_BIT(index) (1 << ((index) & 7))
+
+// Effects draw into the base layer, which persists between frames, while
+// indicators draw into an overlay that is thrown away after every flush.
+static rgb_t   led_buffer[RGB_MATRIX_LED_COUNT];
+static rgb_t   led_overlay[RGB_MATRIX_LED_COUNT];
+static uint8_t led_overlay_mask[LED_BITMAP_SIZE];
+static uint8_t led_overlay_last_mask[LED_BITMAP_SIZE];
+static uint8_t led_dirty[LED_BITMAP_SIZE];
+
+static enum {
+    LED_LAYER_EXTERNAL,
+    LED_LAYER_EFFECT,
+    LED_LAYER_OVERLAY,
+} led_layer = LED_LAYER_EXTERNAL;
+
+// Inputs of the last frame rendered by the current effect
+static uint32_t effect_inputs       = 0;
+static bool     effect_inputs_valid = false;
+static bool     effect_unchanged    = false;
+#endif // RGB_MATRIX_LED_BUFFER
+
 EECONFIG_DEBOUNCE_HELPER(rgb_matrix, rgb_matrix_config);
 
 void eeconfig_force_flush_rgb_matrix(void) {
@@ -142,6 +211,22 @@ uint8_t rgb_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *l
 }
 
 void rgb_matrix_update_pwm_buffers(void) {
+#ifdef RGB_MATRIX_LED_BUFFER
+    // Only push the LEDs whose composed colour changed since the last flush
+    for (uint8_t byte = 0; byte < LED_BITMAP_SIZE; byte++) {
+        // LEDs that had an indicator last time but not any more return to the base layer
+        uint8_t dirty = led_dirty[byte] | (led_overlay_last_mask[byte] & ~led_overlay_mask[byte]);
+        for (uint8_t i = byte * 8; dirty; i++, dirty >>= 1) {
+            if (dirty & 1) {
+                rgb_t rgb = (led_overlay_mask[byte] & LED_BIT(i)) ? led_overlay[i] : led_buffer[i];
+                rgb_matrix_driver.set_color(rgb_matrix_led_index(i), rgb.r, rgb.g, rgb.b);
+            }
+        }
+        led_dirty[byte]             = 0;
+        led_overlay_last_mask[byte] = led_overlay_mask[byte];
+        led_overlay_mask[byte]      = 0;
+    }
+#endif // RGB_MATRIX_LED_BUFFER
     rgb_matrix_driver.flush();
 }
 
@@ -155,11 +240,35 @@ __attribute__((weak)) int rgb_matrix_led_index(int index) {
 }
 
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+#ifdef RGB_MATRIX_LED_BUFFER
+    if (index < 0 || index >= RGB_MATRIX_LED_COUNT) {
+        return;
+    }
+
+    rgb_t   rgb  = {.r = red, .g = green, .b = blue};
+    uint8_t byte = index / 8;
+    if (led_layer == LED_LAYER_OVERLAY) {
+        bool overlaid = led_overlay_last_mask[byte] & LED_BIT(index);
+        if (!overlaid || memcmp(&led_overlay[index], &rgb, sizeof(rgb)) != 0) {
+            led_overlay[index] = rgb;
+            led_dirty[byte] |= LED_BIT(index);
+        }
+        led_overlay_mask[byte] |= LED_BIT(index);
+    } else if (memcmp(&led_buffer[index], &rgb, sizeof(rgb)) != 0) {
+        led_buffer[index] = rgb;
+        led_dirty[byte] |= LED_BIT(index);
+        if (led_layer == LED_LAYER_EXTERNAL) {
+            // Drawn over from outside of the effect, which has to render again
+            effect_inputs_valid = false;
+        }
+    }
+#else
     rgb_matrix_driver.set_color(rgb_matrix_led_index(index), red, green, blue);
+#endif // RGB_MATRIX_LED_BUFFER
 }
 
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
-#if defined(RGB_MATRIX_SPLIT)
+#if defined(RGB_MATRIX_SPLIT) || defined(RGB_MATRIX_LED_BUFFER)
     for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++)
         rgb_matrix_set_color(i, red, green, blue);
 #else
@@ -168,6 +277,10 @@ void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
 }
 
 void rgb_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed) {
+    rgb_matrix_handle_key_event_at(row, col, pressed, sync_timer_read());
+}
+
+void rgb_matrix_handle_key_event_at(uint8_t row, uint8_t col, bool pressed, uint16_t time) {
 #ifndef RGB_MATRIX_SPLIT
     if (!is_keyboard_master()) return;
 #endif
@@ -198,7 +311,7 @@ void rgb_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed) {
         last_hit_buffer.x[index]     = g_led_config.point[led[i]].x;
         last_hit_buffer.y[index]     = g_led_config.point[led[i]].y;
         last_hit_buffer.index[index] = led[i];
-        last_hit_buffer.tick[index]  = 0;
+        last_hit_buffer.tick[index]  = sync_timer_elapsed(time);
         last_hit_buffer.count++;
     }
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
@@ -241,6 +354,19 @@ void rgb_matrix_test(void) {
     }
 }
 
+#ifdef RGB_MATRIX_LED_BUFFER
+bool rgb_matrix_effect_unchanged(effect_params_t *params, uint32_t inputs) {
+    // Decided on the first iteration, so that a frame rendered over several
+    // iterations is either drawn or skipped as a whole
+    if (params->iter == 0) {
+        effect_unchanged    = !params->init && effect_inputs_valid && inputs == effect_inputs;
+        effect_inputs       = inputs;
+        effect_inputs_valid = true;
+    }
+    return effect_unchanged;
+}
+#endif // RGB_MATRIX_LED_BUFFER
+
 static bool rgb_matrix_none(effect_params_t *params) {
     if (!params->init) {
         return false;
@@ -278,6 +404,16 @@ static void rgb_task_sync(void) {
 static void rgb_task_start(void) {
     // reset iter
     rgb_effect_params.iter = 0;
+#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+    rgb_cache_valid = false;
+#endif
+#if RGB_MATRIX_RENDER_BUDGET_US > 0
+#    if defined(RGB_MATRIX_SPLIT)
+    render_budget_start_frame(&rgb_render_budget, is_keyboard_left() ? 0 : k_rgb_matrix_split[0]);
+#    else
+    render_budget_start_frame(&rgb_render_budget, 0);
+#    endif
+#endif // RGB_MATRIX_RENDER_BUDGET_US > 0
 
     // update double buffers
     g_rgb_timer = rgb_timer_buffer;
@@ -295,8 +431,23 @@ static void rgb_task_render(uint8_t effect) {
     if (rgb_effect_params.flags != rgb_matrix_config.flags) {
         rgb_effect_params.flags = rgb_matrix_config.flags;
         rgb_matrix_set_color_all(0, 0, 0);
+#ifdef RGB_MATRIX_LED_BUFFER
+        effect_inputs_valid = false;
+#endif // RGB_MATRIX_LED_BUFFER
     }
 
+#ifdef RGB_MATRIX_LED_BUFFER
+    led_layer = LED_LAYER_EFFECT;
+#endif // RGB_MATRIX_LED_BUFFER
+
+#if RGB_MATRIX_RENDER_BUDGET_US > 0
+#    if defined(RGB_MATRIX_SPLIT)
+    render_budget_begin(&rgb_render_budget, is_keyboard_left() ? k_rgb_matrix_split[0] : RGB_MATRIX_LED_COUNT);
+#    else
+    render_budget_begin(&rgb_render_budget, RGB_MATRIX_LED_COUNT);
+#    endif
+#endif // RGB_MATRIX_RENDER_BUDGET_US > 0
+
     // each effect can opt to do calculations
     // and/or request PWM buffer updates.
     switch (effect) {
@@ -342,10 +493,21 @@ static void rgb_task_render(uint8_t effect) {
         case UINT8_MAX: {
             rgb_matrix_test();
             rgb_task_state = FLUSHING;
+#ifdef RGB_MATRIX_LED_BUFFER
+            led_layer = LED_LAYER_EXTERNAL;
+#endif // RGB_MATRIX_LED_BUFFER
         }
             return;
     }
 
+#ifdef RGB_MATRIX_LED_BUFFER
+    led_layer = LED_LAYER_EXTERNAL;
+#endif // RGB_MATRIX_LED_BUFFER
+
+#if RGB_MATRIX_RENDER_BUDGET_US > 0
+    render_budget_end(&rgb_render_budget);
+#endif // RGB_MATRIX_RENDER_BUDGET_US > 0
+
     rgb_effect_params.iter++;
 
     // next task
@@ -365,6 +527,7 @@ static void rgb_task_flush(uint8_t effect) {
 
     // update pwm buffers
     rgb_matrix_update_pwm_buffers();
+    render_budget_frame_done(&rgb_render_budget);
 
     // next task
     rgb_task_state = SYNCING;
@@ -390,10 +553,16 @@ void rgb_matrix_task(void) {
         case RENDERING:
             rgb_task_render(effect);
             if (effect) {
+#ifdef RGB_MATRIX_LED_BUFFER
+                led_layer = LED_LAYER_OVERLAY;
+#endif // RGB_MATRIX_LED_BUFFER
                 if (rgb_task_state == FLUSHING) { // ensure we only draw basic indicators once rendering is finished
                     rgb_matrix_indicators();
                 }
                 rgb_matrix_indicators_advanced(&rgb_effect_params);
+#ifdef RGB_MATRIX_LED_BUFFER
+                led_layer = LED_LAYER_EXTERNAL;
+#endif // RGB_MATRIX_LED_BUFFER
             }
             break;
         case FLUSHING:
@@ -424,7 +593,11 @@ __attribute__((weak)) bool rgb_matrix_indicators_user(void) {
 
 struct rgb_matrix_limits_t rgb_matrix_get_limits(uint8_t iter) {
     struct rgb_matrix_limits_t limits = {0};
-#if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
+#if RGB_MATRIX_RENDER_BUDGET_US > 0
+    // Chunks are sized as they are rendered, so only the current one is known. It already respects the split.
+    limits.led_min_index = rgb_render_budget.led_min;
+    limits.led_max_index = rgb_render_budget.led_max;
+#elif defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
 #    if defined(RGB_MATRIX_SPLIT)
     limits.led_min_index = RGB_MATRIX_LED_PROCESS_LIMIT * (iter);
     limits.led_max_index = limits.led_min_index + RGB_MATRIX_LED_PROCESS_LIMIT;
@@ -475,6 +648,7 @@ __attribute__((weak)) bool rgb_matrix_indicators_advanced_user(uint8_t led_min,
 
 void rgb_matrix_init(void) {
     rgb_matrix_driver.init();
+    render_budget_init(&rgb_render_budget, RGB_MATRIX_RENDER_BUDGET_US, RGB_MATRIX_LED_PROCESS_LIMIT);
 
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
@@ -510,6 +684,10 @@ bool rgb_matrix_get_suspend_state(void) {
     return suspend_state;
 }
 
+uint16_t rgb_matrix_get_frame_rate(void) {
+    return render_budget_frame_rate(&rgb_render_budget);
+}
+
 void rgb_matrix_toggle_eeprom_helper(bool write_to_eeprom) {
     rgb_matrix_config.enable ^= 1;
     rgb_task_state = STARTING;
@@ -90,6 +90,10 @@
 #    define RGB_MATRIX_LED_PROCESS_LIMIT ((RGB_MATRIX_LED_COUNT + 4) / 5)
 #endif
 
+#ifndef RGB_MATRIX_RENDER_BUDGET_US
+#    define RGB_MATRIX_RENDER_BUDGET_US 0
+#endif
+
 struct rgb_matrix_limits_t {
     uint8_t led_min_index;
     uint8_t led_max_index;
@@ -114,6 +118,18 @@ struct rgb_matrix_limits_t rgb_matrix_get_limits(uint8_t iter);
 #define RGB_MATRIX_TEST_LED_FLAGS() \
     if (!HAS_ANY_FLAGS(g_led_config.flags[i], params->flags)) continue
 
+#ifdef RGB_MATRIX_LED_BUFFER
+/* Skips the rest of an effect while the inputs it renders from are the same as on the previous frame, as the LED buffer
+ * still holds its output */
+#    define RGB_MATRIX_SKIP_UNCHANGED(led_max, inputs) \
+        if (rgb_matrix_effect_unchanged(params, (uint32_t)(inputs))) return rgb_matrix_check_finished_leds(led_max)
+#else
+#    define RGB_MATRIX_SKIP_UNCHANGED(led_max, inputs) (void)sizeof(inputs)
+#endif
+
+/* Packs the configured colour and speed into a single value for RGB_MATRIX_SKIP_UNCHANGED */
+#define RGB_MATRIX_HSV_SPEED_INPUTS(hsv, speed) (((uint32_t)(hsv).h << 24) | ((uint32_t)(hsv).s << 16) | ((uint32_t)(hsv).v << 8) | (speed))
+
 enum rgb_matrix_effects {
     RGB_MATRIX_NONE = 0,
 
@@ -157,6 +173,8 @@ void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue);
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
 
 void rgb_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed);
+/* Same as rgb_matrix_handle_key_event(), for a switch that changed at the given sync_timer_read() time */
+void rgb_matrix_handle_key_event_at(uint8_t row, uint8_t col, bool pressed, uint16_t time);
 
 void rgb_matrix_task(void);
 
@@ -176,6 +194,7 @@ void rgb_matrix_reload_from_eeprom(void);
 
 void        rgb_matrix_set_suspend_state(bool state);
 bool        rgb_matrix_get_suspend_state(void);
+uint16_t    rgb_matrix_get_frame_rate(void);
 void        rgb_matrix_toggle(void);
 void        rgb_matrix_toggle_noeeprom(void);
 void        rgb_matrix_enable(void);
@@ -219,6 +238,9 @@ led_flags_t rgb_matrix_get_flags(void);
 void        rgb_matrix_set_flags(led_flags_t flags);
 void        rgb_matrix_set_flags_noeeprom(led_flags_t flags);
 void        rgb_matrix_update_pwm_buffers(void);
+#ifdef RGB_MATRIX_LED_BUFFER
+bool rgb_matrix_effect_unchanged(effect_params_t *params, uint32_t inputs);
+#endif
 
 #ifndef RGBLIGHT_ENABLE
 #    define eeconfig_update_rgblight_current eeconfig_force_flush_rgb_matrix
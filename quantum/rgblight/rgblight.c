@@ -134,10 +134,14 @@ void rgblight_set_effect_range(uint8_t start_pos, uint8_t num_leds) {
     rgblight_ranges.effect_num_leds  = num_leds;
 }
 
-__attribute__((weak)) rgb_t rgblight_hsv_to_rgb(hsv_t hsv) {
+static rgb_t rgblight_hsv_to_rgb_default(hsv_t hsv) {
     return hsv_to_rgb(hsv);
 }
 
+// Weak alias rather than a weak definition, so effects converting in batches
+// can tell whether a keyboard has overridden it
+rgb_t rgblight_hsv_to_rgb(hsv_t hsv) __attribute__((weak, alias("rgblight_hsv_to_rgb_default")));
+
 uint8_t rgblight_led_index(uint8_t index) {
 #if defined(RGBLIGHT_LED_MAP)
     return pgm_read_byte(&led_map[index]) - rgblight_ranges.clipping_start_pos;
@@ -1155,13 +1159,36 @@ void rgblight_effect_rainbow_mood(animation_status_t *anim) {
 
 __attribute__((weak)) const uint8_t RGBLED_RAINBOW_SWIRL_INTERVALS[] PROGMEM = {100, 50, 20};
 
-void rgblight_effect_rainbow_swirl(animation_status_t *anim) {
-    uint8_t hue;
-    uint8_t i;
+#    ifndef RGBLIGHT_RAINBOW_SWIRL_BATCH_SIZE
+#        define RGBLIGHT_RAINBOW_SWIRL_BATCH_SIZE 8
+#    endif
 
-    for (i = 0; i < rgblight_ranges.effect_num_leds; i++) {
-        hue = (RGBLIGHT_RAINBOW_SWIRL_RANGE / rgblight_ranges.effect_num_leds * i + anim->current_hue);
-        sethsv(hue, rgblight_config.sat, rgblight_config.val, i + rgblight_ranges.effect_start_pos);
+static void rgblight_hsv_to_rgb_batch(const hsv_t *hsv, rgb_t *rgb, uint8_t count) {
+    if (rgblight_hsv_to_rgb == rgblight_hsv_to_rgb_default) {
+        hsv_to_rgb_batch(hsv, rgb, count);
+        return;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        rgb[i] = rgblight_hsv_to_rgb(hsv[i]);
+    }
+}
+
+void rgblight_effect_rainbow_swirl(animation_status_t *anim) {
+    hsv_t   hsv[RGBLIGHT_RAINBOW_SWIRL_BATCH_SIZE];
+    rgb_t   rgb[RGBLIGHT_RAINBOW_SWIRL_BATCH_SIZE];
+    uint8_t val = rgblight_config.val > RGBLIGHT_LIMIT_VAL ? RGBLIGHT_LIMIT_VAL : rgblight_config.val;
+
+    // Work out the colours of a few LEDs at a time and convert them in one go
+    for (uint16_t first = 0; first < rgblight_ranges.effect_num_leds; first += RGBLIGHT_RAINBOW_SWIRL_BATCH_SIZE) {
+        uint8_t count = MIN(RGBLIGHT_RAINBOW_SWIRL_BATCH_SIZE, rgblight_ranges.effect_num_leds - first);
+        for (uint8_t i = 0; i < count; i++) {
+            uint8_t hue = (RGBLIGHT_RAINBOW_SWIRL_RANGE / rgblight_ranges.effect_num_leds * (first + i) + anim->current_hue);
+            hsv[i]      = (hsv_t){hue, rgblight_config.sat, val};
+        }
+        rgblight_hsv_to_rgb_batch(hsv, rgb, count);
+        for (uint8_t i = 0; i < count; i++) {
+            setrgb(rgb[i].r, rgb[i].g, rgb[i].b, first + i + rgblight_ranges.effect_start_pos);
+        }
     }
     rgblight_set();
 
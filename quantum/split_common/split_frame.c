@@ -0,0 +1,99 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "split_frame.h"
+#include "crc.h"
+
+#define FRAME_SEQUENCE 1
+#define FRAME_LENGTH 2
+
+void split_frame_begin(split_frame_t *frame, uint8_t sequence) {
+    frame->data[0]              = SPLIT_FRAME_SYNC;
+    frame->data[FRAME_SEQUENCE] = sequence;
+    frame->data[FRAME_LENGTH]   = 0;
+    frame->size                 = SPLIT_FRAME_HEADER_SIZE;
+}
+
+bool split_frame_append(split_frame_t *frame, uint8_t id, const void *data, uint8_t size) {
+    // Leave room for the CRC
+    if (frame->size + SPLIT_FRAME_RECORD_HEADER_SIZE + size + 1 > SPLIT_FRAME_MAX_SIZE) {
+        return false;
+    }
+    frame->data[frame->size++] = id;
+    frame->data[frame->size++] = size;
+    memcpy(&frame->data[frame->size], data, size);
+    frame->size += size;
+    return true;
+}
+
+uint16_t split_frame_finish(split_frame_t *frame) {
+    frame->data[FRAME_LENGTH] = frame->size - SPLIT_FRAME_HEADER_SIZE;
+    frame->data[frame->size]  = crc8(&frame->data[FRAME_SEQUENCE], frame->size - 1);
+    return frame->size + 1;
+}
+
+bool split_frame_is_empty(const split_frame_t *frame) {
+    return frame->size <= SPLIT_FRAME_HEADER_SIZE;
+}
+
+uint8_t split_frame_sequence(const split_frame_t *frame) {
+    return frame->data[FRAME_SEQUENCE];
+}
+
+bool split_frame_next_record(const split_frame_t *frame, uint16_t *offset, uint8_t *id, const uint8_t **data, uint8_t *size) {
+    uint16_t length = frame->data[FRAME_LENGTH];
+    if (*offset + SPLIT_FRAME_RECORD_HEADER_SIZE > length) {
+        return false;
+    }
+
+    const uint8_t *record = &frame->data[SPLIT_FRAME_HEADER_SIZE + *offset];
+    if (*offset + SPLIT_FRAME_RECORD_HEADER_SIZE + record[1] > length) {
+        return false;
+    }
+    *id   = record[0];
+    *size = record[1];
+    *data = &record[SPLIT_FRAME_RECORD_HEADER_SIZE];
+    *offset += SPLIT_FRAME_RECORD_HEADER_SIZE + record[1];
+    return true;
+}
+
+void split_frame_parser_reset(split_frame_parser_t *parser) {
+    parser->frame.size = 0;
+    parser->complete   = false;
+}
+
+bool split_frame_parser_feed(split_frame_parser_t *parser, uint8_t byte) {
+    split_frame_t *frame = &parser->frame;
+
+    if (parser->complete) {
+        split_frame_parser_reset(parser);
+    }
+
+    if (frame->size == 0 && byte != SPLIT_FRAME_SYNC) {
+        return false;
+    }
+    frame->data[frame->size++] = byte;
+
+    if (frame->size <= SPLIT_FRAME_HEADER_SIZE) {
+        if (frame->size == SPLIT_FRAME_HEADER_SIZE && byte > SPLIT_FRAME_MAX_PAYLOAD) {
+            split_frame_parser_reset(parser);
+        }
+        return false;
+    }
+
+    uint16_t end = SPLIT_FRAME_HEADER_SIZE + frame->data[FRAME_LENGTH];
+    if (frame->size <= end) {
+        return false;
+    }
+
+    // The CRC has arrived, which is not counted in the size of a complete frame
+    frame->size = end;
+    if (crc8(&frame->data[FRAME_SEQUENCE], end - 1) != byte) {
+        parser->crc_errors++;
+        split_frame_parser_reset(parser);
+        return false;
+    }
+    parser->complete = true;
+    return true;
+}
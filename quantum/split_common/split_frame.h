@@ -0,0 +1,105 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+  Framing for the streaming split serial transport.
+
+  Rather than a handshake and a request/response exchange per transaction, the halves exchange frames that batch any
+  number of transactions:
+
+    sync  0xA5
+    seq   sequence number, echoed back by the slave in its response
+    len   payload length
+    payload, a sequence of records of [transaction id][size][size bytes of data]
+    crc   crc8 over seq, len and the payload
+
+  Frames are parsed from a continuous byte stream, anything in between frames -- line noise, or what is left of a
+  frame that failed its CRC -- is skipped until the next sync byte.
+*/
+
+#define SPLIT_FRAME_SYNC 0xA5
+#define SPLIT_FRAME_HEADER_SIZE 3
+#define SPLIT_FRAME_RECORD_HEADER_SIZE 2
+
+#ifndef SPLIT_FRAME_MAX_PAYLOAD
+#    define SPLIT_FRAME_MAX_PAYLOAD 255
+#endif
+
+#if SPLIT_FRAME_MAX_PAYLOAD > 255
+#    error SPLIT_FRAME_MAX_PAYLOAD must fit the single byte length field
+#endif
+
+#define SPLIT_FRAME_MAX_SIZE (SPLIT_FRAME_HEADER_SIZE + SPLIT_FRAME_MAX_PAYLOAD + 1)
+
+typedef struct {
+    uint8_t  data[SPLIT_FRAME_MAX_SIZE];
+    uint16_t size; // bytes of data in use
+} split_frame_t;
+
+typedef struct {
+    split_frame_t frame;
+    bool          complete;
+    uint16_t      crc_errors;
+} split_frame_parser_t;
+
+/**
+ * @brief Starts an empty frame
+ *
+ * @param[out] frame the frame to start
+ * @param[in] sequence sequence number of the frame
+ */
+void split_frame_begin(split_frame_t *frame, uint8_t sequence);
+
+/**
+ * @brief Appends a transaction record to a frame
+ *
+ * @return false if the record does not fit, in which case the frame is left untouched
+ */
+bool split_frame_append(split_frame_t *frame, uint8_t id, const void *data, uint8_t size);
+
+/**
+ * @brief Fills in the length and CRC of a frame, after which it can be sent
+ *
+ * @return total number of bytes to send
+ */
+uint16_t split_frame_finish(split_frame_t *frame);
+
+/**
+ * @return true if no records have been appended to a frame
+ */
+bool split_frame_is_empty(const split_frame_t *frame);
+
+/**
+ * @return the sequence number of a frame
+ */
+uint8_t split_frame_sequence(const split_frame_t *frame);
+
+/**
+ * @brief Iterates over the records of a complete frame
+ *
+ * @param[in] frame the frame to read from
+ * @param[in,out] offset position of the next record, start with 0
+ * @param[out] id transaction id of the record
+ * @param[out] data the data of the record, pointing into the frame
+ * @param[out] size number of bytes of data
+ * @return false if there are no more records
+ */
+bool split_frame_next_record(const split_frame_t *frame, uint16_t *offset, uint8_t *id, const uint8_t **data, uint8_t *size);
+
+/**
+ * @brief Discards any partially received frame
+ */
+void split_frame_parser_reset(split_frame_parser_t *parser);
+
+/**
+ * @brief Feeds one received byte to a parser
+ *
+ * @return true once a complete frame with a valid CRC is available in parser->frame. It remains valid until the next
+ * byte is fed.
+ */
+bool split_frame_parser_feed(split_frame_parser_t *parser, uint8_t byte);
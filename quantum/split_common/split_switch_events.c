@@ -0,0 +1,71 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stddef.h>
+#include "split_switch_events.h"
+#include "debug.h"
+#include "keyboard.h"
+#include "matrix.h"
+
+#ifdef SPLIT_SWITCH_EVENTS_ENABLE
+
+static split_switch_events_sync_t queue = {0};
+
+static uint8_t sent_sequence    = 0; // master
+static uint8_t handled_sequence = 0; // slave
+
+bool split_forward_switch_event(uint8_t row, uint8_t col, bool pressed, uint16_t time) {
+    const bool own_row = is_keyboard_left() == (row < (MATRIX_ROWS) / 2);
+    if (!own_row) {
+        // On the slave, the master's switches arrive as forwarded events instead, even if the matrix is mirrored too
+        return is_keyboard_master();
+    }
+
+    if (is_keyboard_master()) {
+        if (queue.count < SPLIT_SWITCH_EVENTS_MAX) {
+            split_switch_event_t *event = &queue.events[queue.count++];
+            event->row                  = row;
+            event->col                  = col;
+            event->pressed              = pressed;
+            event->time                 = time;
+        } else {
+            dprintf("Dropped switch event %u,%u\n", row, col);
+        }
+    }
+    return true;
+}
+
+void split_switch_events_restart(void) {
+    sent_sequence = 0;
+}
+
+const split_switch_events_sync_t *split_switch_events_next(void) {
+    if (queue.count == 0) {
+        return NULL;
+    }
+    queue.sequence = sent_sequence + 1;
+    return &queue;
+}
+
+void split_switch_events_sent(void) {
+    sent_sequence = queue.sequence;
+    queue.count   = 0;
+}
+
+void split_switch_events_reset(void) {
+    // The master numbers its first batch 1
+    handled_sequence = 0;
+}
+
+void split_switch_events_receive(const split_switch_events_sync_t *batch) {
+    if (batch->sequence == handled_sequence) {
+        return;
+    }
+    handled_sequence = batch->sequence;
+
+    for (uint8_t i = 0; i < batch->count && i < SPLIT_SWITCH_EVENTS_MAX; i++) {
+        switch_events_at(batch->events[i].row, batch->events[i].col, batch->events[i].pressed, batch->events[i].time);
+    }
+}
+
+#endif // SPLIT_SWITCH_EVENTS_ENABLE
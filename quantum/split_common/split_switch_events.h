@@ -0,0 +1,61 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef SPLIT_SWITCH_EVENTS_MAX
+#    define SPLIT_SWITCH_EVENTS_MAX 4
+#endif // SPLIT_SWITCH_EVENTS_MAX
+
+typedef struct _split_switch_event_t {
+    uint8_t  row;
+    uint8_t  col : 7;
+    uint8_t  pressed : 1;
+    uint16_t time; // sync_timer_read() on the master when the switch changed
+} split_switch_event_t;
+
+typedef struct _split_switch_events_sync_t {
+    uint8_t              sequence; // changes with every batch, so the slave handles each one once
+    uint8_t              count;
+    split_switch_event_t events[SPLIT_SWITCH_EVENTS_MAX];
+} split_switch_events_sync_t;
+
+/**
+ * @brief Queues a switch event on the master's half, to be forwarded to the slave.
+ *
+ * @return false if this half should ignore the event, as it arrives as a forwarded event instead
+ */
+bool split_forward_switch_event(uint8_t row, uint8_t col, bool pressed, uint16_t time);
+
+/**
+ * @brief Starts the master's sequence numbers over, once the slave has been told to forget the previous ones.
+ */
+void split_switch_events_restart(void);
+
+/**
+ * @brief Numbers the queued events as the next batch for the slave.
+ *
+ * Until split_switch_events_sent() is called, the same batch is returned again under the same sequence number, so
+ * that a batch the slave did receive despite the transfer failing is not handled twice.
+ *
+ * @return the batch to send, or NULL if there are no queued events
+ */
+const split_switch_events_sync_t *split_switch_events_next(void);
+
+/**
+ * @brief Drops the batch returned by split_switch_events_next(), once it has been sent.
+ */
+void split_switch_events_sent(void);
+
+/**
+ * @brief Forgets the last batch handled by the slave, as the master starts its sequence numbers over.
+ */
+void split_switch_events_reset(void);
+
+/**
+ * @brief Handles a batch of events forwarded by the master, unless it was handled already.
+ */
+void split_switch_events_receive(const split_switch_events_sync_t *batch);
@@ -10,6 +10,10 @@ extern volatile bool isLeftHand;
 void split_pre_init(void);
 void split_post_init(void);
 
+#ifdef SPLIT_SWITCH_EVENTS_ENABLE
+#    include "split_switch_events.h"
+#endif // SPLIT_SWITCH_EVENTS_ENABLE
+
 bool transport_master_if_connected(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 bool is_transport_connected(void);
 
@@ -0,0 +1,18 @@
+split_frame_DEFS := -DNO_DEBUG -DSPLIT_FRAME_MAX_PAYLOAD=128
+
+split_frame_SRC := \
+	$(QUANTUM_PATH)/split_common/tests/split_frame_tests.cpp \
+	$(QUANTUM_PATH)/split_common/split_frame.c \
+	$(QUANTUM_PATH)/crc.c
+
+split_frame_INC := \
+	$(QUANTUM_PATH)/split_common
+
+split_switch_events_DEFS := -DNO_DEBUG -DNO_PRINT -DSPLIT_SWITCH_EVENTS_ENABLE -DMATRIX_ROWS=8 -DMATRIX_COLS=4
+
+split_switch_events_SRC := \
+	$(QUANTUM_PATH)/split_common/tests/split_switch_events_tests.cpp \
+	$(QUANTUM_PATH)/split_common/split_switch_events.c
+
+split_switch_events_INC := \
+	$(QUANTUM_PATH)/split_common
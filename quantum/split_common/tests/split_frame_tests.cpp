@@ -0,0 +1,224 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdlib>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "split_frame.h"
+}
+
+namespace {
+
+struct record_t {
+    uint8_t              id;
+    std::vector<uint8_t> data;
+
+    bool operator==(const record_t &other) const {
+        return id == other.id && data == other.data;
+    }
+};
+
+std::vector<uint8_t> encode(uint8_t sequence, const std::vector<record_t> &records) {
+    split_frame_t frame;
+    split_frame_begin(&frame, sequence);
+    for (const auto &record : records) {
+        EXPECT_TRUE(split_frame_append(&frame, record.id, record.data.data(), record.data.size()));
+    }
+    uint16_t size = split_frame_finish(&frame);
+    return std::vector<uint8_t>(frame.data, frame.data + size);
+}
+
+std::vector<record_t> decode(const split_frame_t &frame) {
+    std::vector<record_t> records;
+    uint16_t              offset = 0;
+    uint8_t               id, size;
+    const uint8_t        *data;
+    while (split_frame_next_record(&frame, &offset, &id, &data, &size)) {
+        records.push_back({id, std::vector<uint8_t>(data, data + size)});
+    }
+    return records;
+}
+
+std::vector<record_t> random_records() {
+    std::vector<record_t> records(std::rand() % 6);
+    for (auto &record : records) {
+        record.id = std::rand() % 32;
+        record.data.resize(std::rand() % 24);
+        for (auto &byte : record.data) {
+            byte = std::rand();
+        }
+    }
+    return records;
+}
+
+} // namespace
+
+class SplitFrame : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        std::srand(1);
+        split_frame_parser_reset(&parser);
+        parser.crc_errors = 0;
+    }
+
+    /* Feeds a byte stream to the parser, as the transport would from its receive ring, and collects the frames */
+    void receive(const std::vector<uint8_t> &stream) {
+        for (uint8_t byte : stream) {
+            if (split_frame_parser_feed(&parser, byte)) {
+                sequences.push_back(split_frame_sequence(&parser.frame));
+                frames.push_back(decode(parser.frame));
+            }
+        }
+    }
+
+    split_frame_parser_t               parser;
+    std::vector<uint8_t>               sequences;
+    std::vector<std::vector<record_t>> frames;
+};
+
+TEST_F(SplitFrame, RoundTrip) {
+    std::vector<record_t> records = {{0, {1, 2, 3}}, {7, {}}, {12, {0xA5, 0xA5, 0x00, 0xFF}}};
+    receive(encode(42, records));
+
+    ASSERT_EQ(frames.size(), 1);
+    EXPECT_EQ(sequences[0], 42);
+    EXPECT_EQ(frames[0], records);
+    EXPECT_EQ(parser.crc_errors, 0);
+}
+
+TEST_F(SplitFrame, EmptyFrame) {
+    split_frame_t frame;
+    split_frame_begin(&frame, 3);
+    EXPECT_TRUE(split_frame_is_empty(&frame));
+    EXPECT_EQ(split_frame_finish(&frame), SPLIT_FRAME_HEADER_SIZE + 1);
+
+    receive(encode(3, {}));
+    ASSERT_EQ(frames.size(), 1);
+    EXPECT_TRUE(frames[0].empty());
+}
+
+TEST_F(SplitFrame, AppendFailsWhenFull) {
+    split_frame_t        frame;
+    std::vector<uint8_t> data(32, 0x55);
+    split_frame_begin(&frame, 0);
+
+    int appended = 0;
+    while (split_frame_append(&frame, appended, data.data(), data.size())) {
+        appended++;
+    }
+    EXPECT_EQ(appended, SPLIT_FRAME_MAX_PAYLOAD / (SPLIT_FRAME_RECORD_HEADER_SIZE + data.size()));
+
+    // A failed append leaves the frame as it was
+    uint16_t size = frame.size;
+    EXPECT_FALSE(split_frame_append(&frame, 0xFF, data.data(), data.size()));
+    EXPECT_EQ(frame.size, size);
+    EXPECT_FALSE(split_frame_is_empty(&frame));
+
+    receive(std::vector<uint8_t>(frame.data, frame.data + split_frame_finish(&frame)));
+    ASSERT_EQ(frames.size(), 1);
+    EXPECT_EQ(frames[0].size(), appended);
+}
+
+TEST_F(SplitFrame, LoopbackStream) {
+    std::vector<uint8_t>               stream;
+    std::vector<std::vector<record_t>> sent;
+    for (int sequence = 0; sequence < 1000; sequence++) {
+        sent.push_back(random_records());
+        auto encoded = encode(sequence, sent.back());
+        stream.insert(stream.end(), encoded.begin(), encoded.end());
+    }
+    receive(stream);
+
+    ASSERT_EQ(frames.size(), sent.size());
+    for (size_t i = 0; i < sent.size(); i++) {
+        EXPECT_EQ(sequences[i], (uint8_t)i);
+        EXPECT_EQ(frames[i], sent[i]);
+    }
+}
+
+TEST_F(SplitFrame, NoiseBetweenFramesSkipped) {
+    std::vector<uint8_t>               stream;
+    std::vector<std::vector<record_t>> sent;
+    for (int sequence = 0; sequence < 100; sequence++) {
+        // Idle line noise without sync bytes in it
+        for (int i = std::rand() % 8; i > 0; i--) {
+            stream.push_back(std::rand() % SPLIT_FRAME_SYNC);
+        }
+        sent.push_back(random_records());
+        auto encoded = encode(sequence, sent.back());
+        stream.insert(stream.end(), encoded.begin(), encoded.end());
+    }
+    receive(stream);
+
+    ASSERT_EQ(frames.size(), sent.size());
+    for (size_t i = 0; i < sent.size(); i++) {
+        EXPECT_EQ(frames[i], sent[i]);
+    }
+}
+
+TEST_F(SplitFrame, CorruptFrameDropped) {
+    std::vector<record_t> records = {{1, {10, 20, 30, 40}}};
+    auto                  first   = encode(0, records);
+    auto                  second  = encode(1, records);
+    auto                  third   = encode(2, records);
+
+    // Flip a bit in the payload of the second frame
+    second[SPLIT_FRAME_HEADER_SIZE + 3] ^= 0x10;
+
+    std::vector<uint8_t> stream(first);
+    stream.insert(stream.end(), second.begin(), second.end());
+    stream.insert(stream.end(), third.begin(), third.end());
+    receive(stream);
+
+    ASSERT_EQ(frames.size(), 2);
+    EXPECT_EQ(sequences[0], 0);
+    EXPECT_EQ(sequences[1], 2);
+    EXPECT_EQ(frames[1], records);
+    EXPECT_EQ(parser.crc_errors, 1);
+}
+
+TEST_F(SplitFrame, RecoversFromTruncatedFrame) {
+    std::vector<record_t> records = {{4, std::vector<uint8_t>(16, 0x33)}};
+    std::vector<uint8_t>  stream;
+
+    // Lose the tail of the first frame, as an overrun of the receive ring would
+    auto truncated = encode(0, records);
+    stream.insert(stream.end(), truncated.begin(), truncated.begin() + 8);
+    for (int sequence = 1; sequence <= 4; sequence++) {
+        auto encoded = encode(sequence, records);
+        stream.insert(stream.end(), encoded.begin(), encoded.end());
+    }
+    receive(stream);
+
+    // The truncated frame swallows the start of the next, everything after that gets through
+    ASSERT_GE(frames.size(), 3);
+    EXPECT_EQ(sequences.back(), 4);
+    for (auto &frame : frames) {
+        EXPECT_EQ(frame, records);
+    }
+}
+
+TEST_F(SplitFrame, InvalidLengthRejected) {
+    std::vector<uint8_t> stream = {SPLIT_FRAME_SYNC, 0, SPLIT_FRAME_MAX_PAYLOAD + 1};
+    auto                 valid  = encode(1, {{2, {3}}});
+    stream.insert(stream.end(), valid.begin(), valid.end());
+    receive(stream);
+
+    ASSERT_EQ(frames.size(), 1);
+    EXPECT_EQ(sequences[0], 1);
+}
+
+TEST_F(SplitFrame, MalformedRecordsIgnored) {
+    split_frame_t frame;
+    uint8_t       data[4] = {1, 2, 3, 4};
+    split_frame_begin(&frame, 0);
+    split_frame_append(&frame, 5, data, sizeof(data));
+    split_frame_finish(&frame);
+
+    // Claim more data than the frame holds
+    frame.data[SPLIT_FRAME_HEADER_SIZE + 1] = sizeof(data) + 1;
+    EXPECT_TRUE(decode(frame).empty());
+}
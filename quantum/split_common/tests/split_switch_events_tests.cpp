@@ -0,0 +1,147 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "split_switch_events.h"
+}
+
+namespace {
+
+struct event_t {
+    uint8_t  row;
+    uint8_t  col;
+    bool     pressed;
+    uint16_t time;
+
+    bool operator==(const event_t &other) const {
+        return row == other.row && col == other.col && pressed == other.pressed && time == other.time;
+    }
+};
+
+bool                 master = true;
+bool                 left   = true;
+std::vector<event_t> handled;
+
+} // namespace
+
+extern "C" {
+bool is_keyboard_master(void) {
+    return master;
+}
+
+bool is_keyboard_left(void) {
+    return left;
+}
+
+void switch_events_at(uint8_t row, uint8_t col, bool pressed, uint16_t time) {
+    handled.push_back({row, col, pressed, time});
+}
+}
+
+class SplitSwitchEvents : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        master = true;
+        left   = true;
+        handled.clear();
+        while (split_switch_events_next()) {
+            split_switch_events_sent();
+        }
+        split_switch_events_restart();
+        split_switch_events_reset();
+    }
+
+    // Copies the batch as the slave's shared memory would
+    split_switch_events_sync_t take_next() {
+        const split_switch_events_sync_t *batch = split_switch_events_next();
+        EXPECT_NE(batch, nullptr);
+        return batch ? *batch : split_switch_events_sync_t{};
+    }
+};
+
+TEST_F(SplitSwitchEvents, RetriedBatchHandledOnce) {
+    EXPECT_TRUE(split_forward_switch_event(0, 1, true, 100));
+    EXPECT_TRUE(split_forward_switch_event(1, 2, false, 101));
+
+    // The slave got the batch, but the master saw the transfer fail and sends it again
+    split_switch_events_sync_t first = take_next();
+    split_switch_events_receive(&first);
+    split_switch_events_sync_t retry = take_next();
+    EXPECT_EQ(retry.sequence, first.sequence);
+    split_switch_events_receive(&retry);
+    split_switch_events_sent();
+
+    std::vector<event_t> expected = {{0, 1, true, 100}, {1, 2, false, 101}};
+    EXPECT_EQ(handled, expected);
+
+    // The next batch is numbered differently, even with the same events
+    EXPECT_TRUE(split_forward_switch_event(0, 1, true, 100));
+    split_switch_events_sync_t second = take_next();
+    EXPECT_NE(second.sequence, first.sequence);
+    split_switch_events_receive(&second);
+    EXPECT_EQ(handled.size(), 3);
+}
+
+TEST_F(SplitSwitchEvents, NothingQueuedNothingSent) {
+    EXPECT_EQ(split_switch_events_next(), nullptr);
+}
+
+TEST_F(SplitSwitchEvents, QueueFullDropsEvents) {
+    for (uint8_t i = 0; i < SPLIT_SWITCH_EVENTS_MAX + 2; i++) {
+        EXPECT_TRUE(split_forward_switch_event(0, i, true, i));
+    }
+    split_switch_events_sync_t batch = take_next();
+    EXPECT_EQ(batch.count, SPLIT_SWITCH_EVENTS_MAX);
+    EXPECT_EQ(batch.events[SPLIT_SWITCH_EVENTS_MAX - 1].col, SPLIT_SWITCH_EVENTS_MAX - 1);
+}
+
+TEST_F(SplitSwitchEvents, MirroredMasterRowsIgnoredOnSlave) {
+    // The right hand slave, with the left hand master's rows mirrored into its matrix
+    master = false;
+    left   = false;
+    EXPECT_FALSE(split_forward_switch_event(0, 0, true, 100));
+    EXPECT_FALSE(split_forward_switch_event(MATRIX_ROWS / 2 - 1, 3, false, 101));
+
+    // Its own rows are handled as usual, and never queued
+    EXPECT_TRUE(split_forward_switch_event(MATRIX_ROWS / 2, 0, true, 102));
+    EXPECT_EQ(split_switch_events_next(), nullptr);
+}
+
+TEST_F(SplitSwitchEvents, SlaveRowsNotForwardedByMaster) {
+    EXPECT_TRUE(split_forward_switch_event(MATRIX_ROWS - 1, 0, true, 100));
+    EXPECT_EQ(split_switch_events_next(), nullptr);
+
+    // A right hand master forwards the right hand rows
+    left = false;
+    EXPECT_TRUE(split_forward_switch_event(0, 0, true, 100));
+    EXPECT_EQ(split_switch_events_next(), nullptr);
+    EXPECT_TRUE(split_forward_switch_event(MATRIX_ROWS - 1, 0, true, 101));
+    EXPECT_NE(split_switch_events_next(), nullptr);
+}
+
+TEST_F(SplitSwitchEvents, FirstBatchAfterMasterRestartHandled) {
+    EXPECT_TRUE(split_forward_switch_event(0, 0, true, 100));
+    split_switch_events_sync_t before = take_next();
+    split_switch_events_receive(&before);
+    split_switch_events_sent();
+    ASSERT_EQ(handled.size(), 1);
+
+    // Only the master reboots, so its first batch has the sequence number the slave handled last
+    split_switch_events_restart();
+    EXPECT_TRUE(split_forward_switch_event(0, 0, false, 200));
+    split_switch_events_sync_t after = take_next();
+    ASSERT_EQ(after.sequence, before.sequence);
+
+    split_switch_events_receive(&after);
+    EXPECT_EQ(handled.size(), 1);
+
+    // Which the reset command on reconnect lets through
+    split_switch_events_reset();
+    split_switch_events_receive(&after);
+    ASSERT_EQ(handled.size(), 2);
+    EXPECT_FALSE(handled[1].pressed);
+}
@@ -0,0 +1,2 @@
+TEST_LIST += split_frame
+TEST_LIST += split_switch_events
@@ -30,6 +30,11 @@ enum serial_transaction_id {
     PUT_MASTER_MATRIX,
 #endif // SPLIT_TRANSPORT_MIRROR
 
+#ifdef SPLIT_SWITCH_EVENTS_ENABLE
+    PUT_SWITCH_EVENTS,
+    CMD_SWITCH_EVENTS_RESET,
+#endif // SPLIT_SWITCH_EVENTS_ENABLE
+
 #ifdef ENCODER_ENABLE
     GET_ENCODERS_CHECKSUM,
     GET_ENCODERS_DATA,
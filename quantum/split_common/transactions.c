@@ -71,6 +71,17 @@
 #    define FORCED_SYNC_THROTTLE_MS 100
 #endif // FORCED_SYNC_THROTTLE_MS
 
+// Bytes on the wire per scan, shared by all transactions. Matrix, encoder and pointing
+// traffic always goes through, and the low priority sync takes turns with whatever is left.
+#ifndef SPLIT_TRANSACTION_BUDGET
+#    define SPLIT_TRANSACTION_BUDGET 64
+#endif // SPLIT_TRANSACTION_BUDGET
+
+// Fixed cost of a transaction on top of its buffers, ie. the transaction ID and handshake
+#ifndef SPLIT_TRANSACTION_OVERHEAD
+#    define SPLIT_TRANSACTION_OVERHEAD 2
+#endif // SPLIT_TRANSACTION_OVERHEAD
+
 #define sizeof_member(type, member) sizeof(((type *)NULL)->member)
 
 #define trans_initiator2target_initializer_cb(member, cb) \
@@ -84,9 +95,9 @@
 #define trans_initiator2target_cb(cb) \
     { 0, 0, 0, 0, cb }
 
-#define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
-#define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
-#define transport_exec(id) transport_execute_transaction(id, NULL, 0, NULL, 0)
+#define transport_write(id, data, length) transaction_execute(id, data, length, NULL, 0)
+#define transport_read(id, data, length) transaction_execute(id, NULL, 0, data, length)
+#define transport_exec(id) transaction_execute(id, NULL, 0, NULL, 0)
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 // Forward-declare the RPC callback handlers
@@ -97,7 +108,29 @@ void slave_rpc_exec_callback(uint8_t initiator2target_buffer_size, const void *i
 ////////////////////////////////////////////////////
 // Helpers
 
-static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[], const char *prefix, bool (*handler)(matrix_row_t master_matrix[], matrix_row_t slave_matrix[])) {
+typedef bool (*transaction_handler_master_t)(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
+
+#if !defined(NO_DEBUG) || defined(SPLIT_TRANSACTION_STATS_ENABLE)
+#    define TRANSACTION_HANDLER_NAMES
+#endif
+
+typedef struct {
+    transaction_handler_master_t handler;
+#ifdef TRANSACTION_HANDLER_NAMES
+    const char *name;
+#endif
+} transaction_handler_desc_t;
+
+// Bytes sent and received during the current scan
+static uint16_t transaction_cost = 0;
+
+static bool transaction_execute(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    transaction_cost += SPLIT_TRANSACTION_OVERHEAD + trans->initiator2target_buffer_size + trans->target2initiator_buffer_size;
+    return transport_execute_transaction(id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length);
+}
+
+static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[], const transaction_handler_desc_t *desc) {
     int num_retries = is_transport_connected() ? 10 : 1;
     for (int iter = 1; iter <= num_retries; ++iter) {
         if (iter > 1) {
@@ -106,17 +139,24 @@ static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_
             }
         }
         bool this_okay = true;
-        this_okay      = handler(master_matrix, slave_matrix);
+        this_okay      = desc->handler(master_matrix, slave_matrix);
         if (this_okay) return true;
     }
-    dprintf("Failed to execute %s\n", prefix);
+#ifdef TRANSACTION_HANDLER_NAMES
+    dprintf("Failed to execute %s\n", desc->name);
+#endif
     return false;
 }
 
-#define TRANSACTION_HANDLER_MASTER(prefix)                                                                              \
-    do {                                                                                                                \
-        if (!transaction_handler_master(master_matrix, slave_matrix, #prefix, &prefix##_handlers_master)) return false; \
-    } while (0)
+/**
+ * @brief Constructs an entry of the master's transaction handler tables, see
+ * transactions_master() for how they are scheduled.
+ */
+#ifdef TRANSACTION_HANDLER_NAMES
+#    define TRANSACTION_HANDLER_MASTER(prefix) {&prefix##_handlers_master, #prefix},
+#else
+#    define TRANSACTION_HANDLER_MASTER(prefix) {&prefix##_handlers_master},
+#endif
 
 /**
  * @brief Constructs a transaction handler that doesn't acquire a lock to the
@@ -233,6 +273,83 @@ static void master_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_ro
 
 #endif // SPLIT_TRANSPORT_MIRROR
 
+////////////////////////////////////////////////////
+// Switch events
+
+#ifdef SPLIT_SWITCH_EVENTS_ENABLE
+
+static bool switch_events_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static bool restart       = true;
+    static bool was_connected = false;
+
+    // After the master reboots or the link drops, the slave may still hold any sequence number. Once per drop, as
+    // resetting again would let the slave handle a batch twice that it got before the reset.
+    const bool connected = is_transport_connected();
+    if (was_connected && !connected) {
+        restart = true;
+    }
+    was_connected = connected;
+
+    if (restart) {
+        restart = !transport_exec(CMD_SWITCH_EVENTS_RESET);
+        if (restart) {
+            return false;
+        }
+        split_switch_events_restart();
+    }
+
+    // A retry resends the same batch under the same sequence number
+    const split_switch_events_sync_t *batch = split_switch_events_next();
+    if (batch == NULL) {
+        return true;
+    }
+    bool okay = transport_write(PUT_SWITCH_EVENTS, batch, sizeof(*batch));
+    if (okay) {
+        split_switch_events_sent();
+    }
+    return okay;
+}
+
+// Runs as the command arrives, with the shared memory locked, so the last batch of the previous connection is gone
+// before the first batch of the new one is written
+static void switch_events_handlers_slave_reset(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    memset(&split_shmem->switch_events, 0, sizeof(split_shmem->switch_events));
+    split_shmem->switch_events_reset = 1;
+}
+
+static void switch_events_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    split_switch_events_sync_t batch;
+    bool                       reset;
+
+    split_shared_memory_lock();
+    reset                            = split_shmem->switch_events_reset;
+    split_shmem->switch_events_reset = 0;
+    memcpy(&batch, &split_shmem->switch_events, sizeof(batch));
+    split_shared_memory_unlock();
+
+    // Handled before the batch, which may already be the first one numbered after the reset
+    if (reset) {
+        split_switch_events_reset();
+    }
+    split_switch_events_receive(&batch);
+}
+
+// clang-format off
+#    define TRANSACTIONS_SWITCH_EVENTS_MASTER() TRANSACTION_HANDLER_MASTER(switch_events)
+#    define TRANSACTIONS_SWITCH_EVENTS_SLAVE() TRANSACTION_HANDLER_SLAVE(switch_events)
+#    define TRANSACTIONS_SWITCH_EVENTS_REGISTRATIONS \
+    [PUT_SWITCH_EVENTS]       = trans_initiator2target_initializer(switch_events), \
+    [CMD_SWITCH_EVENTS_RESET] = trans_initiator2target_cb(switch_events_handlers_slave_reset),
+// clang-format on
+
+#else // SPLIT_SWITCH_EVENTS_ENABLE
+
+#    define TRANSACTIONS_SWITCH_EVENTS_MASTER()
+#    define TRANSACTIONS_SWITCH_EVENTS_SLAVE()
+#    define TRANSACTIONS_SWITCH_EVENTS_REGISTRATIONS
+
+#endif // SPLIT_SWITCH_EVENTS_ENABLE
+
 ////////////////////////////////////////////////////
 // Encoders
 
@@ -927,6 +1044,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
     // clang-format off
     TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS
     TRANSACTIONS_MASTER_MATRIX_REGISTRATIONS
+    TRANSACTIONS_SWITCH_EVENTS_REGISTRATIONS
     TRANSACTIONS_ENCODERS_REGISTRATIONS
     TRANSACTIONS_SYNC_TIMER_REGISTRATIONS
     TRANSACTIONS_LAYER_STATE_REGISTRATIONS
@@ -954,32 +1072,131 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 };
 
+// Handlers run every scan, in order
+static const transaction_handler_desc_t high_priority_handlers[] = {
+    // clang-format off
+    TRANSACTIONS_SLAVE_MATRIX_MASTER()
+    TRANSACTIONS_MASTER_MATRIX_MASTER()
+    TRANSACTIONS_SWITCH_EVENTS_MASTER()
+    TRANSACTIONS_ENCODERS_MASTER()
+    TRANSACTIONS_POINTING_MASTER()
+    TRANSACTIONS_SYNC_TIMER_MASTER()
+    // clang-format on
+};
+
+// Handlers taking turns with the bus budget left over by the high priority ones
+static const transaction_handler_desc_t low_priority_handlers[] = {
+    // clang-format off
+    TRANSACTIONS_LAYER_STATE_MASTER()
+    TRANSACTIONS_LED_STATE_MASTER()
+    TRANSACTIONS_MODS_MASTER()
+    TRANSACTIONS_BACKLIGHT_MASTER()
+    TRANSACTIONS_RGBLIGHT_MASTER()
+    TRANSACTIONS_LED_MATRIX_MASTER()
+    TRANSACTIONS_RGB_MATRIX_MASTER()
+    TRANSACTIONS_WPM_MASTER()
+    TRANSACTIONS_OLED_MASTER()
+    TRANSACTIONS_ST7565_MASTER()
+    TRANSACTIONS_WATCHDOG_MASTER()
+    TRANSACTIONS_HAPTIC_MASTER()
+    TRANSACTIONS_ACTIVITY_MASTER()
+    TRANSACTIONS_DETECTED_OS_MASTER()
+    // clang-format on
+};
+
+#define NUM_HIGH_PRIORITY_HANDLERS (sizeof(high_priority_handlers) / sizeof(transaction_handler_desc_t))
+#define NUM_LOW_PRIORITY_HANDLERS (sizeof(low_priority_handlers) / sizeof(transaction_handler_desc_t))
+
+#ifdef SPLIT_TRANSACTION_STATS_ENABLE
+static split_transaction_stats_t transaction_stats[NUM_HIGH_PRIORITY_HANDLERS + NUM_LOW_PRIORITY_HANDLERS];
+// Scans each low priority handler has been waiting for its turn
+static uint16_t transaction_waiting[NUM_LOW_PRIORITY_HANDLERS];
+
+uint8_t split_transaction_stats_count(void) {
+    return NUM_HIGH_PRIORITY_HANDLERS + NUM_LOW_PRIORITY_HANDLERS;
+}
+
+const char *split_transaction_stats_name(uint8_t index) {
+    if (index >= split_transaction_stats_count()) return NULL;
+    return index < NUM_HIGH_PRIORITY_HANDLERS ? high_priority_handlers[index].name : low_priority_handlers[index - NUM_HIGH_PRIORITY_HANDLERS].name;
+}
+
+const split_transaction_stats_t *split_transaction_stats(uint8_t index) {
+    if (index >= split_transaction_stats_count()) return NULL;
+    return &transaction_stats[index];
+}
+
+void split_transaction_stats_reset(void) {
+    memset(transaction_stats, 0, sizeof(transaction_stats));
+}
+
+void split_transaction_stats_print(void) {
+    for (uint8_t i = 0; i < split_transaction_stats_count(); i++) {
+        dprintf("%-12s runs: %lu failures: %lu bytes: %lu max latency: %u scans\n", split_transaction_stats_name(i), transaction_stats[i].runs, transaction_stats[i].failures, transaction_stats[i].bytes, transaction_stats[i].max_latency);
+    }
+}
+#endif // SPLIT_TRANSACTION_STATS_ENABLE
+
+static bool transaction_run_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[], const transaction_handler_desc_t *desc, uint8_t stats_index) {
+#ifdef SPLIT_TRANSACTION_STATS_ENABLE
+    uint16_t cost_before = transaction_cost;
+#endif
+    bool okay = transaction_handler_master(master_matrix, slave_matrix, desc);
+#ifdef SPLIT_TRANSACTION_STATS_ENABLE
+    split_transaction_stats_t *stats = &transaction_stats[stats_index];
+    stats->runs++;
+    stats->failures += okay ? 0 : 1;
+    stats->bytes += transaction_cost - cost_before;
+#endif
+    return okay;
+}
+
+/**
+ * @brief Runs one scan's worth of transactions on the master.
+ *
+ * Matrix, encoder and pointing device traffic goes through on every scan. The
+ * low priority handlers then run in turn, picking up where the previous scan
+ * left off, until SPLIT_TRANSACTION_BUDGET bytes have been used. At least one
+ * of them runs on every scan, so that none of them can be starved; most have
+ * nothing to send unless their state changed, so on a quiet bus they all run.
+ */
 bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
-    TRANSACTIONS_SLAVE_MATRIX_MASTER();
-    TRANSACTIONS_MASTER_MATRIX_MASTER();
-    TRANSACTIONS_ENCODERS_MASTER();
-    TRANSACTIONS_SYNC_TIMER_MASTER();
-    TRANSACTIONS_LAYER_STATE_MASTER();
-    TRANSACTIONS_LED_STATE_MASTER();
-    TRANSACTIONS_MODS_MASTER();
-    TRANSACTIONS_BACKLIGHT_MASTER();
-    TRANSACTIONS_RGBLIGHT_MASTER();
-    TRANSACTIONS_LED_MATRIX_MASTER();
-    TRANSACTIONS_RGB_MATRIX_MASTER();
-    TRANSACTIONS_WPM_MASTER();
-    TRANSACTIONS_OLED_MASTER();
-    TRANSACTIONS_ST7565_MASTER();
-    TRANSACTIONS_POINTING_MASTER();
-    TRANSACTIONS_WATCHDOG_MASTER();
-    TRANSACTIONS_HAPTIC_MASTER();
-    TRANSACTIONS_ACTIVITY_MASTER();
-    TRANSACTIONS_DETECTED_OS_MASTER();
+    static uint8_t next_low_priority = 0;
+
+    transaction_cost = 0;
+
+    for (uint8_t i = 0; i < NUM_HIGH_PRIORITY_HANDLERS; i++) {
+        if (!transaction_run_master(master_matrix, slave_matrix, &high_priority_handlers[i], i)) return false;
+    }
+
+    for (uint8_t n = 0; n < NUM_LOW_PRIORITY_HANDLERS; n++) {
+        if (n > 0 && transaction_cost >= SPLIT_TRANSACTION_BUDGET) {
+#ifdef SPLIT_TRANSACTION_STATS_ENABLE
+            // Everything from here on has to wait for a later scan
+            for (uint8_t i = next_low_priority; n < NUM_LOW_PRIORITY_HANDLERS; n++) {
+                if (transaction_waiting[i] < UINT16_MAX) transaction_waiting[i]++;
+                if (++i >= NUM_LOW_PRIORITY_HANDLERS) i = 0;
+            }
+#endif
+            break;
+        }
+
+        uint8_t i = next_low_priority;
+        if (++next_low_priority >= NUM_LOW_PRIORITY_HANDLERS) next_low_priority = 0;
+#ifdef SPLIT_TRANSACTION_STATS_ENABLE
+        split_transaction_stats_t *stats = &transaction_stats[NUM_HIGH_PRIORITY_HANDLERS + i];
+        if (transaction_waiting[i] > stats->max_latency) stats->max_latency = transaction_waiting[i];
+        transaction_waiting[i] = 0;
+#endif
+        if (!transaction_run_master(master_matrix, slave_matrix, &low_priority_handlers[i], NUM_HIGH_PRIORITY_HANDLERS + i)) return false;
+    }
     return true;
 }
 
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     TRANSACTIONS_SLAVE_MATRIX_SLAVE();
     TRANSACTIONS_MASTER_MATRIX_SLAVE();
+    TRANSACTIONS_SWITCH_EVENTS_SLAVE();
     TRANSACTIONS_ENCODERS_SLAVE();
     TRANSACTIONS_SYNC_TIMER_SLAVE();
     TRANSACTIONS_LAYER_STATE_SLAVE();
@@ -49,5 +49,21 @@ void transaction_register_rpc(int8_t transaction_id, slave_callback_t callback);
 
 bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
 
+#ifdef SPLIT_TRANSACTION_STATS_ENABLE
+// Counters for each of the master's transaction handlers
+typedef struct {
+    uint32_t runs;        // times the handler ran
+    uint32_t failures;    // runs which failed even after retrying
+    uint32_t bytes;       // bytes sent and received, including per-transaction overhead
+    uint16_t max_latency; // most scans a low priority handler had to wait for its turn
+} split_transaction_stats_t;
+
+uint8_t                          split_transaction_stats_count(void);
+const char                      *split_transaction_stats_name(uint8_t index);
+const split_transaction_stats_t *split_transaction_stats(uint8_t index);
+void                             split_transaction_stats_reset(void);
+void                             split_transaction_stats_print(void);
+#endif // SPLIT_TRANSACTION_STATS_ENABLE
+
 #define transaction_rpc_send(transaction_id, initiator2target_buffer_size, initiator2target_buffer) transaction_rpc_exec(transaction_id, initiator2target_buffer_size, initiator2target_buffer, 0, NULL)
 #define transaction_rpc_recv(transaction_id, target2initiator_buffer_size, target2initiator_buffer) transaction_rpc_exec(transaction_id, 0, NULL, target2initiator_buffer_size, target2initiator_buffer)
@@ -63,6 +63,10 @@ typedef struct _split_master_matrix_sync_t {
 } split_master_matrix_sync_t;
 #endif // SPLIT_TRANSPORT_MIRROR
 
+#ifdef SPLIT_SWITCH_EVENTS_ENABLE
+#    include "split_switch_events.h"
+#endif // SPLIT_SWITCH_EVENTS_ENABLE
+
 #ifdef ENCODER_ENABLE
 typedef struct _split_slave_encoder_sync_t {
     uint8_t          checksum;
@@ -158,6 +162,11 @@ typedef struct _split_shared_memory_t {
     split_master_matrix_sync_t mmatrix;
 #endif // SPLIT_TRANSPORT_MIRROR
 
+#ifdef SPLIT_SWITCH_EVENTS_ENABLE
+    split_switch_events_sync_t switch_events;
+    uint8_t                    switch_events_reset; // set when the master starts its sequence numbers over
+#endif // SPLIT_SWITCH_EVENTS_ENABLE
+
 #ifdef ENCODER_ENABLE
     split_slave_encoder_sync_t encoders;
 #endif // ENCODER_ENABLE
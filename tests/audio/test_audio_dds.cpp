@@ -0,0 +1,207 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "audio_dds.h"
+}
+
+namespace {
+
+constexpr uint8_t  WAVETABLE_BITS   = 8;
+constexpr size_t   WAVETABLE_LENGTH = 1 << WAVETABLE_BITS;
+constexpr uint32_t SAMPLE_RATE      = 24576;
+constexpr uint8_t  MAX_TONES        = 8;
+
+std::vector<uint16_t> make_sine_wavetable() {
+    std::vector<uint16_t> wavetable(WAVETABLE_LENGTH);
+    for (size_t i = 0; i < WAVETABLE_LENGTH; i++) {
+        wavetable[i] = (uint16_t)std::lround(2047.5 - 2047.5 * std::cos(2.0 * M_PI * i / WAVETABLE_LENGTH));
+    }
+    return wavetable;
+}
+
+/* Lowest and highest value of one sample of ideal additive synthesis, allowing for each phase to be off by a tiny
+ * fraction of a cycle -- otherwise a phase landing exactly on the boundary between two wavetable entries could go
+ * either way */
+struct reference_sample_t {
+    uint16_t low;
+    uint16_t high;
+};
+
+/* Ideal additive synthesis in double precision, against which the fixed-point oscillators are measured */
+std::vector<reference_sample_t> render_reference(const std::vector<uint16_t> &wavetable, const std::vector<float> &frequencies, size_t length) {
+    const double                    tolerance = 1e-5;
+    std::vector<reference_sample_t> samples(length);
+    for (size_t n = 0; n < length; n++) {
+        uint32_t low = 0, high = 0;
+        for (float frequency : frequencies) {
+            double   phase  = (double)frequency * (n + 1) / SAMPLE_RATE;
+            uint16_t before = wavetable[(size_t)((phase - tolerance - std::floor(phase - tolerance)) * WAVETABLE_LENGTH)];
+            uint16_t after  = wavetable[(size_t)((phase + tolerance - std::floor(phase + tolerance)) * WAVETABLE_LENGTH)];
+            low += std::min(before, after);
+            high += std::max(before, after);
+        }
+        samples[n] = {(uint16_t)(low / frequencies.size()), (uint16_t)(high / frequencies.size())};
+    }
+    return samples;
+}
+
+/* The previous floating point implementation, kept for comparison in the benchmark */
+std::vector<uint16_t> render_float(const std::vector<uint16_t> &wavetable, const std::vector<float> &frequencies, size_t length) {
+    std::vector<uint16_t> samples(length);
+    std::vector<float>    positions(frequencies.size(), 0.0f);
+    for (size_t n = 0; n < length; n++) {
+        uint32_t value = 0;
+        for (size_t i = 0; i < frequencies.size(); i++) {
+            positions[i] += frequencies[i] * ((float)WAVETABLE_LENGTH / SAMPLE_RATE);
+            while (positions[i] >= WAVETABLE_LENGTH) {
+                positions[i] -= WAVETABLE_LENGTH;
+            }
+            value += wavetable[(size_t)positions[i]] / frequencies.size();
+        }
+        samples[n] = value;
+    }
+    return samples;
+}
+
+} // namespace
+
+class AudioDds : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        wavetable = make_sine_wavetable();
+        audio_dds_init(&bank, oscillators, wavetable.data(), WAVETABLE_BITS);
+    }
+
+    std::vector<uint16_t> render(const std::vector<float> &frequencies, size_t length) {
+        audio_dds_set_tones(&bank, frequencies.data(), frequencies.size(), SAMPLE_RATE);
+        std::vector<uint16_t> samples(length);
+        audio_dds_render(&bank, samples.data(), length);
+        return samples;
+    }
+
+    void expect_matches_reference(const std::vector<float> &frequencies, size_t length) {
+        auto samples   = render(frequencies, length);
+        auto reference = render_reference(wavetable, frequencies, length);
+        for (size_t n = 0; n < length; n++) {
+            ASSERT_GE(samples[n], reference[n].low) << "sample " << n;
+            ASSERT_LE(samples[n], reference[n].high) << "sample " << n;
+        }
+    }
+
+    std::vector<uint16_t>  wavetable;
+    audio_dds_oscillator_t oscillators[MAX_TONES];
+    audio_dds_bank_t       bank;
+};
+
+TEST_F(AudioDds, SilentWithoutTones) {
+    EXPECT_EQ(audio_dds_next_sample(&bank), 0);
+}
+
+TEST_F(AudioDds, SingleToneMatchesReference) {
+    expect_matches_reference({440.0f}, SAMPLE_RATE);
+}
+
+TEST_F(AudioDds, ChordMatchesReference) {
+    expect_matches_reference({261.63f, 329.63f, 392.0f, 523.25f}, SAMPLE_RATE);
+}
+
+TEST_F(AudioDds, FrequencyAccurateOverOneSecond) {
+    // A rising sawtooth wraps around once per cycle
+    std::vector<uint16_t> sawtooth(WAVETABLE_LENGTH);
+    for (size_t i = 0; i < WAVETABLE_LENGTH; i++) {
+        sawtooth[i] = i * 16;
+    }
+    audio_dds_init(&bank, oscillators, sawtooth.data(), WAVETABLE_BITS);
+
+    for (float frequency : {27.5f, 440.0f, 3951.07f, 7902.13f}) {
+        audio_dds_reset(&bank, MAX_TONES);
+        auto samples = render({frequency}, SAMPLE_RATE);
+        int  cycles  = 0;
+        for (size_t n = 1; n < samples.size(); n++) {
+            cycles += samples[n] < samples[n - 1];
+        }
+        EXPECT_NEAR(cycles, frequency, 1.0) << frequency << "Hz";
+    }
+}
+
+TEST_F(AudioDds, PhaseKeptWhenTonesChange) {
+    render({440.0f}, 100);
+    uint32_t phase = oscillators[0].phase;
+
+    float chord[] = {440.0f, 660.0f};
+    audio_dds_set_tones(&bank, chord, 2, SAMPLE_RATE);
+    EXPECT_EQ(oscillators[0].phase, phase);
+    EXPECT_EQ(oscillators[0].increment, audio_dds_phase_increment(440.0f, SAMPLE_RATE));
+
+    audio_dds_reset(&bank, MAX_TONES);
+    EXPECT_EQ(oscillators[0].phase, 0);
+    EXPECT_EQ(audio_dds_next_sample(&bank), 0);
+}
+
+TEST_F(AudioDds, OutputStaysWithinWavetableRange) {
+    std::vector<float> frequencies;
+    for (uint8_t i = 0; i < MAX_TONES; i++) {
+        frequencies.push_back(110.0f * (i + 1));
+    }
+    auto samples = render(frequencies, SAMPLE_RATE);
+    for (uint16_t sample : samples) {
+        ASSERT_LE(sample, 4095);
+    }
+}
+
+TEST_F(AudioDds, AliasingFrequenciesIgnored) {
+    EXPECT_EQ(audio_dds_phase_increment(0.0f, SAMPLE_RATE), 0);
+    EXPECT_EQ(audio_dds_phase_increment(SAMPLE_RATE / 2, SAMPLE_RATE), 0);
+    EXPECT_EQ(audio_dds_phase_increment(SAMPLE_RATE / 4, SAMPLE_RATE), UINT32_C(1) << 30);
+}
+
+TEST_F(AudioDds, FixedPointAndFloatingPointTimings) {
+    std::vector<float> frequencies;
+    for (uint8_t i = 0; i < MAX_TONES; i++) {
+        frequencies.push_back(110.0f * (i + 1));
+    }
+    const size_t length = SAMPLE_RATE;
+
+    // Fastest of several runs of `body`, in ns per sample, keeping the samples of the last run
+    auto fastest_ns = [length](auto body, std::vector<uint16_t> &samples) {
+        auto fastest = std::chrono::nanoseconds::max();
+        for (int run = 0; run < 5; run++) {
+            const auto start = std::chrono::steady_clock::now();
+            samples          = body();
+            fastest          = std::min(fastest, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start));
+        }
+        return static_cast<double>(fastest.count()) / length;
+    };
+
+    std::vector<uint16_t> dds_samples, float_samples;
+    const double          dds_ns = fastest_ns(
+        [&]() {
+            audio_dds_reset(&bank, MAX_TONES);
+            return render(frequencies, length);
+        },
+        dds_samples);
+    const double float_ns = fastest_ns([&]() { return render_float(wavetable, frequencies, length); }, float_samples);
+
+    // Fixed point should be faster even with a hardware FPU on the host, where the gap is smallest. Only reported, wall
+    // clock timings are too noisy to assert on.
+    RecordProperty("tones", MAX_TONES);
+    RecordProperty("ns_per_sample_fixed_point", std::to_string(dds_ns));
+    RecordProperty("ns_per_sample_floating_point", std::to_string(float_ns));
+
+    ASSERT_EQ(dds_samples.size(), length);
+    ASSERT_EQ(float_samples.size(), length);
+    auto reference = render_reference(wavetable, frequencies, length);
+    for (size_t n = 0; n < length; n++) {
+        ASSERT_GE(dds_samples[n], reference[n].low) << "sample " << n;
+        ASSERT_LE(dds_samples[n], reference[n].high) << "sample " << n;
+    }
+}
@@ -290,3 +290,64 @@ TEST_F(KeyPress, PressEqualPlusDontReleaseBeforePress) {
     run_one_scan_loop();
     VERIFY_AND_CLEAR(driver);
 }
+
+TEST_F(KeyPress, KeyLeftOutOfFullReportIsAddedWhenAnotherIsReleased) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+    auto       key_c = KeymapKey(0, 2, 0, KC_C);
+    auto       key_d = KeymapKey(0, 3, 0, KC_D);
+    auto       key_e = KeymapKey(0, 4, 0, KC_E);
+    auto       key_f = KeymapKey(0, 5, 0, KC_F);
+    auto       key_g = KeymapKey(0, 6, 0, KC_G);
+
+    set_keymap({key_a, key_b, key_c, key_d, key_e, key_f, key_g});
+
+    key_a.press();
+    EXPECT_REPORT(driver, (KC_A));
+    run_one_scan_loop();
+    key_b.press();
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    run_one_scan_loop();
+    key_c.press();
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C));
+    run_one_scan_loop();
+    key_d.press();
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C, KC_D));
+    run_one_scan_loop();
+    key_e.press();
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C, KC_D, KC_E));
+    run_one_scan_loop();
+    key_f.press();
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C, KC_D, KC_E, KC_F));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* The report is full, so the seventh key doesn't change it */
+    key_g.press();
+    EXPECT_NO_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* It takes the place of the first key that is released */
+    key_c.release();
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_D, KC_E, KC_F, KC_G));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    key_a.release();
+    key_b.release();
+    key_d.release();
+    key_e.release();
+    key_f.release();
+    key_g.release();
+    EXPECT_REPORT(driver, (KC_B, KC_D, KC_E, KC_F, KC_G));
+    EXPECT_REPORT(driver, (KC_D, KC_E, KC_F, KC_G));
+    EXPECT_REPORT(driver, (KC_E, KC_F, KC_G));
+    EXPECT_REPORT(driver, (KC_F, KC_G));
+    EXPECT_REPORT(driver, (KC_G));
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
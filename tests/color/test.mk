@@ -0,0 +1,6 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+CIE1931_CURVE = yes
+
+SRC += $(QUANTUM_DIR)/color.c
@@ -0,0 +1,93 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "color.h"
+rgb_t hsv_to_rgb_impl(hsv_t hsv, bool use_cie);
+}
+
+namespace {
+
+/* Every possible colour, in the order a hue sweep across the LEDs would produce them */
+std::vector<hsv_t> all_colors() {
+    std::vector<hsv_t> colors;
+    colors.reserve(1 << 24);
+    for (int v = 0; v < 256; v++) {
+        for (int s = 0; s < 256; s++) {
+            for (int h = 0; h < 256; h++) {
+                colors.push_back({(uint8_t)h, (uint8_t)s, (uint8_t)v});
+            }
+        }
+    }
+    return colors;
+}
+
+/* Converts in batches of one hue sweep, as a frame of an effect would */
+std::vector<rgb_t> convert_batches(const std::vector<hsv_t> &colors, void (*convert)(const hsv_t *, rgb_t *, uint16_t)) {
+    std::vector<rgb_t> converted(colors.size());
+    for (size_t i = 0; i < colors.size(); i += 256) {
+        convert(&colors[i], &converted[i], 256);
+    }
+    return converted;
+}
+
+void expect_matches(const std::vector<hsv_t> &colors, const std::vector<rgb_t> &converted, bool use_cie) {
+    for (size_t i = 0; i < colors.size(); i++) {
+        rgb_t expected = hsv_to_rgb_impl(colors[i], use_cie);
+        if (converted[i].r != expected.r || converted[i].g != expected.g || converted[i].b != expected.b) {
+            FAIL() << "hsv " << (int)colors[i].h << "," << (int)colors[i].s << "," << (int)colors[i].v << " converted to " << (int)converted[i].r << "," << (int)converted[i].g << "," << (int)converted[i].b << " instead of " << (int)expected.r << "," << (int)expected.g << "," << (int)expected.b;
+        }
+    }
+}
+
+} // namespace
+
+TEST(Color, BatchMatchesSingleConversion) {
+    auto colors = all_colors();
+    expect_matches(colors, convert_batches(colors, hsv_to_rgb_batch), true);
+}
+
+TEST(Color, BatchMatchesSingleConversionWithoutCie) {
+    auto colors = all_colors();
+    expect_matches(colors, convert_batches(colors, hsv_to_rgb_batch_nocie), false);
+}
+
+TEST(Color, BatchAndSingleConversionTimings) {
+    auto colors = all_colors();
+
+    auto fastest_ns = [&colors](auto body) {
+        auto fastest = std::chrono::nanoseconds::max();
+        for (int run = 0; run < 5; run++) {
+            const auto start = std::chrono::steady_clock::now();
+            EXPECT_EQ(body().size(), colors.size());
+            fastest = std::min(fastest, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start));
+        }
+        return static_cast<double>(fastest.count()) / colors.size();
+    };
+
+    std::vector<rgb_t> single(colors.size());
+    double             single_ns = fastest_ns([&]() -> const std::vector<rgb_t> & {
+        for (size_t i = 0; i < colors.size(); i++) {
+            single[i] = hsv_to_rgb(colors[i]);
+        }
+        return single;
+    });
+    std::vector<rgb_t> batch;
+    double             batch_ns = fastest_ns([&]() -> const std::vector<rgb_t> & {
+        batch = convert_batches(colors, hsv_to_rgb_batch);
+        return batch;
+    });
+
+    // The batch should be the faster of the two. Only reported, wall clock timings are too noisy to assert on.
+    RecordProperty("ns_per_colour_single", std::to_string(single_ns));
+    RecordProperty("ns_per_colour_batch", std::to_string(batch_ns));
+    EXPECT_EQ(0, memcmp(single.data(), batch.data(), single.size() * sizeof(rgb_t)));
+}
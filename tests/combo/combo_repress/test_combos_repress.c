@@ -27,7 +27,7 @@ void process_combo_event(uint16_t combo_index, bool pressed) {
     }
 }
 
-bool process_combo_key_repress(uint16_t combo_index, combo_t *combo, uint8_t key_index, uint16_t keycode) {
+bool process_combo_key_repress(uint16_t combo_index, const combo_t *combo, uint8_t key_index, uint16_t keycode) {
     switch (combo_index) {
         case alttab:
             switch (keycode) {
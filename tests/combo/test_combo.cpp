@@ -5,6 +5,7 @@
 #include "keyboard_report_util.hpp"
 #include "keycode.h"
 #include "test_common.h"
+#include "test_common.hpp"
 #include "test_driver.hpp"
 #include "test_fixture.hpp"
 #include "test_keymap_key.hpp"
@@ -54,3 +55,60 @@ TEST_F(Combo, combo_osmshift_tapped) {
     tap_key(key_i);
     VERIFY_AND_CLEAR(driver);
 }
+
+TEST_F(Combo, combo_sharing_key_with_many_combos_tapped) {
+    TestDriver driver;
+    KeymapKey  key_q(0, 0, 1, KC_Q);
+    KeymapKey  key_f1(0, 0, 2, KC_F1);
+    KeymapKey  key_f20(0, 0, 3, KC_F20);
+    set_keymap({key_q, key_f1, key_f20});
+
+    EXPECT_REPORT(driver, (KC_T));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_q, key_f20});
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_f1, key_q});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Combo, combo_sharing_key_with_many_combos_held) {
+    TestDriver driver;
+    KeymapKey  key_q(0, 0, 1, KC_Q);
+    KeymapKey  key_f20(0, 0, 2, KC_F20);
+    KeymapKey  key_i(0, 0, 3, KC_I);
+    set_keymap({key_q, key_f20, key_i});
+
+    EXPECT_REPORT(driver, (KC_T));
+    key_q.press();
+    run_one_scan_loop();
+    key_f20.press();
+    run_one_scan_loop();
+    idle_for(COMBO_TERM + 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_T, KC_I));
+    EXPECT_REPORT(driver, (KC_T));
+    tap_key(key_i);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_q.release();
+    run_one_scan_loop();
+    key_f20.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Combo, shared_combo_key_tapped_alone) {
+    TestDriver driver;
+    KeymapKey  key_q(0, 0, 1, KC_Q);
+    set_keymap({key_q});
+
+    EXPECT_REPORT(driver, (KC_Q));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_q);
+    VERIFY_AND_CLEAR(driver);
+}
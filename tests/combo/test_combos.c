@@ -4,14 +4,57 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 #include "quantum.h"
 
-enum combos { modtest, osmshift };
+enum combos { modtest, osmshift, shared_f1, shared_f2, shared_f3, shared_f4, shared_f5, shared_f6, shared_f7, shared_f8, shared_f9, shared_f10, shared_f11, shared_f12, shared_f13, shared_f14, shared_f15, shared_f16, shared_f17, shared_f18, shared_f19, shared_f20 };
 
 uint16_t const modtest_combo[]  = {KC_Y, KC_U, COMBO_END};
 uint16_t const osmshift_combo[] = {KC_Z, KC_X, COMBO_END};
 
+// More combos sharing KC_Q than COMBO_STATE_BUFFER_LENGTH
+#define SHARED_KEY_COMBO(n) uint16_t const shared_f##n##_combo[] = {KC_Q, KC_F##n, COMBO_END};
+SHARED_KEY_COMBO(1)
+SHARED_KEY_COMBO(2)
+SHARED_KEY_COMBO(3)
+SHARED_KEY_COMBO(4)
+SHARED_KEY_COMBO(5)
+SHARED_KEY_COMBO(6)
+SHARED_KEY_COMBO(7)
+SHARED_KEY_COMBO(8)
+SHARED_KEY_COMBO(9)
+SHARED_KEY_COMBO(10)
+SHARED_KEY_COMBO(11)
+SHARED_KEY_COMBO(12)
+SHARED_KEY_COMBO(13)
+SHARED_KEY_COMBO(14)
+SHARED_KEY_COMBO(15)
+SHARED_KEY_COMBO(16)
+SHARED_KEY_COMBO(17)
+SHARED_KEY_COMBO(18)
+SHARED_KEY_COMBO(19)
+SHARED_KEY_COMBO(20)
+
 // clang-format off
-combo_t key_combos[] = {
-    [modtest]  = COMBO(modtest_combo, RSFT_T(KC_SPACE)),
-    [osmshift] = COMBO(osmshift_combo, OSM(MOD_LSFT))
+const combo_t key_combos[] = {
+    [modtest]    = COMBO(modtest_combo, RSFT_T(KC_SPACE)),
+    [osmshift]   = COMBO(osmshift_combo, OSM(MOD_LSFT)),
+    [shared_f1]  = COMBO(shared_f1_combo, KC_A),
+    [shared_f2]  = COMBO(shared_f2_combo, KC_B),
+    [shared_f3]  = COMBO(shared_f3_combo, KC_C),
+    [shared_f4]  = COMBO(shared_f4_combo, KC_D),
+    [shared_f5]  = COMBO(shared_f5_combo, KC_E),
+    [shared_f6]  = COMBO(shared_f6_combo, KC_F),
+    [shared_f7]  = COMBO(shared_f7_combo, KC_G),
+    [shared_f8]  = COMBO(shared_f8_combo, KC_H),
+    [shared_f9]  = COMBO(shared_f9_combo, KC_I),
+    [shared_f10] = COMBO(shared_f10_combo, KC_J),
+    [shared_f11] = COMBO(shared_f11_combo, KC_K),
+    [shared_f12] = COMBO(shared_f12_combo, KC_L),
+    [shared_f13] = COMBO(shared_f13_combo, KC_M),
+    [shared_f14] = COMBO(shared_f14_combo, KC_N),
+    [shared_f15] = COMBO(shared_f15_combo, KC_O),
+    [shared_f16] = COMBO(shared_f16_combo, KC_P),
+    [shared_f17] = COMBO(shared_f17_combo, KC_Q),
+    [shared_f18] = COMBO(shared_f18_combo, KC_R),
+    [shared_f19] = COMBO(shared_f19_combo, KC_S),
+    [shared_f20] = COMBO(shared_f20_combo, KC_T)
 };
 // clang-format on
@@ -0,0 +1,160 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycodes.h"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+class DynamicMacro : public TestFixture {
+   protected:
+    void record(KeymapKey &record_key, const std::vector<KeymapKey *> &keys) {
+        EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+        tap_key(record_key);
+        for (auto key : keys) {
+            tap_key(*key);
+        }
+        tap_key(key_stop);
+        VERIFY_AND_CLEAR(driver);
+    }
+
+    void play_until_done() {
+        for (int i = 0; i < 100 && dynamic_macro_is_playing(); i++) {
+            run_one_scan_loop();
+        }
+        EXPECT_FALSE(dynamic_macro_is_playing());
+    }
+
+    TestDriver driver;
+    KeymapKey  key_rec1  = KeymapKey(0, 0, 0, DM_REC1);
+    KeymapKey  key_rec2  = KeymapKey(0, 1, 0, DM_REC2);
+    KeymapKey  key_play1 = KeymapKey(0, 2, 0, DM_PLY1);
+    KeymapKey  key_play2 = KeymapKey(0, 3, 0, DM_PLY2);
+    KeymapKey  key_stop  = KeymapKey(0, 4, 0, DM_RSTP);
+    KeymapKey  key_a     = KeymapKey(0, 0, 1, KC_A);
+    KeymapKey  key_b     = KeymapKey(0, 1, 1, KC_B);
+    KeymapKey  key_c     = KeymapKey(0, 2, 1, KC_C);
+
+    void SetUp() override {
+        TestFixture::SetUp();
+        set_keymap({key_rec1, key_rec2, key_play1, key_play2, key_stop, key_a, key_b, key_c});
+    }
+};
+
+TEST_F(DynamicMacro, RecordAndPlay) {
+    record(key_rec1, {&key_a, &key_b});
+
+    {
+        InSequence seq;
+        EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver);
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    }
+    tap_key(key_play1);
+    play_until_done();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, PlaybackSpreadOverScans) {
+    record(key_rec2, {&key_a, &key_b, &key_c});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    tap_key(key_play2);
+    EXPECT_TRUE(dynamic_macro_is_playing());
+
+    // Keys pressed in the meantime are still scanned and sent
+    EXPECT_REPORT(driver, (KC_A, KC_C)).Times(1);
+    EXPECT_REPORT(driver, (KC_C)).Times(AnyNumber());
+    key_c.press();
+    run_one_scan_loop();
+    run_one_scan_loop();
+    key_c.release();
+    run_one_scan_loop();
+
+    play_until_done();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, NestedPlayback) {
+    record(key_rec2, {&key_b});
+    record(key_rec1, {&key_a, &key_play2, &key_c});
+
+    {
+        InSequence seq;
+        EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+        EXPECT_REPORT(driver, (KC_C));
+        EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    }
+    tap_key(key_play1);
+    play_until_done();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, RecursivePlaybackIgnored) {
+    record(key_rec1, {&key_a, &key_play1});
+
+    {
+        InSequence seq;
+        EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    }
+    tap_key(key_play1);
+    play_until_done();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, TrailingPressesTrimmed) {
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    tap_key(key_rec1);
+    tap_key(key_a);
+    key_b.press();
+    run_one_scan_loop();
+    tap_key(key_stop);
+    key_b.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    {
+        InSequence seq;
+        EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    }
+    tap_key(key_play1);
+    play_until_done();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, LayersChangedByPlaybackRestored) {
+    KeymapKey key_tg = KeymapKey(0, 3, 1, TG(1));
+    add_key(key_tg);
+    add_key(KeymapKey(1, 0, 1, KC_TRNS));
+    add_key(KeymapKey(1, 1, 1, KC_TRNS));
+    add_key(KeymapKey(1, 4, 0, KC_TRNS));
+    add_key(KeymapKey(2, 0, 1, KC_TRNS));
+    add_key(KeymapKey(2, 1, 1, KC_TRNS));
+
+    record(key_rec1, {&key_tg, &key_a, &key_b});
+    layer_off(1);
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    tap_key(key_play1);
+    ASSERT_TRUE(dynamic_macro_is_playing());
+
+    // Changed by a key pressed during playback, rather than by the macro
+    layer_on(2);
+
+    play_until_done();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_FALSE(layer_state_is(1));
+    EXPECT_TRUE(layer_state_is(2));
+}
@@ -0,0 +1,179 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "dynamic_macro.h"
+}
+
+namespace {
+
+keyrecord_t make_record(keyevent_type_t type, uint8_t row, uint8_t col, bool pressed, uint8_t tap_count = 0, bool interrupted = false) {
+    keyrecord_t record     = {};
+    record.event.type      = type;
+    record.event.key.row   = row;
+    record.event.key.col   = col;
+    record.event.pressed   = pressed;
+    record.tap.count       = tap_count;
+    record.tap.interrupted = interrupted;
+    return record;
+}
+
+struct recorded_event_t {
+    keyrecord_t record;
+    uint16_t    delay;
+};
+
+std::vector<recorded_event_t> sample_recording() {
+    return {
+        {make_record(KEY_EVENT, 0, 0, true), 0},
+        {make_record(KEY_EVENT, 0, 0, false), 6},
+        {make_record(KEY_EVENT, 3, 9, true), 7},
+        {make_record(KEY_EVENT, 3, 9, false), 134},
+        {make_record(KEY_EVENT, 2, 5, true, 1), 135},
+        {make_record(KEY_EVENT, 2, 5, false, 1, true), 16390},
+        {make_record(ENCODER_CW_EVENT, KEYLOC_ENCODER_CW, 1, true), 16391},
+        {make_record(ENCODER_CW_EVENT, KEYLOC_ENCODER_CW, 1, false), 65535},
+        {make_record(ENCODER_CCW_EVENT, KEYLOC_ENCODER_CCW, 0, true), 1},
+        {make_record(DIP_SWITCH_ON_EVENT, KEYLOC_DIP_SWITCH_ON, 2, true), 2},
+        {make_record(DIP_SWITCH_OFF_EVENT, KEYLOC_DIP_SWITCH_OFF, 2, false), 3},
+        {make_record(COMBO_EVENT, 0, 0, true, 15), 4},
+    };
+}
+
+void expect_same_event(const keyrecord_t &actual, const keyrecord_t &expected, size_t index) {
+    EXPECT_EQ(actual.event.type, expected.event.type) << "event " << index;
+    EXPECT_EQ(actual.event.key.row, expected.event.key.row) << "event " << index;
+    EXPECT_EQ(actual.event.key.col, expected.event.key.col) << "event " << index;
+    EXPECT_EQ(actual.event.pressed, expected.event.pressed) << "event " << index;
+    EXPECT_EQ(actual.tap.count, expected.tap.count) << "event " << index;
+    EXPECT_EQ(actual.tap.interrupted, expected.tap.interrupted) << "event " << index;
+}
+
+void expect_round_trip(dynamic_macro_t *macro, uint16_t capacity) {
+    auto recording = sample_recording();
+    for (auto &event : recording) {
+        ASSERT_TRUE(dynamic_macro_append(macro, capacity, &event.record, event.delay));
+    }
+
+    keyrecord_t record;
+    uint16_t    delay;
+    uint16_t    offset = 0;
+    for (size_t i = 0; i < recording.size(); i++) {
+        offset = dynamic_macro_read(macro, offset, &record, &delay);
+        ASSERT_NE(offset, 0) << "event " << i;
+        expect_same_event(record, recording[i].record, i);
+        EXPECT_EQ(delay, recording[i].delay) << "event " << i;
+    }
+    EXPECT_EQ(offset, macro->length);
+    EXPECT_EQ(dynamic_macro_read(macro, offset, &record, &delay), 0);
+}
+
+} // namespace
+
+TEST(DynamicMacroEncoding, RoundTripForwards) {
+    uint8_t         buffer[128] = {0};
+    dynamic_macro_t macro       = {.start = buffer, .direction = +1, .length = 0};
+    expect_round_trip(&macro, sizeof(buffer));
+}
+
+TEST(DynamicMacroEncoding, RoundTripBackwards) {
+    uint8_t         buffer[128] = {0};
+    dynamic_macro_t macro       = {.start = buffer + sizeof(buffer) - 1, .direction = -1, .length = 0};
+    expect_round_trip(&macro, sizeof(buffer));
+}
+
+TEST(DynamicMacroEncoding, EveryKeyPositionRoundTrips) {
+    uint8_t         buffer[MATRIX_ROWS * MATRIX_COLS * 2 * 2];
+    dynamic_macro_t macro = {.start = buffer, .direction = +1, .length = 0};
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            keyrecord_t down = make_record(KEY_EVENT, row, col, true);
+            keyrecord_t up   = make_record(KEY_EVENT, row, col, false);
+            ASSERT_TRUE(dynamic_macro_append(&macro, sizeof(buffer), &down, 0));
+            ASSERT_TRUE(dynamic_macro_append(&macro, sizeof(buffer), &up, 0));
+        }
+    }
+
+    keyrecord_t record;
+    uint16_t    delay;
+    uint16_t    offset = 0;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            for (bool pressed : {true, false}) {
+                offset = dynamic_macro_read(&macro, offset, &record, &delay);
+                ASSERT_NE(offset, 0);
+                expect_same_event(record, make_record(KEY_EVENT, row, col, pressed), row * MATRIX_COLS + col);
+            }
+        }
+    }
+}
+
+TEST(DynamicMacroEncoding, PlainKeyTakesTwoBytes) {
+    uint8_t         buffer[16];
+    dynamic_macro_t macro = {.start = buffer, .direction = +1, .length = 0};
+    keyrecord_t     down  = make_record(KEY_EVENT, 3, 9, true);
+
+    ASSERT_TRUE(dynamic_macro_append(&macro, sizeof(buffer), &down, 5));
+    EXPECT_EQ(macro.length, 2);
+
+    // Longer delays spill over into following bytes
+    ASSERT_TRUE(dynamic_macro_append(&macro, sizeof(buffer), &down, 100));
+    EXPECT_EQ(macro.length, 5);
+}
+
+TEST(DynamicMacroEncoding, FullMacroLeftUntouched) {
+    uint8_t         buffer[8];
+    dynamic_macro_t macro = {.start = buffer, .direction = +1, .length = 0};
+    keyrecord_t     down  = make_record(KEY_EVENT, 1, 1, true);
+
+    for (int i = 0; i < 3; i++) {
+        ASSERT_TRUE(dynamic_macro_append(&macro, 7, &down, 0));
+    }
+    EXPECT_EQ(macro.length, 6);
+    EXPECT_FALSE(dynamic_macro_append(&macro, 7, &down, 0));
+    EXPECT_EQ(macro.length, 6);
+}
+
+TEST(DynamicMacroEncoding, TrimDropsTrailingPresses) {
+    uint8_t         buffer[32];
+    dynamic_macro_t macro = {.start = buffer + sizeof(buffer) - 1, .direction = -1, .length = 0};
+
+    keyrecord_t a_down     = make_record(KEY_EVENT, 0, 1, true);
+    keyrecord_t a_up       = make_record(KEY_EVENT, 0, 1, false);
+    keyrecord_t layer_down = make_record(KEY_EVENT, 0, 2, true);
+    keyrecord_t stop_down  = make_record(KEY_EVENT, 0, 3, true);
+    ASSERT_TRUE(dynamic_macro_append(&macro, sizeof(buffer), &a_down, 0));
+    ASSERT_TRUE(dynamic_macro_append(&macro, sizeof(buffer), &a_up, 300));
+    uint16_t length = macro.length;
+    ASSERT_TRUE(dynamic_macro_append(&macro, sizeof(buffer), &layer_down, 0));
+    ASSERT_TRUE(dynamic_macro_append(&macro, sizeof(buffer), &stop_down, 0));
+
+    dynamic_macro_trim(&macro);
+    EXPECT_EQ(macro.length, length);
+
+    // A macro of nothing but presses ends up empty
+    dynamic_macro_t presses = {.start = buffer, .direction = +1, .length = 0};
+    ASSERT_TRUE(dynamic_macro_append(&presses, sizeof(buffer), &layer_down, 0));
+    dynamic_macro_trim(&presses);
+    EXPECT_EQ(presses.length, 0);
+}
+
+TEST(DynamicMacroEncoding, TruncatedEventNotDecoded) {
+    uint8_t         buffer[16];
+    dynamic_macro_t macro = {.start = buffer, .direction = +1, .length = 0};
+    keyrecord_t     down  = make_record(KEY_EVENT, 2, 2, true, 3);
+    ASSERT_TRUE(dynamic_macro_append(&macro, sizeof(buffer), &down, 1000));
+
+    keyrecord_t record;
+    uint16_t    delay;
+    for (uint16_t length = 0; length < macro.length; length++) {
+        dynamic_macro_t truncated = macro;
+        truncated.length          = length;
+        EXPECT_EQ(dynamic_macro_read(&truncated, 0, &record, &delay), 0) << length << " bytes";
+    }
+    EXPECT_EQ(dynamic_macro_read(&macro, 0, &record, &delay), macro.length);
+}
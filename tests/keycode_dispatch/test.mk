@@ -0,0 +1,21 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# Enable as many keycode processors as the test platform supports, so the
+# benchmark reflects a fully loaded process_record_quantum() chain.
+AUDIO_ENABLE = yes
+AUTO_SHIFT_ENABLE = yes
+CAPS_WORD_ENABLE = yes
+DYNAMIC_TAPPING_TERM_ENABLE = yes
+EXTRAKEY_ENABLE = yes
+GRAVE_ESC_ENABLE = yes
+KEY_LOCK_ENABLE = yes
+LAYER_LOCK_ENABLE = yes
+LEADER_ENABLE = yes
+MAGIC_ENABLE = yes
+PROGRAMMABLE_BUTTON_ENABLE = yes
+REPEAT_KEY_ENABLE = yes
+SECURE_ENABLE = yes
+SPACE_CADET_ENABLE = yes
+TRI_LAYER_ENABLE = yes
+UNICODE_ENABLE = yes
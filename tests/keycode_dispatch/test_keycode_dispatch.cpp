@@ -0,0 +1,175 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "keycode_dispatch.h"
+}
+
+using testing::_;
+
+class KeycodeDispatch : public TestFixture {};
+
+TEST_F(KeycodeDispatch, BasicKeycodesSkipRangeBoundHandlers) {
+    EXPECT_EQ(keycode_dispatch_mask(KC_NO), 0);
+    EXPECT_EQ(keycode_dispatch_mask(KC_A), 0);
+    EXPECT_EQ(keycode_dispatch_mask(LCTL(KC_A)), 0);
+    EXPECT_EQ(keycode_dispatch_mask(LT(1, KC_A)), 0);
+    EXPECT_EQ(keycode_dispatch_mask(MO(1)), 0);
+}
+
+TEST_F(KeycodeDispatch, RangeBoundaries) {
+    EXPECT_TRUE(PROCESS_HANDLER_WANTS(keycode_dispatch_mask(QK_MAGIC), MAGIC));
+    EXPECT_TRUE(PROCESS_HANDLER_WANTS(keycode_dispatch_mask(QK_MAGIC_MAX), MAGIC));
+    EXPECT_FALSE(PROCESS_HANDLER_WANTS(keycode_dispatch_mask(QK_MAGIC_MAX + 1), MAGIC));
+
+    EXPECT_TRUE(PROCESS_HANDLER_WANTS(keycode_dispatch_mask(QK_JOYSTICK_MAX), JOYSTICK));
+    EXPECT_FALSE(PROCESS_HANDLER_WANTS(keycode_dispatch_mask(QK_JOYSTICK_MAX), PROGRAMMABLE_BUTTON));
+    EXPECT_TRUE(PROCESS_HANDLER_WANTS(keycode_dispatch_mask(QK_PROGRAMMABLE_BUTTON), PROGRAMMABLE_BUTTON));
+    EXPECT_FALSE(PROCESS_HANDLER_WANTS(keycode_dispatch_mask(QK_PROGRAMMABLE_BUTTON), JOYSTICK));
+
+    EXPECT_TRUE(PROCESS_HANDLER_WANTS(keycode_dispatch_mask(PDF(1)), DEFAULT_LAYER));
+    EXPECT_FALSE(PROCESS_HANDLER_WANTS(keycode_dispatch_mask(DF(1)), DEFAULT_LAYER));
+
+    EXPECT_TRUE(PROCESS_HANDLER_WANTS(keycode_dispatch_mask(QK_TRI_LAYER_LOWER), TRI_LAYER));
+    EXPECT_TRUE(PROCESS_HANDLER_WANTS(keycode_dispatch_mask(QK_GRAVE_ESCAPE), GRAVE_ESC));
+    EXPECT_TRUE(PROCESS_HANDLER_WANTS(keycode_dispatch_mask(QK_BACKLIGHT_ON), LED_MATRIX));
+    EXPECT_TRUE(PROCESS_HANDLER_WANTS(keycode_dispatch_mask(UC(0x2603)), UNICODE));
+    EXPECT_TRUE(PROCESS_HANDLER_WANTS(keycode_dispatch_mask(0xFFFF), UNICODE));
+}
+
+static int all_keycodes_calls;
+static int magic_calls;
+static int module_calls;
+
+static bool count_all_keycodes(uint16_t keycode, keyrecord_t *record) {
+    all_keycodes_calls++;
+    return keycode != KC_ESC;
+}
+
+static bool count_magic(uint16_t keycode, keyrecord_t *record) {
+    magic_calls++;
+    return true;
+}
+
+static bool count_module(uint16_t keycode, keyrecord_t *record) {
+    module_calls++;
+    return true;
+}
+
+static const process_record_handler_t test_handlers[] = {
+    PROCESS_RECORD_ALL_KEYCODES(count_all_keycodes),
+    PROCESS_RECORD_HANDLER(count_magic, MAGIC),
+    PROCESS_RECORD_HANDLER(count_module, COMMUNITY_MODULE),
+};
+static const uint8_t test_handler_count = sizeof(test_handlers) / sizeof(test_handlers[0]);
+
+TEST_F(KeycodeDispatch, RegisteredHandlersOnlySeeTheirRanges) {
+    keyrecord_t record = {};
+
+    all_keycodes_calls = magic_calls = module_calls = 0;
+    EXPECT_TRUE(keycode_dispatch(test_handlers, test_handler_count, KC_A, &record));
+    EXPECT_EQ(all_keycodes_calls, 1);
+    EXPECT_EQ(magic_calls, 0);
+    EXPECT_EQ(module_calls, 0);
+
+    EXPECT_TRUE(keycode_dispatch(test_handlers, test_handler_count, QK_MAGIC_TOGGLE_NKRO, &record));
+    EXPECT_EQ(all_keycodes_calls, 2);
+    EXPECT_EQ(magic_calls, 1);
+    EXPECT_EQ(module_calls, 0);
+
+    EXPECT_TRUE(keycode_dispatch(test_handlers, test_handler_count, QK_COMMUNITY_MODULE, &record));
+    EXPECT_EQ(all_keycodes_calls, 3);
+    EXPECT_EQ(magic_calls, 1);
+    EXPECT_EQ(module_calls, 1);
+}
+
+TEST_F(KeycodeDispatch, HandlerReturningFalseStopsTheChain) {
+    keyrecord_t record = {};
+
+    all_keycodes_calls = magic_calls = module_calls = 0;
+    EXPECT_FALSE(keycode_dispatch(test_handlers, test_handler_count, KC_ESC, &record));
+    EXPECT_EQ(all_keycodes_calls, 1);
+    EXPECT_EQ(magic_calls, 0);
+    EXPECT_EQ(module_calls, 0);
+}
+
+TEST_F(KeycodeDispatch, RangeBoundHandlersStillRun) {
+    TestDriver driver;
+    KeymapKey  lower_layer_key = KeymapKey{0, 0, 0, QK_TRI_LAYER_LOWER};
+    KeymapKey  regular_key     = KeymapKey{0, 1, 0, KC_A};
+
+    set_keymap({lower_layer_key, regular_key, KeymapKey{1, 1, 0, KC_TRNS}});
+
+    EXPECT_NO_REPORT(driver);
+    lower_layer_key.press();
+    run_one_scan_loop();
+    EXPECT_TRUE(layer_state_is(get_tri_layer_lower_layer()));
+    VERIFY_AND_CLEAR(driver);
+
+    // Auto shift holds back the report until release.
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(regular_key);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    lower_layer_key.release();
+    run_one_scan_loop();
+    EXPECT_FALSE(layer_state_is(get_tri_layer_lower_layer()));
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeycodeDispatch, LookupAndEventTimings) {
+    TestDriver driver;
+    KeymapKey  key = KeymapKey{0, 0, 0, KC_NO};
+
+    set_keymap({key});
+
+    constexpr int iterations = 100000;
+
+    // Fastest of several runs of `body`, in ns per iteration.
+    auto fastest_ns = [](auto body) {
+        auto fastest = std::chrono::nanoseconds::max();
+        for (int run = 0; run < 5; run++) {
+            const auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < iterations; i++) {
+                body(i);
+            }
+            fastest = std::min(fastest, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start));
+        }
+        return static_cast<double>(fastest.count()) / iterations;
+    };
+
+    // Lookup alone, sweeping the whole keycode space and checking the result against the magic keycode range.
+    int          mismatches = 0;
+    const double lookup_ns  = fastest_ns([&](int i) {
+        const uint16_t keycode = (uint16_t)(i * 0x9E37);
+        mismatches += PROCESS_HANDLER_WANTS(keycode_dispatch_mask(keycode), MAGIC) != (keycode >= QK_MAGIC && keycode <= QK_MAGIC_MAX);
+    });
+    EXPECT_EQ(mismatches, 0);
+
+    // Full quantum processing of a key that no processor consumes.
+    EXPECT_NO_REPORT(driver);
+    keyrecord_t press   = {};
+    keyrecord_t release = {};
+    press.event.type    = KEY_EVENT;
+    press.event.pressed = true;
+    release.event.type  = KEY_EVENT;
+    const double event_ns = fastest_ns([&](int) {
+                                process_record_quantum(&press);
+                                process_record_quantum(&release);
+                            }) /
+                            2;
+    VERIFY_AND_CLEAR(driver);
+
+    // The lookup replaces a keycode range check in every processor, it should stay a small part of an event. Only
+    // reported, wall clock timings are too noisy to assert on.
+    RecordProperty("ns_per_lookup", std::to_string(lookup_ns));
+    RecordProperty("ns_per_event", std::to_string(event_ns));
+}
@@ -0,0 +1,10 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# Features with keycodes named only while they are enabled
+CAPS_WORD_ENABLE = yes
+GRAVE_ESC_ENABLE = yes
+KEYCODE_STRING_ENABLE = yes
+LAYER_LOCK_ENABLE = yes
+LEADER_ENABLE = yes
+TRI_LAYER_ENABLE = yes
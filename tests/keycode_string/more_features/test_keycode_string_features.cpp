@@ -0,0 +1,39 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include <vector>
+
+#include "test_common.hpp"
+
+class KeycodeStringFeaturesTest : public TestFixture {};
+
+TEST_F(KeycodeStringFeaturesTest, feature_keycodes_named) {
+    struct TestParams {
+        uint16_t    keycode;
+        std::string expected;
+    };
+    for (const auto& [keycode, expected] : std::vector<TestParams>({
+             {QK_GESC, "QK_GESC"},
+             {QK_LEAD, "QK_LEAD"},
+             {CW_TOGG, "CW_TOGG"},
+             {TL_LOWR, "TL_LOWR"},
+             {TL_UPPR, "TL_UPPR"},
+             {QK_LLCK, "QK_LLCK"},
+         })) {
+        EXPECT_EQ(get_keycode_string(keycode), expected) << "where keycode = 0x" << std::hex << keycode;
+
+        uint16_t parsed = KC_NO;
+        EXPECT_TRUE(parse_keycode_string(expected.c_str(), &parsed)) << "where str = " << expected;
+        EXPECT_EQ(parsed, keycode) << "where str = " << expected;
+    }
+}
+
+TEST_F(KeycodeStringFeaturesTest, round_trip) {
+    for (uint32_t keycode = 0; keycode <= UINT16_MAX; ++keycode) {
+        const std::string str    = get_keycode_string(keycode);
+        uint16_t          parsed = KC_NO;
+        ASSERT_TRUE(parse_keycode_string(str.c_str(), &parsed)) << "where str = " << str;
+        ASSERT_EQ(parsed, keycode) << "where str = " << str;
+    }
+}
@@ -12,7 +12,12 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include "test_common.hpp"
 
@@ -151,3 +156,151 @@ TEST_F(KeycodeStringTest, get_keycode_string) {
         EXPECT_EQ(get_keycode_string(keycode), expected) << "where keycode = 0x" << std::hex << keycode;
     }
 }
+
+TEST_F(KeycodeStringTest, get_keycode_string_unnamed) {
+    EXPECT_EQ(get_keycode_string(0x00FF), std::string("0xFF"));
+}
+
+TEST_F(KeycodeStringTest, parse_keycode_string) {
+    struct TestParams {
+        uint16_t    expected;
+        std::string str;
+    };
+    for (const auto& [expected, str] : std::vector<TestParams>({
+             {KC_TRNS, "KC_TRNS"},
+             {KC_A, "KC_A"},
+             {KC_F24, "KC_F24"},
+             {KC_LCTL, "KC_LCTL"},
+             {MC_31, "MC_31"},
+             {QK_KB_0, "QK_KB_0"},
+             {QK_USER_31, "QK_USER_31"},
+             {KC_COLN, "S(KC_SCLN)"},
+             {RALT(KC_BSPC), "RALT(KC_BSPC)"},
+             {OSM(MOD_LSFT), "OSM(MOD_LSFT)"},
+             {OSM(MOD_RCTL | MOD_RGUI), "OSM(0x19)"},
+             {DF(2), "DF(2)"},
+             {PDF(12), "PDF(12)"},
+             {MO(3), "MO(3)"},
+             {TO(0), "TO(0)"},
+             {TT(1), "TT(1)"},
+             {TG(3), "TG(3)"},
+             {OSL(3), "OSL(3)"},
+             {LM(3, MOD_RALT), "LM(3,MOD_RALT)"},
+             {LT(15, KC_QUOT), "LT(15,KC_QUOT)"},
+             {TD(31), "TD(31)"},
+             {LSFT_T(KC_ENT), "LSFT_T(KC_ENT)"},
+             {HYPR_T(KC_GRV), "HYPR_T(KC_GRV)"},
+             {RSA_T(KC_LBRC), "MT(0x16,KC_LBRC)"},
+             {KC_VOLU, "KC_VOLU"},
+             {MS_BTN8, "MS_BTN8"},
+             {SH_T(KC_PSCR), "SH_T(KC_PSCR)"},
+             {SE_REQ, "SE_REQ"},
+             {PB_32, "PB_32"},
+             {QK_MAGIC + 7, "QK_MAGIC+7"},
+             {QK_QUANTUM + 7, "QK_QUANTUM+7"},
+             {MYMACRO1, "MYMACRO1"},
+             {MYMACRO2, "MYMACRO2"},
+             {KC_EXLM, "KC_EXLM"},
+             {0x00FF, "0xFF"},
+             // Names which are not formatted that way, but are understood all the same.
+             {LCTL(KC_A), "LCTL(KC_A)"},
+             {MT(MOD_LSFT, KC_A), "MT(0x2,KC_A)"},
+             {LM(1, MOD_LSFT | MOD_LCTL), "LM(1,0x3)"},
+             {KC_A, "0x4"},
+         })) {
+        uint16_t keycode = KC_NO;
+        EXPECT_TRUE(parse_keycode_string(str.c_str(), &keycode)) << "where str = " << str;
+        EXPECT_EQ(keycode, expected) << "where str = " << str;
+    }
+}
+
+TEST_F(KeycodeStringTest, parse_keycode_string_invalid) {
+    for (const std::string str : {
+             "",
+             "KC_",
+             "KC_AA",
+             "kc_a",
+             "KC_A ",
+             "KC_F25",
+             "KC_10",
+             "MS_BTN0",
+             "0x",
+             "0x1G",
+             "0x10000",
+             "MO",
+             "MO(",
+             "MO(3",
+             "MO(3))",
+             "MO(32)",
+             "MO(0x3)",
+             "MO(KC_A)",
+             "XX(1)",
+             "LT(16,KC_A)",
+             "LT(1,MO(1))",
+             "LT(1,KC_A",
+             "S(KC_A",
+             "S(KC_A)KC_B",
+             "X(KC_A)",
+             "MT(0x20,KC_A)",
+             "OSM(MOD_XSFT)",
+             "SH_T(0xF0)",
+             "UP(128,0)",
+         }) {
+        uint16_t keycode = KC_Q;
+        EXPECT_FALSE(parse_keycode_string(str.c_str(), &keycode)) << "where str = " << str;
+        EXPECT_EQ(keycode, KC_Q) << "where str = " << str;
+    }
+}
+
+TEST_F(KeycodeStringTest, round_trip) {
+    for (uint32_t keycode = 0; keycode <= UINT16_MAX; ++keycode) {
+        const std::string str    = get_keycode_string(keycode);
+        uint16_t          parsed = KC_NO;
+        ASSERT_TRUE(parse_keycode_string(str.c_str(), &parsed)) << "where str = " << str;
+        ASSERT_EQ(parsed, keycode) << "where str = " << str;
+    }
+}
+
+TEST_F(KeycodeStringTest, sorted_names_lookup_timings) {
+    const auto* const data_user = keycode_string_names_data_user;
+    const uint16_t    size_user = keycode_string_names_size_user;
+
+    // Fastest of several runs formatting every keycode of a sorted table of `size` names.
+    auto time_per_lookup = [](uint16_t size) {
+        std::vector<std::string>           names(size);
+        std::vector<keycode_string_name_t> table(size);
+        for (uint16_t i = 0; i < size; ++i) {
+            names[i] = "NAME" + std::to_string(i);
+            table[i] = {static_cast<uint16_t>(QK_UNICODE + i), names[i].c_str()};
+        }
+        keycode_string_names_data_user = table.data();
+        keycode_string_names_size_user = size;
+
+        for (uint16_t i = 0; i < size; ++i) {
+            EXPECT_EQ(get_keycode_string(QK_UNICODE + i), names[i]);
+        }
+
+        const int lookups = 1 << 16;
+        auto      fastest = std::chrono::nanoseconds::max();
+        size_t    length  = 0;
+        for (int run = 0; run < 5; ++run) {
+            const auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < lookups; ++i) {
+                length += strlen(get_keycode_string(QK_UNICODE + i % size));
+            }
+            fastest = std::min(fastest, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start));
+        }
+        EXPECT_GT(length, 0);
+        return static_cast<double>(fastest.count()) / lookups;
+    };
+
+    const double small_ns = time_per_lookup(64);
+    const double large_ns = time_per_lookup(4096);
+    keycode_string_names_data_user = data_user;
+    keycode_string_names_size_user = size_user;
+
+    // A linear search would take around 64 times longer with the large table, a binary search only twice as many
+    // steps. Only reported, wall clock timings are too noisy to assert on.
+    RecordProperty("ns_per_lookup_64_names", std::to_string(small_ns));
+    RecordProperty("ns_per_lookup_4096_names", std::to_string(large_ns));
+}
@@ -0,0 +1,156 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <functional>
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "keyevent_queue.h"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+
+extern "C" void advance_time(uint32_t ms);
+
+namespace {
+
+std::vector<keyrecord_t>                     records;
+std::function<void(uint16_t, keyrecord_t *)> on_record = nullptr;
+
+extern "C" bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    if (record->event.type == KEY_EVENT) {
+        records.push_back(*record);
+        if (on_record) {
+            on_record(keycode, record);
+        }
+    }
+    return true;
+}
+
+class KeyEventQueue : public TestFixture {
+   public:
+    void SetUp() override {
+        records.clear();
+        on_record = nullptr;
+        keyevent_queue_reset_high_water();
+    }
+};
+
+TEST_F(KeyEventQueue, SimultaneousChangesShareScanTime) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+    auto       key_c = KeymapKey(0, 2, 0, KC_C);
+    set_keymap({key_a, key_b, key_c});
+
+    // A slow handler must not delay the timestamps of the keys processed after it
+    on_record = [](uint16_t keycode, keyrecord_t *record) {
+        if (keycode == KC_A) {
+            advance_time(50);
+        }
+    };
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    key_a.press();
+    key_b.press();
+    key_c.press();
+    run_one_scan_loop();
+
+    ASSERT_EQ(records.size(), 3);
+    EXPECT_EQ(records[1].event.time, records[0].event.time);
+    EXPECT_EQ(records[2].event.time, records[0].event.time);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    key_a.release();
+    key_b.release();
+    key_c.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyEventQueue, ProcessedInMatrixOrder) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 1, 0, KC_A);
+    auto       key_b = KeymapKey(0, 0, 1, KC_B);
+    set_keymap({key_a, key_b});
+
+    key_a.press();
+    key_b.press();
+    EXPECT_REPORT(driver, (key_a.report_code));
+    EXPECT_REPORT(driver, (key_a.report_code, key_b.report_code));
+    run_one_scan_loop();
+    EXPECT_EQ(keyevent_queue_depth(), 0);
+    VERIFY_AND_CLEAR(driver);
+
+    key_a.release();
+    key_b.release();
+    EXPECT_REPORT(driver, (key_b.report_code));
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyEventQueue, OverflowProcessesOldestFirst) {
+    TestDriver             driver;
+    std::vector<KeymapKey> keys;
+    for (uint8_t col = 0; col < KEYEVENT_QUEUE_SIZE + 2; col++) {
+        keys.push_back(KeymapKey(0, col, 0, KC_A + col));
+    }
+    for (auto &key : keys) {
+        add_key(key);
+    }
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    for (auto &key : keys) {
+        key.press();
+    }
+    run_one_scan_loop();
+
+    // Every event is still processed once and in order, even though they did not all fit
+    ASSERT_EQ(records.size(), keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+        EXPECT_EQ(records[i].event.key.col, keys[i].position.col);
+        EXPECT_EQ(records[i].event.time, records[0].event.time);
+    }
+    EXPECT_EQ(keyevent_queue_high_water(), KEYEVENT_QUEUE_SIZE);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    for (auto &key : keys) {
+        key.release();
+    }
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyEventQueue, HighWaterTracksDeepestQueue) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+    set_keymap({key_a, key_b});
+
+    EXPECT_EQ(keyevent_queue_high_water(), 0);
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    key_a.press();
+    key_b.press();
+    run_one_scan_loop();
+    EXPECT_EQ(keyevent_queue_high_water(), 2);
+
+    key_a.release();
+    run_one_scan_loop();
+    EXPECT_EQ(keyevent_queue_high_water(), 2);
+
+    keyevent_queue_reset_high_water();
+    EXPECT_EQ(keyevent_queue_high_water(), 0);
+
+    key_b.release();
+    run_one_scan_loop();
+    EXPECT_EQ(keyevent_queue_high_water(), 1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+} // namespace
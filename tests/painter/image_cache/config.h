@@ -0,0 +1,12 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define QUANTUM_PAINTER_SUPPORTS_256_PALETTE 1
+#define QUANTUM_PAINTER_IMAGE_CACHE_ENABLE 1
+
+// Screen and monochrome surfaces, plus one surface per cached animation frame
+#define SURFACE_NUM_DEVICES (2 + 6)
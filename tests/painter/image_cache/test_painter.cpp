@@ -0,0 +1,154 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// The same tests, built with the image cache enabled
+#include "../test_painter.cpp"
+
+namespace {
+
+constexpr uint16_t ANIMATION_FRAMES = 6;
+constexpr uint16_t FRAME_WIDTH      = 120;
+constexpr uint16_t FRAME_HEIGHT     = 64;
+
+uint16_t frame_buffers[ANIMATION_FRAMES][FRAME_WIDTH * FRAME_HEIGHT];
+
+} // namespace
+
+class PainterImageCache : public Painter {
+   protected:
+    static void SetUpTestCase() {
+        Painter::SetUpTestCase();
+        if (frame_surfaces[0] == NULL) {
+            for (uint16_t i = 0; i < ANIMATION_FRAMES; ++i) {
+                frame_surfaces[i] = qp_make_rgb565_surface(FRAME_WIDTH, FRAME_HEIGHT, frame_buffers[i]);
+            }
+        }
+    }
+
+    void SetUp() override {
+        Painter::SetUp();
+        for (auto frame_surface : frame_surfaces) {
+            ASSERT_TRUE(qp_init(frame_surface, QP_ROTATION_0));
+        }
+    }
+
+    qp_image_cache_stats_t stats(painter_image_handle_t image) {
+        qp_image_cache_stats_t stats;
+        EXPECT_TRUE(qp_image_cache_stats(image, &stats));
+        return stats;
+    }
+
+    static painter_device_t frame_surfaces[ANIMATION_FRAMES];
+};
+
+painter_device_t PainterImageCache::frame_surfaces[ANIMATION_FRAMES] = {NULL};
+
+TEST_F(PainterImageCache, FrameInfoAndPaletteReused) {
+    std::vector<std::vector<uint8_t>> expected;
+    auto                              qgf     = make_moving_square_qgf(FRAME_WIDTH, FRAME_HEIGHT, 4, ANIMATION_FRAMES, expected);
+    auto                              palette = make_palette(4);
+
+    painter_image_handle_t image = qp_load_image_mem(qgf.data());
+    ASSERT_NE(image, nullptr);
+    animate(image, 5, 9, 3 * ANIMATION_FRAMES, [&](uint16_t frame_number) {
+        SCOPED_TRACE(testing::Message() << "frame " << frame_number);
+        expect_image(5, 9, FRAME_WIDTH, FRAME_HEIGHT, palette, expected[frame_number]);
+    });
+
+    // Each frame is only parsed once, and every frame carries an identical palette so it only gets converted once
+    auto s = stats(image);
+    EXPECT_EQ(s.frame_info_misses, ANIMATION_FRAMES);
+    EXPECT_EQ(s.frame_info_hits, 2 * ANIMATION_FRAMES);
+    EXPECT_EQ(s.palette_misses, 1);
+    EXPECT_EQ(s.palette_hits, 3 * ANIMATION_FRAMES - 1);
+    EXPECT_EQ(s.decoded_frame_misses, 0);
+    EXPECT_EQ(s.decoded_frame_hits, 0);
+
+    // Another image in between means the palette has to be converted again
+    auto other = make_qgf(16, 16, 4, IMAGE_COMPRESSED_RLE, make_palette(4), make_noise_image(16, 16, 4));
+    ASSERT_TRUE(draw(other, 200, 200));
+    ASSERT_TRUE(qp_drawimage(surface, 5, 9, image));
+    EXPECT_EQ(stats(image).palette_misses, 2);
+    expect_image(5, 9, FRAME_WIDTH, FRAME_HEIGHT, palette, expected[0]);
+
+    qp_close_image(image);
+}
+
+TEST_F(PainterImageCache, DecodedFramesReused) {
+    std::vector<std::vector<uint8_t>> expected;
+    auto                              qgf     = make_moving_square_qgf(FRAME_WIDTH, FRAME_HEIGHT, 4, ANIMATION_FRAMES, expected);
+    auto                              palette = make_palette(4);
+
+    painter_image_handle_t image = qp_load_image_mem(qgf.data());
+    ASSERT_NE(image, nullptr);
+    ASSERT_TRUE(qp_image_cache_frames(image, frame_surfaces, ANIMATION_FRAMES));
+    animate(image, 17, 3, 3 * ANIMATION_FRAMES, [&](uint16_t frame_number) {
+        SCOPED_TRACE(testing::Message() << "frame " << frame_number);
+        expect_image(17, 3, FRAME_WIDTH, FRAME_HEIGHT, palette, expected[frame_number]);
+    });
+
+    auto s = stats(image);
+    EXPECT_EQ(s.decoded_frame_misses, ANIMATION_FRAMES);
+    EXPECT_EQ(s.decoded_frame_hits, 2 * ANIMATION_FRAMES);
+
+    // Recoloring discards the decoded frames
+    ASSERT_TRUE(qp_drawimage_recolor(surface, 17, 3, image, 10, 20, 30, 40, 50, 60));
+    EXPECT_EQ(stats(image).decoded_frame_misses, ANIMATION_FRAMES + 1);
+    expect_image(17, 3, FRAME_WIDTH, FRAME_HEIGHT, palette, expected[0]);
+
+    qp_close_image(image);
+}
+
+TEST_F(PainterImageCache, FramesOutOfOrderBypassCache) {
+    std::vector<std::vector<uint8_t>> expected;
+    auto                              qgf     = make_moving_square_qgf(FRAME_WIDTH, FRAME_HEIGHT, 4, ANIMATION_FRAMES, expected);
+    auto                              palette = make_palette(4);
+
+    // Fewer surfaces than frames -- the remaining frames are decoded directly to the display every time
+    painter_image_handle_t image = qp_load_image_mem(qgf.data());
+    ASSERT_NE(image, nullptr);
+    ASSERT_TRUE(qp_image_cache_frames(image, frame_surfaces, 2));
+    animate(image, 0, 0, 2 * ANIMATION_FRAMES, [&](uint16_t frame_number) {
+        SCOPED_TRACE(testing::Message() << "frame " << frame_number);
+        expect_image(0, 0, FRAME_WIDTH, FRAME_HEIGHT, palette, expected[frame_number]);
+    });
+
+    auto s = stats(image);
+    EXPECT_EQ(s.decoded_frame_misses, 2);
+    EXPECT_EQ(s.decoded_frame_hits, 2);
+
+    // Surfaces smaller than the image are rejected
+    auto large = make_qgf(FRAME_WIDTH + 1, 4, 4, IMAGE_COMPRESSED_RLE, palette, std::vector<uint8_t>((FRAME_WIDTH + 1) * 4, 1));
+    painter_image_handle_t large_image = qp_load_image_mem(large.data());
+    ASSERT_NE(large_image, nullptr);
+    EXPECT_FALSE(qp_image_cache_frames(large_image, frame_surfaces, 1));
+    qp_close_image(large_image);
+
+    qp_close_image(image);
+}
+
+TEST_F(PainterImageCache, AnimationBenchmark) {
+    // Complete frames of noise, which are the most expensive to decode
+    const int                     loops = 50;
+    std::vector<qgf_test_frame_t> frames(ANIMATION_FRAMES);
+    for (uint16_t n = 0; n < ANIMATION_FRAMES; ++n) {
+        frames[n].indices = make_noise_image(FRAME_WIDTH, FRAME_HEIGHT, 8);
+        frames[n].delay   = frame_delay(n);
+    }
+    auto qgf = make_animated_qgf(FRAME_WIDTH, FRAME_HEIGHT, 8, IMAGE_COMPRESSED_RLE, make_palette(8), frames);
+
+    for (bool cache_frames : {false, true}) {
+        painter_image_handle_t image = qp_load_image_mem(qgf.data());
+        ASSERT_NE(image, nullptr);
+        if (cache_frames) {
+            ASSERT_TRUE(qp_image_cache_frames(image, frame_surfaces, ANIMATION_FRAMES));
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        animate(image, 0, 0, loops * ANIMATION_FRAMES, [](uint16_t) {});
+        auto us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / (loops * ANIMATION_FRAMES);
+        qp_close_image(image);
+
+        std::cout << FRAME_WIDTH << "x" << FRAME_HEIGHT << " 8bpp noise animation, " << (cache_frames ? "decoded frame surfaces" : "frame info and palette cache only") << ": " << us << "us per frame" << std::endl;
+    }
+}
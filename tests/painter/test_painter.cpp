@@ -0,0 +1,387 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "color.h"
+#include "qp.h"
+#include "qgf.h"
+#include "qp_surface.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+void qp_internal_animation_tick(void);
+}
+
+namespace {
+
+constexpr uint16_t SCREEN_WIDTH  = 240;
+constexpr uint16_t SCREEN_HEIGHT = 320;
+
+void append_le(std::vector<uint8_t> &out, uint32_t value, uint8_t bytes) {
+    for (uint8_t i = 0; i < bytes; ++i) {
+        out.push_back((value >> (8 * i)) & 0xFF);
+    }
+}
+
+void append_block_header(std::vector<uint8_t> &out, uint8_t type_id, uint32_t length) {
+    out.push_back(type_id);
+    out.push_back(~type_id);
+    append_le(out, length, 3);
+}
+
+// Mirrors compress_bytes_qmk_rle() in lib/python/qmk/painter.py
+std::vector<uint8_t> rle_encode(const std::vector<uint8_t> &input) {
+    std::vector<uint8_t> output;
+    size_t               n = 0;
+    while (n < input.size()) {
+        size_t repeat = 1;
+        while (n + repeat < input.size() && input[n + repeat] == input[n] && repeat < 127) {
+            ++repeat;
+        }
+        if (repeat >= 2) {
+            output.push_back(repeat);
+            output.push_back(input[n]);
+            n += repeat;
+            continue;
+        }
+
+        size_t literal = 1;
+        while (n + literal < input.size() && literal < 128 && !(n + literal + 1 < input.size() && input[n + literal] == input[n + literal + 1])) {
+            ++literal;
+        }
+        output.push_back(127 + literal);
+        output.insert(output.end(), input.begin() + n, input.begin() + n + literal);
+        n += literal;
+    }
+    return output;
+}
+
+struct qgf_test_frame_t {
+    std::vector<uint8_t> indices; // per-pixel palette indices, covering only the delta region for delta frames
+    uint16_t             delay  = 0;
+    bool                 delta  = false;
+    uint16_t             left   = 0;
+    uint16_t             top    = 0;
+    uint16_t             right  = 0;
+    uint16_t             bottom = 0;
+};
+
+// Builds a palette QGF image, with each frame carrying its own copy of the palette much like `qmk painter-convert-graphics`
+std::vector<uint8_t> make_animated_qgf(uint16_t width, uint16_t height, uint8_t bpp, painter_compression_t compression, const std::vector<qgf_palette_entry_v1_t> &palette, const std::vector<qgf_test_frame_t> &frames) {
+    const uint8_t pixels_per_byte = 8 / bpp;
+    const uint8_t format          = bpp == 1 ? PALETTE_1BPP : bpp == 2 ? PALETTE_2BPP : bpp == 4 ? PALETTE_4BPP : PALETTE_8BPP;
+
+    std::vector<std::vector<uint8_t>> frame_blocks;
+    for (auto &f : frames) {
+        std::vector<uint8_t> data((f.indices.size() + pixels_per_byte - 1) / pixels_per_byte, 0);
+        for (size_t i = 0; i < f.indices.size(); ++i) {
+            data[i / pixels_per_byte] |= f.indices[i] << ((i % pixels_per_byte) * bpp);
+        }
+        if (compression == IMAGE_COMPRESSED_RLE) {
+            data = rle_encode(data);
+        }
+
+        std::vector<uint8_t> frame;
+        append_block_header(frame, QGF_FRAME_DESCRIPTOR_TYPEID, 6);
+        frame.push_back(format);
+        frame.push_back(f.delta ? QGF_FRAME_FLAG_DELTA : 0);
+        frame.push_back(compression);
+        frame.push_back(0);
+        append_le(frame, f.delay, 2);
+        append_block_header(frame, QGF_FRAME_PALETTE_DESCRIPTOR_TYPEID, palette.size() * 3);
+        for (auto &entry : palette) {
+            frame.push_back(entry.h);
+            frame.push_back(entry.s);
+            frame.push_back(entry.v);
+        }
+        if (f.delta) {
+            append_block_header(frame, QGF_FRAME_DELTA_DESCRIPTOR_TYPEID, 8);
+            append_le(frame, f.left, 2);
+            append_le(frame, f.top, 2);
+            append_le(frame, f.right, 2);
+            append_le(frame, f.bottom, 2);
+        }
+        append_block_header(frame, QGF_FRAME_DATA_DESCRIPTOR_TYPEID, data.size());
+        frame.insert(frame.end(), data.begin(), data.end());
+        frame_blocks.push_back(frame);
+    }
+
+    const uint32_t header_size = sizeof(qgf_graphics_descriptor_v1_t) + sizeof(qgf_frame_offsets_v1_t) + frames.size() * sizeof(uint32_t);
+    uint32_t       total_size  = header_size;
+    for (auto &frame : frame_blocks) {
+        total_size += frame.size();
+    }
+
+    std::vector<uint8_t> qgf;
+    append_block_header(qgf, QGF_GRAPHICS_DESCRIPTOR_TYPEID, 18);
+    append_le(qgf, QGF_MAGIC, 3);
+    qgf.push_back(0x01);
+    append_le(qgf, total_size, 4);
+    append_le(qgf, ~total_size, 4);
+    append_le(qgf, width, 2);
+    append_le(qgf, height, 2);
+    append_le(qgf, frames.size(), 2);
+    append_block_header(qgf, QGF_FRAME_OFFSET_DESCRIPTOR_TYPEID, frames.size() * sizeof(uint32_t));
+    uint32_t offset = header_size;
+    for (auto &frame : frame_blocks) {
+        append_le(qgf, offset, 4);
+        offset += frame.size();
+    }
+    for (auto &frame : frame_blocks) {
+        qgf.insert(qgf.end(), frame.begin(), frame.end());
+    }
+    return qgf;
+}
+
+// Builds a single-frame palette QGF image from the supplied per-pixel palette indices
+std::vector<uint8_t> make_qgf(uint16_t width, uint16_t height, uint8_t bpp, painter_compression_t compression, const std::vector<qgf_palette_entry_v1_t> &palette, const std::vector<uint8_t> &indices) {
+    qgf_test_frame_t frame;
+    frame.indices = indices;
+    return make_animated_qgf(width, height, bpp, compression, palette, {frame});
+}
+
+std::vector<qgf_palette_entry_v1_t> make_palette(uint8_t bpp) {
+    std::vector<qgf_palette_entry_v1_t> palette;
+    const uint16_t                      entries = 1 << bpp;
+    for (uint16_t i = 0; i < entries; ++i) {
+        palette.push_back({(uint8_t)(i * 37), (uint8_t)(i & 1 ? 255 : 128), (uint8_t)(255 - i * (256 / entries))});
+    }
+    return palette;
+}
+
+// Mostly solid horizontal bands crossed by thin diagonal lines, much like a typical UI background
+std::vector<uint8_t> make_banded_image(uint16_t width, uint16_t height, uint8_t bpp) {
+    const uint8_t        colors = (1 << bpp) - 1;
+    std::vector<uint8_t> indices(width * height);
+    for (uint16_t y = 0; y < height; ++y) {
+        for (uint16_t x = 0; x < width; ++x) {
+            uint8_t band           = (y / 20) % (colors + 1);
+            indices[y * width + x] = ((x + y) % 60 < 2) ? colors - band : band;
+        }
+    }
+    return indices;
+}
+
+// Pseudo-random pixels, so the RLE stream is mostly literals
+std::vector<uint8_t> make_noise_image(uint16_t width, uint16_t height, uint8_t bpp) {
+    std::vector<uint8_t> indices(width * height);
+    uint32_t             seed = 0x12345678;
+    for (auto &index : indices) {
+        seed  = seed * 1103515245 + 12345;
+        index = (seed >> 16) & ((1 << bpp) - 1);
+    }
+    return indices;
+}
+
+uint16_t expected_rgb565(const qgf_palette_entry_v1_t &entry) {
+    rgb_t    rgb    = hsv_to_rgb_nocie((hsv_t){entry.h, entry.s, entry.v});
+    uint16_t rgb565 = (((uint16_t)rgb.r) >> 3) << 11 | (((uint16_t)rgb.g) >> 2) << 5 | (((uint16_t)rgb.b) >> 3);
+    return __builtin_bswap16(rgb565);
+}
+
+// Each frame is shown for a different amount of time, so that frame delays get checked too
+uint16_t frame_delay(uint16_t frame_number) {
+    return 10 + frame_number;
+}
+
+// Builds an animation of a square moving across a banded background. The first frame is complete, every following
+// frame is a delta covering the square's previous and new positions. Also returns the complete contents of each frame.
+std::vector<uint8_t> make_moving_square_qgf(uint16_t width, uint16_t height, uint8_t bpp, uint16_t frame_count, std::vector<std::vector<uint8_t>> &expected_frames) {
+    const uint16_t size       = height / 2;
+    const uint8_t  square     = (1 << bpp) - 1;
+    auto           background = make_banded_image(width, height, bpp);
+    auto           palette    = make_palette(bpp);
+
+    auto frame_pixels = [&](uint16_t n) {
+        auto pixels = background;
+        for (uint16_t y = 0; y < size; ++y) {
+            for (uint16_t x = 0; x < size; ++x) {
+                pixels[(y + size / 2) * width + (x + n * 3)] = square;
+            }
+        }
+        return pixels;
+    };
+
+    std::vector<qgf_test_frame_t> frames;
+    expected_frames.clear();
+    for (uint16_t n = 0; n < frame_count; ++n) {
+        expected_frames.push_back(frame_pixels(n));
+
+        qgf_test_frame_t frame;
+        frame.delay = frame_delay(n);
+        if (n == 0) {
+            frame.indices = expected_frames[0];
+        } else {
+            frame.delta  = true;
+            frame.left   = (n - 1) * 3;
+            frame.top    = size / 2;
+            frame.right  = n * 3 + size - 1;
+            frame.bottom = size / 2 + size - 1;
+            for (uint16_t y = frame.top; y <= frame.bottom; ++y) {
+                for (uint16_t x = frame.left; x <= frame.right; ++x) {
+                    frame.indices.push_back(expected_frames[n][y * width + x]);
+                }
+            }
+        }
+        frames.push_back(frame);
+    }
+    return make_animated_qgf(width, height, bpp, IMAGE_COMPRESSED_RLE, palette, frames);
+}
+
+uint16_t surface_buffer[SCREEN_WIDTH * SCREEN_HEIGHT];
+uint8_t  mono_buffer[SURFACE_REQUIRED_BUFFER_BYTE_SIZE(64, 32, 1)];
+
+} // namespace
+
+class Painter : public TestFixture {
+   protected:
+    // Surface slots can't be released, so each surface is only created once
+    static void SetUpTestCase() {
+        TestFixture::SetUpTestCase();
+        if (surface == NULL) {
+            surface = qp_make_rgb565_surface(SCREEN_WIDTH, SCREEN_HEIGHT, surface_buffer);
+            mono    = qp_make_mono1bpp_surface(64, 32, mono_buffer);
+        }
+    }
+
+    void SetUp() override {
+        ASSERT_TRUE(qp_init(surface, QP_ROTATION_0));
+        ASSERT_TRUE(qp_init(mono, QP_ROTATION_0));
+    }
+
+    bool draw(const std::vector<uint8_t> &qgf, uint16_t x, uint16_t y) {
+        painter_image_handle_t image = qp_load_image_mem(qgf.data());
+        if (image == NULL) {
+            return false;
+        }
+        bool ret = qp_drawimage(surface, x, y, image);
+        qp_close_image(image);
+        return ret;
+    }
+
+    void expect_image(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const std::vector<qgf_palette_entry_v1_t> &palette, const std::vector<uint8_t> &indices) {
+        for (uint16_t j = 0; j < height; ++j) {
+            for (uint16_t i = 0; i < width; ++i) {
+                ASSERT_EQ(surface_buffer[(y + j) * SCREEN_WIDTH + (x + i)], expected_rgb565(palette[indices[j * width + i]])) << "pixel (" << i << ", " << j << ")";
+            }
+        }
+    }
+
+    // Plays a moving square animation, calling `check` once each frame has been drawn
+    void animate(painter_image_handle_t image, uint16_t x, uint16_t y, uint16_t frames_to_play, std::function<void(uint16_t)> check) {
+        // The animation task only runs once time has moved on from its previous run, but every test restarts the timer
+        static uint32_t animation_time = 0;
+        set_time(animation_time);
+
+        deferred_token token = qp_animate(surface, x, y, image);
+        ASSERT_NE(token, INVALID_DEFERRED_TOKEN);
+        for (uint16_t n = 0; n < frames_to_play; ++n) {
+            if (n > 0) {
+                for (uint16_t ms = 0; ms < frame_delay((n - 1) % image->frame_count); ++ms) {
+                    advance_time(1);
+                    ++animation_time;
+                    qp_internal_animation_tick();
+                }
+            }
+            check(n % image->frame_count);
+        }
+        qp_stop_animation(token);
+    }
+
+    static painter_device_t surface;
+    static painter_device_t mono;
+};
+
+painter_device_t Painter::surface = NULL;
+painter_device_t Painter::mono    = NULL;
+
+TEST_F(Painter, PaletteImagesDecodeCorrectly) {
+    for (uint8_t bpp : {1, 2, 4, 8}) {
+        for (auto compression : {IMAGE_UNCOMPRESSED, IMAGE_COMPRESSED_RLE}) {
+            SCOPED_TRACE(testing::Message() << "bpp " << (int)bpp << ", compression " << (int)compression);
+            // Odd dimensions, so that rows don't line up with byte boundaries
+            const uint16_t width = 37, height = 23;
+            auto           palette = make_palette(bpp);
+
+            auto banded = make_banded_image(width, height, bpp);
+            ASSERT_TRUE(draw(make_qgf(width, height, bpp, compression, palette, banded), 3, 5));
+            expect_image(3, 5, width, height, palette, banded);
+
+            auto noise = make_noise_image(width, height, bpp);
+            ASSERT_TRUE(draw(make_qgf(width, height, bpp, compression, palette, noise), 101, 7));
+            expect_image(101, 7, width, height, palette, noise);
+        }
+    }
+}
+
+TEST_F(Painter, LongRunsSpanPixdataBuffer) {
+    // A solid image larger than the pixdata buffer, so runs are split across transmissions
+    const uint8_t bpp     = 4;
+    auto          palette = make_palette(bpp);
+    auto          solid   = std::vector<uint8_t>(SCREEN_WIDTH * 10, 9);
+    ASSERT_TRUE(draw(make_qgf(SCREEN_WIDTH, 10, bpp, IMAGE_COMPRESSED_RLE, palette, solid), 0, 100));
+    expect_image(0, 100, SCREEN_WIDTH, 10, palette, solid);
+}
+
+TEST_F(Painter, AnimationFramesDecodeCorrectly) {
+    const uint16_t                    width = 120, height = 64;
+    std::vector<std::vector<uint8_t>> expected;
+    auto                              qgf     = make_moving_square_qgf(width, height, 4, 6, expected);
+    auto                              palette = make_palette(4);
+
+    painter_image_handle_t image = qp_load_image_mem(qgf.data());
+    ASSERT_NE(image, nullptr);
+    animate(image, 5, 9, 2 * expected.size(), [&](uint16_t frame_number) {
+        SCOPED_TRACE(testing::Message() << "frame " << frame_number);
+        expect_image(5, 9, width, height, palette, expected[frame_number]);
+    });
+    qp_close_image(image);
+}
+
+TEST_F(Painter, MonochromeSurface) {
+    std::vector<qgf_palette_entry_v1_t> palette = {{0, 0, 0}, {0, 0, 255}};
+    auto                                indices = make_banded_image(50, 20, 1);
+    auto                                qgf     = make_qgf(50, 20, 1, IMAGE_COMPRESSED_RLE, palette, indices);
+    painter_image_handle_t              image   = qp_load_image_mem(qgf.data());
+    ASSERT_NE(image, nullptr);
+    EXPECT_TRUE(qp_drawimage(mono, 7, 3, image));
+    qp_close_image(image);
+
+    for (uint16_t y = 0; y < 20; ++y) {
+        for (uint16_t x = 0; x < 50; ++x) {
+            uint32_t pixel = (y + 3) * 64 + (x + 7);
+            bool     set   = (mono_buffer[pixel / 8] >> (pixel % 8)) & 1;
+            ASSERT_EQ(set, indices[y * 50 + x] == 1) << "pixel (" << x << ", " << y << ")";
+        }
+    }
+}
+
+TEST_F(Painter, FullScreenImageBenchmark) {
+    const int iterations = 50;
+    for (uint8_t bpp : {1, 4, 8}) {
+        auto palette = make_palette(bpp);
+        auto indices = make_banded_image(SCREEN_WIDTH, SCREEN_HEIGHT, bpp);
+        for (auto compression : {IMAGE_UNCOMPRESSED, IMAGE_COMPRESSED_RLE}) {
+            auto qgf = make_qgf(SCREEN_WIDTH, SCREEN_HEIGHT, bpp, compression, palette, indices);
+
+            painter_image_handle_t image = qp_load_image_mem(qgf.data());
+            ASSERT_NE(image, nullptr);
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < iterations; ++i) {
+                ASSERT_TRUE(qp_drawimage(surface, 0, 0, image));
+            }
+            auto us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / iterations;
+            qp_close_image(image);
+
+            std::cout << "Full screen " << SCREEN_WIDTH << "x" << SCREEN_HEIGHT << " " << (int)bpp << "bpp " << (compression == IMAGE_COMPRESSED_RLE ? "RLE" : "uncompressed") << " image: " << us << "us per draw" << std::endl;
+            expect_image(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, palette, indices);
+        }
+    }
+}
@@ -0,0 +1,9 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define POINTING_DEVICE_MOTION_ACCUMULATOR_ENABLE
+#define POINTING_DEVICE_TASK_THROTTLE_MS 4
@@ -0,0 +1,151 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "mouse_report_util.hpp"
+#include "test_common.hpp"
+#include "test_pointing_device_driver.h"
+#include "pointing_device.h"
+
+using testing::_;
+using testing::InSequence;
+
+class PointingAccumulator : public TestFixture {
+   protected:
+    void SetUp() override {
+        TestFixture::SetUp();
+        pd_clear_movement();
+        pointing_device_accumulator_clear();
+        pointing_device_set_motion_scale(POINTING_DEVICE_MOTION_SCALE_DEFAULT);
+    }
+
+    void TearDown() override {
+        pd_clear_movement();
+        pointing_device_accumulator_clear();
+        TestFixture::TearDown();
+    }
+
+    /* Lines up with the report throttle, so that each call to report_interval() ends with a report being due */
+    void sync_to_report() {
+        idle_for(POINTING_DEVICE_TASK_THROTTLE_MS + 1);
+    }
+
+    /* Reads the sensor once per scan, with a report becoming due on the last scan */
+    void report_interval() {
+        idle_for(POINTING_DEVICE_TASK_THROTTLE_MS);
+    }
+};
+
+TEST_F(PointingAccumulator, DefaultScaleIsOne) {
+    EXPECT_EQ(pointing_device_get_motion_scale(), POINTING_DEVICE_MOTION_SCALE_ONE);
+}
+
+TEST_F(PointingAccumulator, ReadsCoalescedIntoOneReport) {
+    TestDriver driver;
+    sync_to_report();
+
+    pd_set_x(10);
+    pd_set_y(-3);
+    idle_for(POINTING_DEVICE_TASK_THROTTLE_MS - 1);
+    VERIFY_AND_CLEAR(driver);
+
+    // Every read since the last report is summed, rather than only the latest one being sent
+    EXPECT_MOUSE_REPORT(driver, (10 * POINTING_DEVICE_TASK_THROTTLE_MS, -3 * POINTING_DEVICE_TASK_THROTTLE_MS, 0, 0, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingAccumulator, SubPixelRemainderKept) {
+    TestDriver driver;
+    sync_to_report();
+    InSequence s;
+
+    // An eighth of a count per read is half a count per report
+    pointing_device_set_motion_scale(POINTING_DEVICE_MOTION_SCALE_ONE / 8);
+    pd_set_x(1);
+    pd_set_y(-1);
+
+    for (int i = 0; i < 3; i++) {
+        EXPECT_NO_MOUSE_REPORT(driver);
+        report_interval();
+        VERIFY_AND_CLEAR(driver);
+
+        EXPECT_MOUSE_REPORT(driver, (1, -1, 0, 0, 0));
+        report_interval();
+        VERIFY_AND_CLEAR(driver);
+    }
+}
+
+TEST_F(PointingAccumulator, FractionalScaleAveragesOut) {
+    TestDriver driver;
+    sync_to_report();
+
+    // Over many reports, a scale of 2/3 has to move the cursor by 2/3 of the distance the sensor moved
+    pointing_device_set_motion_scale(POINTING_DEVICE_MOTION_SCALE_ONE * 2 / 3);
+    pd_set_x(3);
+
+    int reported = 0;
+    EXPECT_CALL(driver, send_mouse_mock(_)).WillRepeatedly([&](report_mouse_t& report) {
+        reported += report.x;
+    });
+    const int intervals = 30;
+    for (int i = 0; i < intervals; i++) {
+        report_interval();
+    }
+    VERIFY_AND_CLEAR(driver);
+
+    const int sensor = 3 * POINTING_DEVICE_TASK_THROTTLE_MS * intervals;
+    EXPECT_NEAR(reported, sensor * (POINTING_DEVICE_MOTION_SCALE_ONE * 2 / 3) / POINTING_DEVICE_MOTION_SCALE_ONE, 1);
+}
+
+TEST_F(PointingAccumulator, OverflowCarriedToNextReport) {
+    TestDriver driver;
+    sync_to_report();
+    InSequence s;
+
+    // 400 counts of x and -200 of v, spread over as many reports as it takes
+    EXPECT_MOUSE_REPORT(driver, (127, 0, 0, -128, 0));
+    EXPECT_MOUSE_REPORT(driver, (127, 0, 0, -72, 0));
+    EXPECT_MOUSE_REPORT(driver, (127, 0, 0, 0, 0));
+    EXPECT_MOUSE_REPORT(driver, (19, 0, 0, 0, 0));
+    pd_set_x(100);
+    pd_set_v(-50);
+    report_interval();
+    pd_clear_movement();
+    for (int i = 0; i < 4; i++) {
+        report_interval();
+    }
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingAccumulator, ClearDiscardsRemainder) {
+    TestDriver driver;
+    sync_to_report();
+
+    pointing_device_set_motion_scale(POINTING_DEVICE_MOTION_SCALE_ONE / 8);
+    pd_set_x(1);
+    EXPECT_NO_MOUSE_REPORT(driver);
+    report_interval();
+    VERIFY_AND_CLEAR(driver);
+
+    // Without the half count carried over, the next interval also stays short of a full count
+    pointing_device_accumulator_clear();
+    EXPECT_NO_MOUSE_REPORT(driver);
+    report_interval();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingAccumulator, ButtonsReportedWithoutMotion) {
+    TestDriver driver;
+    sync_to_report();
+
+    pd_press_button(POINTING_DEVICE_BUTTON1);
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 0, 1));
+    report_interval();
+    VERIFY_AND_CLEAR(driver);
+
+    pd_release_button(POINTING_DEVICE_BUTTON1);
+    EXPECT_EMPTY_MOUSE_REPORT(driver);
+    report_interval();
+    VERIFY_AND_CLEAR(driver);
+}
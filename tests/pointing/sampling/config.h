@@ -0,0 +1,12 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define POINTING_DEVICE_MOTION_ACCUMULATOR_ENABLE
+#define POINTING_DEVICE_SAMPLING_TASK_ENABLE
+#define POINTING_DEVICE_SAMPLING_MOTION_INTERRUPT
+#define POINTING_DEVICE_SAMPLE_QUEUE_SIZE 8
+#define POINTING_DEVICE_TASK_THROTTLE_MS 4
@@ -0,0 +1,203 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <atomic>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "mouse_report_util.hpp"
+#include "test_common.hpp"
+#include "test_pointing_device_driver.h"
+#include "pointing_device.h"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+class PointingSampling : public TestFixture {
+   protected:
+    void SetUp() override {
+        TestFixture::SetUp();
+        pd_clear_movement();
+        pointing_device_sampling_clear();
+        pointing_device_accumulator_clear();
+    }
+
+    void TearDown() override {
+        pd_clear_movement();
+        pointing_device_sampling_clear();
+        pointing_device_accumulator_clear();
+        TestFixture::TearDown();
+    }
+
+    /* Lines up with the report throttle, so that each call to report_interval() ends with a report being due */
+    void sync_to_report() {
+        idle_for(POINTING_DEVICE_TASK_THROTTLE_MS + 1);
+    }
+
+    void report_interval() {
+        idle_for(POINTING_DEVICE_TASK_THROTTLE_MS);
+    }
+
+    /* Sums every report sent to the host */
+    void sum_reports(TestDriver &driver) {
+        EXPECT_CALL(driver, send_mouse_mock(_)).Times(AnyNumber()).WillRepeatedly([this](report_mouse_t &report) {
+            reported.x += report.x;
+            reported.y += report.y;
+            reported.h += report.h;
+            reported.v += report.v;
+        });
+    }
+
+    /* Keeps sampling a still sensor until everything sampled so far has been reported */
+    void drain() {
+        for (int i = 0; i < 1000; i++) {
+            pointing_device_sample();
+            run_one_scan_loop();
+        }
+    }
+
+    struct {
+        int32_t x, y, h, v;
+    } reported = {};
+};
+
+TEST_F(PointingSampling, SensorOnlyReadBySamplingContext) {
+    TestDriver driver;
+    sync_to_report();
+
+    // Without a motion interrupt the main loop does not read the sensor, so it never sees the motion
+    pd_set_x(10);
+    EXPECT_NO_MOUSE_REPORT(driver);
+    report_interval();
+    VERIFY_AND_CLEAR(driver);
+
+    pointing_device_sample();
+    pointing_device_sample();
+    EXPECT_MOUSE_REPORT(driver, (20, 0, 0, 0, 0));
+    report_interval();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingSampling, MotionInterruptDefersReadToMainLoop) {
+    TestDriver driver;
+    sync_to_report();
+
+    pd_set_x(10);
+    EXPECT_NO_MOUSE_REPORT(driver);
+    report_interval();
+    VERIFY_AND_CLEAR(driver);
+
+    // The interrupt only flags the motion, the sensor is read once the main loop gets to it
+    pointing_device_sampling_motion_isr();
+    report_mouse_t sample;
+    EXPECT_FALSE(pointing_device_sampling_take(&sample));
+
+    EXPECT_MOUSE_REPORT(driver, (10, 0, 0, 0, 0));
+    report_interval();
+    VERIFY_AND_CLEAR(driver);
+
+    // Read once per interrupt, as there is no motion pin to say whether there is more
+    EXPECT_NO_MOUSE_REPORT(driver);
+    report_interval();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingSampling, MotionInterruptReadsAgainUntilQueued) {
+    TestDriver driver;
+    sync_to_report();
+    sum_reports(driver);
+
+    // More motion than the queue holds, left on the sampling side by a main loop which stalled
+    const int samples = 100;
+    pd_set_x(100);
+    for (int i = 0; i < samples; i++) {
+        pointing_device_sample();
+    }
+    pd_clear_movement();
+
+    // A single interrupt is enough to have the main loop carry on until everything is queued
+    pointing_device_sampling_motion_isr();
+    for (int i = 0; i < 1000; i++) {
+        run_one_scan_loop();
+    }
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(reported.x, 100 * samples);
+}
+
+TEST_F(PointingSampling, SamplesReportedInOrder) {
+    TestDriver driver;
+    InSequence s;
+    sync_to_report();
+
+    pd_set_x(10);
+    pointing_device_sample();
+    pd_press_button(POINTING_DEVICE_BUTTON1);
+    pd_set_x(0);
+    pd_set_y(-5);
+    pointing_device_sample();
+    EXPECT_MOUSE_REPORT(driver, (10, -5, 0, 0, 1));
+    report_interval();
+    VERIFY_AND_CLEAR(driver);
+
+    pd_release_button(POINTING_DEVICE_BUTTON1);
+    pd_clear_movement();
+    pointing_device_sample();
+    EXPECT_EMPTY_MOUSE_REPORT(driver);
+    report_interval();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingSampling, NoMotionLostWhenQueueFull) {
+    TestDriver driver;
+    sync_to_report();
+    sum_reports(driver);
+
+    // A main loop stalled for a thousand sensor reads, far more than the queue or a single report can hold
+    const int samples = 1000;
+    pd_set_x(3);
+    pd_set_y(-2);
+    pd_set_v(1);
+    for (int i = 0; i < samples; i++) {
+        pointing_device_sample();
+    }
+    pd_clear_movement();
+
+    drain();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(reported.x, 3 * samples);
+    EXPECT_EQ(reported.y, -2 * samples);
+    EXPECT_EQ(reported.h, 0);
+    EXPECT_EQ(reported.v, samples);
+}
+
+TEST_F(PointingSampling, NoMotionLostUnderMainLoopLoad) {
+    TestDriver driver;
+    sync_to_report();
+    sum_reports(driver);
+
+    // Sample from another thread while the main loop runs, with the main loop occasionally stalling
+    const int         samples = 20000;
+    std::atomic<bool> done{false};
+    pd_set_x(1);
+    pd_set_h(-1);
+    std::thread sampler([&]() {
+        for (int i = 0; i < samples; i++) {
+            pointing_device_sample();
+        }
+        done = true;
+    });
+    for (int loop = 0; !done; loop++) {
+        run_one_scan_loop();
+        if (loop % 16 == 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+    sampler.join();
+    pd_clear_movement();
+
+    drain();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(reported.x, samples);
+    EXPECT_EQ(reported.h, -samples);
+}
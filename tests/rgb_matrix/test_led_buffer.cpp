@@ -0,0 +1,144 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+}
+
+namespace {
+
+struct {
+    rgb_t    colors[RGB_MATRIX_LED_COUNT];
+    uint32_t set_color_calls;
+    uint32_t flushes;
+} pushed;
+
+bool    indicator_enabled = false;
+uint8_t indicator_led     = 3;
+
+void driver_init(void) {}
+
+void driver_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    ASSERT_GE(index, 0);
+    ASSERT_LT(index, RGB_MATRIX_LED_COUNT);
+    pushed.colors[index] = {.r = r, .g = g, .b = b};
+    pushed.set_color_calls++;
+}
+
+void driver_set_color_all(uint8_t r, uint8_t g, uint8_t b) {
+    for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        driver_set_color(i, r, g, b);
+    }
+}
+
+void driver_flush(void) {
+    pushed.flushes++;
+}
+
+} // namespace
+
+extern "C" {
+const rgb_matrix_driver_t rgb_matrix_driver = {driver_init, driver_set_color, driver_set_color_all, driver_flush};
+
+led_config_t g_led_config = {
+    {},
+    {{0, 0}, {20, 0}, {40, 0}, {60, 0}, {80, 0}, {100, 0}, {120, 0}, {140, 0}, {160, 0}, {180, 0}, {200, 0}, {220, 0}},
+    {4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4},
+};
+
+bool rgb_matrix_indicators_user(void) {
+    if (indicator_enabled) {
+        rgb_matrix_set_color(indicator_led, RGB_RED);
+    }
+    return true;
+}
+}
+
+class RgbMatrixLedBuffer : public TestFixture {
+   protected:
+    void SetUp() override {
+        TestFixture::SetUp();
+        indicator_enabled = false;
+        rgb_matrix_enable_noeeprom();
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+        rgb_matrix_sethsv_noeeprom(HSV_BLUE);
+        settle();
+        base = hsv_to_rgb(rgb_matrix_get_hsv());
+    }
+
+    /* Runs for long enough to render and flush a few complete frames */
+    void settle() {
+        idle_for(RGB_MATRIX_LED_FLUSH_LIMIT * 4);
+    }
+
+    void reset_counts() {
+        pushed.set_color_calls = 0;
+        pushed.flushes         = 0;
+    }
+
+    void expect_color(uint8_t index, rgb_t expected) {
+        EXPECT_EQ(pushed.colors[index].r, expected.r) << "LED " << +index;
+        EXPECT_EQ(pushed.colors[index].g, expected.g) << "LED " << +index;
+        EXPECT_EQ(pushed.colors[index].b, expected.b) << "LED " << +index;
+    }
+
+    TestDriver driver;
+    rgb_t      base;
+};
+
+TEST_F(RgbMatrixLedBuffer, UnchangedFramesPushNothing) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        expect_color(i, base);
+    }
+
+    reset_counts();
+    settle();
+    EXPECT_GT(pushed.flushes, 0);
+    EXPECT_EQ(pushed.set_color_calls, 0);
+}
+
+TEST_F(RgbMatrixLedBuffer, ChangedColourPushesEveryLedOnce) {
+    reset_counts();
+    rgb_matrix_sethsv_noeeprom(HSV_GREEN);
+    settle();
+    EXPECT_EQ(pushed.set_color_calls, RGB_MATRIX_LED_COUNT);
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        expect_color(i, hsv_to_rgb(rgb_matrix_get_hsv()));
+    }
+}
+
+TEST_F(RgbMatrixLedBuffer, RemovedIndicatorRestoresBaseColour) {
+    reset_counts();
+    indicator_enabled = true;
+    settle();
+    EXPECT_EQ(pushed.set_color_calls, 1);
+    expect_color(indicator_led, {.r = 0xFF, .g = 0x00, .b = 0x00});
+
+    // An indicator that stays put is not pushed again
+    reset_counts();
+    settle();
+    EXPECT_EQ(pushed.set_color_calls, 0);
+
+    reset_counts();
+    indicator_enabled = false;
+    settle();
+    EXPECT_EQ(pushed.set_color_calls, 1);
+    expect_color(indicator_led, base);
+}
+
+TEST_F(RgbMatrixLedBuffer, ExternalSetColorForcesRender) {
+    reset_counts();
+    rgb_matrix_set_color(5, RGB_WHITE);
+    settle();
+
+    // The effect rendered again over the external colour, rather than skipping the unchanged frame
+    expect_color(5, base);
+    EXPECT_LE(pushed.set_color_calls, 1);
+
+    reset_counts();
+    settle();
+    EXPECT_EQ(pushed.set_color_calls, 0);
+}
@@ -0,0 +1,10 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define SOURCE_LAYERS_CACHE_BITPLANE
+#define LAYER_STATE_8BIT
+#define MAX_LAYER 4
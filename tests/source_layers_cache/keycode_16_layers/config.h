@@ -0,0 +1,10 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define SOURCE_LAYERS_CACHE_BYTE
+#define SOURCE_LAYERS_CACHE_KEYCODE
+#define LAYER_STATE_16BIT
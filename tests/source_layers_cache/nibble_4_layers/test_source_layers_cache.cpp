@@ -0,0 +1,5 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// The same tests, built against the cache configuration in this directory
+#include "../test_source_layers_cache.cpp"
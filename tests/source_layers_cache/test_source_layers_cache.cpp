@@ -0,0 +1,160 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+
+#define TOP_LAYER (MAX_LAYER - 1)
+
+#if defined(SOURCE_LAYERS_CACHE_BITPLANE)
+#    define CACHE_LAYOUT "bitplane"
+#    define CACHE_BYTES ((((MATRIX_ROWS * MATRIX_COLS) + 7) / 8) * MAX_LAYER_BITS)
+#elif defined(SOURCE_LAYERS_CACHE_NIBBLE)
+#    define CACHE_LAYOUT "nibble"
+#    define CACHE_BYTES (((MATRIX_ROWS * MATRIX_COLS) + 1) / 2)
+#else
+#    define CACHE_LAYOUT "byte"
+#    define CACHE_BYTES (MATRIX_ROWS * MATRIX_COLS)
+#endif
+
+#ifdef SOURCE_LAYERS_CACHE_KEYCODE
+#    define KEYCODE_CACHE_BYTES (MATRIX_ROWS * MATRIX_COLS * 2)
+#else
+#    define KEYCODE_CACHE_BYTES 0
+#endif
+
+class SourceLayersCache : public TestFixture {
+   protected:
+    // Updating the cache may resolve the keycode of any position on any layer, each layer has its own keycode
+    void map_every_key() {
+        for (uint8_t layer = 0; layer < MAX_LAYER; layer++) {
+            for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+                for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                    add_key(KeymapKey(layer, col, row, KC_A + layer));
+                }
+            }
+        }
+    }
+};
+
+TEST_F(SourceLayersCache, EveryLayerRoundTripsForEveryKey) {
+    map_every_key();
+
+    // Fill every entry with a distinct layer, so a write spilling into a neighbouring entry shows up on read back.
+    for (uint8_t layer = 0; layer < MAX_LAYER; layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                update_source_layers_cache({.col = col, .row = row}, (layer + row * MATRIX_COLS + col) % MAX_LAYER);
+            }
+        }
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                EXPECT_EQ(read_source_layers_cache({.col = col, .row = row}), (layer + row * MATRIX_COLS + col) % MAX_LAYER);
+            }
+        }
+    }
+}
+
+TEST_F(SourceLayersCache, ReleaseResolvesToTheLayerOfThePress) {
+    TestDriver driver;
+    KeymapKey  base_key = KeymapKey(0, 3, 2, KC_A);
+    KeymapKey  top_key  = KeymapKey(TOP_LAYER, 3, 2, KC_B);
+
+    set_keymap({base_key, top_key});
+
+    layer_on(TOP_LAYER);
+
+    EXPECT_REPORT(driver, (KC_B));
+    top_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(read_source_layers_cache(top_key.position), TOP_LAYER);
+
+    layer_off(TOP_LAYER);
+
+    EXPECT_EMPTY_REPORT(driver);
+    base_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+#ifdef SOURCE_LAYERS_CACHE_KEYCODE
+TEST_F(SourceLayersCache, KeycodeIsCachedOnPress) {
+    TestDriver driver;
+    KeymapKey  base_key = KeymapKey(0, 1, 1, KC_A);
+    KeymapKey  top_key  = KeymapKey(TOP_LAYER, 1, 1, KC_B);
+    uint16_t   keycode  = KC_NO;
+
+    set_keymap({base_key, top_key});
+
+    // Positions outside the matrix have no cache entry
+    EXPECT_FALSE(read_source_keycode_cache({.col = 0, .row = KEYLOC_DIP_SWITCH_ON}, &keycode));
+
+    layer_on(TOP_LAYER);
+    EXPECT_REPORT(driver, (KC_B));
+    top_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_TRUE(read_source_keycode_cache(top_key.position, &keycode));
+    EXPECT_EQ(keycode, KC_B);
+
+    layer_off(TOP_LAYER);
+    EXPECT_EMPTY_REPORT(driver);
+    top_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+#endif
+
+TEST_F(SourceLayersCache, ReleaseTimings) {
+    constexpr int iterations = 100000;
+
+    map_every_key();
+
+    // Fastest of several runs resolving the keycode of a release, as process_record_quantum() does several times per event
+    auto release_ns = [](keyevent_t release, uint16_t &keycode) {
+        auto fastest = std::chrono::nanoseconds::max();
+        for (int run = 0; run < 5; run++) {
+            const auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < iterations; i++) {
+                keycode = get_event_keycode(release, false);
+            }
+            fastest = std::min(fastest, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start));
+        }
+        return static_cast<double>(fastest.count()) / iterations;
+    };
+
+    keyevent_t release = {};
+    release.key        = {.col = 0, .row = 0};
+    release.type       = KEY_EVENT;
+    release.pressed    = true;
+    layer_on(TOP_LAYER);
+    get_event_keycode(release, true);
+    layer_off(TOP_LAYER);
+    release.pressed = false;
+
+    // The cached release still resolves to the layer of the press, the lookup to the layer that is now active
+    uint16_t     cached_keycode = KC_NO;
+    uint16_t     lookup_keycode = KC_NO;
+    const double cached_ns      = release_ns(release, cached_keycode);
+    disable_action_cache        = true;
+    const double lookup_ns      = release_ns(release, lookup_keycode);
+    disable_action_cache        = false;
+    EXPECT_EQ(cached_keycode, KC_A + TOP_LAYER);
+    EXPECT_EQ(lookup_keycode, KC_A);
+
+    // A hit should be cheaper than searching the layers for the key, only reported as wall clock timings are too noisy
+    // to assert on
+    RecordProperty("layout", CACHE_LAYOUT);
+    RecordProperty("ram_bytes", CACHE_BYTES + KEYCODE_CACHE_BYTES);
+    RecordProperty("ns_per_cached_release", std::to_string(cached_ns));
+    RecordProperty("ns_per_uncached_release", std::to_string(lookup_ns));
+}
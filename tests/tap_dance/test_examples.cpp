@@ -56,6 +56,30 @@ TEST_F(TapDance, DoubleTap) {
     run_one_scan_loop();
 }
 
+TEST_F(TapDance, StateOnlyWhileInProgress) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_esc_caps = KeymapKey{0, 1, 0, TD(TD_ESC_CAPS)};
+
+    set_keymap({key_esc_caps});
+
+    EXPECT_EQ(tap_dance_get_state(TD_ESC_CAPS), nullptr);
+
+    /* The state is tracked from the first tap */
+    tap_key(key_esc_caps);
+    EXPECT_NO_REPORT(driver);
+    tap_dance_state_t *state = tap_dance_get_state(TD_ESC_CAPS);
+    ASSERT_NE(state, nullptr);
+    EXPECT_EQ(state->count, 1);
+    EXPECT_EQ(TAP_DANCE_KEYCODE(state), TD(TD_ESC_CAPS));
+
+    /* And released once the dance is reset */
+    EXPECT_REPORT(driver, (KC_ESC));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(TAPPING_TERM + 1);
+    EXPECT_EQ(tap_dance_get_state(TD_ESC_CAPS), nullptr);
+}
+
 TEST_F(TapDance, DoubleTapWithMod) {
     TestDriver driver;
     InSequence s;
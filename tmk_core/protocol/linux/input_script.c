@@ -0,0 +1,123 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "input_script.h"
+#include "keyswitch.h"
+#include "timer.h"
+#include "usb_device_state.h"
+
+#ifndef INPUT_SCRIPT_LINE_LENGTH
+#    define INPUT_SCRIPT_LINE_LENGTH 128
+#endif
+
+static int      script_fd = -1;
+static char     received[256];
+static size_t   received_start = 0;
+static size_t   received_end   = 0;
+static char     line[INPUT_SCRIPT_LINE_LENGTH + 1];
+static size_t   line_length = 0;
+static uint32_t line_number = 0;
+static bool     waiting     = false;
+static uint32_t wait_until  = 0;
+
+bool input_script_init(void) {
+    const char *path = getenv("QMK_INPUT_SCRIPT");
+    script_fd        = path != NULL ? open(path, O_RDONLY) : STDIN_FILENO;
+    return script_fd >= 0;
+}
+
+/**
+ * @brief Completes the next line from what has been received so far, reading more only if it is already there
+ *
+ * @return true once a line is complete, overlong lines are cut short
+ */
+static bool read_line(void) {
+    while (true) {
+        while (received_start < received_end) {
+            char c = received[received_start++];
+            if (c == '\n') {
+                line[line_length] = '\0';
+                line_length       = 0;
+                return true;
+            }
+            if (line_length < INPUT_SCRIPT_LINE_LENGTH) {
+                line[line_length++] = c;
+            }
+        }
+
+        struct pollfd fds = {.fd = script_fd, .events = POLLIN};
+        if (poll(&fds, 1, 0) <= 0) {
+            return false;
+        }
+
+        ssize_t size = read(script_fd, received, sizeof(received));
+        if (size <= 0) {
+            // The end of the script, a last line without a newline still runs
+            script_fd         = -1;
+            line[line_length] = '\0';
+            bool complete     = line_length > 0;
+            line_length       = 0;
+            return complete;
+        }
+        received_start = 0;
+        received_end   = size;
+    }
+}
+
+static void run_line(char *text) {
+    line_number++;
+
+    char *comment = strchr(text, '#');
+    if (comment != NULL) {
+        *comment = '\0';
+    }
+
+    char command[16];
+    long args[2];
+    int  fields = sscanf(text, "%15s %li %li", command, &args[0], &args[1]);
+    if (fields <= 0) {
+        return;
+    }
+
+    bool valid = false;
+    if (strcmp(command, "press") == 0 || strcmp(command, "release") == 0) {
+        valid = fields == 3 && args[0] >= 0 && args[0] <= UINT8_MAX && args[1] >= 0 && args[1] <= UINT8_MAX && keyswitch_set(args[0], args[1], command[0] == 'p');
+    } else if (strcmp(command, "wait") == 0) {
+        valid = fields == 2 && args[0] >= 0;
+        if (valid) {
+            waiting    = true;
+            wait_until = timer_read32() + args[0];
+        }
+    } else if (strcmp(command, "leds") == 0) {
+        valid = fields == 2 && args[0] >= 0 && args[0] <= UINT8_MAX;
+        if (valid) {
+            usb_device_state_set_leds(args[0]);
+        }
+    } else if (strcmp(command, "exit") == 0) {
+        exit(EXIT_SUCCESS);
+    }
+
+    if (!valid) {
+        fprintf(stderr, "input script line %lu: cannot run '%s'\n", (unsigned long)line_number, text);
+    }
+}
+
+void input_script_task(void) {
+    if (waiting) {
+        if (!timer_expired32(timer_read32(), wait_until)) {
+            return;
+        }
+        waiting = false;
+    }
+
+    while (!waiting && script_fd >= 0 && read_line()) {
+        run_line(line);
+    }
+}
@@ -0,0 +1,31 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+
+/*
+  Scripted input for the host build, read line by line from the file named by QMK_INPUT_SCRIPT or from stdin:
+
+    press <row> <col>     presses a switch of this half's matrix
+    release <row> <col>   releases it again
+    wait <ms>             waits before running the next line, while the firmware keeps running
+    leds <bits>           sets the host's lock LED state, e.g. 2 for caps lock
+    exit                  ends the process
+
+  Blank lines and anything after a # are ignored. The firmware keeps running once the script has been read to its
+  end, a script has to end with exit for the process to end by itself.
+*/
+
+/**
+ * @brief Opens the script
+ *
+ * @return false if the file named by QMK_INPUT_SCRIPT cannot be opened
+ */
+bool input_script_init(void);
+
+/**
+ * @brief Runs the lines of the script that are due, without blocking on lines that have yet to arrive
+ */
+void input_script_task(void);
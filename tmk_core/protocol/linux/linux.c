@@ -0,0 +1,208 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "report.h"
+#include "host.h"
+#include "host_driver.h"
+#include "usb_device_state.h"
+#include "usb_util.h"
+#include "sendchar.h"
+#include "input_script.h"
+
+/*
+  Stands in for USB on the host build. Configuration comes from the environment:
+
+    QMK_HID_OUTPUT    file or FIFO to write the reports sent to the host to, stdout by default
+    QMK_INPUT_SCRIPT  script to read matrix input from, stdin by default, see input_script.h
+    QMK_SPLIT_ROLE    "slave" to run as the half that is not connected to the host
+    QMK_SCAN_RATE     loop iterations per second to pace the main loop to, unpaced by default
+
+  Every report is written as a line of its type followed by its bytes in hex, e.g.
+
+    keyboard 00 00 04 00 00 00 00 00
+*/
+
+static FILE    *hid_output    = NULL;
+static bool     is_slave      = false;
+static uint64_t scan_interval = 0; // ns
+static uint64_t next_scan     = 0;
+
+static void send_report(const char *type, const void *report, size_t size) {
+    if (hid_output == NULL) {
+        return;
+    }
+
+    const uint8_t *data = report;
+    fputs(type, hid_output);
+    for (size_t i = 0; i < size; i++) {
+        fprintf(hid_output, " %02X", data[i]);
+    }
+    fputc('\n', hid_output);
+    fflush(hid_output);
+}
+
+/* -------------------------
+ *   TMK host driver defs
+ * -------------------------
+ */
+
+static void send_keyboard(report_keyboard_t *report);
+static void send_nkro(report_nkro_t *report);
+static void send_mouse(report_mouse_t *report);
+static void send_extra(report_extra_t *report);
+#ifdef RAW_ENABLE
+static void send_raw_hid(uint8_t *data, uint8_t length);
+#endif
+
+static host_driver_t linux_driver = {
+    .keyboard_leds = usb_device_state_get_leds,
+    .send_keyboard = send_keyboard,
+    .send_nkro     = send_nkro,
+    .send_mouse    = send_mouse,
+    .send_extra    = send_extra,
+#ifdef RAW_ENABLE
+    .send_raw_hid = send_raw_hid,
+#endif
+};
+
+static void send_keyboard(report_keyboard_t *report) {
+    if (usb_device_state_get_protocol() == USB_PROTOCOL_BOOT) {
+        send_report("keyboard", &report->mods, 8);
+    } else {
+        send_report("keyboard", report, sizeof(report_keyboard_t));
+    }
+}
+
+static void send_nkro(report_nkro_t *report) {
+    send_report("nkro", report, sizeof(report_nkro_t));
+}
+
+static void send_mouse(report_mouse_t *report) {
+    send_report("mouse", report, sizeof(report_mouse_t));
+}
+
+static void send_extra(report_extra_t *report) {
+    send_report("extra", report, sizeof(report_extra_t));
+}
+
+void send_joystick(report_joystick_t *report) {
+#ifdef JOYSTICK_ENABLE
+    send_report("joystick", report, sizeof(report_joystick_t));
+#endif
+}
+
+void send_digitizer(report_digitizer_t *report) {
+#ifdef DIGITIZER_ENABLE
+    send_report("digitizer", report, sizeof(report_digitizer_t));
+#endif
+}
+
+void send_programmable_button(report_programmable_button_t *report) {
+#ifdef PROGRAMMABLE_BUTTON_ENABLE
+    send_report("programmable_button", report, sizeof(report_programmable_button_t));
+#endif
+}
+
+#ifdef RAW_ENABLE
+static void send_raw_hid(uint8_t *data, uint8_t length) {
+    send_report("raw", data, length);
+}
+
+void raw_hid_task(void) {}
+#endif
+
+#ifdef CONSOLE_ENABLE
+int8_t sendchar(uint8_t c) {
+    fputc(c, stderr);
+    return 0;
+}
+
+void console_task(void) {}
+#endif
+
+/* -------------------------
+ *   Split master detection
+ * -------------------------
+ */
+
+bool usb_connected_state(void) {
+    return !is_slave;
+}
+
+bool usb_vbus_state(void) {
+    return !is_slave;
+}
+
+/* -------------------------
+ *   Protocol hooks
+ * -------------------------
+ */
+
+static uint64_t monotonic_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+void protocol_setup(void) {
+    usb_device_state_init();
+
+    const char *role = getenv("QMK_SPLIT_ROLE");
+    is_slave         = role != NULL && strcmp(role, "slave") == 0;
+
+    const char *scan_rate = getenv("QMK_SCAN_RATE");
+    if (scan_rate != NULL && atol(scan_rate) > 0) {
+        scan_interval = 1000000000 / atol(scan_rate);
+    }
+}
+
+void protocol_pre_init(void) {
+    const char *path = getenv("QMK_HID_OUTPUT");
+    hid_output       = path != NULL ? fopen(path, "w") : stdout;
+    if (hid_output == NULL) {
+        perror("QMK_HID_OUTPUT");
+    }
+
+    if (!input_script_init()) {
+        perror("QMK_INPUT_SCRIPT");
+    }
+
+    if (!is_slave) {
+        usb_device_state_set_configuration(true, 1);
+    }
+}
+
+void protocol_post_init(void) {
+    host_set_driver(&linux_driver);
+    next_scan = monotonic_ns();
+}
+
+void protocol_pre_task(void) {
+    input_script_task();
+}
+
+void protocol_post_task(void) {
+    if (scan_interval == 0) {
+        return;
+    }
+
+    // Pace to absolute deadlines so that time spent in the firmware does not add up to a lower rate, unless the
+    // firmware has fallen behind entirely
+    uint64_t now = monotonic_ns();
+    next_scan += scan_interval;
+    if (next_scan <= now) {
+        next_scan = now;
+        return;
+    }
+
+    struct timespec deadline = {
+        .tv_sec  = next_scan / 1000000000,
+        .tv_nsec = next_scan % 1000000000,
+    };
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL);
+}
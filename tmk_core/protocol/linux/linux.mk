@@ -0,0 +1,10 @@
+LINUX_DIR = protocol/linux
+
+SRC += \
+	$(LINUX_DIR)/linux.c \
+	$(LINUX_DIR)/input_script.c
+
+# Search Path
+VPATH += $(TMK_PATH)/$(LINUX_DIR)
+
+OPT_DEFS += -DPROTOCOL_LINUX
@@ -23,62 +23,70 @@
 #include "util.h"
 #include <string.h>
 
+/* Every key that is down, as a bitmap of usages, whichever report format is in use. The keyboard and NKRO reports are
+ * only generated from it when they are sent, so switching between the two doesn't need any conversion.
+ */
+static uint8_t key_bits[32];
+static uint8_t key_count = 0;
+
+/* The keys that make up the 6KRO report, in the order they were pressed. Keys pressed while it is full are left out
+ * until one of these is released.
+ */
+static uint8_t key_order[KEYBOARD_REPORT_KEYS];
+static uint8_t key_order_count = 0;
+
+static inline bool key_bit_is_set(uint8_t key) {
+    return key_bits[key >> 3] & (1 << (key & 7));
+}
+
+static inline bool nkro_is_active(void) {
+#ifdef NKRO_ENABLE
+    return host_can_send_nkro() && keymap_config.nkro;
+#else
+    return false;
+#endif
+}
+
 /** \brief has_anykey
  *
- * FIXME: Needs doc
+ * Returns the number of keys that are down, not counting modifiers
  */
 uint8_t has_anykey(void) {
-    uint8_t  cnt = 0;
-    uint8_t* p   = keyboard_report->keys;
-    uint8_t  lp  = sizeof(keyboard_report->keys);
-#ifdef NKRO_ENABLE
-    if (host_can_send_nkro() && keymap_config.nkro) {
-        p  = nkro_report->bits;
-        lp = sizeof(nkro_report->bits);
-    }
-#endif
-    while (lp--) {
-        if (*p++) cnt++;
-    }
-    return cnt;
+    return key_count;
 }
 
 /** \brief get_first_key
  *
- * FIXME: Needs doc
+ * Returns the first key that is down: the earliest pressed one for 6KRO, the lowest usage for NKRO
  */
 uint8_t get_first_key(void) {
-#ifdef NKRO_ENABLE
-    if (host_can_send_nkro() && keymap_config.nkro) {
+    if (!key_count) {
+        return KC_NO;
+    }
+    if (nkro_is_active()) {
         uint8_t i = 0;
-        for (; i < NKRO_REPORT_BITS && !nkro_report->bits[i]; i++)
+        for (; i < sizeof(key_bits) - 1 && !key_bits[i]; i++)
             ;
-        return i << 3 | biton(nkro_report->bits[i]);
+        return i << 3 | biton(key_bits[i]);
     }
-#endif
-    return keyboard_report->keys[0];
+    return key_order_count ? key_order[0] : KC_NO;
 }
 
 /** \brief Checks if a key is pressed in the report
  *
- * Returns true if the keyboard_report reports that the key is pressed, otherwise false
+ * Returns true if the key is down and part of the report that is sent, otherwise false
  * Note: The function doesn't support modifers currently, and it returns false for KC_NO
  */
 bool is_key_pressed(uint8_t key) {
-    if (key == KC_NO) {
+    if (key == KC_NO || !key_bit_is_set(key)) {
         return false;
     }
-#ifdef NKRO_ENABLE
-    if (host_can_send_nkro() && keymap_config.nkro) {
-        if ((key >> 3) < NKRO_REPORT_BITS) {
-            return nkro_report->bits[key >> 3] & 1 << (key & 7);
-        } else {
-            return false;
-        }
+    if (nkro_is_active() || key_count <= KEYBOARD_REPORT_KEYS) {
+        return true;
     }
-#endif
-    for (int i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
-        if (keyboard_report->keys[i] == key) {
+    // Some keys are left out of the 6KRO report
+    for (uint8_t i = 0; i < key_order_count; i++) {
+        if (key_order[i] == key) {
             return true;
         }
     }
@@ -147,46 +155,79 @@ void del_key_bit(report_nkro_t* nkro_report, uint8_t code) {
 
 /** \brief add key to report
  *
- * FIXME: Needs doc
+ * Marks a key as down, it is in the report from the next time it is sent
  */
 void add_key_to_report(uint8_t key) {
-#ifdef NKRO_ENABLE
-    if (host_can_send_nkro() && keymap_config.nkro) {
-        add_key_bit(nkro_report, key);
+    if (key_bit_is_set(key)) {
         return;
     }
-#endif
-    add_key_byte(keyboard_report, key);
+    key_bits[key >> 3] |= 1 << (key & 7);
+    key_count++;
+    if (key_order_count < KEYBOARD_REPORT_KEYS) {
+        key_order[key_order_count++] = key;
+    }
 }
 
 /** \brief del key from report
  *
- * FIXME: Needs doc
+ * Marks a key as up, it is left out of the report from the next time it is sent
  */
 void del_key_from_report(uint8_t key) {
-#ifdef NKRO_ENABLE
-    if (host_can_send_nkro() && keymap_config.nkro) {
-        del_key_bit(nkro_report, key);
+    if (!key_bit_is_set(key)) {
         return;
     }
-#endif
-    del_key_byte(keyboard_report, key);
+    key_bits[key >> 3] &= ~(1 << (key & 7));
+    key_count--;
+
+    uint8_t i = 0;
+    for (; i < key_order_count && key_order[i] != key; i++)
+        ;
+    if (i == key_order_count) {
+        return;
+    }
+    memmove(&key_order[i], &key_order[i + 1], key_order_count - i - 1);
+    key_order_count--;
+
+    // Roll over to a key that was left out of the 6KRO report
+    if (key_count > key_order_count) {
+        for (uint16_t code = 0; code < sizeof(key_bits) * 8; code++) {
+            if (!key_bit_is_set(code)) {
+                continue;
+            }
+            for (i = 0; i < key_order_count && key_order[i] != code; i++)
+                ;
+            if (i == key_order_count) {
+                key_order[key_order_count++] = code;
+                break;
+            }
+        }
+    }
 }
 
 /** \brief clear key from report
  *
- * FIXME: Needs doc
+ * Marks all keys as up, not the modifiers
  */
 void clear_keys_from_report(void) {
-    // not clear mods
+    memset(key_bits, 0, sizeof(key_bits));
+    key_count       = 0;
+    key_order_count = 0;
+}
+
+/** \brief Fills in the keys of a 6KRO report from the keys that are down
+ */
+void generate_keyboard_report_keys(report_keyboard_t* keyboard_report) {
+    memcpy(keyboard_report->keys, key_order, key_order_count);
+    memset(&keyboard_report->keys[key_order_count], 0, KEYBOARD_REPORT_KEYS - key_order_count);
+}
+
 #ifdef NKRO_ENABLE
-    if (host_can_send_nkro() && keymap_config.nkro) {
-        memset(nkro_report->bits, 0, sizeof(nkro_report->bits));
-        return;
-    }
-#endif
-    memset(keyboard_report->keys, 0, sizeof(keyboard_report->keys));
+/** \brief Fills in the keys of an NKRO report from the keys that are down
+ */
+void generate_nkro_report_bits(report_nkro_t* nkro_report) {
+    memcpy(nkro_report->bits, key_bits, NKRO_REPORT_BITS);
 }
+#endif
 
 #ifdef MOUSE_ENABLE
 /**
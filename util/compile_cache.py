@@ -0,0 +1,199 @@
+#!/usr/bin/env python3
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+"""Compiler wrapper which shares object files between builds.
+
+Usage: compile_cache.py [--cache-dir DIR] [--max-size MB] <compiler> <arguments...>
+
+Every `-c` compilation is keyed on the compiler, the flags which affect code generation, and the preprocessed
+source. Include paths, defines and forced includes only matter through the preprocessed source, so two keyboards
+building the same file for the same MCU share a single cache entry even though their command lines differ.
+
+Anything which isn't a plain compilation to an object file is passed straight through to the compiler.
+
+Once the cache grows past its maximum size, the least recently used entries are removed. Hits refresh the modification
+time of an entry, which is what the age is taken from, as access times are often not kept by the filesystem.
+"""
+import hashlib
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+from pathlib import Path
+
+# Flags consumed by the preprocessor, whose effect is already captured by the preprocessed source
+PREPROCESSOR_FLAGS_WITH_VALUE = {'-I', '-D', '-U', '-include', '-imacros', '-isystem', '-iquote', '-idirafter', '-MF', '-MT', '-MQ'}
+PREPROCESSOR_FLAG_PREFIXES = ('-I', '-D', '-U')
+PREPROCESSOR_FLAGS = {'-M', '-MM', '-MD', '-MMD', '-MP'}
+
+DEFAULT_MAX_SIZE_MB = 2048
+
+# Walking the whole cache on every store would cost more than most compilations, so it is only checked this often
+PRUNE_INTERVAL = 60
+
+# Pruning goes a little below the maximum, so that the next few stores don't immediately prune again
+PRUNE_TARGET = 0.9
+
+
+def passthrough(command):
+    os.execvp(command[0], command)
+
+
+def codegen_flags(args):
+    """Returns the arguments which can influence the generated object, excluding the output path.
+    """
+    flags = []
+    skip = False
+    for arg in args:
+        if skip:
+            skip = False
+        elif arg in PREPROCESSOR_FLAGS_WITH_VALUE or arg == '-o':
+            skip = True
+        elif arg in PREPROCESSOR_FLAGS or arg.startswith(PREPROCESSOR_FLAG_PREFIXES):
+            pass
+        else:
+            flags.append(arg)
+    return flags
+
+
+def compiler_identity(compiler):
+    """Identifies the compiler binary, so that upgrading the toolchain invalidates the cache.
+    """
+    path = shutil.which(compiler) or compiler
+    stat = os.stat(path)
+    return f'{os.path.realpath(path)}:{stat.st_size}:{stat.st_mtime_ns}'
+
+
+def preprocess(compiler, args, output):
+    """Runs the preprocessor in place of the compiler, writing the dependency file exactly as compilation would.
+
+    Returns the preprocessed source, or None if preprocessing failed.
+    """
+    preprocess_args = ['-E' if arg == '-c' else arg for arg in args]
+    output_index = preprocess_args.index('-o')
+    del preprocess_args[output_index:output_index + 2]
+
+    # The dependency target defaults to the -o argument, which is no longer the object file
+    if any(arg in ('-MF', '-MD', '-MMD') for arg in args) and not any(arg in ('-MT', '-MQ') for arg in args):
+        preprocess_args += ['-MT', output]
+
+    # Without debug info, line markers only carry the paths of headers, which differ between otherwise identical
+    # builds (eg. generated headers under each keyboard's own build directory)
+    if not any(arg.startswith('-g') and arg != '-g0' for arg in args):
+        preprocess_args.append('-P')
+
+    result = subprocess.run([compiler, *preprocess_args], stdout=subprocess.PIPE, stderr=subprocess.DEVNULL)
+    if result.returncode != 0:
+        return None
+    return result.stdout
+
+
+def store(path, data):
+    """Writes a cache entry atomically, as parallel builds may be producing the same one.
+    """
+    path.parent.mkdir(parents=True, exist_ok=True)
+    fd, temp = tempfile.mkstemp(dir=path.parent)
+    with os.fdopen(fd, 'wb') as f:
+        f.write(data)
+    os.replace(temp, path)
+
+
+def prune(cache_dir, max_size):
+    """Removes the least recently used entries until the cache fits within max_size bytes.
+    """
+    entries = []
+    total = 0
+    for cached_object in cache_dir.glob('*/*.o'):
+        cached_stderr = cached_object.with_suffix('.stderr')
+        try:
+            stat = cached_object.stat()
+            size = stat.st_size + (cached_stderr.stat().st_size if cached_stderr.exists() else 0)
+        except FileNotFoundError:
+            # Removed by a concurrent prune
+            continue
+        entries.append((stat.st_mtime_ns, size, cached_object, cached_stderr))
+        total += size
+
+    if total <= max_size:
+        return
+
+    for _, size, cached_object, cached_stderr in sorted(entries, key=lambda entry: entry[0]):
+        if total <= max_size * PRUNE_TARGET:
+            break
+        # The object goes first, as an entry only counts as a hit while both files exist
+        cached_object.unlink(missing_ok=True)
+        cached_stderr.unlink(missing_ok=True)
+        total -= size
+
+
+def maybe_prune(cache_dir, max_size):
+    """Prunes the cache if nothing else has done so in the last PRUNE_INTERVAL seconds.
+    """
+    stamp = cache_dir / '.pruned'
+    try:
+        if time.time() - stamp.stat().st_mtime < PRUNE_INTERVAL:
+            return
+    except FileNotFoundError:
+        pass
+    stamp.touch()
+    prune(cache_dir, max_size)
+
+
+def main(argv):
+    cache_dir = Path('.build/compile_cache')
+    max_size = DEFAULT_MAX_SIZE_MB * 1024 * 1024
+    while len(argv) > 2 and argv[0] in ('--cache-dir', '--max-size'):
+        if argv[0] == '--cache-dir':
+            cache_dir = Path(argv[1])
+        else:
+            max_size = int(argv[1]) * 1024 * 1024
+        argv = argv[2:]
+
+    compiler, args = argv[0], argv[1:]
+
+    # Only plain compilations of a single object file are cached; assembler listings are a side output we can't replay
+    if args.count('-c') != 1 or args.count('-o') != 1 or any(arg.startswith('-Wa,-a') for arg in args):
+        passthrough(argv)
+
+    output = args[args.index('-o') + 1]
+    source = preprocess(compiler, args, output)
+    if source is None:
+        # Let the compiler report the problem
+        passthrough(argv)
+
+    key = hashlib.sha256()
+    key.update(compiler_identity(compiler).encode())
+    key.update(b'\0'.join(arg.encode() for arg in codegen_flags(args)))
+    key.update(b'\0')
+    key.update(source)
+    digest = key.hexdigest()
+
+    entry = cache_dir / digest[:2] / digest
+    cached_object = entry.with_suffix('.o')
+    cached_stderr = entry.with_suffix('.stderr')
+
+    if cached_object.exists() and cached_stderr.exists():
+        try:
+            shutil.copyfile(cached_object, output)
+            stderr = cached_stderr.read_bytes()
+            os.utime(cached_object)
+        except FileNotFoundError:
+            # Pruned while being read, compile it again
+            pass
+        else:
+            sys.stderr.buffer.write(stderr)
+            return 0
+
+    result = subprocess.run(argv, stderr=subprocess.PIPE)
+    sys.stderr.buffer.write(result.stderr)
+    if result.returncode == 0:
+        store(cached_stderr, result.stderr)
+        store(cached_object, Path(output).read_bytes())
+        maybe_prune(cache_dir, max_size)
+    return result.returncode
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))